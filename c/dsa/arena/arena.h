@@ -0,0 +1,268 @@
+// =====
+// Arena
+// =====
+//
+// :Author: RickBarretto
+// :Year: 2026
+// :License: MPL 2.0
+// :Copyright: RickBarretto, 2026
+// :Version: 1.0
+//
+// ``Arena`` is a bump allocator: memory is handed out from large chunks
+// by moving an offset, and is only given back all at once, by ``reset``
+// or ``delete``. Allocating is a few instructions, objects allocated
+// together sit next to each other, and freeing a whole structure
+// (e.g. every node of a tree) costs one ``free`` per chunk.
+//
+// Chunks come from ARRAY_MALLOC and go back through ARRAY_FREE,
+// so an allocator plugged into ``Array<T>`` is also used here.
+// A request larger than the chunk size gets a chunk of its own.
+//
+// How to Use
+// ----------
+//
+//      #include "arena.h"
+//
+// And a common way to use it would be:
+//
+//      Arena * arena = Arena_new(0);               // default chunk size
+//      Node * node = Arena_alloc(arena, sizeof(Node), 64);
+//      ...
+//      Arena_delete(arena);                        // frees every node
+//
+
+#ifndef ARENA_H
+#define ARENA_H
+
+// =~=~=~=~=~=~=~=~ Imports ~=~=~=~=~=~=~=~=
+
+#include <iso646.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+
+// =~=~=~=~=~=~=~=~ Helper Macros ~=~=~=~=~=~=~=~=
+
+#define ensure(COND, VAL) if (not (COND)) return VAL
+
+
+// =~=~=~=~=~=~=~=~ Allocator Hooks ~=~=~=~=~=~=~=~=
+
+// The same hooks as ``Array<T>``, see its documentation.
+
+#ifndef ARRAY_MALLOC
+#define ARRAY_MALLOC(size) malloc(size)
+#endif
+
+#ifndef ARRAY_CALLOC
+#define ARRAY_CALLOC(count, size) calloc(count, size)
+#endif
+
+#ifndef ARRAY_REALLOC
+#define ARRAY_REALLOC(pointer, size) realloc(pointer, size)
+#endif
+
+#ifndef ARRAY_FREE
+#define ARRAY_FREE(pointer) free(pointer)
+#endif
+
+
+// =~=~=~=~=~=~=~=~ Implementation ~=~=~=~=~=~=~=~=
+
+// ARENA_CHUNK: Default chunk size, in bytes.
+#ifndef ARENA_CHUNK
+#define ARENA_CHUNK ((size_t) 1 << 20)
+#endif
+
+typedef struct _ArenaChunk {
+    struct _ArenaChunk * next;
+    size_t size;
+    size_t used;
+    unsigned char data[];
+} _ArenaChunk;
+
+typedef struct {
+    _ArenaChunk * chunks;       // the current chunk first
+    size_t _chunk_size;
+    size_t _allocated;
+} Arena;
+
+// Arena >> delete(arena: *Arena) -> bool
+//
+// Frees the arena and everything allocated from it.
+//
+// Returns
+// -------
+// bool: Returns true on success.
+//
+bool Arena_delete(Arena * arena) {
+    ensure(arena, false);
+
+    for (_ArenaChunk * chunk = arena->chunks, * next; chunk; chunk = next) {
+        next = chunk->next;
+        ARRAY_FREE(chunk);
+    }
+    ARRAY_FREE(arena);
+    return true;
+}
+
+// Arena >> new(chunk_size: size_t) -> *Arena
+//
+// Creates an empty arena. No chunk is allocated until the first request.
+//
+// Parameters
+// ----------
+// chunk_size : size_t
+//     The size of each chunk in bytes, 0 for ARENA_CHUNK.
+//
+// Returns
+// -------
+// *Arena: The new arena, or NULL on failure.
+//
+Arena * Arena_new(size_t chunk_size) {
+    Arena * arena = ARRAY_MALLOC(sizeof(Arena));
+    ensure(arena, NULL);
+
+    arena->chunks = NULL;
+    arena->_chunk_size = chunk_size ? chunk_size : ARENA_CHUNK;
+    arena->_allocated = 0;
+    return arena;
+}
+
+// Chunks get 64 spare bytes, so any alignment fits at their start.
+_ArenaChunk * _Arena_chunk(size_t size) {
+    ensure(size <= SIZE_MAX - sizeof(_ArenaChunk) - 64, NULL);
+    _ArenaChunk * chunk = ARRAY_MALLOC(sizeof(_ArenaChunk) + size + 64);
+    ensure(chunk, NULL);
+
+    chunk->next = NULL;
+    chunk->size = size + 64;
+    chunk->used = 0;
+    return chunk;
+}
+
+// First offset at or after ``used`` whose address is aligned.
+size_t _Arena_offset(_ArenaChunk * chunk, size_t alignment) {
+    uintptr_t start = (uintptr_t) chunk->data;
+    uintptr_t next = (start + chunk->used + alignment - 1) & ~(uintptr_t) (alignment - 1);
+    return (size_t) (next - start);
+}
+
+// Arena >> alloc(arena: *Arena, size: size_t, alignment: size_t) -> *void
+//
+// Allocates ``size`` bytes, not initialized.
+//
+// Parameters
+// ----------
+// arena : *Arena
+//     The arena to allocate from.
+// size : size_t
+//     The number of bytes.
+// alignment : size_t
+//     A power of two, up to 64, e.g. ``_Alignof(Node)`` or a cache line.
+//
+// Returns
+// -------
+// *void: The memory, or NULL on failure.
+//
+void * Arena_alloc(Arena * arena, size_t size, size_t alignment) {
+    ensure(arena and alignment and alignment <= 64, NULL);
+    ensure((alignment & (alignment - 1)) == 0, NULL);
+
+    _ArenaChunk * chunk = arena->chunks;
+    size_t offset = chunk ? _Arena_offset(chunk, alignment) : 0;
+    if (not chunk or offset > chunk->size or size > chunk->size - offset) {
+        // Large requests get their own chunk, behind the current one.
+        if (size > arena->_chunk_size / 4 and chunk) {
+            _ArenaChunk * large = _Arena_chunk(size);
+            ensure(large, NULL);
+            offset = _Arena_offset(large, alignment);
+            large->used = offset + size;
+            large->next = chunk->next;
+            chunk->next = large;
+            arena->_allocated += size;
+            return large->data + offset;
+        }
+
+        chunk = _Arena_chunk(size > arena->_chunk_size ? size : arena->_chunk_size);
+        ensure(chunk, NULL);
+        chunk->next = arena->chunks;
+        arena->chunks = chunk;
+        offset = _Arena_offset(chunk, alignment);
+    }
+
+    chunk->used = offset + size;
+    arena->_allocated += size;
+    return chunk->data + offset;
+}
+
+// Arena >> reset(arena: *Arena) -> bool
+//
+// Forgets every allocation at once, keeping the current chunk for reuse.
+//
+// Returns
+// -------
+// bool: Returns true on success.
+//
+bool Arena_reset(Arena * arena) {
+    ensure(arena, false);
+
+    _ArenaChunk * first = arena->chunks;
+    if (first) {
+        for (_ArenaChunk * chunk = first->next, * next; chunk; chunk = next) {
+            next = chunk->next;
+            ARRAY_FREE(chunk);
+        }
+        first->next = NULL;
+        first->used = 0;
+    }
+    arena->_allocated = 0;
+    return true;
+}
+
+// Arena >> allocated(arena: *Arena) -> size_t
+//
+// Returns the bytes handed out since the last reset, without padding.
+//
+size_t Arena_allocated(Arena * arena) {
+    ensure(arena, 0);
+    return arena->_allocated;
+}
+
+// Arena >> reserved(arena: *Arena) -> size_t
+//
+// Returns the bytes held in chunks.
+//
+size_t Arena_reserved(Arena * arena) {
+    ensure(arena, 0);
+
+    size_t bytes = 0;
+    for (_ArenaChunk * chunk = arena->chunks; chunk; chunk = chunk->next)
+        bytes += chunk->size;
+    return bytes;
+}
+
+// Arena >> debug(arena: *Arena) -> void
+//
+// Prints the debug representation of the arena.
+//
+void Arena_debug(Arena * arena) {
+    if (not arena) {
+        printf("Arena { NULL }\n");
+        return;
+    }
+
+    size_t chunks = 0;
+    for (_ArenaChunk * chunk = arena->chunks; chunk; chunk = chunk->next) chunks++;
+
+    printf("Arena {\n");
+    printf("  chunk_size: %zu,\n", arena->_chunk_size);
+    printf("  chunks: %zu,\n", chunks);
+    printf("  allocated: %zu,\n", arena->_allocated);
+    printf("  reserved: %zu,\n", Arena_reserved(arena));
+    printf("}\n");
+}
+
+#endif
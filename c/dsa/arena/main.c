@@ -0,0 +1,87 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdint.h>
+#include <stdio.h>
+#include <time.h>
+
+#include "arena.h"
+
+// Usage: ./main [nodes], defaults to 10^7 list nodes.
+
+typedef struct Node {
+    struct Node * next;
+    int64_t value;
+    char payload[32];
+} Node;
+
+double seconds() {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec + now.tv_nsec * 1e-9;
+}
+
+int64_t walk(Node * head) {
+    int64_t total = 0;
+    for (Node * node = head; node; node = node->next) total += node->value;
+    return total;
+}
+
+int main(int argc, char ** argv) {
+
+    Arena * small = Arena_new(256);
+    Arena_alloc(small, 100, 8);
+    Arena_alloc(small, 100, 64);
+    Arena_alloc(small, 1000, 16);      // larger than a quarter chunk: its own chunk
+    Arena_debug(small);
+    Arena_reset(small);
+    Arena_debug(small);
+    Arena_delete(small);
+
+    size_t nodes = argc > 1 ? (size_t) atoll(argv[1]) : 10000000;
+
+    double start = seconds();
+    Node * head = NULL;
+    for (size_t i = 0; i < nodes; i++) {
+        Node * node = malloc(sizeof(Node));
+        node->value = (int64_t) i;
+        node->next = head;
+        head = node;
+    }
+    double malloc_build = seconds() - start;
+    start = seconds();
+    int64_t malloc_sum = walk(head);
+    double malloc_walk = seconds() - start;
+    start = seconds();
+    while (head) {
+        Node * next = head->next;
+        free(head);
+        head = next;
+    }
+    double malloc_free = seconds() - start;
+
+    start = seconds();
+    Arena * arena = Arena_new(0);
+    head = NULL;
+    for (size_t i = 0; i < nodes; i++) {
+        Node * node = Arena_alloc(arena, sizeof(Node), _Alignof(Node));
+        node->value = (int64_t) i;
+        node->next = head;
+        head = node;
+    }
+    double arena_build = seconds() - start;
+    start = seconds();
+    int64_t arena_sum = walk(head);
+    double arena_walk = seconds() - start;
+    start = seconds();
+    Arena_delete(arena);
+    double arena_free = seconds() - start;
+
+    printf("\n%zu nodes of %zu bytes        build      walk      free\n", nodes, sizeof(Node));
+    printf("malloc / free:            %7.1f ms %7.1f ms %7.1f ms\n",
+        malloc_build * 1e3, malloc_walk * 1e3, malloc_free * 1e3);
+    printf("arena:                    %7.1f ms %7.1f ms %7.1f ms, sums %s\n",
+        arena_build * 1e3, arena_walk * 1e3, arena_free * 1e3,
+        malloc_sum == arena_sum ? "agree" : "differ");
+    return 0;
+
+}
@@ -6,7 +6,7 @@
 // :Year: 2026
 // :License: MPL 2.0
 // :Copyright: RickBarretto, 2026
-// :Version: 1.0.1
+// :Version: 1.3.0
 //
 // ``Array<T>`` is generic array. 
 // This provides a safe interface to deal with arrays in C,
@@ -38,13 +38,30 @@
 //      Array(cstring, println)(arr);
 //      cstring * first = Array(cstring, get)(arr, 0);
 //
+// Allocations go through ARRAY_MALLOC, ARRAY_CALLOC, ARRAY_REALLOC
+// and ARRAY_FREE, which default to the C library. Define all of them
+// before the first include to plug in another allocator for Array<T>
+// and the modules built on it:
+//
+//      #define ARRAY_MALLOC(size) my_malloc(size)
+//      #define ARRAY_CALLOC(count, size) my_calloc(count, size)
+//      #define ARRAY_REALLOC(pointer, size) my_realloc(pointer, size)
+//      #define ARRAY_FREE(pointer) my_free(pointer)
+//      #include "array.h"
+//
+// Define ARRAY_TRACK_DIRTY before an include to track which chunks
+// of that Array<T> changed, for incremental saves and replication.
+// See ARRAY_TRACK_DIRTY below.
+//
 
 // =~=~=~=~=~=~=~=~ Imports ~=~=~=~=~=~=~=~=
 
 #include <iso646.h>
 #include <stdbool.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
 
 // =~=~=~=~=~=~=~=~ Helper Macros ~=~=~=~=~=~=~=~=
@@ -60,6 +77,25 @@
 #define ensure(COND, VAL) if (not (COND)) return VAL
 
 
+// =~=~=~=~=~=~=~=~ Allocator Hooks ~=~=~=~=~=~=~=~=
+
+#ifndef ARRAY_MALLOC
+#define ARRAY_MALLOC(size) malloc(size)
+#endif
+
+#ifndef ARRAY_CALLOC
+#define ARRAY_CALLOC(count, size) calloc(count, size)
+#endif
+
+#ifndef ARRAY_REALLOC
+#define ARRAY_REALLOC(pointer, size) realloc(pointer, size)
+#endif
+
+#ifndef ARRAY_FREE
+#define ARRAY_FREE(pointer) free(pointer)
+#endif
+
+
 // =~=~=~=~=~=~=~=~ Implementation ~=~=~=~=~=~=~=~=
 
 // T: Element type of the Array<T>
@@ -88,20 +124,69 @@
 #error "PRINT_T is not defined"
 #endif
 
+// ARRAY_TRACK_DIRTY: Optional.
+//
+// Keeps a bitmap with a bit per ARRAY_DIRTY_CHUNK elements (defaults
+// to 4096), set by ``set``, ``replace``, ``write`` and ``resize``,
+// and cleared by ``drain_dirty``, which walks the changed runs:
+//
+//      #define ARRAY_TRACK_DIRTY
+//      #define ARRAY_DIRTY_CHUNK 1024
+//      #define T int64_t
+//      #define PRINT_T(value) printf("%lld", (long long) value)
+//      #include "array.h"
+//
+//      size_t cursor = 0, index, count;
+//      while (Array(int64_t, drain_dirty)(array, &cursor, &index, &count))
+//          save(&array->data[index], count);
+//
+// A new array starts all dirty, so the first drain saves it whole.
+// Writes straight through ``data`` are not seen: report them with
+// ``mark_dirty``. Both macros apply to one include, like T. Without
+// them the bitmap, and every line that touches it, is compiled out.
+//
+#ifdef ARRAY_TRACK_DIRTY
+#ifndef ARRAY_DIRTY_CHUNK
+#define ARRAY_DIRTY_CHUNK 4096
+#endif
+#endif
+
 #define MODULE Array
 #define Self CAT(MODULE, T)
 #define fn(NAME) CAT(Self, NAME)
 
 #define _ARRAY_SELECT_MACRO(_1, _2, NAME, ...) NAME
 #define Array(...) _ARRAY_SELECT_MACRO(__VA_ARGS__, Array2, Array1)(__VA_ARGS__)
-#define Array1(T) CAT(MODULE, T)
-#define Array2(T, FUNC) CAT3(MODULE, T, FUNC)
+#define Array1(T) CAT(Array, T)
+#define Array2(T, FUNC) CAT3(Array, T, FUNC)
 
 typedef struct {
     T* data;
     size_t _size;
+#ifdef ARRAY_TRACK_DIRTY
+    uint64_t * _dirty;          // a bit per ARRAY_DIRTY_CHUNK elements
+#endif
 } Self;
 
+#ifdef ARRAY_TRACK_DIRTY
+
+// Words of the dirty bitmap for ``size`` elements.
+size_t fn(_dirty_words)(size_t size) {
+    size_t chunks = (size + ARRAY_DIRTY_CHUNK - 1) / ARRAY_DIRTY_CHUNK;
+    return chunks ? (chunks + 63) / 64 : 1;
+}
+
+// Marks the chunks of ``count`` elements from ``index``.
+void fn(_mark)(Self * array, size_t index, size_t count) {
+    ensure(count > 0,);
+
+    size_t last = (index + count - 1) / ARRAY_DIRTY_CHUNK;
+    for (size_t chunk = index / ARRAY_DIRTY_CHUNK; chunk <= last; chunk++)
+        array->_dirty[chunk / 64] |= (uint64_t) 1 << (chunk % 64);
+}
+
+#endif
+
 
 // Array >> new(size: size_t) -> *Array<T>
 //
@@ -114,11 +199,26 @@ typedef struct {
 //
 // Returns
 // -------
-// *Array<T>: A pointer to the newly created array.
+// *Array<T>: A pointer to the newly created array, or NULL on failure.
 //
 Self *fn(new)(size_t size) {
-    Self * array = malloc(sizeof(Self));
-    array->data = calloc(size, sizeof(T));
+    Self * array = ARRAY_MALLOC(sizeof(Self));
+    ensure(array, NULL);
+
+    array->data = ARRAY_CALLOC(size ? size : 1, sizeof(T));
+    if (not array->data) {
+        ARRAY_FREE(array);
+        return NULL;
+    }
+#ifdef ARRAY_TRACK_DIRTY
+    array->_dirty = ARRAY_CALLOC(fn(_dirty_words)(size), sizeof(uint64_t));
+    if (not array->_dirty) {
+        ARRAY_FREE(array->data);
+        ARRAY_FREE(array);
+        return NULL;
+    }
+    fn(_mark)(array, 0, size);
+#endif
     array->_size = size;
     return array;
 }
@@ -139,8 +239,11 @@ Self *fn(new)(size_t size) {
 bool fn(delete)(Self* array) {
     ensure(array, false);
 
-    free(array->data);
-    free(array);
+#ifdef ARRAY_TRACK_DIRTY
+    ARRAY_FREE(array->_dirty);
+#endif
+    ARRAY_FREE(array->data);
+    ARRAY_FREE(array);
     return true;
 }
 
@@ -189,6 +292,9 @@ bool fn(set)(Self* array, size_t index, T value) {
     ensure(index < array->_size, false);
 
     array->data[index] = value;
+#ifdef ARRAY_TRACK_DIRTY
+    fn(_mark)(array, index, 1);
+#endif
     return true;
 }
 
@@ -239,6 +345,183 @@ size_t fn(size)(Self * array) {
     return array->_size;
 }
 
+// Array >> resize(array: *Array<T>, size: size_t) -> bool
+//
+// Grows or shrinks the array in place, keeping the first elements.
+// New elements are zeroed, as in ``new``.
+//
+// Parameters
+// ----------
+// array : *Array<T>
+//     The array to resize.
+// size : size_t
+//     The new number of elements.
+//
+// Returns
+// -------
+// bool: Returns true on success. On failure the array is left unchanged.
+//
+bool fn(resize)(Self * array, size_t size) {
+    ensure(array, false);
+
+#ifdef ARRAY_TRACK_DIRTY
+    // The bitmap grows before the data, as a larger one is harmless
+    // if the data fails, and shrinks only once the data did.
+    size_t words = fn(_dirty_words)(array->_size), resized = fn(_dirty_words)(size);
+    if (resized > words) {
+        uint64_t * dirty = ARRAY_REALLOC(array->_dirty, resized * sizeof(uint64_t));
+        ensure(dirty, false);
+
+        for (size_t i = words; i < resized; i++) dirty[i] = 0;
+        array->_dirty = dirty;
+    }
+#endif
+
+    T * data = ARRAY_REALLOC(array->data, (size ? size : 1) * sizeof(T));
+    ensure(data, false);
+
+#ifdef ARRAY_TRACK_DIRTY
+    if (resized < words) {
+        // Keeping the larger bitmap is fine if this fails.
+        uint64_t * dirty = ARRAY_REALLOC(array->_dirty, resized * sizeof(uint64_t));
+        if (dirty) array->_dirty = dirty;
+    }
+#endif
+
+    for (size_t i = array->_size; i < size; i++) data[i] = (T) { 0 };
+#ifdef ARRAY_TRACK_DIRTY
+    // New elements are changes; chunks past the new end are forgotten.
+    if (size > array->_size) fn(_mark)(array, array->_size, size - array->_size);
+    size_t chunks = (size + ARRAY_DIRTY_CHUNK - 1) / ARRAY_DIRTY_CHUNK;
+    for (size_t chunk = chunks; chunk < resized * 64; chunk++)
+        array->_dirty[chunk / 64] &= ~((uint64_t) 1 << (chunk % 64));
+#endif
+    array->data = data;
+    array->_size = size;
+    return true;
+}
+
+// Array >> write(array: *Array<T>, index: size_t, values: *T, count: size_t) -> bool
+//
+// Copies ``count`` values into the array, starting at ``index``.
+//
+// Parameters
+// ----------
+// array : *Array<T>
+//     The array to write to.
+// index : size_t
+//     The index of the first element to write.
+// values : *T
+//     The values to copy, which must not overlap the array.
+// count : size_t
+//     The number of values.
+//
+// Returns
+// -------
+// bool: Returns true on success, false if the range is out of bounds.
+//
+bool fn(write)(Self * array, size_t index, T * values, size_t count) {
+    ensure(array and index <= array->_size and count <= array->_size - index, false);
+    ensure(count > 0, true);
+    ensure(values, false);
+
+    memcpy(&array->data[index], values, count * sizeof(T));
+#ifdef ARRAY_TRACK_DIRTY
+    fn(_mark)(array, index, count);
+#endif
+    return true;
+}
+
+// Array >> mark_dirty(array: *Array<T>, index: size_t, count: size_t) -> bool
+//
+// Reports ``count`` elements from ``index`` as changed, after writing
+// them straight through ``data``. Does nothing without ARRAY_TRACK_DIRTY.
+//
+// Returns
+// -------
+// bool: Returns true on success, false if the range is out of bounds.
+//
+bool fn(mark_dirty)(Self * array, size_t index, size_t count) {
+    ensure(array and index <= array->_size and count <= array->_size - index, false);
+
+#ifdef ARRAY_TRACK_DIRTY
+    fn(_mark)(array, index, count);
+#endif
+    return true;
+}
+
+#ifdef ARRAY_TRACK_DIRTY
+
+// Array >> dirty(array: *Array<T>) -> size_t
+//
+// Returns the number of chunks changed since they were last drained.
+//
+size_t fn(dirty)(Self * array) {
+    ensure(array, 0);
+
+    size_t dirty = 0;
+    for (size_t i = 0; i < fn(_dirty_words)(array->_size); i++)
+        dirty += (size_t) __builtin_popcountll(array->_dirty[i]);
+    return dirty;
+}
+
+// Array >> drain_dirty(array: *Array<T>, cursor: *size_t, index: *size_t, count: *size_t) -> bool
+//
+// Walks the runs of changed elements in order, clearing them as it goes,
+// so the next walk only sees what changed since. Adjacent dirty chunks
+// come as one run. Clean stretches are skipped 64 chunks at a time.
+//
+// Parameters
+// ----------
+// array : *Array<T>
+//     The array to drain.
+// cursor : *size_t
+//     Where to resume, 0 to start.
+// index : *size_t
+//     Receives the first element of the run.
+// count : *size_t
+//     Receives the number of elements in the run.
+//
+// Returns
+// -------
+// bool: Returns true while there is a run, false at the end.
+//
+bool fn(drain_dirty)(Self * array, size_t * cursor, size_t * index, size_t * count) {
+    ensure(array and cursor, false);
+
+    size_t chunks = (array->_size + ARRAY_DIRTY_CHUNK - 1) / ARRAY_DIRTY_CHUNK;
+    size_t chunk = (*cursor + ARRAY_DIRTY_CHUNK - 1) / ARRAY_DIRTY_CHUNK;
+    uint64_t * dirty = array->_dirty;
+
+    // The first dirty chunk from the cursor.
+    while (chunk < chunks) {
+        uint64_t word = dirty[chunk / 64] >> (chunk % 64);
+        if (word) {
+            chunk += (size_t) __builtin_ctzll(word);
+            break;
+        }
+        chunk = (chunk / 64 + 1) * 64;
+    }
+    if (chunk >= chunks) {
+        *cursor = array->_size;
+        return false;
+    }
+
+    size_t first = chunk;
+    while (chunk < chunks and dirty[chunk / 64] & (uint64_t) 1 << (chunk % 64)) {
+        dirty[chunk / 64] &= ~((uint64_t) 1 << (chunk % 64));
+        chunk++;
+    }
+
+    size_t end = chunk * ARRAY_DIRTY_CHUNK < array->_size ? chunk * ARRAY_DIRTY_CHUNK : array->_size;
+    if (index) *index = first * ARRAY_DIRTY_CHUNK;
+    if (count) *count = end - first * ARRAY_DIRTY_CHUNK;
+    *cursor = end;
+    return true;
+}
+
+#endif
+
 // Array >> print(array: *Array<T>, print: (T) -> void) -> void
 // 
 // Prints the array on terminal.
@@ -280,7 +563,10 @@ void fn(debug)(Self * array) {
 
 }
 
+#undef MODULE
 #undef Self
 #undef fn
 #undef T
 #undef PRINT_T
+#undef ARRAY_TRACK_DIRTY
+#undef ARRAY_DIRTY_CHUNK
@@ -0,0 +1,323 @@
+// ===========
+// ArrayTxn<T>
+// ===========
+//
+// :Author: RickBarretto
+// :Year: 2026
+// :License: MPL 2.0
+// :Copyright: RickBarretto, 2026
+// :Version: 1.0
+//
+// ``ArrayTxn<T>`` groups ``Array<T>`` writes that must land all together
+// or not at all. A transaction stages ``(index, value)`` pairs in a log
+// of its own, leaving the array untouched until ``txn_commit``, which
+// checks every staged write against the array as it is then, and only
+// then applies them, sorted by index so memory is walked in order.
+//
+// ``txn_rollback`` just drops the log: nothing was applied, so it costs
+// O(staged) at most, whatever the size of the array. Both end the
+// transaction. When an index is staged twice, the last write wins.
+//
+// ``txn_commit`` returns a ``Result<size_t, ArrayTxnError>``, with the
+// number of writes applied or why none was.
+//
+// How to Use
+// ----------
+//
+// Include this header after ``array.h``, with the same T and PRINT_T.
+// It brings ``Result(size_t, ArrayTxnError)`` from ``result.h`` along.
+//
+//      #define T int64_t
+//      #define PRINT_T(value) printf("%lld", (long long) value)
+//      #include "array.h"
+//
+//      #define T int64_t
+//      #define PRINT_T(value) printf("%lld", (long long) value)
+//      #include "array_txn.h"
+//
+// And a common way to use it would be:
+//
+//      ArrayTxn(int64_t) * txn = Array(int64_t, txn_begin)(accounts);
+//      Array(int64_t, txn_stage)(txn, from, balance_from - amount);
+//      Array(int64_t, txn_stage)(txn, to, balance_to + amount);
+//
+//      Result(size_t, ArrayTxnError) * result = Array(int64_t, txn_commit)(txn);
+//      if (Result(size_t, ArrayTxnError, is_err)(result)) ...   // accounts untouched
+//      Result(size_t, ArrayTxnError, delete)(result);
+//
+
+// =~=~=~=~=~=~=~=~ Imports ~=~=~=~=~=~=~=~=
+
+#include <iso646.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+// =~=~=~=~=~=~=~=~ Helper Macros ~=~=~=~=~=~=~=~=
+
+#define _CAT(X, Y) X ## _ ## Y
+#define CAT(X, Y) _CAT(X, Y)
+#define _CAT3(X, Y, Z) X ## _ ## Y ## _ ## Z
+#define CAT3(X, Y, Z) _CAT3(X, Y, Z)
+
+#define STRINGIFY(x) #x
+#define TOSTRING(x) STRINGIFY(x)
+
+#define ensure(COND, VAL) if (not (COND)) return VAL
+
+
+// =~=~=~=~=~=~=~=~ Shared helpers ~=~=~=~=~=~=~=~=
+
+#ifndef ARRAY_TXN_HELPERS
+#define ARRAY_TXN_HELPERS
+
+typedef enum {
+    ARRAY_TXN_INVALID = 0,          // no transaction, or no array
+    ARRAY_TXN_OUT_OF_BOUNDS = 1,    // a staged index is past the array's end
+    ARRAY_TXN_NO_MEMORY = 2
+} ArrayTxnError;
+
+const char * ArrayTxnError_as_string[] = {
+    "Invalid",
+    "Out Of Bounds",
+    "No Memory"
+};
+
+// Result<size_t, ArrayTxnError> is instantiated once, with the caller's
+// T and PRINT_T set aside meanwhile.
+#pragma push_macro("T")
+#pragma push_macro("PRINT_T")
+#undef T
+#undef PRINT_T
+
+#define T size_t
+#define E ArrayTxnError
+#define PRINT_T(value) printf("%zu", value)
+#define PRINT_E(value) printf("%s", ArrayTxnError_as_string[value])
+#include "../result/result.h"
+
+#pragma pop_macro("T")
+#pragma pop_macro("PRINT_T")
+
+#endif
+
+
+// =~=~=~=~=~=~=~=~ Implementation ~=~=~=~=~=~=~=~=
+
+// T: Element type of the Array<T> the transactions write to.
+#ifndef T
+#error "T is not defined"
+#endif
+
+// PRINT_T: (T) -> void
+//
+// PRINT_T is a macro that defines how to print an element of type T.
+// See ``Array<T>`` for more details.
+//
+#ifndef PRINT_T
+#error "PRINT_T is not defined"
+#endif
+
+#define MODULE ArrayTxn
+#define Self CAT(MODULE, T)
+#define fn(NAME) CAT(Self, NAME)
+
+#define _ARRAY_TXN_SELECT_MACRO(_1, _2, NAME, ...) NAME
+#define ArrayTxn(...) _ARRAY_TXN_SELECT_MACRO(__VA_ARGS__, ArrayTxn2, ArrayTxn1)(__VA_ARGS__)
+#define ArrayTxn1(T) CAT(ArrayTxn, T)
+#define ArrayTxn2(T, FUNC) CAT3(ArrayTxn, T, FUNC)
+
+typedef struct {
+    size_t index;
+    T value;
+} fn(_Entry);
+
+typedef struct {
+    Array(T) * array;
+    fn(_Entry) * _log;
+    size_t _staged;
+    size_t _capacity;
+} Self;
+
+
+// ~~~~~~~~ Log ~~~~~~~~
+
+// Frees the transaction and its log.
+void fn(_end)(Self * txn) {
+    ARRAY_FREE(txn->_log);
+    ARRAY_FREE(txn);
+}
+
+// Sorts the log by index, keeping the staging order of equal indices.
+// A byte at a time, least significant first, through ``scratch``,
+// for as many bytes as ``size`` needs; returns the sorted buffer.
+fn(_Entry) * fn(_sort)(fn(_Entry) * log, fn(_Entry) * scratch, size_t count, size_t size) {
+    for (unsigned shift = 0; shift < 64 and (size - 1) >> shift; shift += 8) {
+        size_t offsets[256] = { 0 };
+        for (size_t i = 0; i < count; i++) offsets[log[i].index >> shift & 0xFF]++;
+        for (size_t digit = 0, total = 0; digit < 256; digit++) {
+            size_t here = offsets[digit];
+            offsets[digit] = total;
+            total += here;
+        }
+        for (size_t i = 0; i < count; i++) scratch[offsets[log[i].index >> shift & 0xFF]++] = log[i];
+
+        fn(_Entry) * swap = log;
+        log = scratch;
+        scratch = swap;
+    }
+    return log;
+}
+
+
+// ~~~~~~~~ Array API ~~~~~~~~
+
+// Array >> txn_begin(array: *Array<T>) -> *ArrayTxn<T>
+//
+// Begins a transaction on ``array``, which stays untouched until commit.
+//
+// Returns
+// -------
+// *ArrayTxn<T>: The transaction, or NULL if there is no array
+//     or no memory.
+//
+Self * Array(T, txn_begin)(Array(T) * array) {
+    ensure(array, NULL);
+
+    Self * txn = ARRAY_CALLOC(1, sizeof(Self));
+    ensure(txn, NULL);
+
+    txn->array = array;
+    return txn;
+}
+
+// Array >> txn_stage(txn: *ArrayTxn<T>, index: size_t, value: T) -> bool
+//
+// Stages ``value`` at ``index``, appending it to the transaction's log.
+//
+// Returns
+// -------
+// bool: Returns true on success, false if the index is out of bounds
+//       now, or there is no memory. The transaction stays usable.
+//
+bool Array(T, txn_stage)(Self * txn, size_t index, T value) {
+    ensure(txn and index < Array(T, size)(txn->array), false);
+
+    if (txn->_staged == txn->_capacity) {
+        size_t capacity = txn->_capacity ? txn->_capacity * 2 : 16;
+        fn(_Entry) * log = ARRAY_REALLOC(txn->_log, capacity * sizeof(fn(_Entry)));
+        ensure(log, false);
+        txn->_log = log;
+        txn->_capacity = capacity;
+    }
+
+    txn->_log[txn->_staged++] = (fn(_Entry)) { index, value };
+    return true;
+}
+
+// Array >> txn_staged(txn: *ArrayTxn<T>) -> size_t
+//
+// Returns the number of writes staged so far.
+//
+size_t Array(T, txn_staged)(Self * txn) {
+    ensure(txn, 0);
+    return txn->_staged;
+}
+
+// Array >> txn_commit(txn: *ArrayTxn<T>) -> *Result<size_t, ArrayTxnError>
+//
+// Applies every staged write in index order, or none of them,
+// then ends the transaction either way.
+//
+// Returns
+// -------
+// *Result<size_t, ArrayTxnError>: The number of elements written,
+//     or why the array was left untouched:
+//     ARRAY_TXN_INVALID without a transaction,
+//     ARRAY_TXN_OUT_OF_BOUNDS if the array shrank under a staged index,
+//     ARRAY_TXN_NO_MEMORY if the log could not be sorted.
+//     The caller deletes it.
+//
+Result(size_t, ArrayTxnError) * Array(T, txn_commit)(Self * txn) {
+    ensure(txn, Fail(size_t, ArrayTxnError)(ARRAY_TXN_INVALID));
+
+    Array(T) * array = txn->array;
+    size_t size = Array(T, size)(array);
+    bool sorted = true;
+    for (size_t i = 0; i < txn->_staged; i++) {
+        if (txn->_log[i].index >= size) {
+            fn(_end)(txn);
+            return Fail(size_t, ArrayTxnError)(ARRAY_TXN_OUT_OF_BOUNDS);
+        }
+        sorted = sorted and (i == 0 or txn->_log[i - 1].index <= txn->_log[i].index);
+    }
+
+    fn(_Entry) * log = txn->_log;
+    fn(_Entry) * scratch = NULL;
+    if (not sorted) {
+        scratch = ARRAY_MALLOC(txn->_staged * sizeof(fn(_Entry)));
+        if (not scratch) {
+            fn(_end)(txn);
+            return Fail(size_t, ArrayTxnError)(ARRAY_TXN_NO_MEMORY);
+        }
+        log = fn(_sort)(txn->_log, scratch, txn->_staged, size);
+    }
+
+    // Only the last write of each index is applied.
+    size_t written = 0;
+    for (size_t i = 0; i < txn->_staged; i++) {
+        if (i + 1 < txn->_staged and log[i + 1].index == log[i].index) continue;
+        Array(T, set)(array, log[i].index, log[i].value);
+        written++;
+    }
+
+    ARRAY_FREE(scratch);
+    fn(_end)(txn);
+    return Success(size_t, ArrayTxnError)(written);
+}
+
+// Array >> txn_rollback(txn: *ArrayTxn<T>) -> bool
+//
+// Drops the staged writes and ends the transaction.
+// The array was never touched, so this is independent of its size.
+//
+// Returns
+// -------
+// bool: Returns true on success.
+//
+bool Array(T, txn_rollback)(Self * txn) {
+    ensure(txn, false);
+
+    fn(_end)(txn);
+    return true;
+}
+
+// Array >> txn_debug(txn: *ArrayTxn<T>) -> void
+//
+// Prints the debug representation of the transaction.
+//
+void Array(T, txn_debug)(Self * txn) {
+    if (not txn) {
+        printf("ArrayTxn<%s> { NULL }\n", TOSTRING(T));
+        return;
+    }
+
+    printf("ArrayTxn<%s> {\n", TOSTRING(T));
+    printf("  array: %zu elements,\n", Array(T, size)(txn->array));
+    printf("  staged: [");
+    for (size_t i = 0; i < txn->_staged; i++) {
+        printf("%zu: ", txn->_log[i].index);
+        PRINT_T(txn->_log[i].value);
+        if (i + 1 < txn->_staged) printf(", ");
+    }
+    printf("]\n}\n");
+}
+
+#undef MODULE
+#undef Self
+#undef fn
+#undef T
+#undef PRINT_T
@@ -1,11 +1,51 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdint.h>
 #include <stdio.h>
+#include <time.h>
 
 typedef char* str;
 #define T str
 #define PRINT_T(value) printf("%s", value)
 #include "array.h"
 
-int main() {
+#define CHUNK 512
+#define ARRAY_TRACK_DIRTY
+#define ARRAY_DIRTY_CHUNK CHUNK
+#define T int64_t
+#define PRINT_T(value) printf("%lld", (long long) value)
+#include "array.h"
+
+#define T int64_t
+#define PRINT_T(value) printf("%lld", (long long) value)
+#include "array_txn.h"
+
+// Usage: ./main [size] [sets] [staged], defaults to 2^24 elements, 2000 sets
+// between saves to a replica file, and 2^20 writes in one transaction.
+
+double seconds() {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec + now.tv_nsec * 1e-9;
+}
+
+uint64_t next_random(uint64_t * seed) {
+    *seed = *seed * 6364136223846793005ull + 1442695040888963407ull;
+    return *seed >> 32;
+}
+
+// Writes the changed runs of ``array`` over the replica, returning the bytes written.
+size_t save_dirty(Array(int64_t) * array, FILE * replica) {
+    size_t cursor = 0, index, count, written = 0;
+    while (Array(int64_t, drain_dirty)(array, &cursor, &index, &count)) {
+        fseek(replica, (long) (index * sizeof(int64_t)), SEEK_SET);
+        written += fwrite(&array->data[index], sizeof(int64_t), count, replica) * sizeof(int64_t);
+    }
+    fflush(replica);
+    return written;
+}
+
+int main(int argc, char ** argv) {
 
     Array(str) * names = Array(str, new)(5);
 
@@ -18,6 +58,83 @@ int main() {
     Array(str, debug)(names);
 
     Array(str, delete)(names);
+
+    // Incremental saves: only the chunks changed since the last save are written,
+    // the first save writes everything as a new array starts dirty.
+    size_t size = argc > 1 ? (size_t) atoll(argv[1]) : (size_t) 1 << 24;
+    size_t sets = argc > 2 ? (size_t) atoll(argv[2]) : 2000;
+    Array(int64_t) * values = Array(int64_t, new)(size);
+    FILE * replica = tmpfile();
+    if (not values or not replica) return 1;
+
+    double start = seconds();
+    size_t full = save_dirty(values, replica);
+    double full_time = seconds() - start;
+
+    uint64_t seed = 1;
+    for (size_t i = 0; i < sets; i++) Array(int64_t, set)(values, next_random(&seed) % size, (int64_t) i);
+    int64_t batch[100] = { 0 };
+    Array(int64_t, write)(values, size / 2, batch, size / 2 < 100 ? size / 2 : 100);
+    size_t dirty = Array(int64_t, dirty)(values);
+
+    start = seconds();
+    size_t incremental = save_dirty(values, replica);
+    double incremental_time = seconds() - start;
+
+    // The replica must now match the array.
+    size_t same = 0;
+    int64_t value;
+    rewind(replica);
+    for (size_t i = 0; i < size and fread(&value, sizeof(value), 1, replica) == 1; i++) same += value == values->data[i];
+
+    printf("\n%zu elements, %zu sets, chunks of %d\n", size, sets, CHUNK);
+    printf("full save:        %10zu bytes, %8.2f ms\n", full, full_time * 1e3);
+    printf("incremental save: %10zu bytes, %8.2f ms, %zu dirty chunks, replica %s\n",
+        incremental, incremental_time * 1e3, dirty, same == size ? "in sync" : "differs");
+
+    // Transactions: the same random writes, set one by one, then staged
+    // and committed in index order.
+    size_t staged = argc > 3 ? (size_t) atoll(argv[3]) : (size_t) 1 << 20;
+    Array(int64_t) * direct = Array(int64_t, new)(size);
+    Array(int64_t) * batched = Array(int64_t, new)(size);
+    if (not direct or not batched) return 1;
+
+    seed = 2;
+    start = seconds();
+    for (size_t i = 0; i < staged; i++) Array(int64_t, set)(direct, next_random(&seed) % size, (int64_t) i);
+    double direct_time = seconds() - start;
+
+    seed = 2;
+    start = seconds();
+    ArrayTxn(int64_t) * txn = Array(int64_t, txn_begin)(batched);
+    for (size_t i = 0; i < staged; i++) Array(int64_t, txn_stage)(txn, next_random(&seed) % size, (int64_t) i);
+    Result(size_t, ArrayTxnError) * result = Array(int64_t, txn_commit)(txn);
+    double txn_time = seconds() - start;
+
+    same = 0;
+    for (size_t i = 0; i < size; i++) same += direct->data[i] == batched->data[i];
+    printf("\n%zu writes\n", staged);
+    printf("one by one:       %8.2f ms\n", direct_time * 1e3);
+    printf("transaction:      %8.2f ms, ", txn_time * 1e3);
+    Result(size_t, ArrayTxnError, print)(result);
+    printf(" elements written, arrays %s\n", same == size ? "agree" : "differ");
+    Result(size_t, ArrayTxnError, delete)(result);
+
+    // A transaction staged before the array shrank applies nothing.
+    txn = Array(int64_t, txn_begin)(batched);
+    Array(int64_t, txn_stage)(txn, 0, -1);
+    Array(int64_t, txn_stage)(txn, size - 1, -1);
+    Array(int64_t, resize)(batched, size / 2);
+    result = Array(int64_t, txn_commit)(txn);
+    printf("after a shrink:   ");
+    Result(size_t, ArrayTxnError, print)(result);
+    printf(", first element %lld\n", (long long) batched->data[0]);
+    Result(size_t, ArrayTxnError, delete)(result);
+
+    fclose(replica);
+    Array(int64_t, delete)(direct);
+    Array(int64_t, delete)(batched);
+    Array(int64_t, delete)(values);
     return 0;
 
-}
\ No newline at end of file
+}
@@ -0,0 +1,666 @@
+// ===========
+// BTree<K, V>
+// ===========
+//
+// :Author: RickBarretto
+// :Year: 2026
+// :License: MPL 2.0
+// :Copyright: RickBarretto, 2026
+// :Version: 1.0
+//
+// ``BTree<K, V>`` is an ordered map, a B+tree: every entry lives
+// in a leaf, leaves are chained in key order for range scans,
+// and inner nodes only route.
+//
+// Nodes are sized in cache lines, not in entries: the keys of a node
+// take BTREE_NODE_BYTES (2 lines by default, i.e. 16 ``int64_t`` keys),
+// so a lookup touches a handful of lines per level and the tree stays
+// shallow. With the default ``<``, a node is searched with a branchless
+// count over all its slots, which the compiler turns into SIMD compares;
+// a custom LESS_K falls back to a binary search within the node.
+//
+// Nodes come from an ``Arena`` owned by the tree, so they are packed
+// together and ``delete`` frees them all at once. ``remove`` does not
+// merge nodes: their space comes back when the tree is deleted
+// or bulk loaded again.
+//
+// How to Use
+// ----------
+//
+// Include ``Array<K>`` and ``Array<V>`` first (for ``from_sorted``),
+// then this header after defining K, V, PRINT_K and PRINT_V:
+//
+//      #define K int64_t
+//      #define V size_t
+//      #define PRINT_K(key) printf("%lld", (long long) key)
+//      #define PRINT_V(value) printf("%zu", value)
+//      #include "btree.h"
+//
+// For string keys:
+//
+//      #define LESS_K(a, b) (strcmp(a, b) < 0)
+//
+// Each function is namespaced under BTree<K, V>,
+// i.e. ``BTree(int64_t, size_t, get)`` is the same as
+// ``BTree_int64_t_size_t_get``.
+//
+//      BTree(int64_t, size_t) * tree = BTree(int64_t, size_t, new)();
+//      BTree(int64_t, size_t, set)(tree, 42, 7);
+//      size_t * value = BTree(int64_t, size_t, get)(tree, 42);
+//
+//      BTree(int64_t, size_t, Iterator) range = BTree(int64_t, size_t, range)(tree, 10, 20);
+//      int64_t * key;
+//      while (BTree(int64_t, size_t, next)(&range, &key, &value)) { ... }
+//
+
+// =~=~=~=~=~=~=~=~ Imports ~=~=~=~=~=~=~=~=
+
+#include <iso646.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../arena/arena.h"
+
+
+// =~=~=~=~=~=~=~=~ Helper Macros ~=~=~=~=~=~=~=~=
+
+#define _CAT(X, Y) X ## _ ## Y
+#define CAT(X, Y) _CAT(X, Y)
+#define _CAT3(X, Y, Z) X ## _ ## Y ## _ ## Z
+#define CAT3(X, Y, Z) _CAT3(X, Y, Z)
+
+#define STRINGIFY(x) #x
+#define TOSTRING(x) STRINGIFY(x)
+
+#define ensure(COND, VAL) if (not (COND)) return VAL
+
+
+// =~=~=~=~=~=~=~=~ Shared helpers ~=~=~=~=~=~=~=~=
+
+#ifndef BTREE_HELPERS
+#define BTREE_HELPERS
+
+// BTREE_NODE_BYTES: Bytes of keys per node, a few cache lines.
+#ifndef BTREE_NODE_BYTES
+#define BTREE_NODE_BYTES 128
+#endif
+
+// BTREE_MAX_HEIGHT: Deepest path kept while inserting.
+#define BTREE_MAX_HEIGHT 32
+
+#endif
+
+
+// =~=~=~=~=~=~=~=~ Implementation ~=~=~=~=~=~=~=~=
+
+// K: Key type of the BTree<K, V>
+#ifndef K
+#error "K is not defined"
+#endif
+
+// V: Value type of the BTree<K, V>
+#ifndef V
+#error "V is not defined"
+#endif
+
+// PRINT_K: (K) -> void
+//
+// PRINT_K is a macro that defines how to print a key of type K.
+// See ``Array<T>`` PRINT_T for more details.
+//
+#ifndef PRINT_K
+#error "PRINT_K is not defined"
+#endif
+
+// PRINT_V: (V) -> void
+//
+// PRINT_V is a macro that defines how to print a value of type V.
+//
+#ifndef PRINT_V
+#error "PRINT_V is not defined"
+#endif
+
+// LESS_K: (K, K) -> bool
+//
+// Optional. Defaults to ``<``, searched with a branchless SIMD count.
+//
+#ifndef LESS_K
+#define LESS_K(a, b) ((a) < (b))
+#define _BTREE_SCAN
+#endif
+
+#define MODULE BTree
+#define Self CAT3(MODULE, K, V)
+#define fn(NAME) CAT(Self, NAME)
+
+#define _BTREE_SELECT_MACRO(_1, _2, _3, NAME, ...) NAME
+#define BTree(...) _BTREE_SELECT_MACRO(__VA_ARGS__, BTree3, BTree2)(__VA_ARGS__)
+#define BTree2(K, V) CAT3(BTree, K, V)
+#define BTree3(K, V, FUNC) CAT(CAT3(BTree, K, V), FUNC)
+
+enum { fn(_CAPACITY) = BTREE_NODE_BYTES / sizeof(K) > 4 ? BTREE_NODE_BYTES / sizeof(K) : 4 };
+#define CAPACITY fn(_CAPACITY)
+
+typedef struct fn(_Node) fn(_Node);
+
+struct fn(_Node) {
+    K keys[CAPACITY];           // first, so a search reads whole lines
+    uint32_t count;
+    bool leaf;
+    fn(_Node) * next;           // leaves: the next leaf in key order
+    union {
+        fn(_Node) * children[CAPACITY + 1];     // keys[i] is the first key of children[i + 1]
+        V values[CAPACITY];
+    };
+};
+
+typedef struct {
+    Arena * arena;
+    fn(_Node) * root;
+    fn(_Node) * first;          // the leftmost leaf
+    size_t _size;
+    size_t _height;
+} Self;
+
+typedef struct {
+    fn(_Node) * leaf;
+    size_t index;
+    K high;
+    bool bounded;
+} fn(Iterator);
+
+
+// ~~~~~~~~ Nodes ~~~~~~~~
+
+fn(_Node) * fn(_node)(Self * tree, bool leaf) {
+    fn(_Node) * node = Arena_alloc(tree->arena, sizeof(fn(_Node)), 64);
+    ensure(node, NULL);
+
+    memset(node, 0, sizeof(fn(_Node)));
+    node->leaf = leaf;
+    return node;
+}
+
+// Number of keys strictly below ``key``.
+size_t fn(_lower)(const fn(_Node) * node, K key) {
+#ifdef _BTREE_SCAN
+    size_t rank = 0;
+    for (size_t i = 0; i < CAPACITY; i++)
+        rank += (i < node->count) & LESS_K(node->keys[i], key);
+    return rank;
+#else
+    size_t low = 0, high = node->count;
+    while (low < high) {
+        size_t middle = (low + high) / 2;
+        if (LESS_K(node->keys[middle], key)) low = middle + 1;
+        else high = middle;
+    }
+    return low;
+#endif
+}
+
+// Number of keys at or below ``key``, i.e. the child that holds it.
+size_t fn(_upper)(const fn(_Node) * node, K key) {
+#ifdef _BTREE_SCAN
+    size_t rank = 0;
+    for (size_t i = 0; i < CAPACITY; i++)
+        rank += (i < node->count) & not LESS_K(key, node->keys[i]);
+    return rank;
+#else
+    size_t low = 0, high = node->count;
+    while (low < high) {
+        size_t middle = (low + high) / 2;
+        if (LESS_K(key, node->keys[middle])) high = middle;
+        else low = middle + 1;
+    }
+    return low;
+#endif
+}
+
+// The leaf that holds ``key``, or would.
+fn(_Node) * fn(_leaf)(const Self * tree, K key) {
+    fn(_Node) * node = tree->root;
+    while (not node->leaf) node = node->children[fn(_upper)(node, key)];
+    return node;
+}
+
+
+// ~~~~~~~~ Lifetime ~~~~~~~~
+
+// BTree >> delete(tree: *BTree<K, V>) -> bool
+//
+// Safely deletes the tree and every node at once.
+//
+// Returns
+// -------
+// bool: Returns true on success.
+//
+bool fn(delete)(Self * tree) {
+    ensure(tree, false);
+
+    Arena_delete(tree->arena);
+    ARRAY_FREE(tree);
+    return true;
+}
+
+// BTree >> new() -> *BTree<K, V>
+//
+// Creates an empty tree.
+//
+// Returns
+// -------
+// *BTree<K, V>: A pointer to the new tree, or NULL on failure.
+//
+Self * fn(new)() {
+    Self * tree = ARRAY_MALLOC(sizeof(Self));
+    ensure(tree, NULL);
+
+    tree->arena = Arena_new(0);
+    tree->root = tree->arena ? fn(_node)(tree, true) : NULL;
+    if (not tree->root) {
+        if (tree->arena) Arena_delete(tree->arena);
+        ARRAY_FREE(tree);
+        return NULL;
+    }
+
+    tree->first = tree->root;
+    tree->_size = 0;
+    tree->_height = 1;
+    return tree;
+}
+
+// BTree >> from_sorted(keys: *Array<K>, values: *Array<V>) -> *BTree<K, V>
+//
+// Bulk loads a tree from strictly increasing keys, in O(n).
+// Leaves and inner nodes are built level by level, evenly filled,
+// instead of n inserts and their splits.
+//
+// Parameters
+// ----------
+// keys : *Array<K>
+//     The keys, strictly increasing.
+// values : *Array<V>
+//     The value of each key, as many as the keys.
+//
+// Returns
+// -------
+// *BTree<K, V>: The new tree, or NULL on mismatching sizes,
+//               unsorted keys or a failed allocation.
+//
+Self * fn(from_sorted)(Array(K) * keys, Array(V) * values) {
+    ensure(keys and values, NULL);
+
+    size_t size = Array(K, size)(keys);
+    ensure(size == Array(V, size)(values), NULL);
+    for (size_t i = 1; i < size; i++) ensure(LESS_K(keys->data[i - 1], keys->data[i]), NULL);
+
+    Self * tree = fn(new)();
+    ensure(tree, NULL);
+    ensure(size > 0, tree);
+
+    size_t count = (size + CAPACITY - 1) / CAPACITY;
+    fn(_Node) ** nodes = ARRAY_MALLOC(count * sizeof(fn(_Node) *));
+    K * lows = ARRAY_MALLOC(count * sizeof(K));
+    bool ok = nodes and lows;
+
+    // Leaves, each holding entries [i * size / count, (i + 1) * size / count).
+    for (size_t i = 0; ok and i < count; i++) {
+        fn(_Node) * leaf = i ? fn(_node)(tree, true) : tree->root;
+        if (not (ok = leaf)) break;
+
+        size_t first = i * size / count, last = (i + 1) * size / count;
+        leaf->count = (uint32_t) (last - first);
+        memcpy(leaf->keys, keys->data + first, leaf->count * sizeof(K));
+        memcpy(leaf->values, values->data + first, leaf->count * sizeof(V));
+        if (i) nodes[i - 1]->next = leaf;
+        nodes[i] = leaf;
+        lows[i] = leaf->keys[0];
+    }
+
+    // Inner levels, up to a single root.
+    while (ok and count > 1) {
+        size_t parents = (count + CAPACITY) / (CAPACITY + 1);
+        for (size_t p = 0; p < parents; p++) {
+            fn(_Node) * inner = fn(_node)(tree, false);
+            if (not (ok = inner)) break;
+
+            size_t first = p * count / parents, last = (p + 1) * count / parents;
+            for (size_t c = first; c < last; c++) {
+                inner->children[c - first] = nodes[c];
+                if (c > first) inner->keys[c - first - 1] = lows[c];
+            }
+            inner->count = (uint32_t) (last - first - 1);
+            lows[p] = lows[first];
+            nodes[p] = inner;
+        }
+        count = parents;
+        tree->_height++;
+    }
+
+    if (ok) {
+        tree->root = nodes[0];
+        tree->_size = size;
+    }
+    ARRAY_FREE(nodes);
+    ARRAY_FREE(lows);
+    if (not ok) {
+        fn(delete)(tree);
+        return NULL;
+    }
+    return tree;
+}
+
+// BTree >> size(tree: *BTree<K, V>) -> size_t
+//
+// Returns the number of entries.
+//
+size_t fn(size)(Self * tree) {
+    ensure(tree, 0);
+    return tree->_size;
+}
+
+// BTree >> height(tree: *BTree<K, V>) -> size_t
+//
+// Returns the number of levels, 1 for a single leaf.
+//
+size_t fn(height)(Self * tree) {
+    ensure(tree, 0);
+    return tree->_height;
+}
+
+
+// ~~~~~~~~ Lookup and Updates ~~~~~~~~
+
+// BTree >> get(tree: *BTree<K, V>, key: K) -> *V
+//
+// Looks a key up.
+//
+// Returns
+// -------
+// *V: A pointer to the value, or NULL if the key is missing.
+//
+V * fn(get)(Self * tree, K key) {
+    ensure(tree, NULL);
+
+    fn(_Node) * leaf = fn(_leaf)(tree, key);
+    size_t at = fn(_lower)(leaf, key);
+    ensure(at < leaf->count and not LESS_K(key, leaf->keys[at]), NULL);
+    return &leaf->values[at];
+}
+
+// Inserts a separator and the node right of it into a full inner node,
+// splitting it in two with the empty node ``right``.
+// Returns the new right half and its separator.
+fn(_Node) * fn(_split_inner)(fn(_Node) * node, size_t slot, K * separator,
+                             fn(_Node) * child, fn(_Node) * right) {
+    K keys[CAPACITY + 1];
+    fn(_Node) * children[CAPACITY + 2];
+    memcpy(keys, node->keys, slot * sizeof(K));
+    keys[slot] = *separator;
+    memcpy(keys + slot + 1, node->keys + slot, (CAPACITY - slot) * sizeof(K));
+    memcpy(children, node->children, (slot + 1) * sizeof(fn(_Node) *));
+    children[slot + 1] = child;
+    memcpy(children + slot + 2, node->children + slot + 1, (CAPACITY - slot) * sizeof(fn(_Node) *));
+
+    // Appending keeps the left node full, as sequential inserts do.
+    size_t middle = slot == CAPACITY ? CAPACITY - 1 : (CAPACITY + 1) / 2;
+    node->count = (uint32_t) middle;
+    memcpy(node->keys, keys, middle * sizeof(K));
+    memcpy(node->children, children, (middle + 1) * sizeof(fn(_Node) *));
+
+    right->count = (uint32_t) (CAPACITY - middle);
+    memcpy(right->keys, keys + middle + 1, right->count * sizeof(K));
+    memcpy(right->children, children + middle + 1, (right->count + 1) * sizeof(fn(_Node) *));
+
+    *separator = keys[middle];
+    return right;
+}
+
+// BTree >> set(tree: *BTree<K, V>, key: K, value: V) -> bool
+//
+// Inserts or replaces an entry. A full leaf is split in two,
+// and the split climbs up while the parents are full.
+//
+// Returns
+// -------
+// bool: Returns true on success, false on a failed allocation,
+//       in which case the tree is left unchanged.
+//
+bool fn(set)(Self * tree, K key, V value) {
+    ensure(tree, false);
+
+    fn(_Node) * path[BTREE_MAX_HEIGHT];
+    size_t slots[BTREE_MAX_HEIGHT];
+    size_t depth = 0;
+
+    fn(_Node) * node = tree->root;
+    while (not node->leaf) {
+        size_t slot = fn(_upper)(node, key);
+        path[depth] = node;
+        slots[depth++] = slot;
+        node = node->children[slot];
+    }
+
+    size_t at = fn(_lower)(node, key);
+    if (at < node->count and not LESS_K(key, node->keys[at])) {
+        node->values[at] = value;
+        return true;
+    }
+
+    // Every node the split will need is allocated before anything changes:
+    // one per full node from the leaf up, and a root if they all are.
+    fn(_Node) * spare[BTREE_MAX_HEIGHT + 1];
+    size_t needed = 0;
+    if (node->count == CAPACITY) {
+        needed = 1;
+        while (needed <= depth and path[depth - needed]->count == CAPACITY) needed++;
+        if (needed > depth) needed++;
+    }
+    for (size_t i = 0; i < needed; i++) ensure(spare[i] = fn(_node)(tree, i == 0), false);
+
+    fn(_Node) * target = node;
+    fn(_Node) * right = NULL;
+    size_t used = 0;
+    if (node->count == CAPACITY) {
+        right = spare[used++];
+
+        // Appending to the last leaf keeps it full, as sequential inserts do.
+        size_t half = at == CAPACITY and not node->next ? CAPACITY : (CAPACITY + 1) / 2;
+        size_t moved = at < half ? half - 1 : half;
+        right->count = (uint32_t) (CAPACITY - moved);
+        memcpy(right->keys, node->keys + moved, right->count * sizeof(K));
+        memcpy(right->values, node->values + moved, right->count * sizeof(V));
+        node->count = (uint32_t) moved;
+        right->next = node->next;
+        node->next = right;
+
+        if (at >= half) {
+            target = right;
+            at -= half;
+        }
+    }
+
+    memmove(target->keys + at + 1, target->keys + at, (target->count - at) * sizeof(K));
+    memmove(target->values + at + 1, target->values + at, (target->count - at) * sizeof(V));
+    target->keys[at] = key;
+    target->values[at] = value;
+    target->count++;
+    tree->_size++;
+
+    K separator = right ? right->keys[0] : key;
+    while (right) {
+        if (depth == 0) {
+            fn(_Node) * root = spare[used++];
+            root->count = 1;
+            root->keys[0] = separator;
+            root->children[0] = tree->root;
+            root->children[1] = right;
+            tree->root = root;
+            tree->_height++;
+            break;
+        }
+
+        fn(_Node) * parent = path[--depth];
+        size_t slot = slots[depth];
+        if (parent->count < CAPACITY) {
+            memmove(parent->keys + slot + 1, parent->keys + slot,
+                (parent->count - slot) * sizeof(K));
+            memmove(parent->children + slot + 2, parent->children + slot + 1,
+                (parent->count - slot) * sizeof(fn(_Node) *));
+            parent->keys[slot] = separator;
+            parent->children[slot + 1] = right;
+            parent->count++;
+            break;
+        }
+
+        right = fn(_split_inner)(parent, slot, &separator, right, spare[used++]);
+    }
+    return true;
+}
+
+// BTree >> remove(tree: *BTree<K, V>, key: K) -> bool
+//
+// Removes an entry from its leaf. Nodes are never merged,
+// so lookups stay correct and leaves may be left empty.
+//
+// Returns
+// -------
+// bool: Returns true on success, false if the key is missing.
+//
+bool fn(remove)(Self * tree, K key) {
+    ensure(tree, false);
+
+    fn(_Node) * leaf = fn(_leaf)(tree, key);
+    size_t at = fn(_lower)(leaf, key);
+    ensure(at < leaf->count and not LESS_K(key, leaf->keys[at]), false);
+
+    leaf->count--;
+    memmove(leaf->keys + at, leaf->keys + at + 1, (leaf->count - at) * sizeof(K));
+    memmove(leaf->values + at, leaf->values + at + 1, (leaf->count - at) * sizeof(V));
+    tree->_size--;
+    return true;
+}
+
+
+// ~~~~~~~~ Iteration ~~~~~~~~
+
+// BTree >> iterate(tree: *BTree<K, V>) -> BTree<K, V>.Iterator
+//
+// Returns an iterator over every entry, in key order.
+//
+fn(Iterator) fn(iterate)(Self * tree) {
+    fn(Iterator) iterator = { .leaf = tree ? tree->first : NULL, .index = 0, .bounded = false };
+    return iterator;
+}
+
+// BTree >> range(tree: *BTree<K, V>, low: K, high: K) -> BTree<K, V>.Iterator
+//
+// Returns an iterator over the entries with keys in ``[low, high)``,
+// in key order. Only the first leaf is searched, the rest are followed.
+//
+fn(Iterator) fn(range)(Self * tree, K low, K high) {
+    fn(Iterator) iterator = { .leaf = NULL, .index = 0, .high = high, .bounded = true };
+    ensure(tree, iterator);
+
+    iterator.leaf = fn(_leaf)(tree, low);
+    iterator.index = fn(_lower)(iterator.leaf, low);
+    return iterator;
+}
+
+// BTree >> next(iterator: *BTree<K, V>.Iterator, key: **K, value: **V) -> bool
+//
+// Moves to the next entry. ``key`` and ``value`` may be NULL.
+// The entries must not be changed by ``set`` or ``remove`` meanwhile.
+//
+// Returns
+// -------
+// bool: Returns true and points ``key`` and ``value`` at the next entry,
+//       or false once the range is over.
+//
+bool fn(next)(fn(Iterator) * iterator, K ** key, V ** value) {
+    ensure(iterator, false);
+
+    while (iterator->leaf and iterator->index >= iterator->leaf->count) {
+        iterator->leaf = iterator->leaf->next;
+        iterator->index = 0;
+    }
+    ensure(iterator->leaf, false);
+
+    fn(_Node) * leaf = iterator->leaf;
+    if (iterator->bounded and not LESS_K(leaf->keys[iterator->index], iterator->high)) {
+        iterator->leaf = NULL;
+        return false;
+    }
+
+    if (key) *key = &leaf->keys[iterator->index];
+    if (value) *value = &leaf->values[iterator->index];
+    iterator->index++;
+    return true;
+}
+
+
+// ~~~~~~~~ Printing ~~~~~~~~
+
+// BTree >> print(tree: *BTree<K, V>) -> void
+//
+// Prints the entries on terminal, in key order.
+//
+void fn(print)(Self * tree) {
+    ensure(tree,);
+
+    fn(Iterator) iterator = fn(iterate)(tree);
+    size_t printed = 0;
+    K * key;
+    V * value;
+
+    printf("{");
+    while (fn(next)(&iterator, &key, &value)) {
+        PRINT_K(*key);
+        printf(": ");
+        PRINT_V(*value);
+        if (++printed < tree->_size) printf(", ");
+    }
+    printf("}");
+}
+
+// BTree >> println(tree: *BTree<K, V>) -> void
+//
+// Prints the entries on terminal followed by a newline.
+//
+void fn(println)(Self * tree) {
+    fn(print)(tree);
+    printf("\n");
+}
+
+// BTree >> debug(tree: *BTree<K, V>) -> void
+//
+// Prints the debug representation of the tree.
+//
+void fn(debug)(Self * tree) {
+    if (not tree) {
+        printf("BTree<%s, %s> { NULL }\n", TOSTRING(K), TOSTRING(V));
+        return;
+    }
+
+    printf("BTree<%s, %s> {\n", TOSTRING(K), TOSTRING(V));
+    printf("  size: %zu,\n", tree->_size);
+    printf("  height: %zu,\n", tree->_height);
+    printf("  node_capacity: %d,\n", CAPACITY);
+    printf("  memory: %zu,\n", Arena_allocated(tree->arena));
+    printf("  data: "); fn(println)(tree);
+    printf("}\n");
+}
+
+#undef MODULE
+#undef Self
+#undef fn
+#undef CAPACITY
+#undef K
+#undef V
+#undef PRINT_K
+#undef PRINT_V
+#undef LESS_K
+#undef _BTREE_SCAN
@@ -0,0 +1,166 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#define T int64_t
+#define PRINT_T(value) printf("%lld", (long long) value)
+#include "../array/array.h"
+
+#define T size_t
+#define PRINT_T(value) printf("%zu", value)
+#include "../array/array.h"
+
+#define K int64_t
+#define V size_t
+#define PRINT_K(key) printf("%lld", (long long) key)
+#define PRINT_V(value) printf("%zu", value)
+#include "btree.h"
+
+// Usage: ./main [size], defaults to 2^22 entries.
+
+double seconds() {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec + now.tv_nsec * 1e-9;
+}
+
+uint64_t next_random(uint64_t * seed) {
+    *seed = *seed * 6364136223846793005ull + 1442695040888963407ull;
+    return *seed >> 32;
+}
+
+// The baseline: a sorted Array and a binary search.
+size_t lower_bound(const int64_t * keys, size_t size, int64_t key) {
+    size_t low = 0, high = size;
+    while (low < high) {
+        size_t middle = low + (high - low) / 2;
+        if (keys[middle] < key) low = middle + 1;
+        else high = middle;
+    }
+    return low;
+}
+
+int main(int argc, char ** argv) {
+
+    BTree(int64_t, size_t) * small = BTree(int64_t, size_t, new)();
+    for (int64_t key = 10; key > 0; key--) BTree(int64_t, size_t, set)(small, key * 3, (size_t) key);
+    BTree(int64_t, size_t, remove)(small, 15);
+    BTree(int64_t, size_t, debug)(small);
+
+    BTree(int64_t, size_t, Iterator) range = BTree(int64_t, size_t, range)(small, 7, 20);
+    int64_t * key;
+    size_t * value;
+    printf("[7, 20):");
+    while (BTree(int64_t, size_t, next)(&range, &key, &value)) printf(" %lld", (long long) *key);
+    printf("\n\n");
+    BTree(int64_t, size_t, delete)(small);
+
+    // Distinct, sorted random keys, spaced so half the lookups miss.
+    size_t size = argc > 1 ? (size_t) atoll(argv[1]) : (size_t) 1 << 22;
+    Array(int64_t) * keys = Array(int64_t, new)(size);
+    Array(size_t) * values = Array(size_t, new)(size);
+    uint64_t seed = 21;
+    for (size_t i = 0; i < size; i++) {
+        keys->data[i] = (int64_t) (i * 32 + next_random(&seed) % 16);
+        values->data[i] = i;
+    }
+
+    double start = seconds();
+    BTree(int64_t, size_t) * tree = BTree(int64_t, size_t, from_sorted)(keys, values);
+    double bulk_time = seconds() - start;
+
+    BTree(int64_t, size_t) * inserted = BTree(int64_t, size_t, new)();
+    for (size_t i = 0; i < size; i++) {
+        size_t j = i + next_random(&seed) % (size - i);
+        int64_t swap = keys->data[i]; keys->data[i] = keys->data[j]; keys->data[j] = swap;
+    }
+    start = seconds();
+    for (size_t i = 0; i < size; i++) BTree(int64_t, size_t, set)(inserted, keys->data[i], i);
+    double insert_time = seconds() - start;
+    Array(int64_t, delete)(keys);
+
+    // Rebuild the sorted baseline from the tree itself.
+    keys = Array(int64_t, new)(size);
+    BTree(int64_t, size_t, Iterator) all = BTree(int64_t, size_t, iterate)(tree);
+    for (size_t i = 0; BTree(int64_t, size_t, next)(&all, &key, &value); i++) keys->data[i] = *key;
+
+    printf("%zu entries, height %zu, %.1f bytes per entry\n", size,
+        BTree(int64_t, size_t, height)(tree), (double) Arena_allocated(tree->arena) / size);
+    printf("build:  bulk load %7.1f ms, %zu random inserts %7.1f ms (%.0f ns each)\n",
+        bulk_time * 1e3, size, insert_time * 1e3, insert_time / size * 1e9);
+
+    // Lookups: a random key, hit or miss.
+    size_t lookups = 4000000, tree_hits = 0, array_hits = 0;
+    int64_t span = (int64_t) size * 32;
+    uint64_t stream = 5;
+    start = seconds();
+    for (size_t i = 0; i < lookups; i++)
+        tree_hits += BTree(int64_t, size_t, get)(tree, (int64_t) (next_random(&stream) % span)) != NULL;
+    double tree_lookup = (seconds() - start) / lookups;
+
+    stream = 5;
+    start = seconds();
+    for (size_t i = 0; i < lookups; i++) {
+        int64_t wanted = (int64_t) (next_random(&stream) % span);
+        size_t at = lower_bound(keys->data, size, wanted);
+        array_hits += at < size and keys->data[at] == wanted;
+    }
+    double array_lookup = (seconds() - start) / lookups;
+    printf("lookup: btree %6.1f ns, sorted array %6.1f ns, hits %s\n",
+        tree_lookup * 1e9, array_lookup * 1e9, tree_hits == array_hits ? "agree" : "differ");
+
+    // Range scans of about 1000 entries.
+    size_t scans = 20000, tree_seen = 0, array_seen = 0;
+    stream = 7;
+    start = seconds();
+    for (size_t i = 0; i < scans; i++) {
+        int64_t low = (int64_t) (next_random(&stream) % span);
+        BTree(int64_t, size_t, Iterator) scan = BTree(int64_t, size_t, range)(tree, low, low + 32000);
+        while (BTree(int64_t, size_t, next)(&scan, NULL, &value)) tree_seen += *value & 1;
+    }
+    double tree_scan = seconds() - start;
+
+    stream = 7;
+    start = seconds();
+    for (size_t i = 0; i < scans; i++) {
+        int64_t low = (int64_t) (next_random(&stream) % span);
+        for (size_t at = lower_bound(keys->data, size, low); at < size and keys->data[at] < low + 32000; at++)
+            array_seen += at & 1;
+    }
+    double array_scan = seconds() - start;
+    printf("scan:   btree %6.1f M entries/s, sorted array %6.1f M entries/s, results %s\n",
+        scans * 1000 / tree_scan / 1e6, scans * 1000 / array_scan / 1e6,
+        tree_seen == array_seen ? "agree" : "differ");
+
+    // Inserts into the populated map; the Array has to shift its tail.
+    size_t tree_inserts = 1000000, array_inserts = 2000;
+    start = seconds();
+    for (size_t i = 0; i < tree_inserts; i++)
+        BTree(int64_t, size_t, set)(tree, (int64_t) (next_random(&stream) % span) | 16, i);
+    double tree_insert = (seconds() - start) / tree_inserts;
+
+    int64_t * grown = malloc((size + array_inserts) * sizeof(int64_t));
+    memcpy(grown, keys->data, size * sizeof(int64_t));
+    size_t count = size;
+    start = seconds();
+    for (size_t i = 0; i < array_inserts; i++) {
+        int64_t wanted = (int64_t) (next_random(&stream) % span) | 16;
+        size_t at = lower_bound(grown, count, wanted);
+        memmove(grown + at + 1, grown + at, (count - at) * sizeof(int64_t));
+        grown[at] = wanted;
+        count++;
+    }
+    double array_insert = (seconds() - start) / array_inserts;
+    printf("insert: btree %6.1f ns, sorted array %6.1f us\n", tree_insert * 1e9, array_insert * 1e6);
+
+    free(grown);
+    BTree(int64_t, size_t, delete)(tree);
+    BTree(int64_t, size_t, delete)(inserted);
+    Array(int64_t, delete)(keys);
+    Array(size_t, delete)(values);
+    return 0;
+
+}
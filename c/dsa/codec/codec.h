@@ -0,0 +1,970 @@
+// =====
+// Codec
+// =====
+//
+// :Author: RickBarretto
+// :Year: 2026
+// :License: MPL 2.0
+// :Copyright: RickBarretto, 2026
+// :Version: 1.0
+//
+// ``Codec`` is a dependency-free block compression layer
+// for the binary representation of ``Array<T>``.
+// Values are cut into blocks of ``block_len`` elements,
+// and every block is encoded on its own,
+// so any block can be decoded without touching the others.
+//
+// Available codecs:
+//
+// - ``CODEC_FOR``: frame-of-reference + bit-packing for unsigned integers.
+// - ``CODEC_DELTA``: delta + frame-of-reference + bit-packing,
+//   made for sorted unsigned integers (IDs, offsets, timestamps...).
+// - ``CODEC_DICT``: dictionary encoding for NUL-terminated strings.
+//   Each block stores bit-packed codes into a shared dictionary.
+// - ``CODEC_LZ``: LZ77-class byte codec for everything else.
+//
+// Unlike the generic headers, this one is not a template,
+// so it is guarded and may be included by other modules.
+//
+// How to Use
+// ----------
+//
+//      #include "codec.h"
+//
+//      Array(uint32_t) * ids = ...;
+//      Codec * packed = Codec_compress(CODEC_FOR,
+//          ids->data, Array(uint32_t, size)(ids), sizeof(uint32_t));
+//
+//      uint32_t block[CODEC_BLOCK_LEN];
+//      Codec_block(packed, 3, block);   // random access per block
+//
+//      Codec_save(packed, "ids.rkc");
+//      Codec_delete(packed);
+//
+// Stream Layout
+// -------------
+//
+// All integers are stored in the host byte order (little-endian on
+// every target this repository cares about).
+//
+//      +----------------+
+//      | header         |  magic "RKC1", kind, element size, counts
+//      +----------------+
+//      | dictionary     |  CODEC_DICT only
+//      +----------------+
+//      | block offsets  |  nblocks + 1 offsets, relative to the first block
+//      +----------------+
+//      | blocks ...     |
+//      +----------------+
+//      | padding        |  CODEC_PADDING zeroed bytes for unaligned loads
+//      +----------------+
+//
+// Bit-packed blocks are laid out as ``base: u64, width: u8, bits...``.
+// Decoding reads whole 64-bit words at any byte offset,
+// and the tail padding keeps those loads inside the buffer.
+// When compiled with AVX2 (e.g. ``-mavx2`` or ``-march=native``),
+// widths up to 25 bits are unpacked 8 values at a time;
+// the portable loop is branch-free but stays scalar.
+//
+
+#ifndef CODEC_H
+#define CODEC_H
+
+// =~=~=~=~=~=~=~=~ Imports ~=~=~=~=~=~=~=~=
+
+#include <iso646.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef __AVX2__
+#include <immintrin.h>
+#define CODEC_AVX2 1
+#endif
+
+
+// =~=~=~=~=~=~=~=~ Helper Macros ~=~=~=~=~=~=~=~=
+
+#define ensure(COND, VAL) if (not (COND)) return VAL
+
+
+// =~=~=~=~=~=~=~=~ Configuration ~=~=~=~=~=~=~=~=
+
+// CODEC_BLOCK_LEN: Number of elements per block.
+// Must be defined before the first include to be overridden.
+#ifndef CODEC_BLOCK_LEN
+#define CODEC_BLOCK_LEN 1024
+#endif
+
+// CODEC_PADDING: Zeroed bytes appended to every packed buffer.
+#define CODEC_PADDING 16
+
+#define CODEC_MAGIC "RKC1"
+
+
+// =~=~=~=~=~=~=~=~ Implementation ~=~=~=~=~=~=~=~=
+
+typedef enum {
+    CODEC_FOR = 1,
+    CODEC_DELTA = 2,
+    CODEC_DICT = 3,
+    CODEC_LZ = 4,
+} CodecKind;
+
+typedef struct {
+    char magic[4];
+    uint8_t kind;
+    uint8_t elem_size;
+    uint16_t _reserved;
+    uint32_t block_len;
+    uint32_t _reserved2;
+    uint64_t count;
+    uint64_t nblocks;
+    uint64_t table;     // offset of the block offsets table
+} CodecHeader;
+
+typedef struct {
+    uint8_t * data;
+    size_t _size;
+} Codec;
+
+
+// ~~~~~~~~ Bit-packing primitives ~~~~~~~~
+
+uint64_t _Codec_load64(const uint8_t * p) {
+    uint64_t value;
+    memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+uint64_t _Codec_load(const void * values, size_t index, size_t elem_size) {
+    const uint8_t * p = (const uint8_t *) values + index * elem_size;
+    switch (elem_size) {
+        case 1: return *p;
+        case 2: { uint16_t v; memcpy(&v, p, 2); return v; }
+        case 4: { uint32_t v; memcpy(&v, p, 4); return v; }
+        default: return _Codec_load64(p);
+    }
+}
+
+void _Codec_store(void * values, size_t index, size_t elem_size, uint64_t value) {
+    uint8_t * p = (uint8_t *) values + index * elem_size;
+    switch (elem_size) {
+        case 1: *p = (uint8_t) value; break;
+        case 2: { uint16_t v = (uint16_t) value; memcpy(p, &v, 2); break; }
+        case 4: { uint32_t v = (uint32_t) value; memcpy(p, &v, 4); break; }
+        default: memcpy(p, &value, 8); break;
+    }
+}
+
+// Codec >> bitwidth(value: u64) -> unsigned
+//
+// Returns the number of bits needed to represent the value.
+//
+unsigned Codec_bitwidth(uint64_t value) {
+    return value ? 64 - (unsigned) __builtin_clzll(value) : 0;
+}
+
+// Codec >> packed_size(count: size_t, width: unsigned) -> size_t
+//
+// Returns how many bytes ``count`` values of ``width`` bits take,
+// not including CODEC_PADDING.
+//
+size_t Codec_packed_size(size_t count, unsigned width) {
+    return (count * width + 7) / 8;
+}
+
+// Codec >> bitpack(values: *u64, count: size_t, base: u64, width: unsigned, out: *u8) -> size_t
+//
+// Packs ``values[i] - base`` into ``width`` bits each.
+//
+// Parameters
+// ----------
+// values : *u64
+//     The values to pack. Each one must be in [base, base + 2^width).
+// count : size_t
+//     The number of values.
+// base : u64
+//     The frame of reference subtracted from every value.
+// width : unsigned
+//     Bits per value, from 0 to 64.
+// out : *u8
+//     Destination, with room for ``Codec_packed_size(count, width)`` bytes.
+//
+// Returns
+// -------
+// size_t: The number of bytes written.
+//
+size_t Codec_bitpack(const uint64_t * values, size_t count,
+                     uint64_t base, unsigned width, uint8_t * out) {
+    size_t bytes = Codec_packed_size(count, width);
+    ensure(width > 0, 0);
+    memset(out, 0, bytes);
+
+    uint64_t buffer = 0;
+    unsigned filled = 0;
+    size_t position = 0;
+
+    for (size_t i = 0; i < count; i++) {
+        uint64_t value = values[i] - base;
+        buffer |= value << filled;
+        filled += width;
+        if (filled >= 64) {
+            memcpy(out + position, &buffer, 8);
+            position += 8;
+            filled -= 64;
+            buffer = filled ? value >> (width - filled) : 0;
+        }
+    }
+
+    for (size_t i = 0; position < bytes; i++, position++) {
+        out[position] = (uint8_t) (buffer >> (8 * i));
+    }
+    return bytes;
+}
+
+// Codec >> bitget(packed: *u8, index: size_t, width: unsigned) -> u64
+//
+// Reads a single packed value, without its base.
+// ``packed`` must be followed by CODEC_PADDING readable bytes.
+//
+uint64_t Codec_bitget(const uint8_t * packed, size_t index, unsigned width) {
+    ensure(width > 0, 0);
+
+    size_t bit = index * width;
+    const uint8_t * p = packed + (bit >> 3);
+    unsigned shift = bit & 7;
+
+    uint64_t value = _Codec_load64(p) >> shift;
+    if (shift + width > 64) value |= (uint64_t) p[8] << (64 - shift);
+    return (width == 64) ? value : value & ((UINT64_C(1) << width) - 1);
+}
+
+#ifdef CODEC_AVX2
+// Eight values of ``width`` bits span ``width`` whole bytes, and each one
+// sits in the 4 bytes from its first one, shifted by at most 7 bits while
+// ``width`` is 25 or less. Each 128-bit half gathers 4 values with a byte
+// shuffle, then they are shifted, masked and widened to 64 bits.
+// Returns how many values were unpacked, a multiple of 8.
+size_t _Codec_bitunpack_avx2(const uint8_t * packed, size_t count,
+                             uint64_t base, unsigned width, uint64_t * out) {
+    size_t middle = (4 * width) >> 3;     // first byte of the upper half
+    int upper = 8 * (int) middle;
+
+    // First bit of every lane within its half, split into byte and shift.
+    __m256i bit = _mm256_sub_epi32(
+        _mm256_mullo_epi32(_mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7), _mm256_set1_epi32((int) width)),
+        _mm256_setr_epi32(0, 0, 0, 0, upper, upper, upper, upper));
+    __m256i shift = _mm256_and_si256(bit, _mm256_set1_epi32(7));
+    __m256i shuffle = _mm256_add_epi32(
+        _mm256_mullo_epi32(_mm256_srli_epi32(bit, 3), _mm256_set1_epi32(0x01010101)),
+        _mm256_set1_epi32(0x03020100));
+    __m256i mask = _mm256_set1_epi32((int) ((UINT32_C(1) << width) - 1));
+    __m256i bases = _mm256_set1_epi64x((long long) base);
+
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        const uint8_t * p = packed + i / 8 * width;
+        __m256i bytes = _mm256_inserti128_si256(
+            _mm256_castsi128_si256(_mm_loadu_si128((const __m128i *) p)),
+            _mm_loadu_si128((const __m128i *) (p + middle)), 1);
+        __m256i values = _mm256_and_si256(
+            _mm256_srlv_epi32(_mm256_shuffle_epi8(bytes, shuffle), shift), mask);
+
+        __m256i low = _mm256_cvtepu32_epi64(_mm256_castsi256_si128(values));
+        __m256i high = _mm256_cvtepu32_epi64(_mm256_extracti128_si256(values, 1));
+        _mm256_storeu_si256((__m256i *) (out + i), _mm256_add_epi64(low, bases));
+        _mm256_storeu_si256((__m256i *) (out + i + 4), _mm256_add_epi64(high, bases));
+    }
+    return i;
+}
+#endif
+
+// Codec >> bitunpack(packed: *u8, count: size_t, base: u64, width: unsigned, out: *u64) -> void
+//
+// Unpacks ``count`` values and adds ``base`` back to them.
+// ``packed`` must be followed by CODEC_PADDING readable bytes.
+//
+void Codec_bitunpack(const uint8_t * packed, size_t count,
+                     uint64_t base, unsigned width, uint64_t * out) {
+    if (width == 0) {
+        for (size_t i = 0; i < count; i++) out[i] = base;
+        return;
+    }
+
+    if (width > 56) {
+        for (size_t i = 0; i < count; i++)
+            out[i] = base + Codec_bitget(packed, i, width);
+        return;
+    }
+
+    size_t i = 0;
+#ifdef CODEC_AVX2
+    if (width <= 25) i = _Codec_bitunpack_avx2(packed, count, base, width, out);
+#endif
+
+    // Branch-free path: one unaligned load per value.
+    uint64_t mask = (UINT64_C(1) << width) - 1;
+    for (; i < count; i++) {
+        size_t bit = i * width;
+        out[i] = base + ((_Codec_load64(packed + (bit >> 3)) >> (bit & 7)) & mask);
+    }
+}
+
+
+// ~~~~~~~~ Integer blocks ~~~~~~~~
+
+// Encodes a block as ``base: u64, width: u8, bits...``.
+size_t _Codec_encode_for(const uint64_t * values, size_t count, uint8_t * out) {
+    uint64_t min = values[0], max = values[0];
+    for (size_t i = 1; i < count; i++) {
+        min = values[i] < min ? values[i] : min;
+        max = values[i] > max ? values[i] : max;
+    }
+
+    unsigned width = Codec_bitwidth(max - min);
+    memcpy(out, &min, 8);
+    out[8] = (uint8_t) width;
+    return 9 + Codec_bitpack(values, count, min, width, out + 9);
+}
+
+// Deltas are taken modulo 2^64, so unsorted input still round-trips.
+size_t _Codec_encode_delta(uint64_t * values, size_t count, uint8_t * out) {
+    uint64_t first = values[0];
+    for (size_t i = count - 1; i > 0; i--) values[i] -= values[i - 1];
+    values[0] = 0;
+
+    memcpy(out, &first, 8);
+    return 8 + _Codec_encode_for(values, count, out + 8);
+}
+
+// Values decoded at a time, through a scratch of this many words.
+// A multiple of 8, so every chunk starts on a whole byte.
+#define _CODEC_CHUNK 256
+
+// A parsed ``[first: u64] base: u64, width: u8, bits...`` block,
+// where ``first`` only leads CODEC_DELTA blocks.
+typedef struct {
+    uint64_t first;
+    uint64_t base;
+    unsigned width;
+    const uint8_t * bits;
+} _CodecFrame;
+
+// Parses a block of ``size`` bytes, checking it holds ``count`` values.
+bool _Codec_frame(const uint8_t * in, size_t size, size_t count,
+                  bool delta, _CodecFrame * frame) {
+    size_t skip = delta ? 8 : 0;
+    ensure(size >= skip + 9 and in[skip + 8] <= 64, false);
+    ensure(size - skip - 9 >= Codec_packed_size(count, in[skip + 8]), false);
+
+    frame->first = delta ? _Codec_load64(in) : 0;
+    frame->base = _Codec_load64(in + skip);
+    frame->width = in[skip + 8];
+    frame->bits = in + skip + 9;
+    return true;
+}
+
+
+// ~~~~~~~~ LZ77 byte codec ~~~~~~~~
+//
+// Sequences of ``token, literals, offset: u16, match extension``.
+// The token holds the literal length in its high nibble
+// and the match length minus 4 in its low nibble.
+// A nibble of 15 is extended by bytes of 255 up to a final smaller one.
+// The last sequence only carries literals.
+
+#define _CODEC_LZ_MIN_MATCH 4
+#define _CODEC_LZ_HASH_BITS 12
+#define _CODEC_LZ_MAX_OFFSET 65535
+
+size_t _Codec_lz_bound(size_t size) {
+    return size + size / 255 + 16;
+}
+
+uint8_t * _Codec_lz_length(uint8_t * op, size_t length) {
+    for (; length >= 255; length -= 255) *op++ = 255;
+    *op++ = (uint8_t) length;
+    return op;
+}
+
+size_t _Codec_lz_compress(const uint8_t * src, size_t size, uint8_t * dst) {
+    uint32_t table[1 << _CODEC_LZ_HASH_BITS];
+    memset(table, 0xff, sizeof(table));
+
+    uint8_t * op = dst;
+    size_t anchor = 0, i = 0;
+
+    while (size >= _CODEC_LZ_MIN_MATCH and i + _CODEC_LZ_MIN_MATCH <= size) {
+        uint32_t word;
+        memcpy(&word, src + i, 4);
+        uint32_t hash = (word * 2654435761u) >> (32 - _CODEC_LZ_HASH_BITS);
+        uint32_t candidate = table[hash];
+        table[hash] = (uint32_t) i;
+
+        uint32_t previous;
+        if (candidate == UINT32_MAX or i - candidate > _CODEC_LZ_MAX_OFFSET
+            or (memcpy(&previous, src + candidate, 4), previous != word)) {
+            i++;
+            continue;
+        }
+
+        size_t match = _CODEC_LZ_MIN_MATCH;
+        while (i + match < size and src[candidate + match] == src[i + match])
+            match++;
+
+        size_t literals = i - anchor;
+        size_t extra = match - _CODEC_LZ_MIN_MATCH;
+        *op++ = (uint8_t) (((literals < 15 ? literals : 15) << 4)
+                         | (extra < 15 ? extra : 15));
+        if (literals >= 15) op = _Codec_lz_length(op, literals - 15);
+        memcpy(op, src + anchor, literals);
+        op += literals;
+
+        uint16_t offset = (uint16_t) (i - candidate);
+        memcpy(op, &offset, 2);
+        op += 2;
+        if (extra >= 15) op = _Codec_lz_length(op, extra - 15);
+
+        i += match;
+        anchor = i;
+    }
+
+    size_t literals = size - anchor;
+    *op++ = (uint8_t) ((literals < 15 ? literals : 15) << 4);
+    if (literals >= 15) op = _Codec_lz_length(op, literals - 15);
+    memcpy(op, src + anchor, literals);
+    op += literals;
+
+    return (size_t) (op - dst);
+}
+
+bool _Codec_lz_decompress(const uint8_t * src, size_t size,
+                          uint8_t * dst, size_t capacity) {
+    const uint8_t * ip = src, * end = src + size;
+    uint8_t * op = dst, * limit = dst + capacity;
+
+    while (ip < end) {
+        uint8_t token = *ip++;
+
+        size_t literals = token >> 4;
+        if (literals == 15) {
+            uint8_t byte;
+            do { ensure(ip < end, false); byte = *ip++; literals += byte; }
+            while (byte == 255);
+        }
+        ensure(literals <= (size_t) (end - ip), false);
+        ensure(literals <= (size_t) (limit - op), false);
+        memcpy(op, ip, literals);
+        op += literals;
+        ip += literals;
+
+        if (ip >= end) break;
+
+        uint16_t offset;
+        ensure(end - ip >= 2, false);
+        memcpy(&offset, ip, 2);
+        ip += 2;
+
+        size_t match = (token & 15) + _CODEC_LZ_MIN_MATCH;
+        if ((token & 15) == 15) {
+            uint8_t byte;
+            do { ensure(ip < end, false); byte = *ip++; match += byte; }
+            while (byte == 255);
+        }
+
+        ensure(offset > 0 and offset <= op - dst, false);
+        ensure(match <= (size_t) (limit - op), false);
+
+        // Matches may overlap their own output, so copy forward.
+        const uint8_t * from = op - offset;
+        for (size_t k = 0; k < match; k++) op[k] = from[k];
+        op += match;
+    }
+
+    return op == limit;
+}
+
+
+// ~~~~~~~~ Dictionary ~~~~~~~~
+//
+// The dictionary section is ``count: u64, offsets: u64[count], strings``.
+// Code 0 stands for NULL, codes 1..count index the dictionary.
+
+uint64_t _Codec_hash(const char * text) {
+    uint64_t hash = 14695981039346656037ull;
+    for (; *text; text++) hash = (hash ^ (uint8_t) *text) * 1099511628211ull;
+    return hash;
+}
+
+// Builds the dictionary and replaces every string by its code.
+// Returns the dictionary section, its size is written to ``size``.
+uint8_t * _Codec_build_dict(char * const * strings, size_t count,
+                            uint64_t * codes, size_t * size) {
+    size_t slots = 16;
+    while (slots < count * 2) slots <<= 1;
+
+    uint64_t * table = calloc(slots, sizeof(uint64_t));   // code per slot
+    const char ** words = malloc((count + 1) * sizeof(char *));
+    if (not table or not words) {
+        free(table);
+        free(words);
+        return NULL;
+    }
+
+    size_t unique = 0, text_bytes = 0;
+    for (size_t i = 0; i < count; i++) {
+        if (not strings[i]) { codes[i] = 0; continue; }
+
+        size_t slot = _Codec_hash(strings[i]) & (slots - 1);
+        while (table[slot] and strcmp(words[table[slot]], strings[i]) != 0)
+            slot = (slot + 1) & (slots - 1);
+
+        if (not table[slot]) {
+            table[slot] = ++unique;
+            words[unique] = strings[i];
+            text_bytes += strlen(strings[i]) + 1;
+        }
+        codes[i] = table[slot];
+    }
+
+    *size = 8 + 8 * unique + text_bytes;
+    uint8_t * section = malloc(*size);
+    if (section) {
+        uint64_t total = unique, offset = 0;
+        memcpy(section, &total, 8);
+        uint8_t * text = section + 8 + 8 * unique;
+        for (size_t code = 1; code <= unique; code++) {
+            size_t length = strlen(words[code]) + 1;
+            memcpy(section + 8 * code, &offset, 8);
+            memcpy(text + offset, words[code], length);
+            offset += length;
+        }
+    }
+
+    free(table);
+    free(words);
+    return section;
+}
+
+
+// ~~~~~~~~ Streams ~~~~~~~~
+
+CodecHeader * _Codec_header(Codec * codec) {
+    return (CodecHeader *) codec->data;
+}
+
+const uint8_t * _Codec_blocks(Codec * codec) {
+    CodecHeader * header = _Codec_header(codec);
+    return codec->data + header->table + 8 * (header->nblocks + 1);
+}
+
+// Block offsets must never decrease, and the last block must end
+// inside the stream, so any ``begin .. end`` pair is readable.
+bool _Codec_valid_offsets(Codec * codec) {
+    CodecHeader * header = _Codec_header(codec);
+    const uint8_t * offsets = codec->data + header->table;
+    size_t room = codec->_size - (size_t) (_Codec_blocks(codec) - codec->data);
+
+    uint64_t previous = 0;
+    for (size_t block = 0; block <= header->nblocks; block++) {
+        uint64_t offset = _Codec_load64(offsets + 8 * block);
+        ensure(offset >= previous and offset <= room, false);
+        previous = offset;
+    }
+    return true;
+}
+
+// The dictionary is ``words: u64, offsets: u64 * words, text...``,
+// between the header and the block offsets. Every word must start
+// inside the text, and the text must end with a NUL,
+// so any code up to ``words`` is a terminated string of the stream.
+bool _Codec_valid_dict(Codec * codec) {
+    CodecHeader * header = _Codec_header(codec);
+    const uint8_t * dict = codec->data + sizeof(CodecHeader);
+    size_t size = header->table - sizeof(CodecHeader);
+    ensure(size >= 8, false);
+
+    uint64_t words = _Codec_load64(dict);
+    ensure(words <= (size - 8) / 8, false);
+    size_t text = size - 8 - 8 * words;
+    ensure(words == 0 or (text > 0 and dict[size - 1] == 0), false);
+
+    for (size_t code = 1; code <= words; code++)
+        ensure(_Codec_load64(dict + 8 * code) < text, false);
+    return true;
+}
+
+// Codec >> compress(kind: CodecKind, values: *void, count: size_t, elem_size: size_t) -> *Codec
+//
+// Compresses ``count`` elements of ``elem_size`` bytes into a new stream.
+//
+// Parameters
+// ----------
+// kind : CodecKind
+//     The codec to use.
+//     CODEC_FOR and CODEC_DELTA take unsigned integers of 1, 2, 4 or 8 bytes.
+//     CODEC_DICT takes ``char *`` elements, ``elem_size`` is ignored.
+//     CODEC_LZ takes anything.
+// values : *void
+//     The elements, usually ``array->data``.
+// count : size_t
+//     The number of elements.
+// elem_size : size_t
+//     ``sizeof(T)``.
+//
+// Returns
+// -------
+// *Codec: The compressed stream, or NULL on invalid arguments.
+//
+Codec * Codec_compress(CodecKind kind, const void * values,
+                       size_t count, size_t elem_size) {
+    if (kind == CODEC_DICT) elem_size = sizeof(char *);
+    ensure(values or count == 0, NULL);
+    ensure(elem_size > 0 and elem_size <= UINT8_MAX, NULL);
+    if (kind == CODEC_FOR or kind == CODEC_DELTA) {
+        ensure(elem_size == 1 or elem_size == 2
+            or elem_size == 4 or elem_size == 8, NULL);
+    }
+
+    size_t block_len = CODEC_BLOCK_LEN;
+    size_t nblocks = (count + block_len - 1) / block_len;
+
+    uint64_t * codes = NULL;
+    uint8_t * dict = NULL;
+    size_t dict_size = 0;
+    if (kind == CODEC_DICT) {
+        codes = malloc((count ? count : 1) * sizeof(uint64_t));
+        ensure(codes, NULL);
+        dict = _Codec_build_dict((char * const *) values, count, codes, &dict_size);
+        ensure(dict, (free(codes), NULL));
+    }
+
+    // Worst case of each block: LZ bound, or 17 bytes of frame + 8 per value.
+    size_t block_bound = (kind == CODEC_LZ)
+        ? _Codec_lz_bound(block_len * elem_size)
+        : 17 + 8 * block_len;
+    size_t table = sizeof(CodecHeader) + dict_size;
+    size_t capacity = table + 8 * (nblocks + 1)
+                    + nblocks * block_bound + CODEC_PADDING;
+
+    Codec * codec = malloc(sizeof(Codec));
+    uint8_t * data = calloc(1, capacity);
+    uint64_t * scratch = malloc(block_len * sizeof(uint64_t));
+    if (not codec or not data or not scratch) {
+        free(codec); free(data); free(scratch); free(codes); free(dict);
+        return NULL;
+    }
+
+    CodecHeader header = {
+        .magic = CODEC_MAGIC, .kind = (uint8_t) kind,
+        .elem_size = (uint8_t) elem_size, .block_len = (uint32_t) block_len,
+        .count = count, .nblocks = nblocks, .table = table,
+    };
+    memcpy(data, &header, sizeof(header));
+    if (dict) memcpy(data + sizeof(CodecHeader), dict, dict_size);
+
+    uint8_t * offsets = data + table;
+    uint8_t * blocks = offsets + 8 * (nblocks + 1);
+    uint64_t written = 0;
+
+    for (size_t block = 0; block < nblocks; block++) {
+        memcpy(offsets + 8 * block, &written, 8);
+
+        size_t first = block * block_len;
+        size_t length = (count - first < block_len) ? count - first : block_len;
+        uint8_t * out = blocks + written;
+
+        switch (kind) {
+            case CODEC_LZ:
+                written += _Codec_lz_compress(
+                    (const uint8_t *) values + first * elem_size,
+                    length * elem_size, out);
+                break;
+            case CODEC_DICT:
+                written += _Codec_encode_for(codes + first, length, out);
+                break;
+            default:
+                for (size_t i = 0; i < length; i++)
+                    scratch[i] = _Codec_load(values, first + i, elem_size);
+                written += (kind == CODEC_DELTA)
+                    ? _Codec_encode_delta(scratch, length, out)
+                    : _Codec_encode_for(scratch, length, out);
+                break;
+        }
+    }
+    memcpy(offsets + 8 * nblocks, &written, 8);
+
+    free(scratch);
+    free(codes);
+    free(dict);
+
+    // Shrink to the real size, keeping the zeroed tail padding.
+    size_t size = (size_t) (blocks - data) + written;
+    memset(data + size, 0, CODEC_PADDING);
+    uint8_t * shrunk = realloc(data, size + CODEC_PADDING);
+    codec->data = shrunk ? shrunk : data;
+    codec->_size = size;
+    return codec;
+}
+
+// Codec >> from_bytes(bytes: *void, size: size_t) -> *Codec
+//
+// Copies a serialized stream and checks its header, block offsets
+// and dictionary, so decoding never reads outside the stream.
+//
+// Returns
+// -------
+// *Codec: The stream, or NULL if the bytes are not a valid stream.
+//
+Codec * Codec_from_bytes(const void * bytes, size_t size) {
+    ensure(bytes and size >= sizeof(CodecHeader), NULL);
+
+    CodecHeader header;
+    memcpy(&header, bytes, sizeof(header));
+    ensure(memcmp(header.magic, CODEC_MAGIC, 4) == 0, NULL);
+    ensure(header.kind >= CODEC_FOR and header.kind <= CODEC_LZ, NULL);
+    ensure(header.block_len > 0 and header.block_len <= 65536, NULL);
+    ensure(header.elem_size > 0, NULL);
+    if (header.kind == CODEC_FOR or header.kind == CODEC_DELTA) {
+        ensure(header.elem_size == 1 or header.elem_size == 2
+            or header.elem_size == 4 or header.elem_size == 8, NULL);
+    }
+    if (header.kind == CODEC_DICT) ensure(header.elem_size == sizeof(char *), NULL);
+    ensure(header.table >= sizeof(CodecHeader) and header.table <= size, NULL);
+    ensure(header.nblocks == (header.count + header.block_len - 1) / header.block_len, NULL);
+    ensure((size - header.table) / 8 > header.nblocks, NULL);
+
+    Codec * codec = malloc(sizeof(Codec));
+    uint8_t * data = calloc(1, size + CODEC_PADDING);
+    if (not codec or not data) { free(codec); free(data); return NULL; }
+
+    memcpy(data, bytes, size);
+    codec->data = data;
+    codec->_size = size;
+
+    bool valid = _Codec_valid_offsets(codec);
+    if (valid and header.kind == CODEC_DICT) valid = _Codec_valid_dict(codec);
+    if (not valid) {
+        free(data);
+        free(codec);
+        return NULL;
+    }
+    return codec;
+}
+
+// Codec >> delete(codec: *Codec) -> bool
+//
+// Safely deletes the stream.
+//
+// Returns
+// -------
+// bool: Returns true on success.
+//
+bool Codec_delete(Codec * codec) {
+    ensure(codec, false);
+
+    free(codec->data);
+    free(codec);
+    return true;
+}
+
+// Codec >> bytes(codec: *Codec) -> *u8
+//
+// Returns the serialized stream, ``Codec_size`` bytes long.
+//
+const uint8_t * Codec_bytes(Codec * codec) {
+    ensure(codec, NULL);
+    return codec->data;
+}
+
+// Codec >> size(codec: *Codec) -> size_t
+//
+// Returns the size of the serialized stream in bytes.
+//
+size_t Codec_size(Codec * codec) {
+    ensure(codec, 0);
+    return codec->_size;
+}
+
+// Codec >> count(codec: *Codec) -> size_t
+//
+// Returns the number of elements in the stream.
+//
+size_t Codec_count(Codec * codec) {
+    ensure(codec, 0);
+    return _Codec_header(codec)->count;
+}
+
+// Codec >> block_count(codec: *Codec) -> size_t
+//
+// Returns the number of blocks in the stream.
+//
+size_t Codec_block_count(Codec * codec) {
+    ensure(codec, 0);
+    return _Codec_header(codec)->nblocks;
+}
+
+// Codec >> block_len(codec: *Codec) -> size_t
+//
+// Returns the number of elements of every block but the last.
+// Element ``i`` lives in block ``i / block_len``.
+//
+size_t Codec_block_len(Codec * codec) {
+    ensure(codec, 0);
+    return _Codec_header(codec)->block_len;
+}
+
+// Codec >> block(codec: *Codec, block: size_t, out: *void) -> size_t
+//
+// Decodes a single block.
+//
+// Parameters
+// ----------
+// codec : *Codec
+//     The stream to read from.
+// block : size_t
+//     The index of the block.
+// out : *void
+//     Destination with room for ``block_len`` elements.
+//     For CODEC_DICT these are ``char *`` that point into the stream,
+//     so they are only valid while the stream lives.
+//
+// Returns
+// -------
+// size_t: The number of elements decoded, 0 if out of bounds or corrupted.
+//
+size_t Codec_block(Codec * codec, size_t block, void * out) {
+    ensure(codec and out, 0);
+
+    CodecHeader * header = _Codec_header(codec);
+    ensure(block < header->nblocks, 0);
+
+    size_t first = block * header->block_len;
+    size_t length = header->count - first;
+    if (length > header->block_len) length = header->block_len;
+
+    uint64_t begin, end;
+    memcpy(&begin, codec->data + header->table + 8 * block, 8);
+    memcpy(&end, codec->data + header->table + 8 * (block + 1), 8);
+    ensure(begin <= end, 0);
+    const uint8_t * in = _Codec_blocks(codec) + begin;
+
+    if (header->kind == CODEC_LZ) {
+        bool ok = _Codec_lz_decompress(in, end - begin, out,
+                                       length * header->elem_size);
+        return ok ? length : 0;
+    }
+
+    _CodecFrame frame;
+    ensure(_Codec_frame(in, end - begin, length,
+                        header->kind == CODEC_DELTA, &frame), 0);
+
+    const uint8_t * dict = codec->data + sizeof(CodecHeader);
+    uint64_t words = (header->kind == CODEC_DICT) ? _Codec_load64(dict) : 0;
+    const char * text = (const char *) dict + 8 + 8 * words;
+
+    uint64_t scratch[_CODEC_CHUNK];
+    uint64_t running = frame.first;
+    for (size_t done = 0; done < length; done += _CODEC_CHUNK) {
+        size_t chunk = length - done;
+        if (chunk > _CODEC_CHUNK) chunk = _CODEC_CHUNK;
+        Codec_bitunpack(frame.bits + done / 8 * frame.width, chunk,
+                        frame.base, frame.width, scratch);
+
+        switch (header->kind) {
+            case CODEC_DICT: {
+                const char ** strings = (const char **) out + done;
+                for (size_t i = 0; i < chunk; i++) {
+                    ensure(scratch[i] <= words, 0);
+                    strings[i] = scratch[i]
+                        ? text + _Codec_load64(dict + 8 * scratch[i])
+                        : NULL;
+                }
+                break;
+            }
+            case CODEC_DELTA:
+                for (size_t i = 0; i < chunk; i++) {
+                    running += scratch[i];
+                    scratch[i] = running;
+                }
+                // fall through
+            default:
+                for (size_t i = 0; i < chunk; i++)
+                    _Codec_store(out, done + i, header->elem_size, scratch[i]);
+                break;
+        }
+    }
+    return length;
+}
+
+// Codec >> decompress(codec: *Codec, out: *void) -> bool
+//
+// Decodes the whole stream into ``out``,
+// which must have room for ``Codec_count`` elements.
+//
+// Returns
+// -------
+// bool: Returns true on success, false if the stream is corrupted.
+//
+bool Codec_decompress(Codec * codec, void * out) {
+    ensure(codec and out, false);
+
+    CodecHeader * header = _Codec_header(codec);
+    uint8_t * cursor = out;
+    for (size_t block = 0; block < header->nblocks; block++) {
+        size_t decoded = Codec_block(codec, block, cursor);
+        ensure(decoded > 0, false);
+        cursor += decoded * header->elem_size;
+    }
+    return true;
+}
+
+// Codec >> save(codec: *Codec, path: *char) -> bool
+//
+// Writes the stream to a file.
+//
+// Returns
+// -------
+// bool: Returns true on success.
+//
+bool Codec_save(Codec * codec, const char * path) {
+    ensure(codec and path, false);
+
+    FILE * file = fopen(path, "wb");
+    ensure(file, false);
+
+    bool ok = fwrite(codec->data, 1, codec->_size, file) == codec->_size;
+    return (fclose(file) == 0) and ok;
+}
+
+// Codec >> load(path: *char) -> *Codec
+//
+// Reads a stream previously written by ``Codec_save``.
+//
+// Returns
+// -------
+// *Codec: The stream, or NULL if the file can not be read or is invalid.
+//
+Codec * Codec_load(const char * path) {
+    ensure(path, NULL);
+
+    FILE * file = fopen(path, "rb");
+    ensure(file, NULL);
+
+    fseek(file, 0, SEEK_END);
+    long size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+
+    uint8_t * bytes = (size > 0) ? malloc((size_t) size) : NULL;
+    bool ok = bytes and fread(bytes, 1, (size_t) size, file) == (size_t) size;
+    fclose(file);
+
+    Codec * codec = ok ? Codec_from_bytes(bytes, (size_t) size) : NULL;
+    free(bytes);
+    return codec;
+}
+
+#endif
@@ -0,0 +1,94 @@
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "codec.h"
+
+typedef char* str;
+#define T str
+#define PRINT_T(value) printf("%s", value)
+#include "../array/array.h"
+
+#define T uint32_t
+#define PRINT_T(value) printf("%u", value)
+#include "../array/array.h"
+
+#define T uint64_t
+#define PRINT_T(value) printf("%llu", (unsigned long long) value)
+#include "../array/array.h"
+
+#define T double
+#define PRINT_T(value) printf("%g", value)
+#include "../array/array.h"
+
+void report(const char * name, Codec * codec, size_t raw) {
+    printf("%-8s %8zu -> %7zu bytes (%.2fx, %zu blocks)\n",
+        name, raw, Codec_size(codec),
+        (double) raw / (double) Codec_size(codec), Codec_block_count(codec));
+}
+
+int main() {
+
+    size_t size = 100000;
+    str colors[] = { "red", "green", "blue", "cyan" };
+
+    Array(uint32_t) * scores = Array(uint32_t, new)(size);
+    Array(uint64_t) * ids = Array(uint64_t, new)(size);
+    Array(str) * labels = Array(str, new)(size);
+    Array(double) * ratios = Array(double, new)(size);
+
+    for (size_t i = 0; i < size; i++) {
+        Array(uint32_t, set)(scores, i, (uint32_t) (1000 + (i * 7919) % 200));
+        Array(uint64_t, set)(ids, i, 5000000000ull + i * 3 + (i % 2));
+        Array(str, set)(labels, i, colors[(i / 10) % 4]);
+        Array(double, set)(ratios, i, (double) (i % 16) / 4.0);
+    }
+
+    Codec * packed_scores = Codec_compress(
+        CODEC_FOR, scores->data, size, sizeof(uint32_t));
+    Codec * packed_ids = Codec_compress(
+        CODEC_DELTA, ids->data, size, sizeof(uint64_t));
+    Codec * packed_labels = Codec_compress(
+        CODEC_DICT, labels->data, size, sizeof(str));
+    Codec * packed_ratios = Codec_compress(
+        CODEC_LZ, ratios->data, size, sizeof(double));
+
+    report("for", packed_scores, size * sizeof(uint32_t));
+    report("delta", packed_ids, size * sizeof(uint64_t));
+    report("dict", packed_labels, size * sizeof(str));
+    report("lz", packed_ratios, size * sizeof(double));
+
+    // Random access: decode only the block that holds element 54321.
+    size_t index = 54321, block_len = Codec_block_len(packed_ids);
+    uint64_t block[CODEC_BLOCK_LEN];
+    Codec_block(packed_ids, index / block_len, block);
+    printf("ids[%zu] = %llu\n", index,
+        (unsigned long long) block[index % block_len]);
+
+    str words[CODEC_BLOCK_LEN];
+    Codec_block(packed_labels, index / block_len, words);
+    printf("labels[%zu] = %s\n", index, words[index % block_len]);
+
+    // Round trip through a file.
+    Codec_save(packed_ratios, "/tmp/ratios.rkc");
+    Codec * loaded = Codec_load("/tmp/ratios.rkc");
+    Array(double) * restored = Array(double, new)(Codec_count(loaded));
+    Codec_decompress(loaded, restored->data);
+    printf("ratios round trip: %s\n",
+        memcmp(restored->data, ratios->data, size * sizeof(double)) == 0
+            ? "ok" : "mismatch");
+
+    Codec_delete(packed_scores);
+    Codec_delete(packed_ids);
+    Codec_delete(packed_labels);
+    Codec_delete(packed_ratios);
+    Codec_delete(loaded);
+
+    Array(uint32_t, delete)(scores);
+    Array(uint64_t, delete)(ids);
+    Array(str, delete)(labels);
+    Array(double, delete)(ratios);
+    Array(double, delete)(restored);
+    return 0;
+
+}
@@ -0,0 +1,360 @@
+// ===========
+// DisjointSet
+// ===========
+//
+// :Author: RickBarretto
+// :Year: 2026
+// :License: MPL 2.0
+// :Copyright: RickBarretto, 2026
+// :Version: 1.0
+//
+// ``DisjointSet`` is a union-find over the ids [0, size),
+// stored in a single ``Array<uint32_t>``, one word per element:
+//
+// - high bit clear: the word is the parent of the element.
+// - high bit set: the element is a root, and the low 31 bits
+//   are the size of its set.
+//
+// ``unite`` links the smaller set under the larger one, and ``find``
+// does path halving, so both take amortized near-constant time
+// and the whole structure is 4 bytes per element.
+//
+// The ``*_concurrent`` functions are lock-free and may run from many
+// threads at once, over the same words: roots are linked with a
+// compare-and-swap that expects the exact root word (size included),
+// so a root that changed under us is simply retried, and sizes only
+// grow, which rules out cycles. Sizes are exact once threads are done.
+// ``unite_all`` unites a list of edges in parallel on a ``ThreadPool``.
+// The concurrent functions use the GCC/Clang ``__atomic`` builtins,
+// so the words stay a plain ``Array<uint32_t>``.
+//
+// How to Use
+// ----------
+//
+// Include ``Array<uint32_t>`` first, then this header:
+//
+//      #define T uint32_t
+//      #define PRINT_T(value) printf("%u", value)
+//      #include "../array/array.h"
+//
+//      #include "disjoint_set.h"
+//
+// And a common way to use it would be:
+//
+//      DisjointSet * set = DisjointSet_new(1000);
+//      DisjointSet_unite(set, 1, 2);
+//      if (DisjointSet_same(set, 1, 2)) { ... }
+//      DisjointSet_unite_all(set, sources, targets, pool);
+//
+// Link with ``-pthread``.
+//
+
+#ifndef DISJOINT_SET_H
+#define DISJOINT_SET_H
+
+// =~=~=~=~=~=~=~=~ Imports ~=~=~=~=~=~=~=~=
+
+#include <iso646.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "../thread_pool/thread_pool.h"
+
+
+// =~=~=~=~=~=~=~=~ Helper Macros ~=~=~=~=~=~=~=~=
+
+#define ensure(COND, VAL) if (not (COND)) return VAL
+
+
+// =~=~=~=~=~=~=~=~ Implementation ~=~=~=~=~=~=~=~=
+
+// DISJOINT_ROOT: Flag of a root word. The low bits hold the set size.
+#define DISJOINT_ROOT 0x80000000u
+
+// DISJOINT_MAX: Largest number of elements.
+#define DISJOINT_MAX ((size_t) 0x7fffffff)
+
+// DISJOINT_TASKS_PER_WORKER: Edge chunks per worker in ``unite_all``.
+#define DISJOINT_TASKS_PER_WORKER 8
+
+typedef struct {
+    Array(uint32_t) * parents;
+    atomic_size_t _sets;
+} DisjointSet;
+
+// DisjointSet >> delete(set: *DisjointSet) -> bool
+//
+// Safely deletes the disjoint set.
+//
+// Returns
+// -------
+// bool: Returns true on success.
+//
+bool DisjointSet_delete(DisjointSet * set) {
+    ensure(set, false);
+
+    Array(uint32_t, delete)(set->parents);
+    ARRAY_FREE(set);
+    return true;
+}
+
+// DisjointSet >> new(size: size_t) -> *DisjointSet
+//
+// Creates ``size`` singleton sets.
+//
+// Parameters
+// ----------
+// size : size_t
+//     The number of elements, up to DISJOINT_MAX.
+//
+// Returns
+// -------
+// *DisjointSet: The new disjoint set, or NULL on failure.
+//
+DisjointSet * DisjointSet_new(size_t size) {
+    ensure(size <= DISJOINT_MAX, NULL);
+
+    DisjointSet * set = ARRAY_MALLOC(sizeof(DisjointSet));
+    ensure(set, NULL);
+
+    set->parents = Array(uint32_t, new)(size);
+    if (not set->parents) {
+        ARRAY_FREE(set);
+        return NULL;
+    }
+    for (size_t i = 0; i < size; i++) set->parents->data[i] = DISJOINT_ROOT | 1;
+    atomic_init(&set->_sets, size);
+    return set;
+}
+
+// DisjointSet >> size(set: *DisjointSet) -> size_t
+//
+// Returns the number of elements.
+//
+size_t DisjointSet_size(DisjointSet * set) {
+    ensure(set, 0);
+    return Array(uint32_t, size)(set->parents);
+}
+
+// DisjointSet >> count(set: *DisjointSet) -> size_t
+//
+// Returns the number of disjoint sets.
+//
+size_t DisjointSet_count(DisjointSet * set) {
+    ensure(set, 0);
+    return atomic_load_explicit(&set->_sets, memory_order_relaxed);
+}
+
+
+// ~~~~~~~~ Sequential ~~~~~~~~
+
+// DisjointSet >> find(set: *DisjointSet, element: uint32_t) -> uint32_t
+//
+// Returns the root of the set of ``element``, halving the path to it.
+// ``element`` must be in range.
+//
+uint32_t DisjointSet_find(DisjointSet * set, uint32_t element) {
+    uint32_t * parents = set->parents->data;
+    while (not (parents[element] & DISJOINT_ROOT)) {
+        uint32_t parent = parents[element];
+        uint32_t grandparent = parents[parent];
+        if (grandparent & DISJOINT_ROOT) return parent;
+
+        parents[element] = grandparent;
+        element = grandparent;
+    }
+    return element;
+}
+
+// DisjointSet >> unite(set: *DisjointSet, a: uint32_t, b: uint32_t) -> bool
+//
+// Merges the sets of ``a`` and ``b``, the smaller under the larger.
+//
+// Returns
+// -------
+// bool: Returns true if two sets were merged,
+//       false if they were already the same or out of range.
+//
+bool DisjointSet_unite(DisjointSet * set, uint32_t a, uint32_t b) {
+    ensure(set and a < DisjointSet_size(set) and b < DisjointSet_size(set), false);
+
+    uint32_t * parents = set->parents->data;
+    uint32_t root_a = DisjointSet_find(set, a), root_b = DisjointSet_find(set, b);
+    ensure(root_a != root_b, false);
+
+    if (parents[root_a] < parents[root_b]) {
+        uint32_t swap = root_a;
+        root_a = root_b;
+        root_b = swap;
+    }
+    parents[root_a] += parents[root_b] & ~DISJOINT_ROOT;
+    parents[root_b] = root_a;
+    atomic_fetch_sub_explicit(&set->_sets, 1, memory_order_relaxed);
+    return true;
+}
+
+// DisjointSet >> same(set: *DisjointSet, a: uint32_t, b: uint32_t) -> bool
+//
+// Returns true if ``a`` and ``b`` are in the same set.
+//
+bool DisjointSet_same(DisjointSet * set, uint32_t a, uint32_t b) {
+    ensure(set and a < DisjointSet_size(set) and b < DisjointSet_size(set), false);
+    return DisjointSet_find(set, a) == DisjointSet_find(set, b);
+}
+
+// DisjointSet >> set_size(set: *DisjointSet, element: uint32_t) -> size_t
+//
+// Returns the size of the set of ``element``, 0 if out of range.
+//
+size_t DisjointSet_set_size(DisjointSet * set, uint32_t element) {
+    ensure(set and element < DisjointSet_size(set), 0);
+    return set->parents->data[DisjointSet_find(set, element)] & ~DISJOINT_ROOT;
+}
+
+
+// ~~~~~~~~ Concurrent ~~~~~~~~
+
+// DisjointSet >> find_concurrent(set: *DisjointSet, element: uint32_t) -> uint32_t
+//
+// Lock-free ``find``. The root may stop being one right after,
+// if another thread links it.
+//
+uint32_t DisjointSet_find_concurrent(DisjointSet * set, uint32_t element) {
+    uint32_t * parents = set->parents->data;
+    for (;;) {
+        uint32_t parent = __atomic_load_n(&parents[element], __ATOMIC_ACQUIRE);
+        if (parent & DISJOINT_ROOT) return element;
+
+        uint32_t grandparent = __atomic_load_n(&parents[parent], __ATOMIC_ACQUIRE);
+        if (grandparent & DISJOINT_ROOT) return parent;
+
+        // Any ancestor is a valid parent, so a lost race is harmless.
+        __atomic_compare_exchange_n(&parents[element], &parent, grandparent,
+            true, __ATOMIC_RELAXED, __ATOMIC_RELAXED);
+        element = grandparent;
+    }
+}
+
+// DisjointSet >> unite_concurrent(set: *DisjointSet, a: uint32_t, b: uint32_t) -> bool
+//
+// Lock-free ``unite``. See the header for why it is safe.
+//
+// Returns
+// -------
+// bool: Returns true if this call merged two sets.
+//
+bool DisjointSet_unite_concurrent(DisjointSet * set, uint32_t a, uint32_t b) {
+    ensure(set and a < DisjointSet_size(set) and b < DisjointSet_size(set), false);
+
+    uint32_t * parents = set->parents->data;
+    for (;;) {
+        uint32_t root_a = DisjointSet_find_concurrent(set, a);
+        uint32_t root_b = DisjointSet_find_concurrent(set, b);
+        if (root_a == root_b) return false;
+
+        uint32_t word_a = __atomic_load_n(&parents[root_a], __ATOMIC_ACQUIRE);
+        uint32_t word_b = __atomic_load_n(&parents[root_b], __ATOMIC_ACQUIRE);
+        if (not (word_a & word_b & DISJOINT_ROOT)) continue;
+
+        // Link the smaller set, ties broken by id, under the larger.
+        if (word_a > word_b or (word_a == word_b and root_a < root_b)) {
+            uint32_t swap = root_a; root_a = root_b; root_b = swap;
+            swap = word_a; word_a = word_b; word_b = swap;
+        }
+        if (not __atomic_compare_exchange_n(&parents[root_a], &word_a, root_b,
+                false, __ATOMIC_ACQ_REL, __ATOMIC_RELAXED))
+            continue;
+
+        // Credit the size to whatever root ``root_b`` now belongs to.
+        uint32_t added = word_a & ~DISJOINT_ROOT;
+        for (;;) {
+            uint32_t root = DisjointSet_find_concurrent(set, root_b);
+            uint32_t word = __atomic_load_n(&parents[root], __ATOMIC_ACQUIRE);
+            if ((word & DISJOINT_ROOT) and __atomic_compare_exchange_n(&parents[root], &word,
+                    word + added, false, __ATOMIC_ACQ_REL, __ATOMIC_RELAXED))
+                break;
+        }
+        atomic_fetch_sub_explicit(&set->_sets, 1, memory_order_relaxed);
+        return true;
+    }
+}
+
+typedef struct {
+    DisjointSet * set;
+    const uint32_t * sources;
+    const uint32_t * targets;
+    size_t edges;
+    size_t tasks;
+} _DisjointSetJob;
+
+void _DisjointSet_unite_chunk(void * context, size_t task, size_t worker) {
+    (void) worker;
+    _DisjointSetJob * job = context;
+
+    size_t first = task * job->edges / job->tasks, last = (task + 1) * job->edges / job->tasks;
+    for (size_t i = first; i < last; i++)
+        DisjointSet_unite_concurrent(job->set, job->sources[i], job->targets[i]);
+}
+
+// DisjointSet >> unite_all(set: *DisjointSet, sources: *Array<uint32_t>,
+//                          targets: *Array<uint32_t>, pool: *ThreadPool) -> bool
+//
+// Unites ``sources[i]`` with ``targets[i]`` for every i, in parallel.
+//
+// Parameters
+// ----------
+// set : *DisjointSet
+//     The disjoint set.
+// sources, targets : *Array<uint32_t>
+//     The pairs to unite, of the same size and in range.
+// pool : *ThreadPool
+//     Where to run, NULL for the calling thread.
+//
+// Returns
+// -------
+// bool: Returns true on success, false on mismatching sizes.
+//
+bool DisjointSet_unite_all(DisjointSet * set, Array(uint32_t) * sources,
+                           Array(uint32_t) * targets, ThreadPool * pool) {
+    ensure(set and sources and targets, false);
+    ensure(Array(uint32_t, size)(sources) == Array(uint32_t, size)(targets), false);
+
+    _DisjointSetJob job = {
+        .set = set, .sources = sources->data, .targets = targets->data,
+        .edges = Array(uint32_t, size)(sources),
+        .tasks = ThreadPool_workers(pool) * DISJOINT_TASKS_PER_WORKER,
+    };
+    ThreadPool_run(pool, job.tasks, _DisjointSet_unite_chunk, &job);
+    return true;
+}
+
+
+// ~~~~~~~~ Printing ~~~~~~~~
+
+// DisjointSet >> debug(set: *DisjointSet) -> void
+//
+// Prints the debug representation of the disjoint set:
+// the root of every element, for small sets.
+//
+void DisjointSet_debug(DisjointSet * set) {
+    if (not set) {
+        printf("DisjointSet { NULL }\n");
+        return;
+    }
+
+    printf("DisjointSet {\n");
+    printf("  size: %zu,\n", DisjointSet_size(set));
+    printf("  sets: %zu,\n", DisjointSet_count(set));
+    if (DisjointSet_size(set) <= 32) {
+        printf("  roots: [");
+        for (uint32_t i = 0; i < DisjointSet_size(set); i++)
+            printf(i ? ", %u" : "%u", DisjointSet_find(set, i));
+        printf("],\n");
+    }
+    printf("}\n");
+}
+
+#endif
@@ -0,0 +1,86 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdint.h>
+#include <stdio.h>
+#include <time.h>
+
+#define T uint32_t
+#define PRINT_T(value) printf("%u", value)
+#include "../array/array.h"
+
+#include "disjoint_set.h"
+
+// Usage: ./main [unions] [elements], defaults to 10^8 unions over 2^24 elements.
+
+double seconds() {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec + now.tv_nsec * 1e-9;
+}
+
+uint64_t next_random(uint64_t * seed) {
+    *seed = *seed * 6364136223846793005ull + 1442695040888963407ull;
+    return *seed >> 32;
+}
+
+int main(int argc, char ** argv) {
+
+    DisjointSet * small = DisjointSet_new(10);
+    DisjointSet_unite(small, 1, 2);
+    DisjointSet_unite(small, 3, 4);
+    DisjointSet_unite(small, 2, 4);
+    DisjointSet_unite(small, 7, 8);
+    DisjointSet_debug(small);
+    printf("same(1, 3) = %s, same(1, 7) = %s, set_size(4) = %zu\n\n",
+        DisjointSet_same(small, 1, 3) ? "true" : "false",
+        DisjointSet_same(small, 1, 7) ? "true" : "false",
+        DisjointSet_set_size(small, 4));
+    DisjointSet_delete(small);
+
+    size_t unions = argc > 1 ? (size_t) atoll(argv[1]) : 100000000;
+    size_t elements = argc > 2 ? (size_t) atoll(argv[2]) : (size_t) 1 << 24;
+
+    // Random pairs, so nearly every find is a cache miss.
+    Array(uint32_t) * sources = Array(uint32_t, new)(unions);
+    Array(uint32_t) * targets = Array(uint32_t, new)(unions);
+    uint64_t seed = 3;
+    for (size_t i = 0; i < unions; i++) {
+        sources->data[i] = (uint32_t) (next_random(&seed) % elements);
+        targets->data[i] = (uint32_t) (next_random(&seed) % elements);
+    }
+
+    DisjointSet * sequential = DisjointSet_new(elements);
+    double start = seconds();
+    for (size_t i = 0; i < unions; i++)
+        DisjointSet_unite(sequential, sources->data[i], targets->data[i]);
+    double sequential_time = seconds() - start;
+
+    ThreadPool * pool = ThreadPool_new(0);
+    DisjointSet * concurrent = DisjointSet_new(elements);
+    start = seconds();
+    DisjointSet_unite_all(concurrent, sources, targets, pool);
+    double concurrent_time = seconds() - start;
+
+    // Same partition: same number of sets, and the same sets.
+    bool agree = DisjointSet_count(sequential) == DisjointSet_count(concurrent);
+    for (size_t i = 0; i < 1000000 and agree; i++) {
+        uint32_t a = (uint32_t) (next_random(&seed) % elements);
+        uint32_t b = (uint32_t) (next_random(&seed) % elements);
+        agree = DisjointSet_same(sequential, a, b) == DisjointSet_same(concurrent, a, b)
+            and DisjointSet_set_size(sequential, a) == DisjointSet_set_size(concurrent, a);
+    }
+
+    printf("%zu unions over %zu elements (%zu MB), %zu sets left\n",
+        unions, elements, elements * sizeof(uint32_t) >> 20, DisjointSet_count(sequential));
+    printf("sequential unite:          %6.1f M unions/s\n", unions / sequential_time / 1e6);
+    printf("lock-free, %2zu workers:     %6.1f M unions/s, partitions %s\n",
+        ThreadPool_workers(pool), unions / concurrent_time / 1e6, agree ? "agree" : "differ");
+
+    DisjointSet_delete(sequential);
+    DisjointSet_delete(concurrent);
+    Array(uint32_t, delete)(sources);
+    Array(uint32_t, delete)(targets);
+    ThreadPool_delete(pool);
+    return 0;
+
+}
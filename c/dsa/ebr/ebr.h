@@ -0,0 +1,473 @@
+// ===
+// Ebr
+// ===
+//
+// :Author: RickBarretto
+// :Year: 2026
+// :License: MPL 2.0
+// :Copyright: RickBarretto, 2026
+// :Version: 1.1
+//
+// ``Ebr`` is epoch-based memory reclamation, for lock-free structures
+// whose readers may still hold a pointer to memory another thread has
+// just unlinked. Instead of freeing it at once, the writer defers it:
+//
+// - Readers wrap every access in ``enter`` and ``exit``, which announce
+//   the global epoch the thread runs in. Both are a couple of stores.
+// - ``defer_free`` queues the pointer with the current epoch.
+// - The epoch advances once every thread inside has caught up with it,
+//   so memory queued two epochs ago can no longer be reached: it is
+//   passed to its destructor, ARRAY_FREE by default.
+//
+// The work is amortized: every call to ``defer_free`` frees at most
+// EBR_BUDGET ready pointers, and tries to advance the epoch once every
+// EBR_ADVANCE calls, so no single call pays for a whole backlog.
+// ``start`` adds a background thread that advances and drains the queues
+// of idle threads as well. A thread that stays inside an epoch holds
+// reclamation back for everyone, so keep critical sections short.
+//
+// Threads are numbered like ``ThreadPool`` workers: each call names
+// the index of the calling thread, which no two threads may share.
+// ``enter`` and ``exit`` nest.
+//
+// How to Use
+// ----------
+//
+//      #include "ebr.h"
+//
+// And a common way to use it would be:
+//
+//      Ebr * ebr = Ebr_new(threads);
+//
+//      Ebr_enter(ebr, worker);                     // readers
+//      Config * config = atomic_load(&shared);
+//      ...
+//      Ebr_exit(ebr, worker);
+//
+//      Config * old = atomic_exchange(&shared, fresh);    // writers
+//      Ebr_defer_free(ebr, worker, old, NULL, NULL);
+//
+// To defer a typed delete, such as ``Array(T, delete)``, wrap it:
+//
+//      void drop(void * context, void * array) { Array(int64_t, delete)(array); }
+//      Ebr_defer_free(ebr, worker, array, drop, NULL);
+//
+// Link with ``-pthread``.
+//
+
+#ifndef EBR_H
+#define EBR_H
+
+// =~=~=~=~=~=~=~=~ Imports ~=~=~=~=~=~=~=~=
+
+#include <iso646.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+
+// =~=~=~=~=~=~=~=~ Helper Macros ~=~=~=~=~=~=~=~=
+
+#define ensure(COND, VAL) if (not (COND)) return VAL
+
+
+// =~=~=~=~=~=~=~=~ Allocator Hooks ~=~=~=~=~=~=~=~=
+
+// The same hooks as ``Array<T>``, see its documentation.
+
+#ifndef ARRAY_MALLOC
+#define ARRAY_MALLOC(size) malloc(size)
+#endif
+
+#ifndef ARRAY_CALLOC
+#define ARRAY_CALLOC(count, size) calloc(count, size)
+#endif
+
+#ifndef ARRAY_REALLOC
+#define ARRAY_REALLOC(pointer, size) realloc(pointer, size)
+#endif
+
+#ifndef ARRAY_FREE
+#define ARRAY_FREE(pointer) free(pointer)
+#endif
+
+
+// =~=~=~=~=~=~=~=~ Implementation ~=~=~=~=~=~=~=~=
+
+// EBR_BUDGET: Most pointers freed by one ``defer_free``.
+#ifndef EBR_BUDGET
+#define EBR_BUDGET 8
+#endif
+
+// EBR_ADVANCE: Calls to ``defer_free`` by a thread between attempts to advance.
+#ifndef EBR_ADVANCE
+#define EBR_ADVANCE 64
+#endif
+
+// A destructor for deferred memory, ``context`` first as in ``ThreadPool``.
+typedef void (*EbrDestructor)(void * context, void * pointer);
+
+typedef struct {
+    void * pointer;
+    EbrDestructor dtor;
+    void * context;
+    uint64_t epoch;
+} _EbrEntry;
+
+// Per-thread state, one cache line apart from the others.
+typedef struct {
+    _Alignas(64) _Atomic uint64_t epoch;        // (epoch << 1) | 1 while inside, 0 outside
+    size_t depth;
+    size_t deferred;            // since the last attempt to advance
+    pthread_mutex_t lock;       // the limbo is shared with the background thread
+    _EbrEntry * limbo;          // a ring of deferred pointers, oldest first
+    size_t head;
+    size_t size;
+    size_t capacity;
+} _EbrThread;
+
+typedef struct {
+    _EbrThread * threads;
+    void * _memory;             // ``threads`` before alignment
+    size_t _threads;
+    _Atomic uint64_t _epoch;
+    _Atomic bool _running;
+    pthread_t _reclaimer;
+    long _interval;             // of the background thread, in microseconds
+} Ebr;
+
+
+// ~~~~~~~~ Epochs ~~~~~~~~
+
+// Ebr >> enter(ebr: *Ebr, thread: size_t) -> void
+//
+// Starts a critical section: memory deferred from now on
+// is not freed before the matching ``exit``.
+//
+void Ebr_enter(Ebr * ebr, size_t thread) {
+    ensure(ebr and thread < ebr->_threads,);
+
+    _EbrThread * self = &ebr->threads[thread];
+    ensure(self->depth++ == 0,);
+
+    uint64_t epoch = atomic_load(&ebr->_epoch);
+    atomic_store(&self->epoch, epoch << 1 | 1);
+    atomic_thread_fence(memory_order_seq_cst);
+}
+
+// Ebr >> exit(ebr: *Ebr, thread: size_t) -> void
+//
+// Ends a critical section. Pointers read inside must not be used after.
+//
+void Ebr_exit(Ebr * ebr, size_t thread) {
+    ensure(ebr and thread < ebr->_threads,);
+
+    _EbrThread * self = &ebr->threads[thread];
+    ensure(self->depth > 0 and --self->depth == 0,);
+    atomic_store_explicit(&self->epoch, 0, memory_order_release);
+}
+
+// Moves the global epoch forward if every thread inside has caught up.
+bool _Ebr_advance(Ebr * ebr) {
+    uint64_t epoch = atomic_load(&ebr->_epoch);
+    atomic_thread_fence(memory_order_seq_cst);
+    for (size_t i = 0; i < ebr->_threads; i++) {
+        uint64_t announced = atomic_load_explicit(&ebr->threads[i].epoch, memory_order_acquire);
+        ensure(not (announced & 1) or announced >> 1 == epoch, false);
+    }
+    return atomic_compare_exchange_strong(&ebr->_epoch, &epoch, epoch + 1);
+}
+
+// Frees up to ``budget`` ready pointers of a thread, oldest first.
+// Destructors run outside the lock, so they may defer more memory.
+size_t _Ebr_collect(Ebr * ebr, _EbrThread * self, size_t budget) {
+    size_t freed = 0;
+    while (freed < budget) {
+        _EbrEntry ready[EBR_BUDGET];
+        size_t count = 0;
+        uint64_t epoch = atomic_load(&ebr->_epoch);
+
+        pthread_mutex_lock(&self->lock);
+        while (count < EBR_BUDGET and freed + count < budget and self->size > 0) {
+            _EbrEntry * oldest = &self->limbo[self->head];
+            if (oldest->epoch + 2 > epoch) break;
+            ready[count++] = *oldest;
+            self->head = (self->head + 1) % self->capacity;
+            self->size--;
+        }
+        pthread_mutex_unlock(&self->lock);
+
+        for (size_t i = 0; i < count; i++) {
+            if (ready[i].dtor) ready[i].dtor(ready[i].context, ready[i].pointer);
+            else ARRAY_FREE(ready[i].pointer);
+        }
+        freed += count;
+        if (count < EBR_BUDGET) break;
+    }
+    return freed;
+}
+
+// Ebr >> defer_free(ebr: *Ebr, thread: size_t, pointer: *void, dtor: EbrDestructor, context: *void) -> bool
+//
+// Frees ``pointer`` once no thread can still be reading it,
+// i.e. once every critical section running now has ended.
+// The pointer must already be unreachable for new readers.
+//
+// Parameters
+// ----------
+// ebr : *Ebr
+//     The reclamation domain.
+// thread : size_t
+//     The index of the calling thread.
+// pointer : *void
+//     The memory to free.
+// dtor : EbrDestructor
+//     Called as ``dtor(context, pointer)``, or NULL for ARRAY_FREE.
+// context : *void
+//     Handed to ``dtor``.
+//
+// Returns
+// -------
+// bool: Returns true on success, false if the queue could not grow,
+//       in which case the pointer is left to the caller.
+//
+bool Ebr_defer_free(Ebr * ebr, size_t thread, void * pointer, EbrDestructor dtor, void * context) {
+    ensure(ebr and thread < ebr->_threads and pointer, false);
+
+    _EbrThread * self = &ebr->threads[thread];
+    _EbrEntry entry = { pointer, dtor, context, atomic_load(&ebr->_epoch) };
+
+    pthread_mutex_lock(&self->lock);
+    if (self->size == self->capacity) {
+        size_t capacity = self->capacity ? self->capacity * 2 : 64;
+        _EbrEntry * limbo = ARRAY_MALLOC(capacity * sizeof(_EbrEntry));
+        if (not limbo) {
+            pthread_mutex_unlock(&self->lock);
+            return false;
+        }
+        for (size_t i = 0; i < self->size; i++)
+            limbo[i] = self->limbo[(self->head + i) % self->capacity];
+        ARRAY_FREE(self->limbo);
+        self->limbo = limbo;
+        self->head = 0;
+        self->capacity = capacity;
+    }
+    self->limbo[(self->head + self->size++) % self->capacity] = entry;
+    pthread_mutex_unlock(&self->lock);
+
+    if (++self->deferred >= EBR_ADVANCE) {
+        self->deferred = 0;
+        _Ebr_advance(ebr);
+    }
+    _Ebr_collect(ebr, self, EBR_BUDGET);
+    return true;
+}
+
+// Ebr >> reclaim(ebr: *Ebr, thread: size_t) -> size_t
+//
+// Tries to advance the epoch, then frees every ready pointer
+// deferred by ``thread``, with no budget.
+//
+// Returns
+// -------
+// size_t: The number of pointers freed.
+//
+size_t Ebr_reclaim(Ebr * ebr, size_t thread) {
+    ensure(ebr and thread < ebr->_threads, 0);
+
+    _Ebr_advance(ebr);
+    return _Ebr_collect(ebr, &ebr->threads[thread], SIZE_MAX);
+}
+
+// Ebr >> synchronize(ebr: *Ebr) -> void
+//
+// Waits for a grace period: returns once every critical section
+// running at the call has ended. The caller must not be inside one.
+// Use it where deferring is not possible, then free directly.
+//
+void Ebr_synchronize(Ebr * ebr) {
+    ensure(ebr,);
+
+    struct timespec pause = { 0, 50000 };
+    uint64_t target = atomic_load(&ebr->_epoch) + 2;
+    while (atomic_load(&ebr->_epoch) < target)
+        if (not _Ebr_advance(ebr)) nanosleep(&pause, NULL);
+}
+
+
+// ~~~~~~~~ Background Reclaimer ~~~~~~~~
+
+void * _Ebr_main(void * argument) {
+    Ebr * ebr = argument;
+    struct timespec pause = { ebr->_interval / 1000000, ebr->_interval % 1000000 * 1000 };
+
+    while (atomic_load(&ebr->_running)) {
+        nanosleep(&pause, NULL);
+        _Ebr_advance(ebr);
+        for (size_t i = 0; i < ebr->_threads; i++) _Ebr_collect(ebr, &ebr->threads[i], SIZE_MAX);
+    }
+    return NULL;
+}
+
+// Ebr >> start(ebr: *Ebr, interval: long) -> bool
+//
+// Starts a background thread that advances the epoch and frees
+// ready pointers every ``interval`` microseconds, so memory deferred
+// by threads that went idle is freed too.
+//
+// Returns
+// -------
+// bool: Returns true on success, false if already started.
+//
+bool Ebr_start(Ebr * ebr, long interval) {
+    ensure(ebr and interval > 0 and not atomic_load(&ebr->_running), false);
+
+    ebr->_interval = interval;
+    atomic_store(&ebr->_running, true);
+    if (pthread_create(&ebr->_reclaimer, NULL, _Ebr_main, ebr) != 0) {
+        atomic_store(&ebr->_running, false);
+        return false;
+    }
+    return true;
+}
+
+// Ebr >> stop(ebr: *Ebr) -> bool
+//
+// Stops the background thread, waiting for its current pass.
+//
+// Returns
+// -------
+// bool: Returns true on success, false if it was not running.
+//
+bool Ebr_stop(Ebr * ebr) {
+    ensure(ebr and atomic_load(&ebr->_running), false);
+
+    atomic_store(&ebr->_running, false);
+    pthread_join(ebr->_reclaimer, NULL);
+    return true;
+}
+
+
+// ~~~~~~~~ Lifetime ~~~~~~~~
+
+// Ebr >> delete(ebr: *Ebr) -> bool
+//
+// Stops the background thread and frees every deferred pointer.
+// No thread may be inside a critical section.
+//
+// Returns
+// -------
+// bool: Returns true on success.
+//
+bool Ebr_delete(Ebr * ebr) {
+    ensure(ebr, false);
+
+    if (atomic_load(&ebr->_running)) Ebr_stop(ebr);
+    for (size_t i = 0; i < ebr->_threads; i++) {
+        _EbrThread * self = &ebr->threads[i];
+        for (size_t n = 0; n < self->size; n++) {
+            _EbrEntry * entry = &self->limbo[(self->head + n) % self->capacity];
+            if (entry->dtor) entry->dtor(entry->context, entry->pointer);
+            else ARRAY_FREE(entry->pointer);
+        }
+        ARRAY_FREE(self->limbo);
+        pthread_mutex_destroy(&self->lock);
+    }
+    ARRAY_FREE(ebr->_memory);
+    ARRAY_FREE(ebr);
+    return true;
+}
+
+// Ebr >> new(threads: size_t) -> *Ebr
+//
+// Creates a reclamation domain for up to ``threads`` thread indices.
+//
+// Returns
+// -------
+// *Ebr: The new domain, or NULL on failure.
+//
+Ebr * Ebr_new(size_t threads) {
+    ensure(threads > 0, NULL);
+
+    Ebr * ebr = ARRAY_MALLOC(sizeof(Ebr));
+    ensure(ebr, NULL);
+
+    // Thread states are aligned to cache lines by hand, past the hooks.
+    ebr->_memory = ARRAY_MALLOC(threads * sizeof(_EbrThread) + 64);
+    if (not ebr->_memory) {
+        ARRAY_FREE(ebr);
+        return NULL;
+    }
+    ebr->threads = (_EbrThread *) (((uintptr_t) ebr->_memory + 63) & ~(uintptr_t) 63);
+    ebr->_threads = threads;
+    ebr->_interval = 0;
+    atomic_init(&ebr->_epoch, 2);
+    atomic_init(&ebr->_running, false);
+
+    for (size_t i = 0; i < threads; i++) {
+        _EbrThread * self = &ebr->threads[i];
+        memset(self, 0, sizeof(_EbrThread));
+        atomic_init(&self->epoch, 0);
+        pthread_mutex_init(&self->lock, NULL);
+    }
+    return ebr;
+}
+
+// Ebr >> threads(ebr: *Ebr) -> size_t
+//
+// Returns the number of thread indices.
+//
+size_t Ebr_threads(Ebr * ebr) {
+    ensure(ebr, 0);
+    return ebr->_threads;
+}
+
+// Ebr >> pending(ebr: *Ebr) -> size_t
+//
+// Returns the number of pointers waiting to be freed.
+//
+size_t Ebr_pending(Ebr * ebr) {
+    ensure(ebr, 0);
+
+    size_t pending = 0;
+    for (size_t i = 0; i < ebr->_threads; i++) {
+        pthread_mutex_lock(&ebr->threads[i].lock);
+        pending += ebr->threads[i].size;
+        pthread_mutex_unlock(&ebr->threads[i].lock);
+    }
+    return pending;
+}
+
+// Ebr >> epoch(ebr: *Ebr) -> u64
+//
+// Returns the global epoch.
+//
+uint64_t Ebr_epoch(Ebr * ebr) {
+    ensure(ebr, 0);
+    return atomic_load(&ebr->_epoch);
+}
+
+// Ebr >> debug(ebr: *Ebr) -> void
+//
+// Prints the debug representation of the domain.
+//
+void Ebr_debug(Ebr * ebr) {
+    if (not ebr) {
+        printf("Ebr { NULL }\n");
+        return;
+    }
+
+    printf("Ebr {\n");
+    printf("  threads: %zu,\n", ebr->_threads);
+    printf("  epoch: %llu,\n", (unsigned long long) Ebr_epoch(ebr));
+    printf("  pending: %zu,\n", Ebr_pending(ebr));
+    printf("  background: %s,\n", atomic_load(&ebr->_running) ? "true" : "false");
+    printf("}\n");
+}
+
+#endif
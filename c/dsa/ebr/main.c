@@ -0,0 +1,116 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdint.h>
+#include <stdio.h>
+#include <time.h>
+
+#define T int64_t
+#define PRINT_T(value) printf("%lld", (long long) value)
+#include "../array/array.h"
+
+#include "../thread_pool/thread_pool.h"
+#include "ebr.h"
+
+// Usage: ./main [operations] [threads], defaults to 2^20 operations
+// per thread on 8 threads. Build with -fsanitize=thread (or address)
+// to run it as a stress test: any early free is reported as a race.
+
+double seconds() {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec + now.tv_nsec * 1e-9;
+}
+
+uint64_t next_random(uint64_t * seed) {
+    *seed = *seed * 6364136223846793005ull + 1442695040888963407ull;
+    return *seed >> 32;
+}
+
+// A snapshot that readers share and writers replace: every element
+// holds its version, so a torn or freed snapshot is noticed.
+typedef struct {
+    Ebr * ebr;
+    _Atomic(Array(int64_t) *) current;
+    _Atomic int64_t version;
+    _Atomic size_t freed;
+    _Atomic size_t torn;
+    _Atomic size_t peak;
+    size_t operations;
+} Job;
+
+void drop(void * context, void * array) {
+    Job * job = context;
+    Array(int64_t, delete)(array);
+    atomic_fetch_add_explicit(&job->freed, 1, memory_order_relaxed);
+}
+
+// One write per 16 operations, the rest are reads.
+void run(void * context, size_t task, size_t worker) {
+    Job * job = context;
+    uint64_t seed = task + 1;
+    for (size_t i = 0; i < job->operations; i++) {
+        if (next_random(&seed) % 16 == 0) {
+            int64_t version = atomic_fetch_add(&job->version, 1) + 1;
+            Array(int64_t) * fresh = Array(int64_t, new)(64);
+            for (size_t j = 0; j < 64; j++) fresh->data[j] = version;
+
+            Array(int64_t) * old = atomic_exchange(&job->current, fresh);
+            if (not Ebr_defer_free(job->ebr, worker, old, drop, job)) drop(job, old);
+
+            size_t pending = Ebr_pending(job->ebr), peak = atomic_load(&job->peak);
+            while (pending > peak and not atomic_compare_exchange_weak(&job->peak, &peak, pending)) {}
+            continue;
+        }
+
+        Ebr_enter(job->ebr, worker);
+        Array(int64_t) * snapshot = atomic_load(&job->current);
+        int64_t first = snapshot->data[0];
+        for (size_t j = 1; j < 64; j++)
+            if (snapshot->data[j] != first) atomic_fetch_add(&job->torn, 1);
+        Ebr_exit(job->ebr, worker);
+    }
+}
+
+int main(int argc, char ** argv) {
+
+    Ebr * small = Ebr_new(2);
+    Ebr_enter(small, 0);
+    Ebr_defer_free(small, 1, malloc(64), NULL, NULL);
+    Ebr_debug(small);               // held back: thread 0 is inside
+    Ebr_exit(small, 0);
+    Ebr_reclaim(small, 1);
+    Ebr_reclaim(small, 1);
+    Ebr_debug(small);
+    Ebr_delete(small);
+
+    size_t operations = argc > 1 ? (size_t) atoll(argv[1]) : (size_t) 1 << 20;
+    size_t threads = argc > 2 ? (size_t) atoll(argv[2]) : 8;
+    printf("\n%zu operations per thread, %zu threads, %zu cores\n", operations, threads, ThreadPool_cores());
+
+    ThreadPool * pool = ThreadPool_new(threads);
+    for (int background = 0; background < 2; background++) {
+        Job job = { .ebr = Ebr_new(threads), .operations = operations };
+        atomic_init(&job.current, Array(int64_t, new)(64));
+        atomic_init(&job.version, 0);
+        atomic_init(&job.freed, 0);
+        atomic_init(&job.torn, 0);
+        atomic_init(&job.peak, 0);
+        if (background) Ebr_start(job.ebr, 1000);
+
+        double start = seconds();
+        ThreadPool_run(pool, threads, run, &job);
+        double elapsed = seconds() - start;
+
+        size_t pending = Ebr_pending(job.ebr);
+        size_t writes = (size_t) atomic_load(&job.version);
+        printf("%s: %6.1f M ops/s, %zu replaced, %zu freed, peak pending %zu, pending at end %zu, torn reads %zu\n",
+            background ? "background" : "amortized ", threads * operations / elapsed / 1e6,
+            writes, atomic_load(&job.freed), atomic_load(&job.peak), pending, atomic_load(&job.torn));
+
+        Ebr_delete(job.ebr);
+        Array(int64_t, delete)(atomic_load(&job.current));
+    }
+    ThreadPool_delete(pool);
+    return 0;
+
+}
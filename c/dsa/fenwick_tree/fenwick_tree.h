@@ -0,0 +1,393 @@
+// ==============
+// FenwickTree<T>
+// ==============
+//
+// :Author: RickBarretto
+// :Year: 2026
+// :License: MPL 2.0
+// :Copyright: RickBarretto, 2026
+// :Version: 1.0
+//
+// ``FenwickTree<T>`` (a binary indexed tree) keeps the prefix sums
+// of a sequence of numbers, so that both a point update and a range sum
+// take O(log n), instead of the O(n) loop over an ``Array<T>``.
+//
+// The tree is a single ``Array<T>`` of n + 1 elements, where slot ``i``
+// holds the sum of the ``i & -i`` elements ending at position ``i``.
+// It is built in O(n) from an Array, by pushing each slot into its parent
+// once, instead of n O(log n) insertions.
+//
+// ``add_all`` applies a batch of updates. Small batches go one by one,
+// large ones unfold the tree back into plain values in O(n),
+// apply the batch there and build it again.
+//
+// How to Use
+// ----------
+//
+// Include ``Array<T>`` first, then this header with the same T:
+//
+//      #define T int64_t
+//      #define PRINT_T(value) printf("%lld", (long long) value)
+//      #include "../array/array.h"
+//
+//      #define T int64_t
+//      #define PRINT_T(value) printf("%lld", (long long) value)
+//      #include "fenwick_tree.h"
+//
+// And a common way to use it would be:
+//
+//      FenwickTree(int64_t) * tree = FenwickTree(int64_t, from_array)(values);
+//      FenwickTree(int64_t, add)(tree, 3, -2);
+//      int64_t total = FenwickTree(int64_t, sum)(tree, 2, 10);
+//
+
+// =~=~=~=~=~=~=~=~ Imports ~=~=~=~=~=~=~=~=
+
+#include <iso646.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+
+// =~=~=~=~=~=~=~=~ Helper Macros ~=~=~=~=~=~=~=~=
+
+#define _CAT(X, Y) X ## _ ## Y
+#define CAT(X, Y) _CAT(X, Y)
+#define _CAT3(X, Y, Z) X ## _ ## Y ## _ ## Z
+#define CAT3(X, Y, Z) _CAT3(X, Y, Z)
+
+#define STRINGIFY(x) #x
+#define TOSTRING(x) STRINGIFY(x)
+
+#define ensure(COND, VAL) if (not (COND)) return VAL
+
+
+// =~=~=~=~=~=~=~=~ Shared helpers ~=~=~=~=~=~=~=~=
+
+#ifndef FENWICK_TREE_HELPERS
+#define FENWICK_TREE_HELPERS
+
+// Number of bits of ``value``, i.e. floor(log2(value)) + 1.
+size_t _FenwickTree_bits(size_t value) {
+    size_t bits = 0;
+    for (; value; value >>= 1) bits++;
+    return bits;
+}
+
+#endif
+
+
+// =~=~=~=~=~=~=~=~ Implementation ~=~=~=~=~=~=~=~=
+
+// T: Element type of the FenwickTree<T>, a numeric type.
+#ifndef T
+#error "T is not defined"
+#endif
+
+// PRINT_T: (T) -> void
+//
+// PRINT_T is a macro that defines how to print an element of type T.
+// See ``Array<T>`` for more details.
+//
+#ifndef PRINT_T
+#error "PRINT_T is not defined"
+#endif
+
+#define MODULE FenwickTree
+#define Self CAT(MODULE, T)
+#define fn(NAME) CAT(Self, NAME)
+
+#define _FENWICK_TREE_SELECT_MACRO(_1, _2, NAME, ...) NAME
+#define FenwickTree(...) _FENWICK_TREE_SELECT_MACRO(__VA_ARGS__, FenwickTree2, FenwickTree1)(__VA_ARGS__)
+#define FenwickTree1(T) CAT(FenwickTree, T)
+#define FenwickTree2(T, FUNC) CAT3(FenwickTree, T, FUNC)
+
+typedef struct {
+    Array(T) * storage;         // slot 0 is unused
+    size_t _size;
+} Self;
+
+
+// FenwickTree >> delete(tree: *FenwickTree<T>) -> bool
+//
+// Safely deletes the tree and its storage.
+//
+// Returns
+// -------
+// bool: Returns true on success.
+//
+bool fn(delete)(Self * tree) {
+    ensure(tree, false);
+
+    Array(T, delete)(tree->storage);
+    ARRAY_FREE(tree);
+    return true;
+}
+
+// FenwickTree >> new(size: size_t) -> *FenwickTree<T>
+//
+// Creates a tree over ``size`` zeros.
+//
+// Returns
+// -------
+// *FenwickTree<T>: A pointer to the new tree, or NULL on failure.
+//
+Self * fn(new)(size_t size) {
+    Self * tree = ARRAY_MALLOC(sizeof(Self));
+    ensure(tree, NULL);
+
+    tree->storage = Array(T, new)(size + 1);
+    if (not tree->storage) {
+        ARRAY_FREE(tree);
+        return NULL;
+    }
+
+    tree->_size = size;
+    return tree;
+}
+
+// Turns plain values in data[1..n] into the tree, in place, in O(n).
+void fn(_build)(T * data, size_t size) {
+    for (size_t i = 1; i <= size; i++) {
+        size_t parent = i + (i & -i);
+        if (parent <= size) data[parent] += data[i];
+    }
+}
+
+// The inverse of ``_build``: turns the tree back into plain values.
+void fn(_unbuild)(T * data, size_t size) {
+    for (size_t i = size; i >= 1; i--) {
+        size_t parent = i + (i & -i);
+        if (parent <= size) data[parent] -= data[i];
+    }
+}
+
+// FenwickTree >> from_array(array: *Array<T>) -> *FenwickTree<T>
+//
+// Builds a tree over a copy of the array, in O(n).
+//
+// Returns
+// -------
+// *FenwickTree<T>: A pointer to the new tree, or NULL on failure.
+//
+Self * fn(from_array)(Array(T) * array) {
+    ensure(array, NULL);
+
+    size_t size = Array(T, size)(array);
+    Self * tree = fn(new)(size);
+    ensure(tree, NULL);
+
+    T * data = tree->storage->data;
+    for (size_t i = 0; i < size; i++) data[i + 1] = array->data[i];
+    fn(_build)(data, size);
+    return tree;
+}
+
+// FenwickTree >> size(tree: *FenwickTree<T>) -> size_t
+//
+// Returns the number of elements.
+//
+size_t fn(size)(Self * tree) {
+    ensure(tree, 0);
+    return tree->_size;
+}
+
+
+// ~~~~~~~~ Updates ~~~~~~~~
+
+// FenwickTree >> add(tree: *FenwickTree<T>, index: size_t, delta: T) -> bool
+//
+// Adds ``delta`` to the element at ``index``, in O(log n).
+//
+// Returns
+// -------
+// bool: Returns true on success, false if out of bounds.
+//
+bool fn(add)(Self * tree, size_t index, T delta) {
+    ensure(tree and index < tree->_size, false);
+
+    T * data = tree->storage->data;
+    for (size_t i = index + 1; i <= tree->_size; i += i & -i)
+        data[i] += delta;
+    return true;
+}
+
+// FenwickTree >> add_all(tree: *FenwickTree<T>, indices: *size_t, deltas: *T, count: size_t) -> bool
+//
+// Adds ``deltas[k]`` to the element at ``indices[k]``, for every k.
+// Once the batch costs more than a rebuild, i.e. ``count * log2(n) > n``,
+// the whole tree is unfolded and built again in O(n).
+//
+// Parameters
+// ----------
+// tree : *FenwickTree<T>
+//     The tree to update.
+// indices : *size_t
+//     The positions to update, in any order, repeats allowed.
+// deltas : *T
+//     What to add at each position.
+// count : size_t
+//     The number of updates.
+//
+// Returns
+// -------
+// bool: Returns true on success, false if any index is out of bounds,
+//       in which case nothing is changed.
+//
+bool fn(add_all)(Self * tree, const size_t * indices, const T * deltas, size_t count) {
+    ensure(tree, false);
+    ensure(count == 0 or (indices and deltas), false);
+    for (size_t k = 0; k < count; k++) ensure(indices[k] < tree->_size, false);
+
+    if (count * _FenwickTree_bits(tree->_size) <= tree->_size) {
+        for (size_t k = 0; k < count; k++) fn(add)(tree, indices[k], deltas[k]);
+        return true;
+    }
+
+    T * data = tree->storage->data;
+    fn(_unbuild)(data, tree->_size);
+    for (size_t k = 0; k < count; k++) data[indices[k] + 1] += deltas[k];
+    fn(_build)(data, tree->_size);
+    return true;
+}
+
+
+// ~~~~~~~~ Queries ~~~~~~~~
+
+// FenwickTree >> prefix(tree: *FenwickTree<T>, end: size_t) -> T
+//
+// Returns the sum of the elements in ``[0, end)``, in O(log n).
+// ``end`` is clamped to the size of the tree.
+//
+T fn(prefix)(Self * tree, size_t end) {
+    ensure(tree, 0);
+
+    T * data = tree->storage->data;
+    T total = 0;
+    for (size_t i = end < tree->_size ? end : tree->_size; i; i &= i - 1)
+        total += data[i];
+    return total;
+}
+
+// FenwickTree >> sum(tree: *FenwickTree<T>, start: size_t, end: size_t) -> T
+//
+// Returns the sum of the elements in ``[start, end)``, in O(log n).
+// Both prefixes are walked together and stop where their paths meet,
+// so short ranges only touch a few slots.
+//
+// Returns
+// -------
+// T: The sum, or 0 for an empty or out-of-bounds range.
+//
+T fn(sum)(Self * tree, size_t start, size_t end) {
+    ensure(tree and start < end and end <= tree->_size, 0);
+
+    T * data = tree->storage->data;
+    T total = 0;
+    while (end != start) {
+        if (end > start) {
+            total += data[end];
+            end &= end - 1;
+        } else {
+            total -= data[start];
+            start &= start - 1;
+        }
+    }
+    return total;
+}
+
+// FenwickTree >> get(tree: *FenwickTree<T>, index: size_t) -> T
+//
+// Returns the element at ``index``, or 0 if out of bounds.
+//
+T fn(get)(Self * tree, size_t index) {
+    return fn(sum)(tree, index, index + 1);
+}
+
+// FenwickTree >> set(tree: *FenwickTree<T>, index: size_t, value: T) -> bool
+//
+// Sets the element at ``index``, in O(log n).
+//
+// Returns
+// -------
+// bool: Returns true on success, false if out of bounds.
+//
+bool fn(set)(Self * tree, size_t index, T value) {
+    ensure(tree and index < tree->_size, false);
+    return fn(add)(tree, index, value - fn(get)(tree, index));
+}
+
+// FenwickTree >> lower_bound(tree: *FenwickTree<T>, value: T) -> size_t
+//
+// Finds the first ``index`` such that ``prefix(index + 1) >= value``,
+// descending the tree in O(log n). The elements must not be negative.
+//
+// Returns
+// -------
+// size_t: The index, or the size of the tree if the total is below ``value``.
+//
+size_t fn(lower_bound)(Self * tree, T value) {
+    ensure(tree, 0);
+
+    T * data = tree->storage->data;
+    size_t position = 0;
+    size_t bits = _FenwickTree_bits(tree->_size);
+    for (size_t step = bits ? (size_t) 1 << (bits - 1) : 0; step; step >>= 1) {
+        size_t next = position + step;
+        if (next <= tree->_size and data[next] < value) {
+            position = next;
+            value -= data[next];
+        }
+    }
+    return position;
+}
+
+
+// ~~~~~~~~ Printing ~~~~~~~~
+
+// FenwickTree >> print(tree: *FenwickTree<T>) -> void
+//
+// Prints the elements on terminal, not the internal sums.
+//
+void fn(print)(Self * tree) {
+    ensure(tree,);
+
+    printf("[");
+    for (size_t i = 0; i < tree->_size; i++) {
+        PRINT_T(fn(get)(tree, i));
+        if (i + 1 < tree->_size) printf(", ");
+    }
+    printf("]");
+}
+
+// FenwickTree >> println(tree: *FenwickTree<T>) -> void
+//
+// Prints the elements on terminal followed by a newline.
+//
+void fn(println)(Self * tree) {
+    fn(print)(tree);
+    printf("\n");
+}
+
+// FenwickTree >> debug(tree: *FenwickTree<T>) -> void
+//
+// Prints the debug representation of the tree.
+//
+void fn(debug)(Self * tree) {
+    if (not tree) {
+        printf("FenwickTree<%s> { NULL }\n", TOSTRING(T));
+        return;
+    }
+
+    printf("FenwickTree<%s> {\n", TOSTRING(T));
+    printf("  size: %zu,\n", tree->_size);
+    printf("  values: "); fn(println)(tree);
+    printf("  slots: "); Array(T, println)(tree->storage);
+    printf("}\n");
+}
+
+#undef MODULE
+#undef Self
+#undef fn
+#undef T
+#undef PRINT_T
@@ -0,0 +1,111 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdint.h>
+#include <stdio.h>
+#include <time.h>
+
+#define T int64_t
+#define PRINT_T(value) printf("%lld", (long long) value)
+#include "../array/array.h"
+
+#define T int64_t
+#define PRINT_T(value) printf("%lld", (long long) value)
+#include "fenwick_tree.h"
+
+// Usage: ./main [size], defaults to 2^22 elements.
+
+double seconds() {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec + now.tv_nsec * 1e-9;
+}
+
+uint64_t next_random(uint64_t * seed) {
+    *seed = *seed * 6364136223846793005ull + 1442695040888963407ull;
+    return *seed >> 32;
+}
+
+int main(int argc, char ** argv) {
+
+    Array(int64_t) * small = Array(int64_t, new)(8);
+    for (size_t i = 0; i < 8; i++) small->data[i] = (int64_t) i + 1;
+
+    FenwickTree(int64_t) * tree = FenwickTree(int64_t, from_array)(small);
+    FenwickTree(int64_t, add)(tree, 2, 10);
+    FenwickTree(int64_t, set)(tree, 7, 0);
+    FenwickTree(int64_t, debug)(tree);
+    printf("sum[2, 5) = %lld, prefix(8) = %lld, lower_bound(20) = %zu\n\n",
+        (long long) FenwickTree(int64_t, sum)(tree, 2, 5),
+        (long long) FenwickTree(int64_t, prefix)(tree, 8),
+        FenwickTree(int64_t, lower_bound)(tree, 20));
+    FenwickTree(int64_t, delete)(tree);
+    Array(int64_t, delete)(small);
+
+    size_t size = argc > 1 ? (size_t) atoll(argv[1]) : (size_t) 1 << 22;
+    Array(int64_t) * values = Array(int64_t, new)(size);
+    uint64_t seed = 5;
+    for (size_t i = 0; i < size; i++) values->data[i] = (int64_t) (next_random(&seed) % 1000);
+
+    double start = seconds();
+    tree = FenwickTree(int64_t, from_array)(values);
+    printf("%zu elements, built in %.1f ms\n", size, (seconds() - start) * 1e3);
+
+    // One update, then one range sum, as a mutable Array would be used.
+    size_t rounds = 1000000, loop_rounds = 200;
+    int64_t checksum = 0;
+    start = seconds();
+    for (size_t r = 0; r < rounds; r++) {
+        size_t index = next_random(&seed) % size;
+        size_t a = next_random(&seed) % size, b = next_random(&seed) % size;
+        values->data[index] += 1;
+        FenwickTree(int64_t, add)(tree, index, 1);
+        checksum += FenwickTree(int64_t, sum)(tree, a < b ? a : b, (a < b ? b : a) + 1);
+    }
+    double tree_time = (seconds() - start) / rounds;
+
+    bool agree = true;
+    start = seconds();
+    for (size_t r = 0; r < loop_rounds; r++) {
+        size_t index = next_random(&seed) % size;
+        size_t a = next_random(&seed) % size, b = next_random(&seed) % size;
+        if (a > b) { size_t swap = a; a = b; b = swap; }
+        values->data[index] += 1;
+        FenwickTree(int64_t, add)(tree, index, 1);
+        int64_t total = 0;
+        for (size_t i = a; i <= b; i++) total += values->data[i];
+        agree = agree and total == FenwickTree(int64_t, sum)(tree, a, b + 1);
+    }
+    double loop_time = (seconds() - start) / loop_rounds;
+
+    printf("update + range sum, Array loop: %10.1f ns\n", loop_time * 1e9);
+    printf("update + range sum, Fenwick:    %10.1f ns, sums %s (checksum %lld)\n",
+        tree_time * 1e9, agree ? "agree" : "differ", (long long) checksum);
+
+    // Batches: one by one below the threshold, unfold and rebuild above it.
+    for (size_t count = 1024; count <= size; count *= 16) {
+        size_t * indices = malloc(count * sizeof(size_t));
+        int64_t * deltas = malloc(count * sizeof(int64_t));
+        for (size_t k = 0; k < count; k++) {
+            indices[k] = next_random(&seed) % size;
+            deltas[k] = 1;
+        }
+
+        start = seconds();
+        for (size_t k = 0; k < count; k++) FenwickTree(int64_t, add)(tree, indices[k], deltas[k]);
+        double single = seconds() - start;
+
+        start = seconds();
+        FenwickTree(int64_t, add_all)(tree, indices, deltas, count);
+        double batch = seconds() - start;
+
+        printf("%8zu updates: one by one %8.2f ms, add_all %8.2f ms\n",
+            count, single * 1e3, batch * 1e3);
+        free(indices);
+        free(deltas);
+    }
+
+    FenwickTree(int64_t, delete)(tree);
+    Array(int64_t, delete)(values);
+    return 0;
+
+}
@@ -0,0 +1,624 @@
+// =============
+// FlatMap<K, V>
+// =============
+//
+// :Author: RickBarretto
+// :Year: 2026
+// :License: MPL 2.0
+// :Copyright: RickBarretto, 2026
+// :Version: 1.0
+//
+// ``FlatMap<K, V>`` is an ordered map for read-mostly data, such as
+// configuration and routing tables. Entries live in two sorted Arrays,
+// one of keys and one of values, so a lookup is a binary search over
+// densely packed keys, with no pointer to chase.
+//
+// Updates to existing keys are written in place. New keys and removals
+// of merged keys go to a small sorted tail instead, which is merged
+// into the Arrays in one O(n) pass once it fills up. The tail holds
+// about sqrt(n) entries, at least FLATMAP_TAIL, so inserts cost about
+// sqrt(n) moves each, and a lookup binary searches it before the Arrays,
+// in O(log n) either way. ``flush`` merges it early, e.g. after loading
+// a batch of updates.
+//
+// How to Use
+// ----------
+//
+// Include ``Array<K>`` and ``Array<V>`` first,
+// then this header after defining K, V, PRINT_K and PRINT_V:
+//
+//      #define K int64_t
+//      #define V size_t
+//      #define PRINT_K(key) printf("%lld", (long long) key)
+//      #define PRINT_V(value) printf("%zu", value)
+//      #include "flat_map.h"
+//
+// For string keys:
+//
+//      #define LESS_K(a, b) (strcmp(a, b) < 0)
+//      #define EQ_K(a, b) (strcmp(a, b) == 0)
+//
+// Each function is namespaced under FlatMap<K, V>,
+// i.e. ``FlatMap(int64_t, size_t, get)`` is the same as
+// ``FlatMap_int64_t_size_t_get``.
+//
+//      FlatMap(int64_t, size_t) * map = FlatMap(int64_t, size_t, new)();
+//      FlatMap(int64_t, size_t, set)(map, 42, 7);
+//      size_t * value = FlatMap(int64_t, size_t, get)(map, 42);
+//
+//      size_t cursor = 0;
+//      int64_t * key;
+//      while (FlatMap(int64_t, size_t, next)(map, &cursor, &key, &value)) { ... }
+//
+
+// =~=~=~=~=~=~=~=~ Imports ~=~=~=~=~=~=~=~=
+
+#include <iso646.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+// =~=~=~=~=~=~=~=~ Helper Macros ~=~=~=~=~=~=~=~=
+
+#define _CAT(X, Y) X ## _ ## Y
+#define CAT(X, Y) _CAT(X, Y)
+#define _CAT3(X, Y, Z) X ## _ ## Y ## _ ## Z
+#define CAT3(X, Y, Z) _CAT3(X, Y, Z)
+
+#define STRINGIFY(x) #x
+#define TOSTRING(x) STRINGIFY(x)
+
+#define ensure(COND, VAL) if (not (COND)) return VAL
+
+
+// =~=~=~=~=~=~=~=~ Shared helpers ~=~=~=~=~=~=~=~=
+
+#ifndef FLATMAP_HELPERS
+#define FLATMAP_HELPERS
+
+// FLATMAP_TAIL: Smallest capacity of the tail, in entries.
+#ifndef FLATMAP_TAIL
+#define FLATMAP_TAIL 32
+#endif
+
+// Tail capacity for ``merged`` entries: a power of two near sqrt(merged).
+size_t _FlatMap_tail(size_t merged) {
+    size_t capacity = FLATMAP_TAIL;
+    while (capacity * capacity < merged) capacity <<= 1;
+    return capacity;
+}
+
+#endif
+
+
+// =~=~=~=~=~=~=~=~ Implementation ~=~=~=~=~=~=~=~=
+
+// K: Key type of the FlatMap<K, V>
+#ifndef K
+#error "K is not defined"
+#endif
+
+// V: Value type of the FlatMap<K, V>
+#ifndef V
+#error "V is not defined"
+#endif
+
+// PRINT_K: (K) -> void
+//
+// PRINT_K is a macro that defines how to print a key of type K.
+// See ``Array<T>`` PRINT_T for more details.
+//
+#ifndef PRINT_K
+#error "PRINT_K is not defined"
+#endif
+
+// PRINT_V: (V) -> void
+//
+// PRINT_V is a macro that defines how to print a value of type V.
+//
+#ifndef PRINT_V
+#error "PRINT_V is not defined"
+#endif
+
+// LESS_K: (K, K) -> bool
+//
+// Optional. Defaults to ``<``.
+//
+#ifndef LESS_K
+#define LESS_K(a, b) ((a) < (b))
+#endif
+
+// EQ_K: (K, K) -> bool
+//
+// Optional. Defaults to ``==``, used to match removals on a merge.
+//
+#ifndef EQ_K
+#define EQ_K(a, b) ((a) == (b))
+#endif
+
+#define MODULE FlatMap
+#define Self CAT3(MODULE, K, V)
+#define fn(NAME) CAT(Self, NAME)
+
+#define _FLATMAP_SELECT_MACRO(_1, _2, _3, NAME, ...) NAME
+#define FlatMap(...) _FLATMAP_SELECT_MACRO(__VA_ARGS__, FlatMap3, FlatMap2)(__VA_ARGS__)
+#define FlatMap2(K, V) CAT3(FlatMap, K, V)
+#define FlatMap3(K, V, FUNC) CAT(CAT3(FlatMap, K, V), FUNC)
+
+typedef struct {
+    Array(K) * keys;            // sorted, the merged entries
+    Array(V) * values;
+    K * tail_keys;              // sorted, each key at most once
+    V * tail_values;
+    bool * tail_removed;        // a removal of a merged key
+    size_t _size;               // live entries
+    size_t _tail;
+    size_t _tail_capacity;
+} Self;
+
+typedef struct {
+    K key;
+    V value;
+    bool removed;
+} fn(_Entry);
+
+
+// ~~~~~~~~ Search ~~~~~~~~
+
+// Number of merged keys strictly below ``key``, without branches:
+// the halving step compiles to a conditional move, and both candidates
+// for the next probe are prefetched, since the CPU can no longer guess.
+size_t fn(_lower)(const Self * map, K key) {
+    size_t size = Array(K, size)(map->keys);
+    ensure(size > 0, 0);
+
+    const K * base = map->keys->data;
+    while (size > 1) {
+        size_t half = size / 2;
+        __builtin_prefetch(base + half / 2);
+        __builtin_prefetch(base + half + half / 2);
+        base = LESS_K(base[half], key) ? base + half : base;
+        size -= half;
+    }
+    return (size_t) (base - map->keys->data) + LESS_K(*base, key);
+}
+
+// Index of the merged ``key``, or SIZE_MAX when absent.
+size_t fn(_find)(const Self * map, K key) {
+    size_t at = fn(_lower)(map, key);
+    ensure(at < Array(K, size)(map->keys) and not LESS_K(key, map->keys->data[at]), SIZE_MAX);
+    return at;
+}
+
+// Number of tail keys strictly below ``key``, branchless as ``_lower``.
+size_t fn(_tail_lower)(const Self * map, K key) {
+    size_t size = map->_tail;
+    ensure(size > 0, 0);
+
+    const K * base = map->tail_keys;
+    while (size > 1) {
+        size_t half = size / 2;
+        base = LESS_K(base[half], key) ? base + half : base;
+        size -= half;
+    }
+    return (size_t) (base - map->tail_keys) + LESS_K(*base, key);
+}
+
+// Whether the tail slot ``slot``, from ``_tail_lower``, holds ``key``.
+bool fn(_tail_holds)(const Self * map, size_t slot, K key) {
+    return slot < map->_tail and not LESS_K(key, map->tail_keys[slot]);
+}
+
+// Opens the tail slot ``slot`` for an entry, keeping the tail sorted.
+void fn(_tail_insert)(Self * map, size_t slot, K key, V value, bool removed) {
+    size_t moved = map->_tail - slot;
+    memmove(map->tail_keys + slot + 1, map->tail_keys + slot, moved * sizeof(K));
+    memmove(map->tail_values + slot + 1, map->tail_values + slot, moved * sizeof(V));
+    memmove(map->tail_removed + slot + 1, map->tail_removed + slot, moved * sizeof(bool));
+    map->tail_keys[slot] = key;
+    map->tail_values[slot] = value;
+    map->tail_removed[slot] = removed;
+    map->_tail++;
+}
+
+// Closes the tail slot ``slot``, keeping the tail sorted.
+void fn(_tail_drop)(Self * map, size_t slot) {
+    size_t moved = --map->_tail - slot;
+    memmove(map->tail_keys + slot, map->tail_keys + slot + 1, moved * sizeof(K));
+    memmove(map->tail_values + slot, map->tail_values + slot + 1, moved * sizeof(V));
+    memmove(map->tail_removed + slot, map->tail_removed + slot + 1, moved * sizeof(bool));
+}
+
+// Grows the tail buffers; they never shrink.
+bool fn(_tail_reserve)(Self * map, size_t capacity) {
+    ensure(capacity > map->_tail_capacity, true);
+
+    K * keys = ARRAY_REALLOC(map->tail_keys, capacity * sizeof(K));
+    if (keys) map->tail_keys = keys;
+    V * values = ARRAY_REALLOC(map->tail_values, capacity * sizeof(V));
+    if (values) map->tail_values = values;
+    bool * removed = ARRAY_REALLOC(map->tail_removed, capacity * sizeof(bool));
+    if (removed) map->tail_removed = removed;
+
+    // A partial failure leaves some buffers larger, which is harmless.
+    ensure(keys and values and removed, false);
+    map->_tail_capacity = capacity;
+    return true;
+}
+
+
+// ~~~~~~~~ Lifetime ~~~~~~~~
+
+// FlatMap >> delete(map: *FlatMap<K, V>) -> bool
+//
+// Safely deletes the map.
+//
+// Returns
+// -------
+// bool: Returns true on success.
+//
+bool fn(delete)(Self * map) {
+    ensure(map, false);
+
+    Array(K, delete)(map->keys);
+    Array(V, delete)(map->values);
+    ARRAY_FREE(map->tail_keys);
+    ARRAY_FREE(map->tail_values);
+    ARRAY_FREE(map->tail_removed);
+    ARRAY_FREE(map);
+    return true;
+}
+
+// FlatMap >> new() -> *FlatMap<K, V>
+//
+// Creates an empty map.
+//
+// Returns
+// -------
+// *FlatMap<K, V>: A pointer to the new map, or NULL on failure.
+//
+Self * fn(new)() {
+    Self * map = ARRAY_MALLOC(sizeof(Self));
+    ensure(map, NULL);
+
+    map->keys = Array(K, new)(0);
+    map->values = Array(V, new)(0);
+    map->tail_keys = NULL;
+    map->tail_values = NULL;
+    map->tail_removed = NULL;
+    map->_size = 0;
+    map->_tail = 0;
+    map->_tail_capacity = 0;
+
+    if (not map->keys or not map->values or not fn(_tail_reserve)(map, FLATMAP_TAIL)) {
+        fn(delete)(map);
+        return NULL;
+    }
+    return map;
+}
+
+// FlatMap >> from_sorted(keys: *Array<K>, values: *Array<V>) -> *FlatMap<K, V>
+//
+// Creates a map from strictly increasing keys, copying both Arrays.
+//
+// Parameters
+// ----------
+// keys : *Array<K>
+//     The keys, strictly increasing.
+// values : *Array<V>
+//     The value of each key, as many as the keys.
+//
+// Returns
+// -------
+// *FlatMap<K, V>: The new map, or NULL on mismatching sizes,
+//                 unsorted keys or a failed allocation.
+//
+Self * fn(from_sorted)(Array(K) * keys, Array(V) * values) {
+    ensure(keys and values, NULL);
+
+    size_t size = Array(K, size)(keys);
+    ensure(size == Array(V, size)(values), NULL);
+    for (size_t i = 1; i < size; i++) ensure(LESS_K(keys->data[i - 1], keys->data[i]), NULL);
+
+    Self * map = fn(new)();
+    ensure(map, NULL);
+
+    if (not Array(K, resize)(map->keys, size) or not Array(V, resize)(map->values, size)
+        or not fn(_tail_reserve)(map, _FlatMap_tail(size))) {
+        fn(delete)(map);
+        return NULL;
+    }
+
+    memcpy(map->keys->data, keys->data, size * sizeof(K));
+    memcpy(map->values->data, values->data, size * sizeof(V));
+    map->_size = size;
+    return map;
+}
+
+// FlatMap >> size(map: *FlatMap<K, V>) -> size_t
+//
+// Returns the number of entries, merged or not.
+//
+size_t fn(size)(Self * map) {
+    ensure(map, 0);
+    return map->_size;
+}
+
+// FlatMap >> flush(map: *FlatMap<K, V>) -> bool
+//
+// Merges the tail into the sorted Arrays, in O(n + t):
+// removals are compacted out first, then the new keys are merged
+// in from the back, so no entry moves twice and no copy is made.
+//
+// Returns
+// -------
+// bool: Returns true on success. On failure, the removals are applied
+//       and the new keys stay in the tail.
+//
+bool fn(flush)(Self * map) {
+    ensure(map, false);
+    ensure(map->_tail > 0, true);
+
+    size_t count = map->_tail;
+    fn(_Entry) * entries = ARRAY_MALLOC(count * sizeof(fn(_Entry)));
+    ensure(entries, false);
+
+    for (size_t i = 0; i < count; i++)
+        entries[i] = (fn(_Entry)) { map->tail_keys[i], map->tail_values[i], map->tail_removed[i] };
+
+    // Removals: every one names a merged key, walked in the same order.
+    K * keys = map->keys->data;
+    V * values = map->values->data;
+    size_t merged = Array(K, size)(map->keys), kept = 0, inserts = 0;
+    size_t removal = 0;
+    while (removal < count and not entries[removal].removed) removal++;
+    for (size_t i = 0; i < merged; i++) {
+        if (removal < count and EQ_K(keys[i], entries[removal].key)) {
+            do removal++; while (removal < count and not entries[removal].removed);
+            continue;
+        }
+        keys[kept] = keys[i];
+        values[kept] = values[i];
+        kept++;
+    }
+
+    map->_tail = 0;
+    for (size_t i = 0; i < count; i++) {
+        if (entries[i].removed) continue;
+        inserts++;
+        map->tail_keys[map->_tail] = entries[i].key;
+        map->tail_values[map->_tail] = entries[i].value;
+        map->tail_removed[map->_tail++] = false;
+    }
+
+    bool grown = Array(K, resize)(map->keys, kept + inserts);
+    grown = grown and Array(V, resize)(map->values, kept + inserts);
+    if (not grown) {
+        Array(K, resize)(map->keys, kept);
+        Array(V, resize)(map->values, kept);
+        ARRAY_FREE(entries);
+        return false;
+    }
+
+    // Insertions: merged from the back into the grown Arrays.
+    keys = map->keys->data;
+    values = map->values->data;
+    size_t read = kept, write = kept + inserts;
+    for (size_t i = count; i-- > 0;) {
+        if (entries[i].removed) continue;
+        while (read > 0 and LESS_K(entries[i].key, keys[read - 1])) {
+            write--; read--;
+            keys[write] = keys[read];
+            values[write] = values[read];
+        }
+        write--;
+        keys[write] = entries[i].key;
+        values[write] = entries[i].value;
+    }
+
+    map->_tail = 0;
+    ARRAY_FREE(entries);
+    fn(_tail_reserve)(map, _FlatMap_tail(kept + inserts));
+    return true;
+}
+
+
+// ~~~~~~~~ Lookup and Updates ~~~~~~~~
+
+// FlatMap >> get(map: *FlatMap<K, V>, key: K) -> *V
+//
+// Looks a key up, in the tail first, then in the sorted keys.
+//
+// Returns
+// -------
+// *V: A pointer to the value, valid until the next ``set`` or ``remove``.
+//     If the key is absent, returns NULL.
+//
+V * fn(get)(Self * map, K key) {
+    ensure(map, NULL);
+
+    if (map->_tail) {
+        size_t slot = fn(_tail_lower)(map, key);
+        if (fn(_tail_holds)(map, slot, key)) return map->tail_removed[slot] ? NULL : &map->tail_values[slot];
+    }
+
+    size_t at = fn(_find)(map, key);
+    ensure(at != SIZE_MAX, NULL);
+    return &map->values->data[at];
+}
+
+// FlatMap >> contains(map: *FlatMap<K, V>, key: K) -> bool
+//
+// Returns true if the key is in the map.
+//
+bool fn(contains)(Self * map, K key) {
+    return fn(get)(map, key) != NULL;
+}
+
+// FlatMap >> set(map: *FlatMap<K, V>, key: K, value: V) -> bool
+//
+// Inserts or overwrites an entry. Existing keys are updated in place,
+// new ones go to the tail, which is merged first if it is full.
+//
+// Returns
+// -------
+// bool: Returns true on success, false if the merge failed.
+//
+bool fn(set)(Self * map, K key, V value) {
+    ensure(map, false);
+
+    size_t slot = fn(_tail_lower)(map, key);
+    bool held = fn(_tail_holds)(map, slot, key);
+    if (held and not map->tail_removed[slot]) {
+        map->tail_values[slot] = value;
+        return true;
+    }
+
+    size_t at = fn(_find)(map, key);
+    if (at != SIZE_MAX) {
+        // A removed merged key comes back by dropping its removal.
+        if (held) {
+            fn(_tail_drop)(map, slot);
+            map->_size++;
+        }
+        map->values->data[at] = value;
+        return true;
+    }
+
+    if (map->_tail == map->_tail_capacity) {
+        ensure(fn(flush)(map), false);
+        slot = fn(_tail_lower)(map, key);
+    }
+    fn(_tail_insert)(map, slot, key, value, false);
+    map->_size++;
+    return true;
+}
+
+// FlatMap >> remove(map: *FlatMap<K, V>, key: K) -> bool
+//
+// Removes an entry. A key still in the tail is dropped from it,
+// a merged one is marked in the tail and compacted out on the next merge.
+//
+// Returns
+// -------
+// bool: Returns true on success, false if the key is missing
+//       or the merge failed.
+//
+bool fn(remove)(Self * map, K key) {
+    ensure(map, false);
+
+    size_t slot = fn(_tail_lower)(map, key);
+    if (fn(_tail_holds)(map, slot, key)) {
+        ensure(not map->tail_removed[slot], false);
+        fn(_tail_drop)(map, slot);
+        map->_size--;
+        return true;
+    }
+
+    size_t at = fn(_find)(map, key);
+    ensure(at != SIZE_MAX, false);
+    if (map->_tail == map->_tail_capacity) {
+        ensure(fn(flush)(map), false);
+        at = fn(_find)(map, key);
+        slot = fn(_tail_lower)(map, key);
+    }
+    fn(_tail_insert)(map, slot, key, map->values->data[at], true);
+    map->_size--;
+    return true;
+}
+
+
+// ~~~~~~~~ Iteration ~~~~~~~~
+
+// FlatMap >> next(map: *FlatMap<K, V>, cursor: *size_t, key: **K, value: **V) -> bool
+//
+// Iterates over the entries, in key order. ``cursor`` must start at 0,
+// which merges the tail first. The map must not change meanwhile.
+//
+// Returns
+// -------
+// bool: Returns true and points ``key`` and ``value`` at the next entry,
+//       or false once every entry was visited or the merge failed.
+//
+bool fn(next)(Self * map, size_t * cursor, K ** key, V ** value) {
+    ensure(map and cursor, false);
+    if (*cursor == 0) ensure(fn(flush)(map), false);
+    ensure(*cursor < Array(K, size)(map->keys), false);
+
+    if (key) *key = &map->keys->data[*cursor];
+    if (value) *value = &map->values->data[*cursor];
+    (*cursor)++;
+    return true;
+}
+
+
+// ~~~~~~~~ Printing ~~~~~~~~
+
+// FlatMap >> print(map: *FlatMap<K, V>) -> void
+//
+// Prints the entries on terminal, in key order. Merges the tail first.
+//
+void fn(print)(Self * map) {
+    ensure(map,);
+
+    size_t cursor = 0, printed = 0;
+    K * key;
+    V * value;
+
+    printf("{");
+    while (fn(next)(map, &cursor, &key, &value)) {
+        PRINT_K(*key);
+        printf(": ");
+        PRINT_V(*value);
+        if (++printed < map->_size) printf(", ");
+    }
+    printf("}");
+}
+
+// FlatMap >> println(map: *FlatMap<K, V>) -> void
+//
+// Prints the entries on terminal followed by a newline.
+//
+void fn(println)(Self * map) {
+    fn(print)(map);
+    printf("\n");
+}
+
+// FlatMap >> debug(map: *FlatMap<K, V>) -> void
+//
+// Prints the debug representation of the map, without merging the tail.
+//
+void fn(debug)(Self * map) {
+    if (not map) {
+        printf("FlatMap<%s, %s> { NULL }\n", TOSTRING(K), TOSTRING(V));
+        return;
+    }
+
+    printf("FlatMap<%s, %s> {\n", TOSTRING(K), TOSTRING(V));
+    printf("  size: %zu,\n", map->_size);
+    printf("  merged: %zu,\n", Array(K, size)(map->keys));
+    printf("  tail: %zu,\n", map->_tail);
+    printf("  tail_capacity: %zu,\n", map->_tail_capacity);
+    printf("  keys: "); Array(K, println)(map->keys);
+    printf("  tail_keys: [");
+    for (size_t i = 0; i < map->_tail; i++) {
+        if (map->tail_removed[i]) printf("-");
+        PRINT_K(map->tail_keys[i]);
+        if (i + 1 < map->_tail) printf(", ");
+    }
+    printf("],\n");
+    printf("}\n");
+}
+
+#undef MODULE
+#undef Self
+#undef fn
+#undef K
+#undef V
+#undef PRINT_K
+#undef PRINT_V
+#undef LESS_K
+#undef EQ_K
@@ -0,0 +1,129 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdint.h>
+#include <stdio.h>
+#include <time.h>
+
+#define T int64_t
+#define PRINT_T(value) printf("%lld", (long long) value)
+#include "../array/array.h"
+
+#define T size_t
+#define PRINT_T(value) printf("%zu", value)
+#include "../array/array.h"
+
+#define K int64_t
+#define V size_t
+#define PRINT_K(key) printf("%lld", (long long) key)
+#define PRINT_V(value) printf("%zu", value)
+#include "flat_map.h"
+
+#define K int64_t
+#define V size_t
+#define PRINT_K(key) printf("%lld", (long long) key)
+#define PRINT_V(value) printf("%zu", value)
+#include "../btree/btree.h"
+
+#define K int64_t
+#define V size_t
+#define PRINT_K(key) printf("%lld", (long long) key)
+#define PRINT_V(value) printf("%zu", value)
+#include "../hashmap/hashmap.h"
+
+// Usage: ./main [size], defaults to 2^20 entries.
+
+double seconds() {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec + now.tv_nsec * 1e-9;
+}
+
+uint64_t next_random(uint64_t * seed) {
+    *seed = *seed * 6364136223846793005ull + 1442695040888963407ull;
+    return *seed >> 32;
+}
+
+// Times random lookups, hit or miss, in ns each, counting the hits.
+#define LOOKUPS(GET, MAP, SPAN, HITS, NANOSECONDS) do {                     \
+    uint64_t stream = 5;                                                    \
+    double start = seconds();                                               \
+    for (size_t i = 0; i < 4000000; i++)                                    \
+        HITS += GET(MAP, (int64_t) (next_random(&stream) % (SPAN))) != NULL; \
+    NANOSECONDS = (seconds() - start) / 4000000 * 1e9;                      \
+} while (0)
+
+int main(int argc, char ** argv) {
+
+    FlatMap(int64_t, size_t) * small = FlatMap(int64_t, size_t, new)();
+    for (int64_t key = 10; key > 0; key--) FlatMap(int64_t, size_t, set)(small, key * 3, (size_t) key);
+    FlatMap(int64_t, size_t, flush)(small);
+    FlatMap(int64_t, size_t, remove)(small, 15);
+    FlatMap(int64_t, size_t, set)(small, 16, 0);
+    FlatMap(int64_t, size_t, debug)(small);
+    FlatMap(int64_t, size_t, println)(small);
+    printf("\n");
+    FlatMap(int64_t, size_t, delete)(small);
+
+    // Distinct, sorted random keys, spaced so half the lookups miss.
+    size_t size = argc > 1 ? (size_t) atoll(argv[1]) : (size_t) 1 << 20;
+    Array(int64_t) * keys = Array(int64_t, new)(size);
+    Array(size_t) * values = Array(size_t, new)(size);
+    uint64_t seed = 21;
+    for (size_t i = 0; i < size; i++) {
+        keys->data[i] = (int64_t) (i * 32 + next_random(&seed) % 16);
+        values->data[i] = i;
+    }
+    int64_t span = (int64_t) size * 32;
+
+    FlatMap(int64_t, size_t) * map = FlatMap(int64_t, size_t, from_sorted)(keys, values);
+    BTree(int64_t, size_t) * tree = BTree(int64_t, size_t, from_sorted)(keys, values);
+    HashMap(int64_t, size_t) * hash = HashMap(int64_t, size_t, new)(size);
+    for (size_t i = 0; i < size; i++) HashMap(int64_t, size_t, set)(hash, keys->data[i], i);
+
+    size_t map_hits = 0, tree_hits = 0, hash_hits = 0;
+    double map_lookup, tree_lookup, hash_lookup;
+    LOOKUPS(FlatMap(int64_t, size_t, get), map, span, map_hits, map_lookup);
+    LOOKUPS(BTree(int64_t, size_t, get), tree, span, tree_hits, tree_lookup);
+    LOOKUPS(HashMap(int64_t, size_t, get), hash, span, hash_hits, hash_lookup);
+    printf("%zu entries\n", size);
+    printf("lookup: flat map %6.1f ns, btree %6.1f ns, hash map %6.1f ns, hits %s\n",
+        map_lookup, tree_lookup, hash_lookup,
+        map_hits == tree_hits and tree_hits == hash_hits ? "agree" : "differ");
+
+    // Inserts of new keys, merged in batches.
+    size_t inserts = size / 4;
+    uint64_t stream = seed;
+    double start = seconds();
+    for (size_t i = 0; i < inserts; i++)
+        FlatMap(int64_t, size_t, set)(map, (int64_t) (next_random(&seed) % span) | 16, i);
+    double map_insert = (seconds() - start) / inserts;
+
+    seed = stream;
+    start = seconds();
+    for (size_t i = 0; i < inserts; i++)
+        BTree(int64_t, size_t, set)(tree, (int64_t) (next_random(&seed) % span) | 16, i);
+    double tree_insert = (seconds() - start) / inserts;
+    printf("insert: flat map %6.1f ns, btree %6.1f ns (%zu keys)\n",
+        map_insert * 1e9, tree_insert * 1e9, inserts);
+
+    // Lookups with a pending tail, then after merging it.
+    size_t pending_hits = 0, flushed_hits = 0;
+    double pending_lookup, flushed_lookup;
+    size_t pending = map->_tail;
+    LOOKUPS(FlatMap(int64_t, size_t, get), map, span, pending_hits, pending_lookup);
+    start = seconds();
+    FlatMap(int64_t, size_t, flush)(map);
+    double flush_time = seconds() - start;
+    LOOKUPS(FlatMap(int64_t, size_t, get), map, span, flushed_hits, flushed_lookup);
+    printf("lookup: flat map %6.1f ns with %zu keys in the tail, %6.1f ns merged (%.1f ms), hits %s\n",
+        pending_lookup, pending, flushed_lookup, flush_time * 1e3,
+        pending_hits == flushed_hits ? "agree" : "differ");
+
+    FlatMap(int64_t, size_t, delete)(map);
+    BTree(int64_t, size_t, delete)(tree);
+    HashMap(int64_t, size_t, delete)(hash);
+    Array(int64_t, delete)(keys);
+    Array(size_t, delete)(values);
+    return 0;
+
+}
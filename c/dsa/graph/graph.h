@@ -0,0 +1,804 @@
+// =====
+// Graph
+// =====
+//
+// :Author: RickBarretto
+// :Year: 2026
+// :License: MPL 2.0
+// :Copyright: RickBarretto, 2026
+// :Version: 1.0
+//
+// ``Graph`` is a static graph in compressed sparse row (CSR) form:
+// the neighbors of vertex ``v`` are ``targets[offsets[v] .. offsets[v + 1])``.
+// Vertices are ``uint32_t`` ids in [0, vertices). Directed graphs also
+// keep the reverse CSR (in-edges); undirected graphs store every edge
+// in both directions and share one CSR for both.
+//
+// Kernels, all running on a ``ThreadPool``:
+//
+// - ``bfs``: direction-optimizing breadth-first search. It expands the
+//   frontier top-down (frontier to neighbors) while the frontier is small,
+//   and switches to bottom-up (unvisited vertices look for a parent in a
+//   frontier bitmap) when the frontier's edges outnumber
+//   1 / GRAPH_ALPHA of the unexplored ones, and back when the frontier
+//   shrinks under 1 / GRAPH_BETA of the vertices.
+// - ``pagerank``: pull-based power iteration, balanced by in-edges.
+// - ``components``: weakly connected components, hooking roots
+//   with compare-and-swap then compressing paths.
+//
+// ``rmat`` generates the usual Graph500-like synthetic graphs.
+//
+// How to Use
+// ----------
+//
+// Include ``Array<size_t>``, ``Array<uint32_t>`` and ``Array<double>``
+// first, then this header:
+//
+//      #define T size_t
+//      #define PRINT_T(value) printf("%zu", value)
+//      #include "../array/array.h"
+//
+//      #define T uint32_t
+//      #define PRINT_T(value) printf("%u", value)
+//      #include "../array/array.h"
+//
+//      #define T double
+//      #define PRINT_T(value) printf("%g", value)
+//      #include "../array/array.h"
+//
+//      #include "graph.h"
+//
+// And a common way to use it would be:
+//
+//      Graph * graph = Graph_new(vertices, sources, targets, true);
+//      Array(uint32_t) * depth = Graph_bfs(graph, 0, pool);
+//      Array(double) * rank = Graph_pagerank(graph, 0.85, 1e-6, 100, pool);
+//      Array(uint32_t) * component = Graph_components(graph, pool);
+//
+// Link with ``-pthread``.
+//
+
+#ifndef GRAPH_H
+#define GRAPH_H
+
+// =~=~=~=~=~=~=~=~ Imports ~=~=~=~=~=~=~=~=
+
+#include <iso646.h>
+#include <math.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../thread_pool/thread_pool.h"
+
+
+// =~=~=~=~=~=~=~=~ Helper Macros ~=~=~=~=~=~=~=~=
+
+#define ensure(COND, VAL) if (not (COND)) return VAL
+
+
+// =~=~=~=~=~=~=~=~ Implementation ~=~=~=~=~=~=~=~=
+
+// GRAPH_UNREACHED: Depth of the vertices BFS did not reach.
+#define GRAPH_UNREACHED UINT32_MAX
+
+// GRAPH_ALPHA, GRAPH_BETA: Direction switching thresholds of BFS.
+#define GRAPH_ALPHA 14
+#define GRAPH_BETA 24
+
+// GRAPH_CHUNK: Vertices per task in vertex-parallel loops, a multiple of 64.
+#define GRAPH_CHUNK 4096
+
+// GRAPH_LOCAL: Size of the per-task buffer of top-down BFS.
+#define GRAPH_LOCAL 256
+
+// GRAPH_TASKS_PER_WORKER: Tasks per worker for edge-balanced loops.
+#define GRAPH_TASKS_PER_WORKER 4
+
+typedef struct {
+    size_t _vertices;
+    size_t _edges;              // stored arcs, twice the edges if undirected
+    bool _undirected;
+    Array(size_t) * offsets;
+    Array(uint32_t) * targets;
+    Array(size_t) * in_offsets; // the same Arrays when undirected
+    Array(uint32_t) * in_sources;
+} Graph;
+
+// Counting sort of the arcs by ``from``, both ways if ``both``.
+bool _Graph_csr(size_t vertices, const uint32_t * from, const uint32_t * to, size_t edges,
+                bool both, Array(size_t) ** offsets_out, Array(uint32_t) ** targets_out) {
+    Array(size_t) * offsets = Array(size_t, new)(vertices + 1);
+    Array(uint32_t) * targets = Array(uint32_t, new)(both ? 2 * edges : edges);
+    if (not offsets or not targets) {
+        Array(size_t, delete)(offsets);
+        Array(uint32_t, delete)(targets);
+        return false;
+    }
+
+    size_t * offset = offsets->data;
+    for (size_t i = 0; i < edges; i++) {
+        offset[from[i] + 1]++;
+        if (both) offset[to[i] + 1]++;
+    }
+    for (size_t v = 0; v < vertices; v++) offset[v + 1] += offset[v];
+
+    for (size_t i = 0; i < edges; i++) {
+        targets->data[offset[from[i]]++] = to[i];
+        if (both) targets->data[offset[to[i]]++] = from[i];
+    }
+    for (size_t v = vertices; v > 0; v--) offset[v] = offset[v - 1];
+    offset[0] = 0;
+
+    *offsets_out = offsets;
+    *targets_out = targets;
+    return true;
+}
+
+// Graph >> delete(graph: *Graph) -> bool
+//
+// Safely deletes the graph and its Arrays.
+//
+// Returns
+// -------
+// bool: Returns true on success.
+//
+bool Graph_delete(Graph * graph) {
+    ensure(graph, false);
+
+    if (not graph->_undirected) {
+        Array(size_t, delete)(graph->in_offsets);
+        Array(uint32_t, delete)(graph->in_sources);
+    }
+    Array(size_t, delete)(graph->offsets);
+    Array(uint32_t, delete)(graph->targets);
+    ARRAY_FREE(graph);
+    return true;
+}
+
+// Graph >> new(vertices: size_t, sources: *Array<uint32_t>, targets: *Array<uint32_t>,
+//              undirected: bool) -> *Graph
+//
+// Builds a graph from an edge list. The edge Arrays are not modified.
+//
+// Parameters
+// ----------
+// vertices : size_t
+//     The number of vertices, less than 2^32 - 1.
+// sources, targets : *Array<uint32_t>
+//     Edge ``i`` goes from ``sources[i]`` to ``targets[i]``.
+// undirected : bool
+//     Whether every edge goes both ways.
+//
+// Returns
+// -------
+// *Graph: The new graph, or NULL on mismatching sizes,
+//     out of range vertices or failure.
+//
+Graph * Graph_new(size_t vertices, Array(uint32_t) * sources, Array(uint32_t) * targets,
+                  bool undirected) {
+    ensure(sources and targets and vertices < GRAPH_UNREACHED, NULL);
+
+    size_t edges = Array(uint32_t, size)(sources);
+    ensure(Array(uint32_t, size)(targets) == edges, NULL);
+    for (size_t i = 0; i < edges; i++)
+        ensure(sources->data[i] < vertices and targets->data[i] < vertices, NULL);
+
+    Graph * graph = ARRAY_MALLOC(sizeof(Graph));
+    ensure(graph, NULL);
+    *graph = (Graph) { ._vertices = vertices, ._undirected = undirected };
+
+    bool built = _Graph_csr(vertices, sources->data, targets->data, edges, undirected,
+        &graph->offsets, &graph->targets);
+    if (built and undirected) {
+        graph->in_offsets = graph->offsets;
+        graph->in_sources = graph->targets;
+    } else if (built) {
+        built = _Graph_csr(vertices, targets->data, sources->data, edges, false,
+            &graph->in_offsets, &graph->in_sources);
+    }
+
+    if (not built) {
+        graph->_undirected = false;
+        Graph_delete(graph);
+        return NULL;
+    }
+    graph->_edges = Array(uint32_t, size)(graph->targets);
+    return graph;
+}
+
+// Graph >> vertices(graph: *Graph) -> size_t
+//
+// Returns the number of vertices.
+//
+size_t Graph_vertices(Graph * graph) {
+    ensure(graph, 0);
+    return graph->_vertices;
+}
+
+// Graph >> edges(graph: *Graph) -> size_t
+//
+// Returns the number of stored arcs: twice the edges if undirected.
+//
+size_t Graph_edges(Graph * graph) {
+    ensure(graph, 0);
+    return graph->_edges;
+}
+
+// Graph >> degree(graph: *Graph, vertex: uint32_t) -> size_t
+//
+// Returns the out-degree of a vertex, 0 if out of range.
+//
+size_t Graph_degree(Graph * graph, uint32_t vertex) {
+    ensure(graph and vertex < graph->_vertices, 0);
+    return graph->offsets->data[vertex + 1] - graph->offsets->data[vertex];
+}
+
+// Graph >> neighbors(graph: *Graph, vertex: uint32_t, count: *size_t) -> *uint32_t
+//
+// Returns the out-neighbors of a vertex and writes their count.
+//
+// Returns
+// -------
+// *uint32_t: The first neighbor, or NULL if out of range.
+//
+const uint32_t * Graph_neighbors(Graph * graph, uint32_t vertex, size_t * count) {
+    ensure(graph and count and vertex < graph->_vertices, NULL);
+
+    *count = Graph_degree(graph, vertex);
+    return graph->targets->data + graph->offsets->data[vertex];
+}
+
+// First ``v`` in [0, size] with ``offsets[v] >= target``.
+size_t _Graph_lower_bound(const size_t * offsets, size_t size, size_t target) {
+    size_t low = 0, high = size;
+    while (low < high) {
+        size_t middle = low + (high - low) / 2;
+        if (offsets[middle] < target) low = middle + 1;
+        else high = middle;
+    }
+    return low;
+}
+
+// Vertex range of ``task``, with the same share of arcs for every task.
+void _Graph_balanced(const size_t * offsets, size_t vertices, size_t task, size_t tasks,
+                     size_t * first, size_t * last) {
+    size_t arcs = offsets[vertices];
+    *first = _Graph_lower_bound(offsets, vertices, task * arcs / tasks);
+    *last = task + 1 == tasks
+        ? vertices : _Graph_lower_bound(offsets, vertices, (task + 1) * arcs / tasks);
+}
+
+
+// ~~~~~~~~ BFS ~~~~~~~~
+
+typedef struct {
+    Graph * graph;
+    _Atomic uint32_t * depth;
+    uint32_t level;
+    size_t tasks;
+
+    const uint32_t * frontier;
+    size_t frontier_size;
+    uint32_t * next;
+    atomic_size_t next_size;
+    atomic_size_t next_edges;
+
+    const uint64_t * bitmap;
+    uint64_t * next_bitmap;
+} _GraphBfs;
+
+void _Graph_top_down(void * context, size_t task, size_t worker) {
+    (void) worker;
+    _GraphBfs * job = context;
+
+    const size_t * offsets = job->graph->offsets->data;
+    const uint32_t * targets = job->graph->targets->data;
+    size_t first = task * job->frontier_size / job->tasks;
+    size_t last = (task + 1) * job->frontier_size / job->tasks;
+
+    uint32_t local[GRAPH_LOCAL];
+    size_t count = 0, edges = 0;
+    for (size_t i = first; i < last; i++) {
+        uint32_t u = job->frontier[i];
+        for (size_t e = offsets[u]; e < offsets[u + 1]; e++) {
+            uint32_t v = targets[e];
+            uint32_t unreached = GRAPH_UNREACHED;
+            if (atomic_load_explicit(&job->depth[v], memory_order_relaxed) != GRAPH_UNREACHED
+                or not atomic_compare_exchange_strong_explicit(&job->depth[v], &unreached,
+                    job->level + 1, memory_order_relaxed, memory_order_relaxed))
+                continue;
+
+            edges += offsets[v + 1] - offsets[v];
+            local[count++] = v;
+            if (count == GRAPH_LOCAL) {
+                size_t at = atomic_fetch_add_explicit(&job->next_size, count, memory_order_relaxed);
+                memcpy(job->next + at, local, count * sizeof(uint32_t));
+                count = 0;
+            }
+        }
+    }
+
+    size_t at = atomic_fetch_add_explicit(&job->next_size, count, memory_order_relaxed);
+    memcpy(job->next + at, local, count * sizeof(uint32_t));
+    atomic_fetch_add_explicit(&job->next_edges, edges, memory_order_relaxed);
+}
+
+// Each task owns GRAPH_CHUNK vertices, so whole words of ``next_bitmap``.
+void _Graph_bottom_up(void * context, size_t task, size_t worker) {
+    (void) worker;
+    _GraphBfs * job = context;
+
+    const size_t * in_offsets = job->graph->in_offsets->data;
+    const uint32_t * in_sources = job->graph->in_sources->data;
+    const size_t * offsets = job->graph->offsets->data;
+    size_t first = task * GRAPH_CHUNK;
+    size_t last = first + GRAPH_CHUNK < job->graph->_vertices
+        ? first + GRAPH_CHUNK : job->graph->_vertices;
+
+    size_t count = 0, edges = 0;
+    for (size_t v = first; v < last; v++) {
+        if (atomic_load_explicit(&job->depth[v], memory_order_relaxed) != GRAPH_UNREACHED) continue;
+
+        for (size_t e = in_offsets[v]; e < in_offsets[v + 1]; e++) {
+            uint32_t u = in_sources[e];
+            if (not (job->bitmap[u / 64] >> (u % 64) & 1)) continue;
+
+            atomic_store_explicit(&job->depth[v], job->level + 1, memory_order_relaxed);
+            job->next_bitmap[v / 64] |= (uint64_t) 1 << (v % 64);
+            edges += offsets[v + 1] - offsets[v];
+            count++;
+            break;
+        }
+    }
+
+    atomic_fetch_add_explicit(&job->next_size, count, memory_order_relaxed);
+    atomic_fetch_add_explicit(&job->next_edges, edges, memory_order_relaxed);
+}
+
+Array(uint32_t) * _Graph_bfs(Graph * graph, uint32_t source, ThreadPool * pool, bool optimize) {
+    ensure(graph and source < graph->_vertices, NULL);
+
+    size_t vertices = graph->_vertices;
+    size_t words = (vertices + 63) / 64;
+    _GraphBfs job = { .graph = graph };
+    job.depth = ARRAY_MALLOC(vertices * sizeof(_Atomic uint32_t));
+    uint32_t * frontier = ARRAY_MALLOC(vertices * sizeof(uint32_t));
+    job.next = ARRAY_MALLOC(vertices * sizeof(uint32_t));
+    uint64_t * bitmap = ARRAY_CALLOC(words, sizeof(uint64_t));
+    job.next_bitmap = ARRAY_CALLOC(words, sizeof(uint64_t));
+    Array(uint32_t) * result = Array(uint32_t, new)(vertices);
+
+    if (not job.depth or not frontier or not job.next or not bitmap
+        or not job.next_bitmap or not result) {
+        ARRAY_FREE(job.depth); ARRAY_FREE(frontier); ARRAY_FREE(job.next);
+        ARRAY_FREE(bitmap); ARRAY_FREE(job.next_bitmap);
+        Array(uint32_t, delete)(result);
+        return NULL;
+    }
+
+    for (size_t v = 0; v < vertices; v++) atomic_init(&job.depth[v], GRAPH_UNREACHED);
+    atomic_store(&job.depth[source], 0);
+    frontier[0] = source;
+
+    size_t frontier_size = 1;
+    size_t frontier_edges = Graph_degree(graph, source);
+    size_t unexplored_edges = graph->_edges - frontier_edges;
+    bool top_down = true;
+
+    while (frontier_size > 0) {
+        if (optimize and top_down and frontier_edges > unexplored_edges / GRAPH_ALPHA) {
+            memset(bitmap, 0, words * sizeof(uint64_t));
+            for (size_t i = 0; i < frontier_size; i++)
+                bitmap[frontier[i] / 64] |= (uint64_t) 1 << (frontier[i] % 64);
+            top_down = false;
+        } else if (not top_down and frontier_size < vertices / GRAPH_BETA) {
+            frontier_size = 0;
+            for (size_t word = 0; word < words; word++)
+                for (uint64_t bits = bitmap[word]; bits; bits &= bits - 1)
+                    frontier[frontier_size++] = (uint32_t) (word * 64 + __builtin_ctzll(bits));
+            top_down = true;
+        }
+
+        atomic_store(&job.next_size, 0);
+        atomic_store(&job.next_edges, 0);
+        if (top_down) {
+            job.frontier = frontier;
+            job.frontier_size = frontier_size;
+            job.tasks = ThreadPool_workers(pool) * GRAPH_TASKS_PER_WORKER;
+            ThreadPool_run(pool, job.tasks, _Graph_top_down, &job);
+
+            uint32_t * swap = frontier;
+            frontier = job.next;
+            job.next = swap;
+        } else {
+            memset(job.next_bitmap, 0, words * sizeof(uint64_t));
+            job.bitmap = bitmap;
+            ThreadPool_run(pool, (vertices + GRAPH_CHUNK - 1) / GRAPH_CHUNK, _Graph_bottom_up, &job);
+
+            uint64_t * swap = bitmap;
+            bitmap = job.next_bitmap;
+            job.next_bitmap = swap;
+        }
+
+        frontier_size = atomic_load(&job.next_size);
+        frontier_edges = atomic_load(&job.next_edges);
+        unexplored_edges -= frontier_edges < unexplored_edges ? frontier_edges : unexplored_edges;
+        job.level++;
+    }
+
+    for (size_t v = 0; v < vertices; v++) result->data[v] = atomic_load(&job.depth[v]);
+
+    ARRAY_FREE(job.depth);
+    ARRAY_FREE(frontier);
+    ARRAY_FREE(job.next);
+    ARRAY_FREE(bitmap);
+    ARRAY_FREE(job.next_bitmap);
+    return result;
+}
+
+// Graph >> bfs(graph: *Graph, source: uint32_t, pool: *ThreadPool) -> *Array<uint32_t>
+//
+// Direction-optimizing breadth-first search from ``source``.
+//
+// Parameters
+// ----------
+// graph : *Graph
+//     The graph to search.
+// source : uint32_t
+//     The starting vertex.
+// pool : *ThreadPool
+//     Where to run, NULL for the calling thread.
+//
+// Returns
+// -------
+// *Array<uint32_t>: The depth of every vertex, GRAPH_UNREACHED for
+//     unreachable ones, or NULL on failure.
+//
+Array(uint32_t) * Graph_bfs(Graph * graph, uint32_t source, ThreadPool * pool) {
+    return _Graph_bfs(graph, source, pool, true);
+}
+
+// Graph >> bfs_top_down(graph: *Graph, source: uint32_t, pool: *ThreadPool) -> *Array<uint32_t>
+//
+// Like ``bfs``, but always top-down: the baseline ``bfs`` improves on.
+//
+Array(uint32_t) * Graph_bfs_top_down(Graph * graph, uint32_t source, ThreadPool * pool) {
+    return _Graph_bfs(graph, source, pool, false);
+}
+
+
+// ~~~~~~~~ PageRank ~~~~~~~~
+
+typedef struct {
+    Graph * graph;
+    double damping;
+    double * rank;
+    double * next;
+    double * contribution;
+    double base;                // teleport + dangling share, per vertex
+    size_t tasks;
+    double * partials;          // per task: dangling mass, then error
+} _GraphRank;
+
+void _Graph_contribute(void * context, size_t task, size_t worker) {
+    (void) worker;
+    _GraphRank * job = context;
+
+    size_t vertices = job->graph->_vertices;
+    size_t first = task * vertices / job->tasks, last = (task + 1) * vertices / job->tasks;
+    const size_t * offsets = job->graph->offsets->data;
+
+    double dangling = 0.0;
+    for (size_t v = first; v < last; v++) {
+        size_t degree = offsets[v + 1] - offsets[v];
+        job->contribution[v] = degree ? job->rank[v] / degree : 0.0;
+        if (not degree) dangling += job->rank[v];
+    }
+    job->partials[task] = dangling;
+}
+
+void _Graph_pull(void * context, size_t task, size_t worker) {
+    (void) worker;
+    _GraphRank * job = context;
+
+    size_t first, last;
+    const size_t * offsets = job->graph->in_offsets->data;
+    const uint32_t * sources = job->graph->in_sources->data;
+    _Graph_balanced(offsets, job->graph->_vertices, task, job->tasks, &first, &last);
+
+    double error = 0.0;
+    for (size_t v = first; v < last; v++) {
+        double sum = 0.0;
+        for (size_t e = offsets[v]; e < offsets[v + 1]; e++) sum += job->contribution[sources[e]];
+        job->next[v] = job->base + job->damping * sum;
+        error += fabs(job->next[v] - job->rank[v]);
+    }
+    job->partials[task] = error;
+}
+
+// Graph >> pagerank(graph: *Graph, damping: double, tolerance: double,
+//                   iterations: size_t, pool: *ThreadPool) -> *Array<double>
+//
+// Computes PageRank by power iteration, pulling from in-neighbors.
+// The rank of dangling vertices is spread evenly over every vertex.
+//
+// Parameters
+// ----------
+// graph : *Graph
+//     The graph to rank.
+// damping : double
+//     The probability to follow an edge, usually 0.85.
+// tolerance : double
+//     Stops once the L1 change of an iteration falls below it.
+// iterations : size_t
+//     The maximum number of iterations.
+// pool : *ThreadPool
+//     Where to run, NULL for the calling thread.
+//
+// Returns
+// -------
+// *Array<double>: The rank of every vertex, summing to 1, or NULL on failure.
+//
+Array(double) * Graph_pagerank(Graph * graph, double damping, double tolerance,
+                               size_t iterations, ThreadPool * pool) {
+    ensure(graph and graph->_vertices > 0, NULL);
+
+    size_t vertices = graph->_vertices;
+    _GraphRank job = { .graph = graph, .damping = damping };
+    job.tasks = ThreadPool_workers(pool) * GRAPH_TASKS_PER_WORKER;
+    Array(double) * result = Array(double, new)(vertices);
+    job.next = ARRAY_MALLOC(vertices * sizeof(double));
+    job.contribution = ARRAY_MALLOC(vertices * sizeof(double));
+    job.partials = ARRAY_MALLOC(job.tasks * sizeof(double));
+
+    if (not result or not job.next or not job.contribution or not job.partials) {
+        Array(double, delete)(result);
+        ARRAY_FREE(job.next); ARRAY_FREE(job.contribution); ARRAY_FREE(job.partials);
+        return NULL;
+    }
+
+    job.rank = result->data;
+    for (size_t v = 0; v < vertices; v++) job.rank[v] = 1.0 / vertices;
+
+    for (size_t iteration = 0; iteration < iterations; iteration++) {
+        ThreadPool_run(pool, job.tasks, _Graph_contribute, &job);
+        double dangling = 0.0;
+        for (size_t task = 0; task < job.tasks; task++) dangling += job.partials[task];
+        job.base = (1.0 - damping + damping * dangling) / vertices;
+
+        ThreadPool_run(pool, job.tasks, _Graph_pull, &job);
+        double error = 0.0;
+        for (size_t task = 0; task < job.tasks; task++) error += job.partials[task];
+
+        double * swap = job.rank;
+        job.rank = job.next;
+        job.next = swap;
+        if (error < tolerance) break;
+    }
+
+    if (job.rank != result->data) {
+        memcpy(result->data, job.rank, vertices * sizeof(double));
+        job.next = job.rank;
+    }
+    ARRAY_FREE(job.next);
+    ARRAY_FREE(job.contribution);
+    ARRAY_FREE(job.partials);
+    return result;
+}
+
+
+// ~~~~~~~~ Connected components ~~~~~~~~
+
+typedef struct {
+    Graph * graph;
+    _Atomic uint32_t * label;
+    size_t tasks;
+} _GraphComponents;
+
+// Hooks the higher root under the lower one, retrying on races.
+void _Graph_link(_Atomic uint32_t * label, uint32_t u, uint32_t v) {
+    uint32_t p1 = atomic_load_explicit(&label[u], memory_order_relaxed);
+    uint32_t p2 = atomic_load_explicit(&label[v], memory_order_relaxed);
+    while (p1 != p2) {
+        uint32_t high = p1 > p2 ? p1 : p2, low = p1 > p2 ? p2 : p1;
+        uint32_t p_high = atomic_load_explicit(&label[high], memory_order_relaxed);
+        uint32_t expected = high;
+        if (p_high == low or (p_high == high and atomic_compare_exchange_strong_explicit(
+                &label[high], &expected, low, memory_order_relaxed, memory_order_relaxed)))
+            return;
+
+        p1 = atomic_load_explicit(&label[atomic_load_explicit(&label[high], memory_order_relaxed)],
+            memory_order_relaxed);
+        p2 = atomic_load_explicit(&label[low], memory_order_relaxed);
+    }
+}
+
+void _Graph_hook(void * context, size_t task, size_t worker) {
+    (void) worker;
+    _GraphComponents * job = context;
+
+    size_t first, last;
+    const size_t * offsets = job->graph->offsets->data;
+    const uint32_t * targets = job->graph->targets->data;
+    _Graph_balanced(offsets, job->graph->_vertices, task, job->tasks, &first, &last);
+
+    for (size_t v = first; v < last; v++)
+        for (size_t e = offsets[v]; e < offsets[v + 1]; e++)
+            _Graph_link(job->label, (uint32_t) v, targets[e]);
+}
+
+void _Graph_compress(void * context, size_t task, size_t worker) {
+    (void) worker;
+    _GraphComponents * job = context;
+
+    size_t vertices = job->graph->_vertices;
+    size_t first = task * vertices / job->tasks, last = (task + 1) * vertices / job->tasks;
+    for (size_t v = first; v < last; v++) {
+        uint32_t parent = atomic_load_explicit(&job->label[v], memory_order_relaxed);
+        uint32_t root = atomic_load_explicit(&job->label[parent], memory_order_relaxed);
+        while (parent != root) {
+            parent = root;
+            root = atomic_load_explicit(&job->label[parent], memory_order_relaxed);
+        }
+        atomic_store_explicit(&job->label[v], root, memory_order_relaxed);
+    }
+}
+
+// Graph >> components(graph: *Graph, pool: *ThreadPool) -> *Array<uint32_t>
+//
+// Labels the weakly connected components: two vertices get the same
+// label iff a path joins them, ignoring directions. The label of a
+// component is its smallest vertex.
+//
+// Returns
+// -------
+// *Array<uint32_t>: The label of every vertex, or NULL on failure.
+//
+Array(uint32_t) * Graph_components(Graph * graph, ThreadPool * pool) {
+    ensure(graph, NULL);
+
+    size_t vertices = graph->_vertices;
+    _GraphComponents job = { .graph = graph };
+    job.tasks = ThreadPool_workers(pool) * GRAPH_TASKS_PER_WORKER;
+    job.label = ARRAY_MALLOC((vertices ? vertices : 1) * sizeof(_Atomic uint32_t));
+    Array(uint32_t) * result = Array(uint32_t, new)(vertices);
+    if (not job.label or not result) {
+        ARRAY_FREE(job.label);
+        Array(uint32_t, delete)(result);
+        return NULL;
+    }
+
+    for (size_t v = 0; v < vertices; v++) atomic_init(&job.label[v], (uint32_t) v);
+    ThreadPool_run(pool, job.tasks, _Graph_hook, &job);
+    ThreadPool_run(pool, job.tasks, _Graph_compress, &job);
+
+    for (size_t v = 0; v < vertices; v++) result->data[v] = atomic_load(&job.label[v]);
+    ARRAY_FREE(job.label);
+    return result;
+}
+
+
+// ~~~~~~~~ RMAT ~~~~~~~~
+
+typedef struct {
+    unsigned scale;
+    size_t edges;
+    uint64_t seed;
+    size_t tasks;
+    uint32_t * sources;
+    uint32_t * targets;
+    const uint32_t * permutation;
+} _GraphRmat;
+
+uint64_t _Graph_random(uint64_t * state) {
+    uint64_t z = (*state += 0x9e3779b97f4a7c15ull);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+    return z ^ (z >> 31);
+}
+
+// Graph500 quadrant probabilities a = 0.57, b = c = 0.19, over 2^16.
+void _Graph_rmat_edges(void * context, size_t task, size_t worker) {
+    (void) worker;
+    _GraphRmat * job = context;
+
+    size_t first = task * job->edges / job->tasks, last = (task + 1) * job->edges / job->tasks;
+    uint64_t state = job->seed ^ (task * 0x632be59bd9b4e019ull);
+
+    for (size_t i = first; i < last; i++) {
+        uint32_t u = 0, v = 0;
+        uint64_t bits = 0;
+        for (unsigned level = 0; level < job->scale; level++) {
+            if (level % 4 == 0) bits = _Graph_random(&state);
+            uint32_t draw = bits & 0xffff;
+            bits >>= 16;
+
+            uint32_t right = draw >= 37355 and draw < 49807;     // b
+            uint32_t down = draw >= 49807;                       // c or d
+            right |= draw >= 62259;                              // d
+            u = u << 1 | down;
+            v = v << 1 | right;
+        }
+        job->sources[i] = job->permutation[u];
+        job->targets[i] = job->permutation[v];
+    }
+}
+
+// Graph >> rmat(scale: unsigned, edges: size_t, seed: uint64_t,
+//               undirected: bool, pool: *ThreadPool) -> *Graph
+//
+// Generates an R-MAT graph with 2^scale vertices and ``edges`` edges,
+// using the Graph500 parameters, with shuffled vertex ids.
+// Edges may repeat and include self-loops.
+//
+// Returns
+// -------
+// *Graph: The new graph, or NULL on failure.
+//
+Graph * Graph_rmat(unsigned scale, size_t edges, uint64_t seed, bool undirected, ThreadPool * pool) {
+    ensure(scale > 0 and scale < 32, NULL);
+
+    size_t vertices = (size_t) 1 << scale;
+    Array(uint32_t) * sources = Array(uint32_t, new)(edges);
+    Array(uint32_t) * targets = Array(uint32_t, new)(edges);
+    uint32_t * permutation = ARRAY_MALLOC(vertices * sizeof(uint32_t));
+    Graph * graph = NULL;
+
+    if (sources and targets and permutation) {
+        uint64_t state = seed;
+        for (size_t v = 0; v < vertices; v++) permutation[v] = (uint32_t) v;
+        for (size_t v = vertices - 1; v > 0; v--) {
+            size_t w = _Graph_random(&state) % (v + 1);
+            uint32_t swap = permutation[v];
+            permutation[v] = permutation[w];
+            permutation[w] = swap;
+        }
+
+        _GraphRmat job = {
+            .scale = scale, .edges = edges, .seed = seed, .permutation = permutation,
+            .sources = sources->data, .targets = targets->data,
+            .tasks = ThreadPool_workers(pool) * GRAPH_TASKS_PER_WORKER,
+        };
+        ThreadPool_run(pool, job.tasks, _Graph_rmat_edges, &job);
+        graph = Graph_new(vertices, sources, targets, undirected);
+    }
+
+    Array(uint32_t, delete)(sources);
+    Array(uint32_t, delete)(targets);
+    ARRAY_FREE(permutation);
+    return graph;
+}
+
+
+// ~~~~~~~~ Printing ~~~~~~~~
+
+// Graph >> debug(graph: *Graph) -> void
+//
+// Prints the debug representation of the graph,
+// with the neighbors of its first vertices.
+//
+void Graph_debug(Graph * graph) {
+    if (not graph) {
+        printf("Graph { NULL }\n");
+        return;
+    }
+
+    printf("Graph {\n");
+    printf("  vertices: %zu,\n", graph->_vertices);
+    printf("  arcs: %zu,\n", graph->_edges);
+    printf("  undirected: %s,\n", graph->_undirected ? "true" : "false");
+    for (size_t v = 0; v < graph->_vertices and v < 8; v++) {
+        printf("  %zu -> [", v);
+        for (size_t e = graph->offsets->data[v]; e < graph->offsets->data[v + 1]; e++)
+            printf(e > graph->offsets->data[v] ? ", %u" : "%u", graph->targets->data[e]);
+        printf("],\n");
+    }
+    if (graph->_vertices > 8) printf("  ...\n");
+    printf("}\n");
+}
+
+#endif
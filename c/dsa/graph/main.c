@@ -0,0 +1,131 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdint.h>
+#include <stdio.h>
+#include <time.h>
+
+#define T size_t
+#define PRINT_T(value) printf("%zu", value)
+#include "../array/array.h"
+
+#define T uint32_t
+#define PRINT_T(value) printf("%u", value)
+#include "../array/array.h"
+
+#define T double
+#define PRINT_T(value) printf("%.3f", value)
+#include "../array/array.h"
+
+#include "graph.h"
+
+// Usage: ./main [scale] [edge factor], defaults to 2^20 vertices, 16M edges.
+
+double seconds() {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec + now.tv_nsec * 1e-9;
+}
+
+// Edges inside the component reached by a BFS, as Graph500 counts them.
+double traversed_edges(Graph * graph, Array(uint32_t) * depth) {
+    double arcs = 0;
+    for (uint32_t v = 0; v < Graph_vertices(graph); v++)
+        if (depth->data[v] != GRAPH_UNREACHED) arcs += Graph_degree(graph, v);
+    return arcs / 2;
+}
+
+int main(int argc, char ** argv) {
+
+    // A path 0 - 1 - 2 - 3, a triangle 4 - 5 - 6 and a lone vertex 7.
+    uint32_t from[] = { 0, 1, 2, 4, 5, 6 };
+    uint32_t to[] = { 1, 2, 3, 5, 6, 4 };
+    Array(uint32_t) * sources = Array(uint32_t, new)(6);
+    Array(uint32_t) * targets = Array(uint32_t, new)(6);
+    for (size_t i = 0; i < 6; i++) {
+        sources->data[i] = from[i];
+        targets->data[i] = to[i];
+    }
+
+    Graph * small = Graph_new(8, sources, targets, true);
+    Graph_debug(small);
+    Array(uint32_t) * depth = Graph_bfs(small, 0, NULL);
+    Array(uint32_t) * component = Graph_components(small, NULL);
+    Array(double) * rank = Graph_pagerank(small, 0.85, 1e-9, 100, NULL);
+    printf("depth from 0: "); Array(uint32_t, println)(depth);
+    printf("components:   "); Array(uint32_t, println)(component);
+    printf("pagerank:     "); Array(double, println)(rank);
+
+    Array(uint32_t, delete)(depth);
+    Array(uint32_t, delete)(component);
+    Array(double, delete)(rank);
+    Array(uint32_t, delete)(sources);
+    Array(uint32_t, delete)(targets);
+    Graph_delete(small);
+
+    unsigned scale = argc > 1 ? (unsigned) atoi(argv[1]) : 20;
+    size_t factor = argc > 2 ? (size_t) atoi(argv[2]) : 16;
+    ThreadPool * pool = ThreadPool_new(0);
+
+    double start = seconds();
+    Graph * graph = Graph_rmat(scale, factor << scale, 7, true, pool);
+    double build = seconds() - start;
+    if (not graph) {
+        printf("not enough memory for scale %u\n", scale);
+        return 1;
+    }
+    printf("\nRMAT scale %u: %zu vertices, %zu edges, generated and built in %.2f s, %zu workers\n",
+        scale, Graph_vertices(graph), Graph_edges(graph) / 2, build, ThreadPool_workers(pool));
+
+    // BFS from a few roots with neighbors, as Graph500 does.
+    double top_down_time = 0, optimized_time = 0, edges = 0;
+    bool agree = true;
+    uint64_t state = 1;
+    for (int root = 0; root < 8; root++) {
+        uint32_t source;
+        do source = _Graph_random(&state) % Graph_vertices(graph);
+        while (Graph_degree(graph, source) == 0);
+
+        start = seconds();
+        Array(uint32_t) * plain = Graph_bfs_top_down(graph, source, pool);
+        top_down_time += seconds() - start;
+
+        start = seconds();
+        Array(uint32_t) * optimized = Graph_bfs(graph, source, pool);
+        optimized_time += seconds() - start;
+
+        edges += traversed_edges(graph, optimized);
+        agree = agree and memcmp(plain->data, optimized->data,
+            Graph_vertices(graph) * sizeof(uint32_t)) == 0;
+        Array(uint32_t, delete)(plain);
+        Array(uint32_t, delete)(optimized);
+    }
+    printf("bfs top-down:             %7.1f M edges/s\n", edges / top_down_time / 1e6);
+    printf("bfs direction-optimizing: %7.1f M edges/s, depths %s\n",
+        edges / optimized_time / 1e6, agree ? "agree" : "differ");
+
+    start = seconds();
+    rank = Graph_pagerank(graph, 0.85, 0.0, 10, pool);
+    double elapsed = seconds() - start;
+    double total = 0;
+    for (size_t v = 0; v < Graph_vertices(graph); v++) total += rank->data[v];
+    printf("pagerank, 10 iterations:  %7.1f M edges/s, ranks sum to %.6f\n",
+        10.0 * Graph_edges(graph) / elapsed / 1e6, total);
+    Array(double, delete)(rank);
+
+    start = seconds();
+    component = Graph_components(graph, pool);
+    elapsed = seconds() - start;
+    size_t components = 0, isolated = 0;
+    for (uint32_t v = 0; v < Graph_vertices(graph); v++) {
+        components += component->data[v] == v;
+        isolated += Graph_degree(graph, v) == 0;
+    }
+    printf("components:               %7.1f M edges/s, %zu components (%zu isolated vertices)\n",
+        Graph_edges(graph) / elapsed / 1e6, components, isolated);
+    Array(uint32_t, delete)(component);
+
+    Graph_delete(graph);
+    ThreadPool_delete(pool);
+    return 0;
+
+}
@@ -0,0 +1,451 @@
+// =============
+// HashMap<K, V>
+// =============
+//
+// :Author: RickBarretto
+// :Year: 2026
+// :License: MPL 2.0
+// :Copyright: RickBarretto, 2026
+// :Version: 1.0
+//
+// ``HashMap<K, V>`` is a generic open-addressing hash map.
+// Keys, values and slot states live in three parallel arrays,
+// probed linearly, and the table doubles once it is 3/4 full.
+// Removed entries leave tombstones that are dropped on the next growth.
+//
+// How to Use
+// ----------
+//
+// Include this header after defining K, V, PRINT_K and PRINT_V.
+// HASH_K and EQ_K are optional, they default to an integer mixer
+// and ``==``, so they must be defined for non-integer keys.
+//
+//      #define K int64_t
+//      #define V size_t
+//      #define PRINT_K(key) printf("%lld", (long long) key)
+//      #define PRINT_V(value) printf("%zu", value)
+//      #include "hashmap.h"
+//
+// For string keys:
+//
+//      #define HASH_K(key) HashMap_hash_str(key)
+//      #define EQ_K(a, b) (strcmp(a, b) == 0)
+//
+// Each function is namespaced under HashMap<K, V>,
+// i.e. ``HashMap(int64_t, size_t, get)`` is the same as
+// ``HashMap_int64_t_size_t_get``.
+//
+//      HashMap(int64_t, size_t) * map = HashMap(int64_t, size_t, new)(16);
+//      HashMap(int64_t, size_t, set)(map, 42, 7);
+//      size_t * value = HashMap(int64_t, size_t, get)(map, 42);
+//
+//      size_t cursor = 0;
+//      int64_t * key;
+//      while (HashMap(int64_t, size_t, next)(map, &cursor, &key, &value)) { ... }
+//
+
+// =~=~=~=~=~=~=~=~ Imports ~=~=~=~=~=~=~=~=
+
+#include <iso646.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+
+// =~=~=~=~=~=~=~=~ Helper Macros ~=~=~=~=~=~=~=~=
+
+#define _CAT(X, Y) X ## _ ## Y
+#define CAT(X, Y) _CAT(X, Y)
+#define _CAT3(X, Y, Z) X ## _ ## Y ## _ ## Z
+#define CAT3(X, Y, Z) _CAT3(X, Y, Z)
+
+#define STRINGIFY(x) #x
+#define TOSTRING(x) STRINGIFY(x)
+
+#define ensure(COND, VAL) if (not (COND)) return VAL
+
+
+// =~=~=~=~=~=~=~=~ Shared helpers ~=~=~=~=~=~=~=~=
+
+#ifndef HASHMAP_HELPERS
+#define HASHMAP_HELPERS
+
+#define _HASHMAP_EMPTY 0
+#define _HASHMAP_FULL 1
+#define _HASHMAP_DELETED 2
+
+// HashMap >> hash_u64(key: u64) -> u64
+//
+// Mixes an integer key (splitmix64 finalizer).
+//
+uint64_t HashMap_hash_u64(uint64_t key) {
+    key ^= key >> 30;
+    key *= 0xbf58476d1ce4e5b9ull;
+    key ^= key >> 27;
+    key *= 0x94d049bb133111ebull;
+    key ^= key >> 31;
+    return key;
+}
+
+// HashMap >> hash_str(key: *char) -> u64
+//
+// Hashes a NUL-terminated string (FNV-1a).
+//
+uint64_t HashMap_hash_str(const char * key) {
+    uint64_t hash = 14695981039346656037ull;
+    for (; *key; key++) hash = (hash ^ (uint8_t) *key) * 1099511628211ull;
+    return hash;
+}
+
+#endif
+
+
+// =~=~=~=~=~=~=~=~ Implementation ~=~=~=~=~=~=~=~=
+
+// K: Key type of the HashMap<K, V>
+#ifndef K
+#error "K is not defined"
+#endif
+
+// V: Value type of the HashMap<K, V>
+#ifndef V
+#error "V is not defined"
+#endif
+
+// PRINT_K: (K) -> void
+//
+// PRINT_K is a macro that defines how to print a key of type K.
+// See ``Array<T>`` PRINT_T for more details.
+//
+#ifndef PRINT_K
+#error "PRINT_K is not defined"
+#endif
+
+// PRINT_V: (V) -> void
+//
+// PRINT_V is a macro that defines how to print a value of type V.
+//
+#ifndef PRINT_V
+#error "PRINT_V is not defined"
+#endif
+
+// HASH_K: (K) -> u64
+//
+// Optional. Defaults to ``HashMap_hash_u64`` over the integer key.
+//
+#ifndef HASH_K
+#define HASH_K(key) HashMap_hash_u64((uint64_t) (key))
+#endif
+
+// EQ_K: (K, K) -> bool
+//
+// Optional. Defaults to ``==``.
+//
+#ifndef EQ_K
+#define EQ_K(a, b) ((a) == (b))
+#endif
+
+#define MODULE HashMap
+#define Self CAT3(MODULE, K, V)
+#define fn(NAME) CAT(Self, NAME)
+
+#define _HASHMAP_SELECT_MACRO(_1, _2, _3, NAME, ...) NAME
+#define HashMap(...) _HASHMAP_SELECT_MACRO(__VA_ARGS__, HashMap3, HashMap2)(__VA_ARGS__)
+#define HashMap2(K, V) CAT3(HashMap, K, V)
+#define HashMap3(K, V, FUNC) CAT(CAT3(HashMap, K, V), FUNC)
+
+typedef struct {
+    K * keys;
+    V * values;
+    uint8_t * states;
+    size_t _size;
+    size_t _used;       // full + deleted slots
+    size_t _capacity;   // always a power of two
+} Self;
+
+
+// HashMap >> new(capacity: size_t) -> *HashMap<K, V>
+//
+// Creates an empty map with room for ``capacity`` entries before growing.
+//
+// Parameters
+// ----------
+// capacity : size_t
+//     The expected number of entries.
+//
+// Returns
+// -------
+// *HashMap<K, V>: A pointer to the newly created map.
+//
+Self * fn(new)(size_t capacity) {
+    size_t slots = 8;
+    while (slots * 3 / 4 < capacity) slots <<= 1;
+
+    Self * map = malloc(sizeof(Self));
+    K * keys = malloc(slots * sizeof(K));
+    V * values = malloc(slots * sizeof(V));
+    uint8_t * states = calloc(slots, 1);
+
+    if (not map or not keys or not values or not states) {
+        free(map); free(keys); free(values); free(states);
+        return NULL;
+    }
+
+    map->keys = keys;
+    map->values = values;
+    map->states = states;
+    map->_size = 0;
+    map->_used = 0;
+    map->_capacity = slots;
+    return map;
+}
+
+// HashMap >> delete(map: *HashMap<K, V>) -> bool
+//
+// Safely deletes the map.
+//
+// Returns
+// -------
+// bool: Returns true on success.
+//
+bool fn(delete)(Self * map) {
+    ensure(map, false);
+
+    free(map->keys);
+    free(map->values);
+    free(map->states);
+    free(map);
+    return true;
+}
+
+// HashMap >> size(map: *HashMap<K, V>) -> size_t
+//
+// Returns the number of entries in the map.
+//
+size_t fn(size)(Self * map) {
+    ensure(map, 0);
+    return map->_size;
+}
+
+// Returns the slot of ``key``, or SIZE_MAX when absent.
+size_t fn(_find)(Self * map, K key) {
+    size_t mask = map->_capacity - 1;
+    for (size_t slot = HASH_K(key) & mask; ; slot = (slot + 1) & mask) {
+        if (map->states[slot] == _HASHMAP_EMPTY) return SIZE_MAX;
+        if (map->states[slot] == _HASHMAP_FULL and EQ_K(map->keys[slot], key))
+            return slot;
+    }
+}
+
+bool fn(_grow)(Self * map) {
+    // Only grow when live entries need it, otherwise just purge tombstones.
+    size_t slots = (map->_size * 2 >= map->_capacity)
+        ? map->_capacity * 2 : map->_capacity;
+
+    K * keys = malloc(slots * sizeof(K));
+    V * values = malloc(slots * sizeof(V));
+    uint8_t * states = calloc(slots, 1);
+    if (not keys or not values or not states) {
+        free(keys); free(values); free(states);
+        return false;
+    }
+
+    for (size_t old = 0; old < map->_capacity; old++) {
+        if (map->states[old] != _HASHMAP_FULL) continue;
+
+        size_t slot = HASH_K(map->keys[old]) & (slots - 1);
+        while (states[slot] == _HASHMAP_FULL) slot = (slot + 1) & (slots - 1);
+        keys[slot] = map->keys[old];
+        values[slot] = map->values[old];
+        states[slot] = _HASHMAP_FULL;
+    }
+
+    free(map->keys);
+    free(map->values);
+    free(map->states);
+    map->keys = keys;
+    map->values = values;
+    map->states = states;
+    map->_capacity = slots;
+    map->_used = map->_size;
+    return true;
+}
+
+// HashMap >> get(map: *HashMap<K, V>, key: K) -> *V
+//
+// Looks a key up.
+//
+// Returns
+// -------
+// *V: A pointer to the value, valid until the next insertion.
+//     If the key is absent, returns NULL.
+//
+V * fn(get)(Self * map, K key) {
+    ensure(map, NULL);
+
+    size_t slot = fn(_find)(map, key);
+    ensure(slot != SIZE_MAX, NULL);
+    return &map->values[slot];
+}
+
+// HashMap >> contains(map: *HashMap<K, V>, key: K) -> bool
+//
+// Returns true if the key is in the map.
+//
+bool fn(contains)(Self * map, K key) {
+    return fn(get)(map, key) != NULL;
+}
+
+// HashMap >> entry(map: *HashMap<K, V>, key: K, fallback: V) -> *V
+//
+// Returns the value of ``key``, inserting ``fallback`` first if absent.
+// This is the single-probe building block of counters and group-bys.
+//
+// Returns
+// -------
+// *V: A pointer to the value, valid until the next insertion.
+//     Returns NULL if the map could not grow.
+//
+V * fn(entry)(Self * map, K key, V fallback) {
+    ensure(map, NULL);
+
+    if ((map->_used + 1) * 4 > map->_capacity * 3) {
+        ensure(fn(_grow)(map), NULL);
+    }
+
+    size_t mask = map->_capacity - 1, tombstone = SIZE_MAX;
+    size_t slot = HASH_K(key) & mask;
+    for (; map->states[slot] != _HASHMAP_EMPTY; slot = (slot + 1) & mask) {
+        if (map->states[slot] == _HASHMAP_DELETED) {
+            if (tombstone == SIZE_MAX) tombstone = slot;
+        } else if (EQ_K(map->keys[slot], key)) {
+            return &map->values[slot];
+        }
+    }
+
+    if (tombstone != SIZE_MAX) slot = tombstone;
+    else map->_used++;
+
+    map->keys[slot] = key;
+    map->values[slot] = fallback;
+    map->states[slot] = _HASHMAP_FULL;
+    map->_size++;
+    return &map->values[slot];
+}
+
+// HashMap >> set(map: *HashMap<K, V>, key: K, value: V) -> bool
+//
+// Inserts or overwrites an entry.
+//
+// Returns
+// -------
+// bool: Returns true on success, false if the map could not grow.
+//
+bool fn(set)(Self * map, K key, V value) {
+    V * slot = fn(entry)(map, key, value);
+    ensure(slot, false);
+
+    *slot = value;
+    return true;
+}
+
+// HashMap >> remove(map: *HashMap<K, V>, key: K) -> bool
+//
+// Removes an entry.
+//
+// Returns
+// -------
+// bool: Returns true if the key was present.
+//
+bool fn(remove)(Self * map, K key) {
+    ensure(map, false);
+
+    size_t slot = fn(_find)(map, key);
+    ensure(slot != SIZE_MAX, false);
+
+    map->states[slot] = _HASHMAP_DELETED;
+    map->_size--;
+    return true;
+}
+
+// HashMap >> next(map: *HashMap<K, V>, cursor: *size_t, key: **K, value: **V) -> bool
+//
+// Iterates over the entries, in no particular order.
+// ``cursor`` must start at 0.
+//
+// Returns
+// -------
+// bool: Returns true and points ``key`` and ``value`` at the next entry,
+//       or false once every entry was visited.
+//
+bool fn(next)(Self * map, size_t * cursor, K ** key, V ** value) {
+    ensure(map and cursor, false);
+
+    for (; *cursor < map->_capacity; (*cursor)++) {
+        if (map->states[*cursor] != _HASHMAP_FULL) continue;
+
+        if (key) *key = &map->keys[*cursor];
+        if (value) *value = &map->values[*cursor];
+        (*cursor)++;
+        return true;
+    }
+    return false;
+}
+
+// HashMap >> print(map: *HashMap<K, V>) -> void
+//
+// Prints the map on terminal.
+//
+void fn(print)(Self * map) {
+    ensure(map,);
+
+    size_t cursor = 0, printed = 0;
+    K * key;
+    V * value;
+
+    printf("{");
+    while (fn(next)(map, &cursor, &key, &value)) {
+        PRINT_K(*key);
+        printf(": ");
+        PRINT_V(*value);
+        if (++printed < map->_size) printf(", ");
+    }
+    printf("}");
+}
+
+// HashMap >> println(map: *HashMap<K, V>) -> void
+//
+// Prints the map on terminal followed by a newline.
+//
+void fn(println)(Self * map) {
+    fn(print)(map);
+    printf("\n");
+}
+
+// HashMap >> debug(map: *HashMap<K, V>) -> void
+//
+// Prints the debug representation of the map.
+//
+void fn(debug)(Self * map) {
+    if (not map) {
+        printf("HashMap<%s, %s> { NULL }\n", TOSTRING(K), TOSTRING(V));
+        return;
+    }
+
+    printf("HashMap<%s, %s> {\n", TOSTRING(K), TOSTRING(V));
+    printf("  size: %zu,\n", map->_size);
+    printf("  capacity: %zu,\n", map->_capacity);
+    printf("  data: "); fn(println)(map);
+    printf("}\n");
+}
+
+#undef MODULE
+#undef Self
+#undef fn
+#undef K
+#undef V
+#undef PRINT_K
+#undef PRINT_V
+#undef HASH_K
+#undef EQ_K
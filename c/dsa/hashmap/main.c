@@ -0,0 +1,43 @@
+#include <stdio.h>
+#include <string.h>
+
+typedef char* str;
+
+#define K str
+#define V int
+#define PRINT_K(key) printf("%s", key)
+#define PRINT_V(value) printf("%d", value)
+#define HASH_K(key) HashMap_hash_str(key)
+#define EQ_K(a, b) (strcmp(a, b) == 0)
+#include "hashmap.h"
+
+#define K int
+#define V int
+#define PRINT_K(key) printf("%d", key)
+#define PRINT_V(value) printf("%d", value)
+#include "hashmap.h"
+
+int main() {
+
+    str words[] = { "to", "be", "or", "not", "to", "be" };
+
+    HashMap(str, int) * counts = HashMap(str, int, new)(4);
+    for (size_t i = 0; i < 6; i++)
+        (*HashMap(str, int, entry)(counts, words[i], 0))++;
+
+    HashMap(str, int, debug)(counts);
+
+    HashMap(int, int) * squares = HashMap(int, int, new)(0);
+    for (int i = 0; i < 1000; i++) HashMap(int, int, set)(squares, i, i * i);
+    for (int i = 0; i < 1000; i += 2) HashMap(int, int, remove)(squares, i);
+
+    printf("size: %zu, 31^2 = %d, has 30: %s\n",
+        HashMap(int, int, size)(squares),
+        *HashMap(int, int, get)(squares, 31),
+        HashMap(int, int, contains)(squares, 30) ? "yes" : "no");
+
+    HashMap(str, int, delete)(counts);
+    HashMap(int, int, delete)(squares);
+    return 0;
+
+}
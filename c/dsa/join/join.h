@@ -0,0 +1,624 @@
+// =======
+// Join<T>
+// =======
+//
+// :Author: RickBarretto
+// :Year: 2026
+// :License: MPL 2.0
+// :Copyright: RickBarretto, 2026
+// :Version: 1.0
+//
+// ``Join<T>`` provides equi-join kernels over two ``Array<T>`` key columns.
+// Each kernel returns ``JoinPairs``: two ``Array<size_t>`` of the same size,
+// where ``left[k]`` and ``right[k]`` are the rows of the k-th match.
+//
+// - ``hash``: builds one chained hash table over ``left``
+//   and probes it with ``right``. Fast while the table fits the cache.
+// - ``radix``: radix-partitions both sides by hash first,
+//   so every partition's table fits JOIN_CACHE_BYTES,
+//   then joins the partitions independently.
+//   Each pass has at most 2^JOIN_PASS_BITS outputs, to stay TLB-friendly,
+//   and large inputs are partitioned in two passes.
+// - ``merge``: merges two sorted Arrays, splitting ``left``
+//   on key boundaries so equal keys stay in the same task.
+//
+// All kernels run on a ``ThreadPool`` (or on the calling thread for NULL),
+// and produce their pairs in a deterministic order.
+//
+// T must be an integer type.
+//
+// How to Use
+// ----------
+//
+// Include ``Array<size_t>`` and ``Array<T>`` first, then this header:
+//
+//      #define T size_t
+//      #define PRINT_T(value) printf("%zu", value)
+//      #include "../array/array.h"
+//
+//      #define T uint64_t
+//      #define PRINT_T(value) printf("%llu", (unsigned long long) value)
+//      #include "../array/array.h"
+//
+//      #define T uint64_t
+//      #include "join.h"
+//
+// And a common way to use it would be:
+//
+//      JoinPairs * pairs = Join(uint64_t, radix)(orders, customers, pool);
+//      for (size_t k = 0; k < JoinPairs_size(pairs); k++)
+//          use(pairs->left->data[k], pairs->right->data[k]);
+//      JoinPairs_delete(pairs);
+//
+
+// =~=~=~=~=~=~=~=~ Imports ~=~=~=~=~=~=~=~=
+
+#include <iso646.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../thread_pool/thread_pool.h"
+
+
+// =~=~=~=~=~=~=~=~ Helper Macros ~=~=~=~=~=~=~=~=
+
+#define _CAT(X, Y) X ## _ ## Y
+#define CAT(X, Y) _CAT(X, Y)
+#define _CAT3(X, Y, Z) X ## _ ## Y ## _ ## Z
+#define CAT3(X, Y, Z) _CAT3(X, Y, Z)
+
+#define ensure(COND, VAL) if (not (COND)) return VAL
+
+
+// =~=~=~=~=~=~=~=~ Shared helpers ~=~=~=~=~=~=~=~=
+
+#ifndef JOIN_HELPERS
+#define JOIN_HELPERS
+
+// JOIN_CACHE_BYTES: Target size of a partition's build side.
+#ifndef JOIN_CACHE_BYTES
+#define JOIN_CACHE_BYTES (256 * 1024)
+#endif
+
+// JOIN_PASS_BITS: Maximum radix bits per partitioning pass.
+#define JOIN_PASS_BITS 8
+
+// JOIN_CHUNKS_PER_WORKER: Tasks per worker for the data-parallel steps.
+#define JOIN_CHUNKS_PER_WORKER 4
+
+typedef struct {
+    Array(size_t) * left;
+    Array(size_t) * right;
+} JoinPairs;
+
+typedef struct {
+    size_t * left;
+    size_t * right;
+    size_t size;
+    size_t capacity;
+} _JoinBuffer;
+
+bool _JoinBuffer_reserve(_JoinBuffer * buffer, size_t capacity) {
+    if (capacity <= buffer->capacity) return true;
+    size_t * lefts = realloc(buffer->left, capacity * sizeof(size_t));
+    if (lefts) buffer->left = lefts;
+    size_t * rights = realloc(buffer->right, capacity * sizeof(size_t));
+    if (rights) buffer->right = rights;
+    ensure(lefts and rights, false);
+    buffer->capacity = capacity;
+    return true;
+}
+
+bool _JoinBuffer_push(_JoinBuffer * buffer, size_t left, size_t right) {
+    if (buffer->size == buffer->capacity) {
+        ensure(_JoinBuffer_reserve(buffer, buffer->capacity ? buffer->capacity * 2 : 256), false);
+    }
+    buffer->left[buffer->size] = left;
+    buffer->right[buffer->size] = right;
+    buffer->size++;
+    return true;
+}
+
+// Concatenates and frees the per-task buffers.
+JoinPairs * _Join_collect(_JoinBuffer * buffers, size_t count, bool ok) {
+    size_t total = 0;
+    for (size_t i = 0; i < count; i++) total += buffers[i].size;
+
+    JoinPairs * pairs = ok ? malloc(sizeof(JoinPairs)) : NULL;
+    if (pairs) {
+        pairs->left = Array(size_t, new)(total);
+        pairs->right = Array(size_t, new)(total);
+        if (not pairs->left or not pairs->right) {
+            Array(size_t, delete)(pairs->left);
+            Array(size_t, delete)(pairs->right);
+            free(pairs);
+            pairs = NULL;
+        }
+    }
+
+    size_t at = 0;
+    for (size_t i = 0; i < count; i++) {
+        if (pairs and buffers[i].size) {
+            memcpy(pairs->left->data + at, buffers[i].left, buffers[i].size * sizeof(size_t));
+            memcpy(pairs->right->data + at, buffers[i].right, buffers[i].size * sizeof(size_t));
+            at += buffers[i].size;
+        }
+        free(buffers[i].left);
+        free(buffers[i].right);
+    }
+    free(buffers);
+    return pairs;
+}
+
+// JoinPairs >> size(pairs: *JoinPairs) -> size_t
+//
+// Returns the number of matches.
+//
+size_t JoinPairs_size(JoinPairs * pairs) {
+    ensure(pairs, 0);
+    return Array(size_t, size)(pairs->left);
+}
+
+// JoinPairs >> delete(pairs: *JoinPairs) -> bool
+//
+// Safely deletes the pairs and both of their Arrays.
+//
+bool JoinPairs_delete(JoinPairs * pairs) {
+    ensure(pairs, false);
+
+    Array(size_t, delete)(pairs->left);
+    Array(size_t, delete)(pairs->right);
+    free(pairs);
+    return true;
+}
+
+uint64_t _Join_hash(uint64_t key) {
+    return (key ^ (key >> 29)) * 0x9e3779b97f4a7c15ull;
+}
+
+// ``bits`` bits of the hash, right after the ``skip`` topmost ones.
+size_t _Join_bits(uint64_t hash, unsigned skip, unsigned bits) {
+    return bits ? (size_t) ((hash << skip) >> (64 - bits)) : 0;
+}
+
+unsigned _Join_log2(size_t value) {
+    unsigned bits = 0;
+    while (((size_t) 1 << bits) < value) bits++;
+    return bits;
+}
+
+#endif
+
+
+// =~=~=~=~=~=~=~=~ Implementation ~=~=~=~=~=~=~=~=
+
+// T: Key type of the Join<T>, an integer.
+#ifndef T
+#error "T is not defined"
+#endif
+
+#define MODULE Join
+#define Self CAT(MODULE, T)
+#define fn(NAME) CAT(Self, NAME)
+
+#define Join(T, FUNC) CAT3(Join, T, FUNC)
+
+typedef struct {
+    T key;
+    size_t row;
+} fn(Tuple);
+
+
+// ~~~~~~~~ Non-partitioned hash join ~~~~~~~~
+
+typedef struct {
+    const T * build;
+    const T * probe;
+    size_t probe_size;
+    size_t * head;              // bucket -> first row + 1, 0 when empty
+    size_t * next;              // row -> next row + 1 in the same bucket
+    unsigned bits;
+    size_t chunks;
+    _JoinBuffer * buffers;
+    atomic_bool failed;
+} fn(_HashJob);
+
+void fn(_hash_probe)(void * context, size_t task, size_t worker) {
+    (void) worker;
+    fn(_HashJob) * job = context;
+
+    size_t first = task * job->probe_size / job->chunks;
+    size_t last = (task + 1) * job->probe_size / job->chunks;
+    _JoinBuffer * out = &job->buffers[task];
+    _JoinBuffer_reserve(out, last - first);
+
+    for (size_t j = first; j < last; j++) {
+        T key = job->probe[j];
+        size_t bucket = _Join_bits(_Join_hash((uint64_t) key), 0, job->bits);
+        for (size_t i = job->head[bucket]; i; i = job->next[i - 1]) {
+            if (job->build[i - 1] == key and not _JoinBuffer_push(out, i - 1, j))
+                atomic_store(&job->failed, true);
+        }
+    }
+}
+
+// Join >> hash(left: *Array<T>, right: *Array<T>, pool: *ThreadPool) -> *JoinPairs
+//
+// Joins with a single hash table built over ``left``, probed in parallel.
+// This is the baseline ``radix`` is measured against:
+// once the table outgrows the cache, every probe is a cache miss.
+//
+// Parameters
+// ----------
+// left : *Array<T>
+//     The build side, preferably the smaller one.
+// right : *Array<T>
+//     The probe side.
+// pool : *ThreadPool
+//     Where to run, NULL for the calling thread.
+//
+// Returns
+// -------
+// *JoinPairs: The matching row pairs, or NULL on failure.
+//
+JoinPairs * fn(hash)(Array(T) * left, Array(T) * right, ThreadPool * pool) {
+    ensure(left and right, NULL);
+
+    size_t build_size = Array(T, size)(left);
+    unsigned bits = _Join_log2(build_size ? build_size : 1);
+
+    fn(_HashJob) job = {
+        .build = left->data, .probe = right->data,
+        .probe_size = Array(T, size)(right), .bits = bits,
+        .chunks = ThreadPool_workers(pool) * JOIN_CHUNKS_PER_WORKER,
+    };
+    atomic_init(&job.failed, false);
+    job.head = calloc((size_t) 1 << bits, sizeof(size_t));
+    job.next = malloc((build_size ? build_size : 1) * sizeof(size_t));
+    job.buffers = calloc(job.chunks, sizeof(_JoinBuffer));
+    if (not job.head or not job.next or not job.buffers) {
+        free(job.head); free(job.next); free(job.buffers);
+        return NULL;
+    }
+
+    // Inserting backwards keeps every chain in ascending row order.
+    for (size_t i = build_size; i-- > 0; ) {
+        size_t bucket = _Join_bits(_Join_hash((uint64_t) left->data[i]), 0, bits);
+        job.next[i] = job.head[bucket];
+        job.head[bucket] = i + 1;
+    }
+
+    ThreadPool_run(pool, job.chunks, fn(_hash_probe), &job);
+
+    free(job.head);
+    free(job.next);
+    return _Join_collect(job.buffers, job.chunks, not atomic_load(&job.failed));
+}
+
+
+// ~~~~~~~~ Radix-partitioned hash join ~~~~~~~~
+
+typedef struct {
+    const T * keys;
+    size_t size;
+    fn(Tuple) * out;
+    unsigned bits;
+    size_t chunks;
+    size_t * histogram;         // chunks x partitions, then scatter offsets
+} fn(_PartitionJob);
+
+void fn(_histogram)(void * context, size_t task, size_t worker) {
+    (void) worker;
+    fn(_PartitionJob) * job = context;
+
+    size_t first = task * job->size / job->chunks;
+    size_t last = (task + 1) * job->size / job->chunks;
+    size_t * counts = job->histogram + (task << job->bits);
+
+    for (size_t i = first; i < last; i++)
+        counts[_Join_bits(_Join_hash((uint64_t) job->keys[i]), 0, job->bits)]++;
+}
+
+void fn(_scatter)(void * context, size_t task, size_t worker) {
+    (void) worker;
+    fn(_PartitionJob) * job = context;
+
+    size_t first = task * job->size / job->chunks;
+    size_t last = (task + 1) * job->size / job->chunks;
+    size_t * offsets = job->histogram + (task << job->bits);
+
+    for (size_t i = first; i < last; i++) {
+        size_t part = _Join_bits(_Join_hash((uint64_t) job->keys[i]), 0, job->bits);
+        job->out[offsets[part]++] = (fn(Tuple)) { .key = job->keys[i], .row = i };
+    }
+}
+
+// First pass: parallel over chunks of the input.
+// ``bounds`` receives 2^bits + 1 partition boundaries.
+bool fn(_partition)(const T * keys, size_t size, unsigned bits,
+                    fn(Tuple) * out, size_t * bounds, ThreadPool * pool) {
+    size_t parts = (size_t) 1 << bits;
+    fn(_PartitionJob) job = {
+        .keys = keys, .size = size, .out = out, .bits = bits,
+        .chunks = ThreadPool_workers(pool) * JOIN_CHUNKS_PER_WORKER,
+    };
+    job.histogram = calloc(job.chunks * parts, sizeof(size_t));
+    ensure(job.histogram, false);
+
+    ThreadPool_run(pool, job.chunks, fn(_histogram), &job);
+
+    // Partition-major prefix sum: chunk c of partition p writes after
+    // every chunk of the partitions before p and the chunks before c.
+    size_t running = 0;
+    for (size_t part = 0; part < parts; part++) {
+        bounds[part] = running;
+        for (size_t chunk = 0; chunk < job.chunks; chunk++) {
+            size_t count = job.histogram[(chunk << bits) + part];
+            job.histogram[(chunk << bits) + part] = running;
+            running += count;
+        }
+    }
+    bounds[parts] = running;
+
+    ThreadPool_run(pool, job.chunks, fn(_scatter), &job);
+    free(job.histogram);
+    return true;
+}
+
+typedef struct {
+    fn(Tuple) * in;
+    fn(Tuple) * out;
+    const size_t * coarse;      // first pass bounds
+    size_t * fine;              // final bounds, 2^(bits + fine_bits) + 1
+    unsigned bits;
+    unsigned fine_bits;
+} fn(_RefineJob);
+
+// Second pass: one task per first-pass partition, serial inside.
+void fn(_refine)(void * context, size_t task, size_t worker) {
+    (void) worker;
+    fn(_RefineJob) * job = context;
+
+    size_t parts = (size_t) 1 << job->fine_bits;
+    size_t first = job->coarse[task], last = job->coarse[task + 1];
+    size_t * bounds = job->fine + (task << job->fine_bits);
+    size_t counts[1 << JOIN_PASS_BITS] = { 0 };
+
+    for (size_t i = first; i < last; i++)
+        counts[_Join_bits(_Join_hash((uint64_t) job->in[i].key), job->bits, job->fine_bits)]++;
+
+    size_t running = first;
+    for (size_t part = 0; part < parts; part++) {
+        bounds[part] = running;
+        running += counts[part];
+        counts[part] = bounds[part];
+    }
+
+    for (size_t i = first; i < last; i++) {
+        size_t part = _Join_bits(_Join_hash((uint64_t) job->in[i].key), job->bits, job->fine_bits);
+        job->out[counts[part]++] = job->in[i];
+    }
+}
+
+typedef struct {
+    const fn(Tuple) * build;
+    const fn(Tuple) * probe;
+    const size_t * build_bounds;
+    const size_t * probe_bounds;
+    unsigned bits;
+    _JoinBuffer * buffers;
+    atomic_bool failed;
+} fn(_RadixJob);
+
+void fn(_join_partition)(void * context, size_t task, size_t worker) {
+    (void) worker;
+    fn(_RadixJob) * job = context;
+
+    const fn(Tuple) * build = job->build + job->build_bounds[task];
+    size_t build_size = job->build_bounds[task + 1] - job->build_bounds[task];
+    const fn(Tuple) * probe = job->probe + job->probe_bounds[task];
+    size_t probe_size = job->probe_bounds[task + 1] - job->probe_bounds[task];
+    if (build_size == 0 or probe_size == 0) return;
+
+    // The partition is small, so its table lives in cache.
+    unsigned bits = _Join_log2(build_size);
+    size_t * head = calloc((size_t) 1 << bits, sizeof(size_t));
+    size_t * next = malloc(build_size * sizeof(size_t));
+    if (not head or not next) {
+        free(head); free(next);
+        atomic_store(&job->failed, true);
+        return;
+    }
+
+    for (size_t i = build_size; i-- > 0; ) {
+        size_t bucket = _Join_bits(_Join_hash((uint64_t) build[i].key), job->bits, bits);
+        next[i] = head[bucket];
+        head[bucket] = i + 1;
+    }
+
+    _JoinBuffer * out = &job->buffers[task];
+    _JoinBuffer_reserve(out, probe_size);
+    for (size_t j = 0; j < probe_size; j++) {
+        T key = probe[j].key;
+        size_t bucket = _Join_bits(_Join_hash((uint64_t) key), job->bits, bits);
+        for (size_t i = head[bucket]; i; i = next[i - 1]) {
+            if (build[i - 1].key == key
+                and not _JoinBuffer_push(out, build[i - 1].row, probe[j].row))
+                atomic_store(&job->failed, true);
+        }
+    }
+
+    free(head);
+    free(next);
+}
+
+// Partitions ``keys`` into 2^bits partitions, in one or two passes.
+// Returns the partitioned tuples and writes their bounds.
+fn(Tuple) * fn(_radix_partition)(const T * keys, size_t size, unsigned bits,
+                                size_t * bounds, ThreadPool * pool) {
+    unsigned first_bits = bits < JOIN_PASS_BITS ? bits : JOIN_PASS_BITS;
+    unsigned fine_bits = bits - first_bits;
+
+    fn(Tuple) * tuples = malloc((size ? size : 1) * sizeof(fn(Tuple)));
+    ensure(tuples, NULL);
+
+    if (fine_bits == 0) {
+        if (fn(_partition)(keys, size, first_bits, tuples, bounds, pool)) return tuples;
+        free(tuples);
+        return NULL;
+    }
+
+    fn(Tuple) * refined = malloc((size ? size : 1) * sizeof(fn(Tuple)));
+    size_t * coarse = malloc((((size_t) 1 << first_bits) + 1) * sizeof(size_t));
+    if (not refined or not coarse
+        or not fn(_partition)(keys, size, first_bits, tuples, coarse, pool)) {
+        free(tuples); free(refined); free(coarse);
+        return NULL;
+    }
+
+    fn(_RefineJob) job = {
+        .in = tuples, .out = refined, .coarse = coarse, .fine = bounds,
+        .bits = first_bits, .fine_bits = fine_bits,
+    };
+    ThreadPool_run(pool, (size_t) 1 << first_bits, fn(_refine), &job);
+    bounds[(size_t) 1 << bits] = size;
+
+    free(coarse);
+    free(tuples);
+    return refined;
+}
+
+// Join >> radix(left: *Array<T>, right: *Array<T>, pool: *ThreadPool) -> *JoinPairs
+//
+// Joins with a radix-partitioned hash join.
+// Both sides are split by hash so each build partition fits
+// JOIN_CACHE_BYTES, then partition pairs are joined in parallel.
+// See ``Join(T, hash)`` for the parameters.
+//
+JoinPairs * fn(radix)(Array(T) * left, Array(T) * right, ThreadPool * pool) {
+    ensure(left and right, NULL);
+
+    size_t build_size = Array(T, size)(left);
+    size_t probe_size = Array(T, size)(right);
+
+    size_t partitions_needed = build_size * sizeof(fn(Tuple)) / JOIN_CACHE_BYTES;
+    unsigned bits = _Join_log2(partitions_needed ? partitions_needed : 1);
+    if (bits > 2 * JOIN_PASS_BITS) bits = 2 * JOIN_PASS_BITS;
+    if (bits == 0) return fn(hash)(left, right, pool);
+
+    size_t parts = (size_t) 1 << bits;
+    size_t * build_bounds = malloc((parts + 1) * sizeof(size_t));
+    size_t * probe_bounds = malloc((parts + 1) * sizeof(size_t));
+    _JoinBuffer * buffers = calloc(parts, sizeof(_JoinBuffer));
+
+    fn(Tuple) * build = (build_bounds and probe_bounds and buffers)
+        ? fn(_radix_partition)(left->data, build_size, bits, build_bounds, pool) : NULL;
+    fn(Tuple) * probe = build
+        ? fn(_radix_partition)(right->data, probe_size, bits, probe_bounds, pool) : NULL;
+
+    if (not probe) {
+        free(build); free(build_bounds); free(probe_bounds); free(buffers);
+        return NULL;
+    }
+
+    fn(_RadixJob) job = {
+        .build = build, .probe = probe,
+        .build_bounds = build_bounds, .probe_bounds = probe_bounds,
+        .bits = bits, .buffers = buffers,
+    };
+    atomic_init(&job.failed, false);
+    ThreadPool_run(pool, parts, fn(_join_partition), &job);
+
+    free(build);
+    free(probe);
+    free(build_bounds);
+    free(probe_bounds);
+    return _Join_collect(buffers, parts, not atomic_load(&job.failed));
+}
+
+
+// ~~~~~~~~ Sort-merge join ~~~~~~~~
+
+typedef struct {
+    const T * left;
+    size_t left_size;
+    const T * right;
+    size_t right_size;
+    size_t chunks;
+    _JoinBuffer * buffers;
+    atomic_bool failed;
+} fn(_MergeJob);
+
+// Start of chunk ``task``, moved forward so a run of equal keys
+// never straddles two chunks.
+size_t fn(_merge_bound)(fn(_MergeJob) * job, size_t task) {
+    size_t at = task * job->left_size / job->chunks;
+    while (at > 0 and at < job->left_size and job->left[at] == job->left[at - 1]) at++;
+    return at;
+}
+
+void fn(_merge_chunk)(void * context, size_t task, size_t worker) {
+    (void) worker;
+    fn(_MergeJob) * job = context;
+
+    size_t i = fn(_merge_bound)(job, task);
+    size_t end = fn(_merge_bound)(job, task + 1);
+    if (i >= end) return;
+
+    // First right row not less than our first key.
+    size_t low = 0, high = job->right_size;
+    while (low < high) {
+        size_t middle = low + (high - low) / 2;
+        if (job->right[middle] < job->left[i]) low = middle + 1;
+        else high = middle;
+    }
+
+    _JoinBuffer * out = &job->buffers[task];
+    size_t j = low;
+    while (i < end and j < job->right_size) {
+        T key = job->left[i];
+        if (key < job->right[j]) { i++; continue; }
+        if (job->right[j] < key) { j++; continue; }
+
+        size_t left_run = i, right_run = j;
+        while (left_run < end and job->left[left_run] == key) left_run++;
+        while (right_run < job->right_size and job->right[right_run] == key) right_run++;
+
+        for (size_t a = i; a < left_run; a++)
+            for (size_t b = j; b < right_run; b++)
+                if (not _JoinBuffer_push(out, a, b)) atomic_store(&job->failed, true);
+
+        i = left_run;
+        j = right_run;
+    }
+}
+
+// Join >> merge(left: *Array<T>, right: *Array<T>, pool: *ThreadPool) -> *JoinPairs
+//
+// Joins two Arrays sorted in ascending order.
+// ``left`` is split into chunks on key boundaries, and every chunk
+// binary searches its start in ``right`` before merging.
+// See ``Join(T, hash)`` for the parameters.
+//
+JoinPairs * fn(merge)(Array(T) * left, Array(T) * right, ThreadPool * pool) {
+    ensure(left and right, NULL);
+
+    fn(_MergeJob) job = {
+        .left = left->data, .left_size = Array(T, size)(left),
+        .right = right->data, .right_size = Array(T, size)(right),
+        .chunks = ThreadPool_workers(pool) * JOIN_CHUNKS_PER_WORKER,
+    };
+    atomic_init(&job.failed, false);
+    job.buffers = calloc(job.chunks, sizeof(_JoinBuffer));
+    ensure(job.buffers, NULL);
+
+    ThreadPool_run(pool, job.chunks, fn(_merge_chunk), &job);
+    return _Join_collect(job.buffers, job.chunks, not atomic_load(&job.failed));
+}
+
+#undef MODULE
+#undef Self
+#undef fn
+#undef T
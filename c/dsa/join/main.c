@@ -0,0 +1,112 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdint.h>
+#include <stdio.h>
+#include <time.h>
+
+#define T size_t
+#define PRINT_T(value) printf("%zu", value)
+#include "../array/array.h"
+
+#define T uint64_t
+#define PRINT_T(value) printf("%llu", (unsigned long long) value)
+#include "../array/array.h"
+
+#define T uint64_t
+#include "join.h"
+
+double seconds() {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec + now.tv_nsec * 1e-9;
+}
+
+uint64_t next_random(uint64_t * seed) {
+    *seed = *seed * 6364136223846793005ull + 1442695040888963407ull;
+    return *seed >> 33;
+}
+
+// Order-independent fingerprint of the matches.
+uint64_t fingerprint(JoinPairs * pairs) {
+    uint64_t total = 0;
+    for (size_t k = 0; k < JoinPairs_size(pairs); k++)
+        total += _Join_hash(pairs->left->data[k] * 0x100000001ull + pairs->right->data[k]);
+    return total;
+}
+
+int main() {
+
+    ThreadPool * pool = ThreadPool_new(0);
+    uint64_t seed = 42;
+
+    // Correctness: sorted keys with duplicates on both sides.
+    size_t size = 100000;
+    Array(uint64_t) * left = Array(uint64_t, new)(size);
+    Array(uint64_t) * right = Array(uint64_t, new)(size);
+    for (size_t i = 0; i < size; i++) {
+        left->data[i] = i / 3;
+        right->data[i] = i / 2 + next_random(&seed) % 3;
+    }
+    for (size_t i = 1; i < size; i++)
+        if (right->data[i] < right->data[i - 1]) right->data[i] = right->data[i - 1];
+
+    JoinPairs * hashed = Join(uint64_t, hash)(left, right, pool);
+    JoinPairs * radix = Join(uint64_t, radix)(left, right, pool);
+    JoinPairs * merged = Join(uint64_t, merge)(left, right, pool);
+
+    printf("matches: hash %zu, radix %zu, merge %zu -> %s\n\n",
+        JoinPairs_size(hashed), JoinPairs_size(radix), JoinPairs_size(merged),
+        JoinPairs_size(hashed) == JoinPairs_size(radix)
+            and JoinPairs_size(hashed) == JoinPairs_size(merged)
+            and fingerprint(hashed) == fingerprint(radix)
+            and fingerprint(hashed) == fingerprint(merged) ? "agree" : "differ");
+
+    JoinPairs_delete(hashed);
+    JoinPairs_delete(radix);
+    JoinPairs_delete(merged);
+    Array(uint64_t, delete)(left);
+    Array(uint64_t, delete)(right);
+
+    // Throughput: a growing build side against a fixed 4M-row probe side,
+    // where every probe key matches exactly one build row.
+    size_t probe_size = (size_t) 1 << 22;
+    printf("%zu workers, %zu probe rows, JOIN_CACHE_BYTES = %d\n",
+        ThreadPool_workers(pool), probe_size, JOIN_CACHE_BYTES);
+    printf("%10s %14s %14s\n", "build rows", "hash M/s", "radix M/s");
+
+    for (size_t build_size = (size_t) 1 << 12; build_size <= (size_t) 1 << 22; build_size <<= 2) {
+        Array(uint64_t) * build = Array(uint64_t, new)(build_size);
+        Array(uint64_t) * probe = Array(uint64_t, new)(probe_size);
+        for (size_t i = 0; i < build_size; i++) build->data[i] = i * 7 + 1;
+        for (size_t i = 0; i < build_size; i++) {
+            size_t j = next_random(&seed) % (i + 1);
+            uint64_t swap = build->data[i];
+            build->data[i] = build->data[j];
+            build->data[j] = swap;
+        }
+        for (size_t i = 0; i < probe_size; i++)
+            probe->data[i] = build->data[next_random(&seed) % build_size];
+
+        double start = seconds();
+        JoinPairs * plain = Join(uint64_t, hash)(build, probe, pool);
+        double plain_time = seconds() - start;
+
+        start = seconds();
+        JoinPairs * partitioned = Join(uint64_t, radix)(build, probe, pool);
+        double radix_time = seconds() - start;
+
+        printf("%10zu %14.1f %14.1f%s\n", build_size,
+            probe_size / plain_time / 1e6, probe_size / radix_time / 1e6,
+            JoinPairs_size(plain) == probe_size
+                and fingerprint(plain) == fingerprint(partitioned) ? "" : "  (differ)");
+
+        JoinPairs_delete(plain);
+        JoinPairs_delete(partitioned);
+        Array(uint64_t, delete)(build);
+        Array(uint64_t, delete)(probe);
+    }
+
+    ThreadPool_delete(pool);
+    return 0;
+
+}
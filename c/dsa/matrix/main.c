@@ -0,0 +1,129 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <math.h>
+#include <stdio.h>
+#include <time.h>
+
+#define T double
+#define PRINT_T(value) printf("%g", value)
+#include "../array/array.h"
+
+#define T double
+#define PRINT_T(value) printf("%g", value)
+#include "matrix.h"
+
+// Build with -O2 -march=native (or -mavx2 -mfma) for the FMA micro-kernel.
+
+double seconds() {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec + now.tv_nsec * 1e-9;
+}
+
+Matrix(double) * random_matrix(size_t rows, size_t cols, uint64_t seed) {
+    Matrix(double) * matrix = Matrix(double, new)(rows, cols);
+    for (size_t i = 0; i < rows * cols; i++) {
+        seed = seed * 6364136223846793005ull + 1442695040888963407ull;
+        matrix->storage->data[i] = (double) (seed >> 11) / 9007199254740992.0 - 0.5;
+    }
+    return matrix;
+}
+
+// The triple loop we had before.
+void mul_naive(Matrix(double) * c, Matrix(double) * a, Matrix(double) * b) {
+    size_t n = a->_rows, m = b->_cols, p = a->_cols;
+    for (size_t i = 0; i < n; i++)
+        for (size_t j = 0; j < m; j++) {
+            double sum = 0.0;
+            for (size_t k = 0; k < p; k++)
+                sum += a->storage->data[i * p + k] * b->storage->data[k * m + j];
+            c->storage->data[i * m + j] = sum;
+        }
+}
+
+int main() {
+
+    Matrix(double) * a = Matrix(double, new)(2, 3);
+    Matrix(double) * b = Matrix(double, new)(3, 2);
+    for (size_t i = 0; i < 6; i++) a->storage->data[i] = b->storage->data[i] = i + 1;
+    Matrix(double) * c = Matrix(double, mul)(a, b, NULL);
+    Matrix(double) * at = Matrix(double, transpose)(a);
+    printf("a * b =\n"); Matrix(double, println)(c);
+    printf("transpose(a) =\n"); Matrix(double, println)(at);
+    Matrix(double, delete)(a);
+    Matrix(double, delete)(b);
+    Matrix(double, delete)(c);
+    Matrix(double, delete)(at);
+
+    ThreadPool * pool = ThreadPool_new(0);
+#ifdef MATRIX_AVX2
+    const char * kernel = "AVX2/FMA 6x8";
+#else
+    const char * kernel = "portable 6x8";
+#endif
+    printf("\nGFLOPS, %s kernel, %zu workers\n", kernel, ThreadPool_workers(pool));
+    printf("%6s %10s %10s %10s %12s\n", "n", "naive", "blocked", "parallel", "max error");
+
+    for (size_t n = 64; n <= 4096; n *= 2) {
+        a = random_matrix(n, n, n);
+        b = random_matrix(n, n, n + 1);
+        c = Matrix(double, new)(n, n);
+        double flops = 2.0 * n * n * n;
+
+        double start = seconds();
+        Matrix(double, mul_into)(c, a, b, NULL);
+        double blocked = seconds() - start;
+
+        start = seconds();
+        Matrix(double, mul_into)(c, a, b, pool);
+        double parallel = seconds() - start;
+
+        // The naive loop takes minutes beyond 1024.
+        if (n <= 1024) {
+            Matrix(double) * expected = Matrix(double, new)(n, n);
+            start = seconds();
+            mul_naive(expected, a, b);
+            double naive = seconds() - start;
+
+            double error = 0.0;
+            for (size_t i = 0; i < n * n; i++)
+                error = fmax(error, fabs(expected->storage->data[i] - c->storage->data[i]));
+            printf("%6zu %10.2f %10.2f %10.2f %12.2e\n", n,
+                flops / naive / 1e9, flops / blocked / 1e9, flops / parallel / 1e9, error);
+            Matrix(double, delete)(expected);
+        } else {
+            printf("%6zu %10s %10.2f %10.2f %12s\n", n,
+                "-", flops / blocked / 1e9, flops / parallel / 1e9, "-");
+        }
+
+        Matrix(double, delete)(a);
+        Matrix(double, delete)(b);
+        Matrix(double, delete)(c);
+    }
+
+    // Transpose: row-by-row loop against the recursive one.
+    size_t n = 4096;
+    a = random_matrix(n, n, 3);
+    b = Matrix(double, new)(n, n);
+    double start = seconds();
+    for (size_t i = 0; i < n; i++)
+        for (size_t j = 0; j < n; j++)
+            b->storage->data[j * n + i] = a->storage->data[i * n + j];
+    double naive = seconds() - start;
+
+    start = seconds();
+    Matrix(double) * t = Matrix(double, transpose)(a);
+    double recursive = seconds() - start;
+
+    printf("\ntranspose %zux%zu: naive %.1f GB/s, cache-oblivious %.1f GB/s, %s\n", n, n,
+        2.0 * n * n * sizeof(double) / naive / 1e9,
+        2.0 * n * n * sizeof(double) / recursive / 1e9,
+        memcmp(b->storage->data, t->storage->data, n * n * sizeof(double)) ? "differ" : "agree");
+
+    Matrix(double, delete)(a);
+    Matrix(double, delete)(b);
+    Matrix(double, delete)(t);
+    ThreadPool_delete(pool);
+    return 0;
+
+}
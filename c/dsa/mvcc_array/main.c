@@ -0,0 +1,131 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdint.h>
+#include <stdio.h>
+#include <time.h>
+
+#include "../thread_pool/thread_pool.h"
+
+#define T int64_t
+#define PRINT_T(value) printf("%lld", (long long) value)
+#include "mvcc_array.h"
+
+// Usage: ./main [size] [batches] [threads], defaults to 2^20 accounts,
+// 200 batches of 2000 transfers, and 8 threads: one writer, the rest scan.
+
+typedef MvccArray(int64_t) Accounts;
+
+double seconds() {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec + now.tv_nsec * 1e-9;
+}
+
+uint64_t next_random(uint64_t * seed) {
+    *seed = *seed * 6364136223846793005ull + 1442695040888963407ull;
+    return *seed >> 32;
+}
+
+// Transfers move money between accounts, so every consistent view
+// has the same total: a scan that sees half a batch is caught.
+typedef struct {
+    Accounts * accounts;
+    size_t batches;
+    int64_t total;
+    _Atomic bool writing;
+    _Atomic size_t scans;
+    _Atomic size_t inconsistent;
+    _Atomic size_t peak_versions;
+    double scan_time;
+} Job;
+
+void transfer(Job * job) {
+    uint64_t seed = 11;
+    size_t size = MvccArray(int64_t, size)(job->accounts);
+    for (size_t b = 0; b < job->batches; b++) {
+        MvccArray(int64_t, begin_write)(job->accounts);
+        for (size_t t = 0; t < 2000; t++) {
+            size_t from = next_random(&seed) % size, to = next_random(&seed) % size;
+            int64_t amount = (int64_t) (next_random(&seed) % 100);
+            MvccArray(int64_t, set)(job->accounts, from, *MvccArray(int64_t, staged)(job->accounts, from) - amount);
+            MvccArray(int64_t, set)(job->accounts, to, *MvccArray(int64_t, staged)(job->accounts, to) + amount);
+        }
+        MvccArray(int64_t, commit)(job->accounts);
+
+        size_t versions = MvccArray(int64_t, versions)(job->accounts);
+        if (versions > atomic_load(&job->peak_versions)) atomic_store(&job->peak_versions, versions);
+    }
+    atomic_store(&job->writing, false);
+}
+
+void run(void * context, size_t task, size_t worker) {
+    Job * job = context;
+    if (task == 0) {
+        transfer(job);
+        return;
+    }
+
+    size_t size = MvccArray(int64_t, size)(job->accounts);
+    do {
+        MvccArray(int64_t, Snapshot) view = MvccArray(int64_t, begin_read)(job->accounts, worker);
+        int64_t total = 0;
+        size_t count = 0;
+        for (size_t i = 0; i < size; i += count) {
+            int64_t * run = MvccArray(int64_t, view)(&view, i, &count);
+            for (size_t j = 0; j < count; j++) total += run[j];
+        }
+        MvccArray(int64_t, end_read)(&view);
+
+        atomic_fetch_add(&job->scans, 1);
+        if (total != job->total) atomic_fetch_add(&job->inconsistent, 1);
+    } while (atomic_load(&job->writing));
+}
+
+int main(int argc, char ** argv) {
+
+    Accounts * small = MvccArray(int64_t, new)(6, 2);
+    MvccArray(int64_t, Snapshot) before = MvccArray(int64_t, begin_read)(small, 1);
+    MvccArray(int64_t, begin_write)(small);
+    MvccArray(int64_t, set)(small, 0, 10);
+    MvccArray(int64_t, set)(small, 5, -10);
+    MvccArray(int64_t, commit)(small);
+    MvccArray(int64_t, debug)(small, 0);
+    printf("still open: "); MvccArray(int64_t, println)(&before);
+    MvccArray(int64_t, end_read)(&before);
+    size_t versions = MvccArray(int64_t, versions)(small);
+    MvccArray(int64_t, collect)(small);
+    printf("versions: %zu, after collecting %zu\n\n", versions, MvccArray(int64_t, versions)(small));
+    MvccArray(int64_t, delete)(small);
+
+    size_t size = argc > 1 ? (size_t) atoll(argv[1]) : (size_t) 1 << 20;
+    size_t batches = argc > 2 ? (size_t) atoll(argv[2]) : 200;
+    size_t threads = argc > 3 ? (size_t) atoll(argv[3]) : 8;
+    if (threads < 2) threads = 2;              // a writer and a reader
+    printf("%zu accounts, %zu batches, %zu threads, %zu cores\n", size, batches, threads, ThreadPool_cores());
+
+    Job job = { .accounts = MvccArray(int64_t, new)(size, threads), .batches = batches };
+    MvccArray(int64_t, begin_write)(job.accounts);
+    for (size_t i = 0; i < size; i++) MvccArray(int64_t, set)(job.accounts, i, 1000);
+    MvccArray(int64_t, commit)(job.accounts);
+    job.total = (int64_t) size * 1000;
+    atomic_init(&job.writing, true);
+    atomic_init(&job.scans, 0);
+    atomic_init(&job.inconsistent, 0);
+    atomic_init(&job.peak_versions, 0);
+
+    ThreadPool * pool = ThreadPool_new(threads);
+    double start = seconds();
+    ThreadPool_run(pool, threads, run, &job);
+    double elapsed = seconds() - start;
+
+    printf("%zu commits in %.2f s while %zu full scans ran, %zu inconsistent\n",
+        batches, elapsed, atomic_load(&job.scans), atomic_load(&job.inconsistent));
+    MvccArray(int64_t, collect)(job.accounts);
+    printf("chunk versions: %zu current, peak %zu alive, %zu after the last reader\n",
+        (size + MVCC_CHUNK - 1) / MVCC_CHUNK, atomic_load(&job.peak_versions), MvccArray(int64_t, versions)(job.accounts));
+
+    ThreadPool_delete(pool);
+    MvccArray(int64_t, delete)(job.accounts);
+    return 0;
+
+}
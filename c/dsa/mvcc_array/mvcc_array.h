@@ -0,0 +1,623 @@
+// ============
+// MvccArray<T>
+// ============
+//
+// :Author: RickBarretto
+// :Year: 2026
+// :License: MPL 2.0
+// :Copyright: RickBarretto, 2026
+// :Version: 1.0
+//
+// ``MvccArray<T>`` is a fixed-size array with multi-version concurrency
+// control: long scans see one consistent state of the array while
+// a writer applies thousands of changes to it, and never wait for it.
+//
+// The array is split into chunks of MVCC_CHUNK elements. Every chunk
+// is a chain of versions, newest first, each stamped with the commit
+// that made it. A reader takes a snapshot with ``begin_read``, which
+// is the current commit stamp, and sees in each chunk the newest
+// version not newer than it.
+//
+// A writer stages a batch with ``begin_write`` and ``set``: the first
+// change to a chunk copies its newest version (copy-on-write at chunk
+// granularity), the next ones edit the copy. ``commit`` links every
+// copy at the head of its chain and only then advances the commit stamp,
+// so readers see the whole batch or none of it. ``abort`` drops it.
+//
+// After each commit, versions that no snapshot can reach any more,
+// i.e. older than the newest one visible to the oldest running reader,
+// are freed. A reader that stays open keeps its versions alive.
+//
+// Threads are numbered, like ``ThreadPool`` workers: ``begin_read``
+// names the calling thread's index, which holds one snapshot at a time.
+// Writers are serialized by a lock that readers never take.
+//
+// How to Use
+// ----------
+//
+//      #define T int64_t
+//      #define PRINT_T(value) printf("%lld", (long long) value)
+//      #include "mvcc_array.h"
+//
+// And a common way to use it would be:
+//
+//      MvccArray(int64_t) * balances = MvccArray(int64_t, new)(size, threads);
+//
+//      MvccArray(int64_t, begin_write)(balances);                 // writers
+//      MvccArray(int64_t, set)(balances, from, *from_balance - 10);
+//      MvccArray(int64_t, set)(balances, to, *to_balance + 10);
+//      MvccArray(int64_t, commit)(balances);
+//
+//      MvccArray(int64_t, Snapshot) view = MvccArray(int64_t, begin_read)(balances, worker);
+//      size_t count = 0;
+//      for (size_t i = 0; i < size; i += count) {                 // readers
+//          int64_t * run = MvccArray(int64_t, view)(&view, i, &count);
+//          ...
+//      }
+//      MvccArray(int64_t, end_read)(&view);
+//
+// Link with ``-pthread``.
+//
+
+// =~=~=~=~=~=~=~=~ Imports ~=~=~=~=~=~=~=~=
+
+#include <iso646.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+// =~=~=~=~=~=~=~=~ Helper Macros ~=~=~=~=~=~=~=~=
+
+#define _CAT(X, Y) X ## _ ## Y
+#define CAT(X, Y) _CAT(X, Y)
+#define _CAT3(X, Y, Z) X ## _ ## Y ## _ ## Z
+#define CAT3(X, Y, Z) _CAT3(X, Y, Z)
+
+#define STRINGIFY(x) #x
+#define TOSTRING(x) STRINGIFY(x)
+
+#define ensure(COND, VAL) if (not (COND)) return VAL
+
+
+// =~=~=~=~=~=~=~=~ Allocator Hooks ~=~=~=~=~=~=~=~=
+
+// The same hooks as ``Array<T>``, see its documentation.
+
+#ifndef ARRAY_MALLOC
+#define ARRAY_MALLOC(size) malloc(size)
+#endif
+
+#ifndef ARRAY_CALLOC
+#define ARRAY_CALLOC(count, size) calloc(count, size)
+#endif
+
+#ifndef ARRAY_REALLOC
+#define ARRAY_REALLOC(pointer, size) realloc(pointer, size)
+#endif
+
+#ifndef ARRAY_FREE
+#define ARRAY_FREE(pointer) free(pointer)
+#endif
+
+
+// =~=~=~=~=~=~=~=~ Shared helpers ~=~=~=~=~=~=~=~=
+
+#ifndef MVCC_ARRAY_HELPERS
+#define MVCC_ARRAY_HELPERS
+
+// MVCC_CHUNK: Elements per chunk, the unit of copy-on-write.
+#ifndef MVCC_CHUNK
+#define MVCC_CHUNK 1024
+#endif
+
+// A reader's snapshot stamp, one cache line apart from the others. 0 while idle.
+typedef struct {
+    _Alignas(64) _Atomic uint64_t stamp;
+} _MvccReader;
+
+#endif
+
+
+// =~=~=~=~=~=~=~=~ Implementation ~=~=~=~=~=~=~=~=
+
+// T: Element type of the MvccArray<T>
+#ifndef T
+#error "T is not defined"
+#endif
+
+// PRINT_T: (T) -> void
+//
+// PRINT_T is a macro that defines how to print an element of type T.
+// See ``Array<T>`` for more details.
+//
+#ifndef PRINT_T
+#error "PRINT_T is not defined"
+#endif
+
+#define MODULE MvccArray
+#define Self CAT(MODULE, T)
+#define fn(NAME) CAT(Self, NAME)
+
+#define _MVCC_ARRAY_SELECT_MACRO(_1, _2, NAME, ...) NAME
+#define MvccArray(...) _MVCC_ARRAY_SELECT_MACRO(__VA_ARGS__, MvccArray2, MvccArray1)(__VA_ARGS__)
+#define MvccArray1(T) CAT(MvccArray, T)
+#define MvccArray2(T, FUNC) CAT3(MvccArray, T, FUNC)
+
+typedef struct fn(_Version) fn(_Version);
+
+struct fn(_Version) {
+    uint64_t stamp;             // the commit that made it
+    fn(_Version) * older;
+    T values[MVCC_CHUNK];
+};
+
+typedef struct {
+    _Atomic(fn(_Version) *) * chunks;   // the newest version of each chunk
+    _MvccReader * readers;
+    void * _memory;                     // ``readers`` before alignment
+    size_t _size;
+    size_t _chunks;
+    size_t _threads;
+    _Atomic uint64_t _clock;            // the last commit
+    _Atomic size_t _versions;           // alive, including the newest ones
+
+    // Writer state, under ``_lock``.
+    pthread_mutex_t _lock;
+    fn(_Version) ** _staged;            // per chunk, NULL if untouched
+    size_t * _touched;                  // chunks staged in this batch
+    size_t _batch;
+    size_t * _chains;                   // chunks with older versions
+    size_t _chained;
+    bool * _in_chains;
+} Self;
+
+typedef struct {
+    Self * mvcc;
+    size_t thread;
+    uint64_t stamp;
+} fn(Snapshot);
+
+
+// ~~~~~~~~ Versions ~~~~~~~~
+
+// The version of ``chunk`` a snapshot at ``stamp`` sees.
+fn(_Version) * fn(_visible)(Self * mvcc, size_t chunk, uint64_t stamp) {
+    fn(_Version) * version = atomic_load_explicit(&mvcc->chunks[chunk], memory_order_acquire);
+    while (version->stamp > stamp) version = version->older;
+    return version;
+}
+
+// The oldest stamp any reader may still use, given the current clock.
+uint64_t fn(_horizon)(Self * mvcc) {
+    uint64_t horizon = atomic_load(&mvcc->_clock);
+    atomic_thread_fence(memory_order_seq_cst);
+    for (size_t i = 0; i < mvcc->_threads; i++) {
+        uint64_t stamp = atomic_load(&mvcc->readers[i].stamp);
+        if (stamp and stamp < horizon) horizon = stamp;
+    }
+    return horizon;
+}
+
+// Frees the versions behind the newest one visible at the horizon.
+// Under the writer lock: readers never go past that version.
+size_t fn(_collect)(Self * mvcc) {
+    uint64_t horizon = fn(_horizon)(mvcc);
+    size_t freed = 0, kept = 0;
+
+    for (size_t i = 0; i < mvcc->_chained; i++) {
+        size_t chunk = mvcc->_chains[i];
+        fn(_Version) * keep = fn(_visible)(mvcc, chunk, horizon);
+        fn(_Version) * old = keep->older;
+        keep->older = NULL;
+        for (; old; freed++) {
+            fn(_Version) * next = old->older;
+            ARRAY_FREE(old);
+            old = next;
+        }
+
+        bool chained = atomic_load_explicit(&mvcc->chunks[chunk], memory_order_relaxed)->older != NULL;
+        if (chained) mvcc->_chains[kept++] = chunk;
+        else mvcc->_in_chains[chunk] = false;
+    }
+    mvcc->_chained = kept;
+    atomic_fetch_sub_explicit(&mvcc->_versions, freed, memory_order_relaxed);
+    return freed;
+}
+
+
+// ~~~~~~~~ Lifetime ~~~~~~~~
+
+// MvccArray >> delete(mvcc: *MvccArray<T>) -> bool
+//
+// Deletes the array and every version. No reader nor writer may be running.
+//
+// Returns
+// -------
+// bool: Returns true on success.
+//
+bool fn(delete)(Self * mvcc) {
+    ensure(mvcc, false);
+
+    for (size_t chunk = 0; mvcc->chunks and mvcc->_staged and chunk < mvcc->_chunks; chunk++) {
+        ARRAY_FREE(mvcc->_staged[chunk]);
+        fn(_Version) * version = atomic_load(&mvcc->chunks[chunk]);
+        while (version) {
+            fn(_Version) * older = version->older;
+            ARRAY_FREE(version);
+            version = older;
+        }
+    }
+    pthread_mutex_destroy(&mvcc->_lock);
+    ARRAY_FREE(mvcc->chunks);
+    ARRAY_FREE(mvcc->_memory);
+    ARRAY_FREE(mvcc->_staged);
+    ARRAY_FREE(mvcc->_touched);
+    ARRAY_FREE(mvcc->_chains);
+    ARRAY_FREE(mvcc->_in_chains);
+    ARRAY_FREE(mvcc);
+    return true;
+}
+
+// MvccArray >> new(size: size_t, threads: size_t) -> *MvccArray<T>
+//
+// Creates an array of ``size`` zeros, read by up to ``threads`` thread indices.
+//
+// Returns
+// -------
+// *MvccArray<T>: The new array, or NULL on failure.
+//
+Self * fn(new)(size_t size, size_t threads) {
+    ensure(threads > 0, NULL);
+
+    Self * mvcc = ARRAY_CALLOC(1, sizeof(Self));
+    ensure(mvcc, NULL);
+
+    size_t chunks = size ? (size + MVCC_CHUNK - 1) / MVCC_CHUNK : 1;
+    mvcc->_size = size;
+    mvcc->_chunks = chunks;
+    mvcc->_threads = threads;
+    atomic_init(&mvcc->_clock, 1);
+    atomic_init(&mvcc->_versions, 0);
+    pthread_mutex_init(&mvcc->_lock, NULL);
+
+    // Reader stamps are aligned to cache lines by hand, past the hooks.
+    mvcc->_memory = ARRAY_MALLOC(threads * sizeof(_MvccReader) + 64);
+    mvcc->chunks = ARRAY_CALLOC(chunks, sizeof(*mvcc->chunks));
+    mvcc->_staged = ARRAY_CALLOC(chunks, sizeof(fn(_Version) *));
+    mvcc->_touched = ARRAY_MALLOC(chunks * sizeof(size_t));
+    mvcc->_chains = ARRAY_MALLOC(chunks * sizeof(size_t));
+    mvcc->_in_chains = ARRAY_CALLOC(chunks, sizeof(bool));
+    if (not mvcc->_memory or not mvcc->chunks or not mvcc->_staged
+        or not mvcc->_touched or not mvcc->_chains or not mvcc->_in_chains) {
+        fn(delete)(mvcc);
+        return NULL;
+    }
+
+    mvcc->readers = (_MvccReader *) (((uintptr_t) mvcc->_memory + 63) & ~(uintptr_t) 63);
+    for (size_t i = 0; i < threads; i++) atomic_init(&mvcc->readers[i].stamp, 0);
+
+    for (size_t chunk = 0; chunk < chunks; chunk++) {
+        fn(_Version) * version = ARRAY_CALLOC(1, sizeof(fn(_Version)));
+        atomic_init(&mvcc->chunks[chunk], version);
+        if (not version) {
+            fn(delete)(mvcc);
+            return NULL;
+        }
+        version->stamp = 1;
+        atomic_fetch_add_explicit(&mvcc->_versions, 1, memory_order_relaxed);
+    }
+    return mvcc;
+}
+
+// MvccArray >> size(mvcc: *MvccArray<T>) -> size_t
+//
+// Returns the number of elements.
+//
+size_t fn(size)(Self * mvcc) {
+    ensure(mvcc, 0);
+    return mvcc->_size;
+}
+
+// MvccArray >> versions(mvcc: *MvccArray<T>) -> size_t
+//
+// Returns the number of chunk versions alive, the current ones included.
+//
+size_t fn(versions)(Self * mvcc) {
+    ensure(mvcc, 0);
+    return atomic_load_explicit(&mvcc->_versions, memory_order_relaxed);
+}
+
+
+// ~~~~~~~~ Readers ~~~~~~~~
+
+// MvccArray >> begin_read(mvcc: *MvccArray<T>, thread: size_t) -> MvccArray<T>.Snapshot
+//
+// Takes a snapshot of the last commit. Reads through it see that commit
+// and nothing later, until ``end_read``. Never blocks.
+//
+// Parameters
+// ----------
+// mvcc : *MvccArray<T>
+//     The array to read.
+// thread : size_t
+//     The index of the calling thread, with no other snapshot open.
+//
+// Returns
+// -------
+// MvccArray<T>.Snapshot: The snapshot, with a stamp of 0 on an invalid thread.
+//
+fn(Snapshot) fn(begin_read)(Self * mvcc, size_t thread) {
+    fn(Snapshot) snapshot = { mvcc, thread, 0 };
+    ensure(mvcc and thread < mvcc->_threads, snapshot);
+
+    // Announce the stamp, then check it is still the last commit: either
+    // the collector sees the announcement, or this sees its commit and retries.
+    _Atomic uint64_t * announced = &mvcc->readers[thread].stamp;
+    uint64_t stamp = atomic_load(&mvcc->_clock);
+    while (true) {
+        atomic_store(announced, stamp);
+        atomic_thread_fence(memory_order_seq_cst);
+        uint64_t clock = atomic_load(&mvcc->_clock);
+        if (clock == stamp) break;
+        stamp = clock;
+    }
+    snapshot.stamp = stamp;
+    return snapshot;
+}
+
+// MvccArray >> end_read(snapshot: *MvccArray<T>.Snapshot) -> void
+//
+// Releases the snapshot, letting its versions be collected.
+// Pointers read through it must not be used after.
+//
+void fn(end_read)(fn(Snapshot) * snapshot) {
+    ensure(snapshot and snapshot->stamp,);
+
+    atomic_store_explicit(&snapshot->mvcc->readers[snapshot->thread].stamp, 0, memory_order_release);
+    snapshot->stamp = 0;
+}
+
+// MvccArray >> get(snapshot: *MvccArray<T>.Snapshot, index: size_t) -> *T
+//
+// Gets a pointer to the element at ``index`` as of the snapshot, for reading.
+//
+// Returns
+// -------
+// *T: A pointer to the element, or NULL if the index is out of bounds.
+//
+T * fn(get)(fn(Snapshot) * snapshot, size_t index) {
+    ensure(snapshot and snapshot->stamp and index < snapshot->mvcc->_size, NULL);
+
+    fn(_Version) * version = fn(_visible)(snapshot->mvcc, index / MVCC_CHUNK, snapshot->stamp);
+    return &version->values[index % MVCC_CHUNK];
+}
+
+// MvccArray >> view(snapshot: *MvccArray<T>.Snapshot, index: size_t, count: *size_t) -> *T
+//
+// Gets the run of elements from ``index`` to the end of its chunk,
+// as of the snapshot, so scans resolve a version once per chunk.
+//
+// Parameters
+// ----------
+// snapshot : *MvccArray<T>.Snapshot
+//     The snapshot to read through.
+// index : size_t
+//     The first element of the run.
+// count : *size_t
+//     Receives the number of elements in the run.
+//
+// Returns
+// -------
+// *T: A pointer to the first element, for reading, or NULL if out of bounds.
+//
+T * fn(view)(fn(Snapshot) * snapshot, size_t index, size_t * count) {
+    T * first = fn(get)(snapshot, index);
+    ensure(first, NULL);
+
+    size_t end = (index / MVCC_CHUNK + 1) * MVCC_CHUNK;
+    if (end > snapshot->mvcc->_size) end = snapshot->mvcc->_size;
+    if (count) *count = end - index;
+    return first;
+}
+
+
+// ~~~~~~~~ Writers ~~~~~~~~
+
+// MvccArray >> begin_write(mvcc: *MvccArray<T>) -> bool
+//
+// Starts a batch, waiting for the batch of any other writer.
+// Readers are not affected.
+//
+// Returns
+// -------
+// bool: Returns true on success.
+//
+bool fn(begin_write)(Self * mvcc) {
+    ensure(mvcc, false);
+
+    pthread_mutex_lock(&mvcc->_lock);
+    mvcc->_batch = 0;
+    return true;
+}
+
+// MvccArray >> set(mvcc: *MvccArray<T>, index: size_t, value: T) -> bool
+//
+// Stages ``value`` at ``index`` in the current batch. The first change
+// to a chunk copies it; no reader sees any change before ``commit``.
+//
+// Returns
+// -------
+// bool: Returns true on success, false if the index is out of bounds
+//       or the chunk could not be copied.
+//
+bool fn(set)(Self * mvcc, size_t index, T value) {
+    ensure(mvcc and index < mvcc->_size, false);
+
+    size_t chunk = index / MVCC_CHUNK;
+    fn(_Version) * staged = mvcc->_staged[chunk];
+    if (not staged) {
+        staged = ARRAY_MALLOC(sizeof(fn(_Version)));
+        ensure(staged, false);
+
+        fn(_Version) * newest = atomic_load_explicit(&mvcc->chunks[chunk], memory_order_relaxed);
+        memcpy(staged->values, newest->values, sizeof(staged->values));
+        mvcc->_staged[chunk] = staged;
+        mvcc->_touched[mvcc->_batch++] = chunk;
+    }
+    staged->values[index % MVCC_CHUNK] = value;
+    return true;
+}
+
+// MvccArray >> staged(mvcc: *MvccArray<T>, index: size_t) -> *T
+//
+// Gets a pointer to the element at ``index`` as the writer sees it:
+// staged in this batch, or else as last committed.
+//
+// Returns
+// -------
+// *T: A pointer to the element, or NULL if the index is out of bounds.
+//
+T * fn(staged)(Self * mvcc, size_t index) {
+    ensure(mvcc and index < mvcc->_size, NULL);
+
+    size_t chunk = index / MVCC_CHUNK;
+    fn(_Version) * version = mvcc->_staged[chunk];
+    if (not version) version = atomic_load_explicit(&mvcc->chunks[chunk], memory_order_relaxed);
+    return &version->values[index % MVCC_CHUNK];
+}
+
+// MvccArray >> commit(mvcc: *MvccArray<T>) -> u64
+//
+// Publishes the batch atomically: snapshots taken from now on see all
+// of it, older ones none of it. Then frees the versions no snapshot
+// can reach, and ends the batch.
+//
+// Returns
+// -------
+// u64: The stamp of the commit, or 0 on an invalid array.
+//
+uint64_t fn(commit)(Self * mvcc) {
+    ensure(mvcc, 0);
+
+    uint64_t stamp = atomic_load(&mvcc->_clock) + 1;
+    for (size_t i = 0; i < mvcc->_batch; i++) {
+        size_t chunk = mvcc->_touched[i];
+        fn(_Version) * version = mvcc->_staged[chunk];
+        version->stamp = stamp;
+        version->older = atomic_load_explicit(&mvcc->chunks[chunk], memory_order_relaxed);
+        atomic_store_explicit(&mvcc->chunks[chunk], version, memory_order_release);
+        mvcc->_staged[chunk] = NULL;
+
+        if (not mvcc->_in_chains[chunk]) {
+            mvcc->_in_chains[chunk] = true;
+            mvcc->_chains[mvcc->_chained++] = chunk;
+        }
+    }
+    atomic_fetch_add_explicit(&mvcc->_versions, mvcc->_batch, memory_order_relaxed);
+
+    // Only now may new snapshots take the stamp, so they see every chunk of the batch.
+    atomic_store(&mvcc->_clock, stamp);
+    fn(_collect)(mvcc);
+
+    mvcc->_batch = 0;
+    pthread_mutex_unlock(&mvcc->_lock);
+    return stamp;
+}
+
+// MvccArray >> abort(mvcc: *MvccArray<T>) -> bool
+//
+// Drops every change staged in the batch, and ends it.
+//
+// Returns
+// -------
+// bool: Returns true on success.
+//
+bool fn(abort)(Self * mvcc) {
+    ensure(mvcc, false);
+
+    for (size_t i = 0; i < mvcc->_batch; i++) {
+        size_t chunk = mvcc->_touched[i];
+        ARRAY_FREE(mvcc->_staged[chunk]);
+        mvcc->_staged[chunk] = NULL;
+    }
+    mvcc->_batch = 0;
+    pthread_mutex_unlock(&mvcc->_lock);
+    return true;
+}
+
+// MvccArray >> collect(mvcc: *MvccArray<T>) -> size_t
+//
+// Frees the versions no snapshot can reach any more. ``commit`` does it
+// too; call it after long readers end, when no commit follows soon.
+//
+// Returns
+// -------
+// size_t: The number of versions freed.
+//
+size_t fn(collect)(Self * mvcc) {
+    ensure(mvcc, 0);
+
+    pthread_mutex_lock(&mvcc->_lock);
+    size_t freed = fn(_collect)(mvcc);
+    pthread_mutex_unlock(&mvcc->_lock);
+    return freed;
+}
+
+
+// ~~~~~~~~ Printing ~~~~~~~~
+
+// MvccArray >> print(snapshot: *MvccArray<T>.Snapshot) -> void
+//
+// Prints the elements as of the snapshot on terminal.
+//
+void fn(print)(fn(Snapshot) * snapshot) {
+    ensure(snapshot and snapshot->stamp,);
+
+    printf("[");
+    for (size_t i = 0; i < snapshot->mvcc->_size; i++) {
+        PRINT_T(*fn(get)(snapshot, i));
+        if (i + 1 < snapshot->mvcc->_size) printf(", ");
+    }
+    printf("]");
+}
+
+// MvccArray >> println(snapshot: *MvccArray<T>.Snapshot) -> void
+//
+// Prints the elements as of the snapshot on terminal followed by a newline.
+//
+void fn(println)(fn(Snapshot) * snapshot) {
+    fn(print)(snapshot);
+    printf("\n");
+}
+
+// MvccArray >> debug(mvcc: *MvccArray<T>, thread: size_t) -> void
+//
+// Prints the debug representation of the array, reading as ``thread``.
+//
+void fn(debug)(Self * mvcc, size_t thread) {
+    if (not mvcc) {
+        printf("MvccArray<%s> { NULL }\n", TOSTRING(T));
+        return;
+    }
+
+    fn(Snapshot) snapshot = fn(begin_read)(mvcc, thread);
+    printf("MvccArray<%s> {\n", TOSTRING(T));
+    printf("  size: %zu,\n", mvcc->_size);
+    printf("  chunks: %zu,\n", mvcc->_chunks);
+    printf("  versions: %zu,\n", fn(versions)(mvcc));
+    printf("  stamp: %llu,\n", (unsigned long long) snapshot.stamp);
+    printf("  data: "); fn(println)(&snapshot);
+    printf("}\n");
+    fn(end_read)(&snapshot);
+}
+
+#undef MODULE
+#undef Self
+#undef fn
+#undef T
+#undef PRINT_T
@@ -0,0 +1,117 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <time.h>
+
+#define T double
+#define PRINT_T(value) printf("%g", value)
+#include "../array/array.h"
+
+#define T double
+#define PRINT_T(value) printf("%g", value)
+#include "ndarray.h"
+
+double seconds() {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec + now.tv_nsec * 1e-9;
+}
+
+// What we did before: flat Array and manual index math, element by element.
+void add_by_index(NDArray(double) * out, NDArray(double) * left, NDArray(double) * bias) {
+    size_t index[3];
+    for (index[0] = 0; index[0] < out->shape[0]; index[0]++)
+        for (index[1] = 0; index[1] < out->shape[1]; index[1]++)
+            for (index[2] = 0; index[2] < out->shape[2]; index[2]++)
+                *NDArray(double, get)(out, index) = *NDArray(double, get)(left, index)
+                    + *NDArray(double, get)(bias, (size_t[]) { index[2] });
+}
+
+int main() {
+
+    // Views share the storage of their base.
+    Array(double) * values = Array(double, new)(24);
+    for (size_t i = 0; i < 24; i++) values->data[i] = i;
+
+    NDArray(double) * cube = NDArray(double, from_array)(values, 3, (size_t[]) { 2, 3, 4 });
+    NDArray(double) * swapped = NDArray(double, transpose)(cube, (size_t[]) { 2, 1, 0 });
+    NDArray(double) * middle = NDArray(double, slice)(cube, 2, 1, 3, 1);
+    NDArray(double) * flat = NDArray(double, reshape)(cube, 2, (size_t[]) { 6, 4 });
+
+    printf("cube:       "); NDArray(double, println)(cube);
+    printf("transposed: "); NDArray(double, println)(swapped);
+    printf("columns 1-2: "); NDArray(double, println)(middle);
+    printf("as 6x4:     "); NDArray(double, println)(flat);
+    printf("reshape of a transposed view: %s\n",
+        NDArray(double, reshape)(swapped, 1, (size_t[]) { 24 }) ? "view" : "NULL, copy first");
+
+    NDArray(double, fill)(middle, -1);
+    printf("after filling the slice, sum = %g\n", NDArray(double, sum)(cube));
+    NDArray(double, debug)(middle);
+
+    // Broadcasting: (2, 3, 4) + (3, 1) + (4)
+    NDArray(double) * column = NDArray(double, new)(2, (size_t[]) { 3, 1 });
+    NDArray(double) * row = NDArray(double, new)(1, (size_t[]) { 4 });
+    for (size_t i = 0; i < 3; i++) column->data[i] = 100 * (i + 1);
+    for (size_t i = 0; i < 4; i++) row->data[i] = 0.5 * i;
+
+    NDArray(double) * partial = NDArray(double, add)(cube, column);
+    NDArray(double) * result = NDArray(double, add)(partial, row);
+    printf("\ncube + column + row: "); NDArray(double, println)(result);
+
+    NDArray(double, delete)(partial);
+    NDArray(double, delete)(result);
+    NDArray(double, delete)(column);
+    NDArray(double, delete)(row);
+    NDArray(double, delete)(flat);
+    NDArray(double, delete)(middle);
+    NDArray(double, delete)(swapped);
+    NDArray(double, delete)(cube);
+
+    // Throughput on a (64, 256, 256) array.
+    size_t shape[3] = { 64, 256, 256 };
+    NDArray(double) * left = NDArray(double, new)(3, shape);
+    NDArray(double) * right = NDArray(double, new)(3, shape);
+    NDArray(double) * out = NDArray(double, new)(3, shape);
+    NDArray(double) * bias = NDArray(double, new)(1, (size_t[]) { 256 });
+    NDArray(double, fill)(left, 1.5);
+    NDArray(double, fill)(right, 2.5);
+    NDArray(double, fill)(bias, 0.25);
+    double elements = NDArray(double, size)(out);
+
+    double start = seconds();
+    add_by_index(out, left, bias);
+    double by_index = seconds() - start;
+    double expected = NDArray(double, sum)(out);
+
+    start = seconds();
+    NDArray(double, apply)(NDARRAY_ADD, out, left, bias);
+    double broadcast = seconds() - start;
+    bool agree = NDArray(double, sum)(out) == expected;
+
+    start = seconds();
+    NDArray(double, apply)(NDARRAY_ADD, out, left, right);
+    double contiguous = seconds() - start;
+
+    NDArray(double) * left_t = NDArray(double, transpose)(left, (size_t[]) { 0, 2, 1 });
+    NDArray(double) * out_t = NDArray(double, transpose)(out, (size_t[]) { 0, 2, 1 });
+    start = seconds();
+    NDArray(double, apply)(NDARRAY_ADD, out_t, left_t, bias);
+    double strided = seconds() - start;
+
+    printf("\n(64, 256, 256) doubles, M elements/s:\n");
+    printf("  index math + get:        %8.1f\n", elements / by_index / 1e6);
+    printf("  broadcast row, 2 axes:   %8.1f  (%s)\n",
+        elements / broadcast / 1e6, agree ? "agrees" : "differs");
+    printf("  contiguous, 1 flat loop: %8.1f\n", elements / contiguous / 1e6);
+    printf("  transposed views:        %8.1f\n", elements / strided / 1e6);
+
+    NDArray(double, delete)(left_t);
+    NDArray(double, delete)(out_t);
+    NDArray(double, delete)(left);
+    NDArray(double, delete)(right);
+    NDArray(double, delete)(out);
+    NDArray(double, delete)(bias);
+    return 0;
+
+}
@@ -0,0 +1,728 @@
+// ==========
+// NDArray<T>
+// ==========
+//
+// :Author: RickBarretto
+// :Year: 2026
+// :License: MPL 2.0
+// :Copyright: RickBarretto, 2026
+// :Version: 1.0
+//
+// ``NDArray<T>`` is a strided, n-dimensional view over an ``Array<T>``.
+// It keeps a ``shape`` and a ``stride`` per axis (in elements),
+// so ``transpose``, ``slice`` and ``reshape`` only write new metadata
+// and share the storage of their base: they are zero-copy views.
+//
+// Elementwise kernels broadcast like NumPy: shapes are aligned on the
+// right, and an axis of size 1 is repeated to match the other side.
+// Before looping, axes that are contiguous for every operand are merged
+// and axes of size 1 are dropped, so a contiguous 3-D array runs as one
+// flat, vectorizable loop, and a broadcast row runs as flat rows.
+//
+// The base owns the storage; views borrow it and must be deleted
+// before their base. Allocations go through the ``Array<T>`` hooks.
+//
+// How to Use
+// ----------
+//
+// Include ``Array<T>`` first, then this header with the same T:
+//
+//      #define T double
+//      #define PRINT_T(value) printf("%g", value)
+//      #include "../array/array.h"
+//
+//      #define T double
+//      #define PRINT_T(value) printf("%g", value)
+//      #include "ndarray.h"
+//
+// And a common way to use it would be:
+//
+//      NDArray(double) * image = NDArray(double, new)(3, (size_t[]) { 480, 640, 3 });
+//      NDArray(double) * red = NDArray(double, slice)(image, 2, 0, 1, 1);
+//      NDArray(double) * bias = NDArray(double, new)(1, (size_t[]) { 3 });
+//      NDArray(double) * shifted = NDArray(double, add)(image, bias);
+//
+//      double * pixel = NDArray(double, get)(image, (size_t[]) { 10, 20, 0 });
+//
+
+// =~=~=~=~=~=~=~=~ Imports ~=~=~=~=~=~=~=~=
+
+#include <iso646.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+
+// =~=~=~=~=~=~=~=~ Helper Macros ~=~=~=~=~=~=~=~=
+
+#define _CAT(X, Y) X ## _ ## Y
+#define CAT(X, Y) _CAT(X, Y)
+#define _CAT3(X, Y, Z) X ## _ ## Y ## _ ## Z
+#define CAT3(X, Y, Z) _CAT3(X, Y, Z)
+
+#define STRINGIFY(x) #x
+#define TOSTRING(x) STRINGIFY(x)
+
+#define ensure(COND, VAL) if (not (COND)) return VAL
+
+
+// =~=~=~=~=~=~=~=~ Shared helpers ~=~=~=~=~=~=~=~=
+
+#ifndef NDARRAY_HELPERS
+#define NDARRAY_HELPERS
+
+// NDARRAY_MAX_DIMS: Maximum number of axes.
+#define NDARRAY_MAX_DIMS 8
+
+typedef enum {
+    NDARRAY_ADD,
+    NDARRAY_SUB,
+    NDARRAY_MUL,
+    NDARRAY_DIV,
+} NDArrayOp;
+
+// Loop nest shared by up to 3 operands, after collapsing.
+// The last axis is the flat inner loop; the others advance ``offsets``.
+typedef struct {
+    size_t ndim;
+    size_t operands;
+    size_t shape[NDARRAY_MAX_DIMS];
+    ptrdiff_t strides[3][NDARRAY_MAX_DIMS];
+    size_t counter[NDARRAY_MAX_DIMS];
+} _NDArrayWalk;
+
+// Drops axes of size 1, then merges every axis into the one before it
+// when ``stride[outer] == stride[inner] * shape[inner]`` for all operands.
+void _NDArrayWalk_collapse(_NDArrayWalk * walk) {
+    size_t kept = 0;
+    for (size_t axis = 0; axis < walk->ndim; axis++) {
+        if (walk->shape[axis] == 1) continue;
+
+        bool mergeable = kept > 0;
+        for (size_t o = 0; o < walk->operands and mergeable; o++)
+            mergeable = walk->strides[o][kept - 1]
+                == walk->strides[o][axis] * (ptrdiff_t) walk->shape[axis];
+
+        if (mergeable) {
+            walk->shape[kept - 1] *= walk->shape[axis];
+            for (size_t o = 0; o < walk->operands; o++)
+                walk->strides[o][kept - 1] = walk->strides[o][axis];
+        } else {
+            walk->shape[kept] = walk->shape[axis];
+            for (size_t o = 0; o < walk->operands; o++)
+                walk->strides[o][kept] = walk->strides[o][axis];
+            kept++;
+        }
+    }
+
+    if (kept == 0) {
+        walk->shape[0] = 1;
+        for (size_t o = 0; o < walk->operands; o++) walk->strides[o][0] = 0;
+        kept = 1;
+    }
+    walk->ndim = kept;
+    for (size_t axis = 0; axis < kept; axis++) walk->counter[axis] = 0;
+}
+
+// Number of inner loops to run.
+size_t _NDArrayWalk_rows(_NDArrayWalk * walk) {
+    size_t rows = 1;
+    for (size_t axis = 0; axis + 1 < walk->ndim; axis++) rows *= walk->shape[axis];
+    return rows;
+}
+
+// Moves ``offsets`` to the start of the next inner loop.
+void _NDArrayWalk_next(_NDArrayWalk * walk, ptrdiff_t * offsets) {
+    for (size_t axis = walk->ndim - 1; axis-- > 0; ) {
+        for (size_t o = 0; o < walk->operands; o++) offsets[o] += walk->strides[o][axis];
+        if (++walk->counter[axis] < walk->shape[axis]) return;
+
+        for (size_t o = 0; o < walk->operands; o++)
+            offsets[o] -= walk->strides[o][axis] * (ptrdiff_t) walk->shape[axis];
+        walk->counter[axis] = 0;
+    }
+}
+
+#endif
+
+
+// =~=~=~=~=~=~=~=~ Implementation ~=~=~=~=~=~=~=~=
+
+// T: Element type of the NDArray<T>, a numeric type.
+#ifndef T
+#error "T is not defined"
+#endif
+
+// PRINT_T: (T) -> void
+//
+// PRINT_T is a macro that defines how to print an element of type T.
+// See ``Array<T>`` for more details.
+//
+#ifndef PRINT_T
+#error "PRINT_T is not defined"
+#endif
+
+#define MODULE NDArray
+#define Self CAT(MODULE, T)
+#define fn(NAME) CAT(Self, NAME)
+
+#define _NDARRAY_SELECT_MACRO(_1, _2, NAME, ...) NAME
+#define NDArray(...) _NDARRAY_SELECT_MACRO(__VA_ARGS__, NDArray2, NDArray1)(__VA_ARGS__)
+#define NDArray1(T) CAT(NDArray, T)
+#define NDArray2(T, FUNC) CAT3(NDArray, T, FUNC)
+
+typedef struct {
+    Array(T) * storage;
+    T * data;                   // first element of this view
+    size_t ndim;
+    size_t shape[NDARRAY_MAX_DIMS];
+    ptrdiff_t strides[NDARRAY_MAX_DIMS];
+    bool _owner;
+} Self;
+
+
+Self * fn(_view)(Self * base) {
+    Self * view = ARRAY_MALLOC(sizeof(Self));
+    ensure(view, NULL);
+
+    *view = *base;
+    view->_owner = false;
+    return view;
+}
+
+void fn(_contiguous_strides)(Self * array) {
+    ptrdiff_t stride = 1;
+    for (size_t axis = array->ndim; axis-- > 0; ) {
+        array->strides[axis] = stride;
+        stride *= (ptrdiff_t) array->shape[axis];
+    }
+}
+
+// NDArray >> delete(array: *NDArray<T>) -> bool
+//
+// Deletes the array. Only the base also deletes the storage.
+//
+// Parameters
+// ----------
+// array : *NDArray<T>
+//     The array or view to be deleted.
+//
+// Returns
+// -------
+// bool: Returns true on success.
+//
+bool fn(delete)(Self * array) {
+    ensure(array, false);
+
+    if (array->_owner) Array(T, delete)(array->storage);
+    ARRAY_FREE(array);
+    return true;
+}
+
+// NDArray >> from_array(storage: *Array<T>, ndim: size_t, shape: *size_t) -> *NDArray<T>
+//
+// Wraps an Array as a contiguous (row-major) NDArray, without copying.
+// The NDArray takes ownership of the Array.
+//
+// Parameters
+// ----------
+// storage : *Array<T>
+//     The elements, whose size must be the product of ``shape``.
+// ndim : size_t
+//     The number of axes, from 1 to NDARRAY_MAX_DIMS.
+// shape : *size_t
+//     The size of each axis.
+//
+// Returns
+// -------
+// *NDArray<T>: A pointer to the new array, or NULL on a shape mismatch.
+//
+Self * fn(from_array)(Array(T) * storage, size_t ndim, const size_t * shape) {
+    ensure(storage and shape, NULL);
+    ensure(ndim > 0 and ndim <= NDARRAY_MAX_DIMS, NULL);
+
+    size_t size = 1;
+    for (size_t axis = 0; axis < ndim; axis++) size *= shape[axis];
+    ensure(size == Array(T, size)(storage), NULL);
+
+    Self * array = ARRAY_MALLOC(sizeof(Self));
+    ensure(array, NULL);
+
+    array->storage = storage;
+    array->data = storage->data;
+    array->ndim = ndim;
+    for (size_t axis = 0; axis < ndim; axis++) array->shape[axis] = shape[axis];
+    fn(_contiguous_strides)(array);
+    array->_owner = true;
+    return array;
+}
+
+// NDArray >> new(ndim: size_t, shape: *size_t) -> *NDArray<T>
+//
+// Creates a new, zeroed, contiguous array.
+// See ``from_array`` for the parameters.
+//
+Self * fn(new)(size_t ndim, const size_t * shape) {
+    ensure(shape and ndim > 0 and ndim <= NDARRAY_MAX_DIMS, NULL);
+
+    size_t size = 1;
+    for (size_t axis = 0; axis < ndim; axis++) size *= shape[axis];
+
+    Array(T) * storage = Array(T, new)(size);
+    ensure(storage, NULL);
+
+    Self * array = fn(from_array)(storage, ndim, shape);
+    if (not array) Array(T, delete)(storage);
+    return array;
+}
+
+// NDArray >> size(array: *NDArray<T>) -> size_t
+//
+// Returns the number of elements, the product of the shape.
+//
+size_t fn(size)(Self * array) {
+    ensure(array, 0);
+
+    size_t size = 1;
+    for (size_t axis = 0; axis < array->ndim; axis++) size *= array->shape[axis];
+    return size;
+}
+
+// NDArray >> shape(array: *NDArray<T>, axis: size_t) -> size_t
+//
+// Returns the size of ``axis``, or 0 if there is no such axis.
+//
+size_t fn(shape)(Self * array, size_t axis) {
+    ensure(array and axis < array->ndim, 0);
+    return array->shape[axis];
+}
+
+// NDArray >> is_contiguous(array: *NDArray<T>) -> bool
+//
+// Returns true if the elements are dense and in row-major order.
+//
+bool fn(is_contiguous)(Self * array) {
+    ensure(array, false);
+
+    ptrdiff_t stride = 1;
+    for (size_t axis = array->ndim; axis-- > 0; ) {
+        if (array->shape[axis] != 1 and array->strides[axis] != stride) return false;
+        stride *= (ptrdiff_t) array->shape[axis];
+    }
+    return true;
+}
+
+// NDArray >> get(array: *NDArray<T>, index: *size_t) -> *T
+//
+// Safely gets a pointer to an element.
+//
+// Parameters
+// ----------
+// array : *NDArray<T>
+//     The array from which to get the element.
+// index : *size_t
+//     One index per axis.
+//
+// Returns
+// -------
+// *T: A pointer to the element, or NULL if the index is out of bounds.
+//
+T * fn(get)(Self * array, const size_t * index) {
+    ensure(array and index, NULL);
+
+    ptrdiff_t offset = 0;
+    for (size_t axis = 0; axis < array->ndim; axis++) {
+        ensure(index[axis] < array->shape[axis], NULL);
+        offset += (ptrdiff_t) index[axis] * array->strides[axis];
+    }
+    return array->data + offset;
+}
+
+// NDArray >> set(array: *NDArray<T>, index: *size_t, value: T) -> bool
+//
+// Safely sets an element. Views write through to their base.
+//
+// Returns
+// -------
+// bool: Returns true on success, false if the index is out of bounds.
+//
+bool fn(set)(Self * array, const size_t * index, T value) {
+    T * element = fn(get)(array, index);
+    ensure(element, false);
+
+    *element = value;
+    return true;
+}
+
+
+// ~~~~~~~~ Views ~~~~~~~~
+
+// NDArray >> transpose(array: *NDArray<T>, axes: *size_t) -> *NDArray<T>
+//
+// Returns a view with permuted axes: axis ``i`` of the view
+// is axis ``axes[i]`` of ``array``.
+//
+// Parameters
+// ----------
+// array : *NDArray<T>
+//     The array to transpose.
+// axes : *size_t
+//     A permutation of the axes, or NULL to reverse them.
+//
+// Returns
+// -------
+// *NDArray<T>: A zero-copy view, or NULL if ``axes`` is not a permutation.
+//
+Self * fn(transpose)(Self * array, const size_t * axes) {
+    ensure(array, NULL);
+
+    bool seen[NDARRAY_MAX_DIMS] = { false };
+    for (size_t axis = 0; axes and axis < array->ndim; axis++) {
+        ensure(axes[axis] < array->ndim and not seen[axes[axis]], NULL);
+        seen[axes[axis]] = true;
+    }
+
+    Self * view = fn(_view)(array);
+    ensure(view, NULL);
+
+    for (size_t axis = 0; axis < array->ndim; axis++) {
+        size_t from = axes ? axes[axis] : array->ndim - 1 - axis;
+        view->shape[axis] = array->shape[from];
+        view->strides[axis] = array->strides[from];
+    }
+    return view;
+}
+
+// NDArray >> slice(array: *NDArray<T>, axis: size_t, start: size_t, stop: size_t, step: size_t) -> *NDArray<T>
+//
+// Returns a view of ``start, start + step, ...`` up to ``stop`` (excluded)
+// along ``axis``. The other axes are kept whole.
+//
+// Parameters
+// ----------
+// array : *NDArray<T>
+//     The array to slice.
+// axis : size_t
+//     The axis to slice.
+// start, stop : size_t
+//     The range, clamped to the axis size.
+// step : size_t
+//     The distance between taken elements, at least 1.
+//
+// Returns
+// -------
+// *NDArray<T>: A zero-copy view, or NULL on invalid arguments.
+//
+Self * fn(slice)(Self * array, size_t axis, size_t start, size_t stop, size_t step) {
+    ensure(array and axis < array->ndim and step > 0, NULL);
+
+    if (stop > array->shape[axis]) stop = array->shape[axis];
+    if (start > stop) start = stop;
+
+    Self * view = fn(_view)(array);
+    ensure(view, NULL);
+
+    view->shape[axis] = (stop - start + step - 1) / step;
+    view->strides[axis] = array->strides[axis] * (ptrdiff_t) step;
+    if (view->shape[axis] > 0) view->data += (ptrdiff_t) start * array->strides[axis];
+    return view;
+}
+
+// NDArray >> reshape(array: *NDArray<T>, ndim: size_t, shape: *size_t) -> *NDArray<T>
+//
+// Returns a contiguous view with a new shape and the same size.
+// Only contiguous arrays can be reshaped without copying,
+// so for other views, ``copy`` first.
+//
+// Returns
+// -------
+// *NDArray<T>: A zero-copy view, or NULL if sizes differ
+//     or ``array`` is not contiguous.
+//
+Self * fn(reshape)(Self * array, size_t ndim, const size_t * shape) {
+    ensure(array and shape and ndim > 0 and ndim <= NDARRAY_MAX_DIMS, NULL);
+    ensure(fn(is_contiguous)(array), NULL);
+
+    size_t size = 1;
+    for (size_t axis = 0; axis < ndim; axis++) size *= shape[axis];
+    ensure(size == fn(size)(array), NULL);
+
+    Self * view = fn(_view)(array);
+    ensure(view, NULL);
+
+    view->ndim = ndim;
+    for (size_t axis = 0; axis < ndim; axis++) view->shape[axis] = shape[axis];
+    fn(_contiguous_strides)(view);
+    return view;
+}
+
+
+// ~~~~~~~~ Kernels ~~~~~~~~
+
+// Aligns ``operand`` on the right of ``shape``, with stride 0
+// for the missing and the broadcast axes.
+bool fn(_broadcast)(Self * operand, size_t ndim, const size_t * shape, ptrdiff_t * strides) {
+    size_t skip = ndim - operand->ndim;
+    for (size_t axis = 0; axis < ndim; axis++) {
+        if (axis < skip) { strides[axis] = 0; continue; }
+
+        size_t size = operand->shape[axis - skip];
+        ensure(size == shape[axis] or size == 1, false);
+        strides[axis] = size == 1 ? 0 : operand->strides[axis - skip];
+    }
+    return true;
+}
+
+// The inner loop, specialized for the contiguous and scalar cases
+// so the compiler can vectorize them.
+void fn(_kernel)(NDArrayOp op, T * out, const T * left, const T * right,
+                 size_t count, ptrdiff_t so, ptrdiff_t sl, ptrdiff_t sr) {
+    #define _NDARRAY_LOOP(OUT, LEFT, RIGHT) switch (op) {                                 \
+        case NDARRAY_ADD: for (size_t i = 0; i < count; i++) OUT = LEFT + RIGHT; break;   \
+        case NDARRAY_SUB: for (size_t i = 0; i < count; i++) OUT = LEFT - RIGHT; break;   \
+        case NDARRAY_MUL: for (size_t i = 0; i < count; i++) OUT = LEFT * RIGHT; break;   \
+        case NDARRAY_DIV: for (size_t i = 0; i < count; i++) OUT = LEFT / RIGHT; break;   \
+    }
+
+    if (so == 1 and sl == 1 and sr == 1) {
+        _NDARRAY_LOOP(out[i], left[i], right[i]);
+    } else if (so == 1 and sl == 1 and sr == 0) {
+        T scalar = *right;
+        _NDARRAY_LOOP(out[i], left[i], scalar);
+    } else if (so == 1 and sl == 0 and sr == 1) {
+        T scalar = *left;
+        _NDARRAY_LOOP(out[i], scalar, right[i]);
+    } else {
+        _NDARRAY_LOOP(out[(ptrdiff_t) i * so], left[(ptrdiff_t) i * sl], right[(ptrdiff_t) i * sr]);
+    }
+
+    #undef _NDARRAY_LOOP
+}
+
+// NDArray >> apply(op: NDArrayOp, out: *NDArray<T>, left: *NDArray<T>, right: *NDArray<T>) -> bool
+//
+// Computes ``out = left op right`` elementwise, broadcasting both
+// operands to the shape of ``out``. ``out`` may alias an operand
+// with the same layout, for in-place updates.
+// As in C, integer division by zero is undefined.
+//
+// Parameters
+// ----------
+// op : NDArrayOp
+//     NDARRAY_ADD, NDARRAY_SUB, NDARRAY_MUL or NDARRAY_DIV.
+// out : *NDArray<T>
+//     Where to write the result.
+// left, right : *NDArray<T>
+//     The operands, broadcastable to the shape of ``out``.
+//
+// Returns
+// -------
+// bool: Returns true on success, false if the shapes do not broadcast.
+//
+bool fn(apply)(NDArrayOp op, Self * out, Self * left, Self * right) {
+    ensure(out and left and right, false);
+    ensure(left->ndim <= out->ndim and right->ndim <= out->ndim, false);
+
+    _NDArrayWalk walk = { .ndim = out->ndim, .operands = 3 };
+    for (size_t axis = 0; axis < out->ndim; axis++) {
+        walk.shape[axis] = out->shape[axis];
+        walk.strides[0][axis] = out->strides[axis];
+    }
+    ensure(fn(_broadcast)(left, out->ndim, out->shape, walk.strides[1]), false);
+    ensure(fn(_broadcast)(right, out->ndim, out->shape, walk.strides[2]), false);
+    ensure(fn(size)(out) > 0, true);
+
+    _NDArrayWalk_collapse(&walk);
+
+    size_t inner = walk.shape[walk.ndim - 1];
+    ptrdiff_t offsets[3] = { 0, 0, 0 };
+    for (size_t row = _NDArrayWalk_rows(&walk); row > 0; row--) {
+        fn(_kernel)(op, out->data + offsets[0], left->data + offsets[1],
+            right->data + offsets[2], inner, walk.strides[0][walk.ndim - 1],
+            walk.strides[1][walk.ndim - 1], walk.strides[2][walk.ndim - 1]);
+        _NDArrayWalk_next(&walk, offsets);
+    }
+    return true;
+}
+
+// Allocates the broadcast result of two operands, then applies ``op``.
+Self * fn(_binary)(NDArrayOp op, Self * left, Self * right) {
+    ensure(left and right, NULL);
+
+    size_t ndim = left->ndim > right->ndim ? left->ndim : right->ndim;
+    size_t shape[NDARRAY_MAX_DIMS];
+    for (size_t axis = 0; axis < ndim; axis++) {
+        size_t l = axis + left->ndim >= ndim ? left->shape[axis + left->ndim - ndim] : 1;
+        size_t r = axis + right->ndim >= ndim ? right->shape[axis + right->ndim - ndim] : 1;
+        ensure(l == r or l == 1 or r == 1, NULL);
+        shape[axis] = l == 1 ? r : l;
+    }
+
+    Self * out = fn(new)(ndim, shape);
+    ensure(out, NULL);
+
+    fn(apply)(op, out, left, right);
+    return out;
+}
+
+// NDArray >> add(left: *NDArray<T>, right: *NDArray<T>) -> *NDArray<T>
+//
+// Returns a new array with ``left + right``, broadcasting both sides.
+// ``sub``, ``mul`` and ``div`` work the same way.
+//
+// Returns
+// -------
+// *NDArray<T>: The result, or NULL if the shapes do not broadcast.
+//
+Self * fn(add)(Self * left, Self * right) { return fn(_binary)(NDARRAY_ADD, left, right); }
+Self * fn(sub)(Self * left, Self * right) { return fn(_binary)(NDARRAY_SUB, left, right); }
+Self * fn(mul)(Self * left, Self * right) { return fn(_binary)(NDARRAY_MUL, left, right); }
+Self * fn(div)(Self * left, Self * right) { return fn(_binary)(NDARRAY_DIV, left, right); }
+
+// NDArray >> fill(array: *NDArray<T>, value: T) -> bool
+//
+// Sets every element of the array, or of the view, to ``value``.
+//
+bool fn(fill)(Self * array, T value) {
+    ensure(array, false);
+    ensure(fn(size)(array) > 0, true);
+
+    _NDArrayWalk walk = { .ndim = array->ndim, .operands = 1 };
+    for (size_t axis = 0; axis < array->ndim; axis++) {
+        walk.shape[axis] = array->shape[axis];
+        walk.strides[0][axis] = array->strides[axis];
+    }
+    _NDArrayWalk_collapse(&walk);
+
+    size_t inner = walk.shape[walk.ndim - 1];
+    ptrdiff_t stride = walk.strides[0][walk.ndim - 1];
+    ptrdiff_t offsets[1] = { 0 };
+    for (size_t row = _NDArrayWalk_rows(&walk); row > 0; row--) {
+        T * data = array->data + offsets[0];
+        if (stride == 1) for (size_t i = 0; i < inner; i++) data[i] = value;
+        else for (size_t i = 0; i < inner; i++) data[(ptrdiff_t) i * stride] = value;
+        _NDArrayWalk_next(&walk, offsets);
+    }
+    return true;
+}
+
+// NDArray >> sum(array: *NDArray<T>) -> T
+//
+// Returns the sum of every element of the array or view.
+//
+T fn(sum)(Self * array) {
+    T total = 0;
+    ensure(array and fn(size)(array) > 0, total);
+
+    _NDArrayWalk walk = { .ndim = array->ndim, .operands = 1 };
+    for (size_t axis = 0; axis < array->ndim; axis++) {
+        walk.shape[axis] = array->shape[axis];
+        walk.strides[0][axis] = array->strides[axis];
+    }
+    _NDArrayWalk_collapse(&walk);
+
+    size_t inner = walk.shape[walk.ndim - 1];
+    ptrdiff_t stride = walk.strides[0][walk.ndim - 1];
+    ptrdiff_t offsets[1] = { 0 };
+    for (size_t row = _NDArrayWalk_rows(&walk); row > 0; row--) {
+        const T * data = array->data + offsets[0];
+        if (stride == 1) for (size_t i = 0; i < inner; i++) total += data[i];
+        else for (size_t i = 0; i < inner; i++) total += data[(ptrdiff_t) i * stride];
+        _NDArrayWalk_next(&walk, offsets);
+    }
+    return total;
+}
+
+// NDArray >> copy(array: *NDArray<T>) -> *NDArray<T>
+//
+// Returns a new, contiguous array with the elements of the view.
+//
+Self * fn(copy)(Self * array) {
+    ensure(array, NULL);
+
+    Self * out = fn(new)(array->ndim, array->shape);
+    ensure(out, NULL);
+    ensure(fn(size)(array) > 0, out);
+
+    _NDArrayWalk walk = { .ndim = array->ndim, .operands = 2 };
+    for (size_t axis = 0; axis < array->ndim; axis++) {
+        walk.shape[axis] = array->shape[axis];
+        walk.strides[0][axis] = out->strides[axis];
+        walk.strides[1][axis] = array->strides[axis];
+    }
+    _NDArrayWalk_collapse(&walk);
+
+    size_t inner = walk.shape[walk.ndim - 1];
+    ptrdiff_t stride = walk.strides[1][walk.ndim - 1];
+    ptrdiff_t offsets[2] = { 0, 0 };
+    for (size_t row = _NDArrayWalk_rows(&walk); row > 0; row--) {
+        T * target = out->data + offsets[0];
+        const T * source = array->data + offsets[1];
+        if (stride == 1) for (size_t i = 0; i < inner; i++) target[i] = source[i];
+        else for (size_t i = 0; i < inner; i++) target[i] = source[(ptrdiff_t) i * stride];
+        _NDArrayWalk_next(&walk, offsets);
+    }
+    return out;
+}
+
+
+// ~~~~~~~~ Printing ~~~~~~~~
+
+void fn(_print)(Self * array, size_t axis, const T * data) {
+    printf("[");
+    for (size_t i = 0; i < array->shape[axis]; i++) {
+        const T * element = data + (ptrdiff_t) i * array->strides[axis];
+        if (axis + 1 == array->ndim) PRINT_T(*element);
+        else fn(_print)(array, axis + 1, element);
+        if (i + 1 < array->shape[axis]) printf(", ");
+    }
+    printf("]");
+}
+
+// NDArray >> print(array: *NDArray<T>) -> void
+//
+// Prints the array on terminal, as nested lists.
+//
+void fn(print)(Self * array) {
+    ensure(array,);
+    fn(_print)(array, 0, array->data);
+}
+
+// NDArray >> println(array: *NDArray<T>) -> void
+//
+// Prints the array on terminal followed by a newline.
+//
+void fn(println)(Self * array) {
+    fn(print)(array);
+    printf("\n");
+}
+
+// NDArray >> debug(array: *NDArray<T>) -> void
+//
+// Prints the debug representation of the array.
+//
+void fn(debug)(Self * array) {
+    if (not array) {
+        printf("NDArray<%s> { NULL }\n", TOSTRING(T));
+        return;
+    }
+
+    printf("NDArray<%s> {\n", TOSTRING(T));
+    printf("  shape: (");
+    for (size_t axis = 0; axis < array->ndim; axis++)
+        printf(axis ? ", %zu" : "%zu", array->shape[axis]);
+    printf("),\n  strides: (");
+    for (size_t axis = 0; axis < array->ndim; axis++)
+        printf(axis ? ", %td" : "%td", array->strides[axis]);
+    printf("),\n  offset: %td,\n", array->data - array->storage->data);
+    printf("  owner: %s,\n", array->_owner ? "true" : "false");
+    printf("  data: "); fn(println)(array);
+    printf("}\n");
+}
+
+#undef MODULE
+#undef Self
+#undef fn
+#undef T
+#undef PRINT_T
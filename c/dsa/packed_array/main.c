@@ -0,0 +1,85 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdint.h>
+#include <stdio.h>
+#include <time.h>
+
+#define T uint64_t
+#define PRINT_T(value) printf("%llu", (unsigned long long) value)
+#include "../array/array.h"
+
+#define T uint64_t
+#define PRINT_T(value) printf("%llu", (unsigned long long) value)
+#include "packed_array.h"
+
+double seconds() {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec + now.tv_nsec * 1e-9;
+}
+
+int main() {
+
+    // Sorted IDs with small, irregular gaps.
+    size_t size = 4000000;
+    Array(uint64_t) * ids = Array(uint64_t, new)(size);
+    uint64_t id = 1000000000ull;
+    for (size_t i = 0; i < size; i++) {
+        id += 1 + (i * 2654435761u) % 64;
+        Array(uint64_t, set)(ids, i, id);
+    }
+
+    PackedArray(uint64_t) * packed = PackedArray(uint64_t, from_array)(ids);
+
+    size_t raw = size * sizeof(uint64_t);
+    size_t bytes = PackedArray(uint64_t, bytes)(packed);
+    printf("memory: %zu -> %zu bytes (%.2fx)\n",
+        raw, bytes, (double) raw / (double) bytes);
+
+    // Decode throughput, whole blocks at a time.
+    uint64_t block[PACKED_BLOCK_LEN], checksum = 0;
+    size_t blocks = (size + PACKED_BLOCK_LEN - 1) / PACKED_BLOCK_LEN;
+    int rounds = 10;
+
+    double start = seconds();
+    for (int round = 0; round < rounds; round++) {
+        for (size_t b = 0; b < blocks; b++) {
+            size_t length = PackedArray(uint64_t, decode_block)(packed, b, block);
+            checksum += block[length - 1];
+        }
+    }
+    double elapsed = seconds() - start;
+    printf("decode: %.2f billion integers/s (checksum %llu)\n",
+        rounds * size / elapsed / 1e9, (unsigned long long) checksum);
+
+    // Random access and search agree with the plain Array.
+    bool ok = true;
+    for (size_t i = 0; i < size; i += 9973) {
+        uint64_t value;
+        PackedArray(uint64_t, get)(packed, i, &value);
+        ok = ok and value == *Array(uint64_t, get)(ids, i);
+        ok = ok and PackedArray(uint64_t, lower_bound)(packed, value) == i;
+        ok = ok and PackedArray(uint64_t, lower_bound)(packed, value + 1) == i + 1;
+    }
+
+    PackedArray(uint64_t, Iter) it = PackedArray(uint64_t, iter)(packed);
+    uint64_t value;
+    for (size_t i = 0; PackedArray(uint64_t, next)(&it, &value); i++)
+        ok = ok and value == ids->data[i];
+
+    Array(uint64_t) * restored = PackedArray(uint64_t, to_array)(packed);
+    for (size_t i = 0; i < size; i++)
+        ok = ok and restored->data[i] == ids->data[i];
+    printf("get / lower_bound / iter / to_array: %s\n", ok ? "ok" : "mismatch");
+
+    uint64_t small[] = { 3, 5, 8, 13, 21, 34 };
+    PackedArray(uint64_t) * fib = PackedArray(uint64_t, new)(small, 6);
+    PackedArray(uint64_t, debug)(fib);
+
+    PackedArray(uint64_t, delete)(fib);
+    PackedArray(uint64_t, delete)(packed);
+    Array(uint64_t, delete)(restored);
+    Array(uint64_t, delete)(ids);
+    return 0;
+
+}
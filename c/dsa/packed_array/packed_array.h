@@ -0,0 +1,440 @@
+// ==============
+// PackedArray<T>
+// ==============
+//
+// :Author: RickBarretto
+// :Year: 2026
+// :License: MPL 2.0
+// :Copyright: RickBarretto, 2026
+// :Version: 1.0
+//
+// ``PackedArray<T>`` is a read-optimized, compressed integer array.
+// Values are stored in blocks of 128, each block encoded as
+// frame-of-reference + bit-packing, so a block of sorted IDs
+// only pays for the bits of its own spread.
+//
+// A skip index keeps ``base``, ``width`` and ``offset`` per block,
+// so ``get(i)`` is O(1): block ``i / 128``, then a single bit extraction.
+// ``lower_bound`` binary searches the block bases first
+// and only touches one block.
+//
+// Block decode goes through ``Codec_bitunpack``, which unpacks 8 values
+// at a time when compiled with AVX2, for widths up to 25 bits,
+// that is any block whose values spread less than 2^25.
+//
+// T must be an unsigned integer type, up to 64 bits.
+//
+// How to Use
+// ----------
+//
+// Include ``Array<T>`` first, then this header with the same T:
+//
+//      #define T uint64_t
+//      #define PRINT_T(value) printf("%llu", (unsigned long long) value)
+//      #include "../array/array.h"
+//
+//      #define T uint64_t
+//      #define PRINT_T(value) printf("%llu", (unsigned long long) value)
+//      #include "packed_array.h"
+//
+// And a common way to use it would be:
+//
+//      PackedArray(uint64_t) * packed = PackedArray(uint64_t, from_array)(ids);
+//
+//      uint64_t value;
+//      PackedArray(uint64_t, get)(packed, 42, &value);
+//      size_t position = PackedArray(uint64_t, lower_bound)(packed, 1000);
+//
+//      PackedArray(uint64_t, Iter) it = PackedArray(uint64_t, iter)(packed);
+//      while (PackedArray(uint64_t, next)(&it, &value)) { ... }
+//
+
+// =~=~=~=~=~=~=~=~ Imports ~=~=~=~=~=~=~=~=
+
+#include <iso646.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../codec/codec.h"
+
+
+// =~=~=~=~=~=~=~=~ Helper Macros ~=~=~=~=~=~=~=~=
+
+#define _CAT(X, Y) X ## _ ## Y
+#define CAT(X, Y) _CAT(X, Y)
+#define _CAT3(X, Y, Z) X ## _ ## Y ## _ ## Z
+#define CAT3(X, Y, Z) _CAT3(X, Y, Z)
+
+#define STRINGIFY(x) #x
+#define TOSTRING(x) STRINGIFY(x)
+
+#define ensure(COND, VAL) if (not (COND)) return VAL
+
+
+// =~=~=~=~=~=~=~=~ Implementation ~=~=~=~=~=~=~=~=
+
+// T: Element type of the PackedArray<T>, an unsigned integer.
+#ifndef T
+#error "T is not defined"
+#endif
+
+// PRINT_T: (T) -> void
+//
+// PRINT_T is a macro that defines how to print an element of type T.
+// See ``Array<T>`` for more details.
+//
+#ifndef PRINT_T
+#error "PRINT_T is not defined"
+#endif
+
+// PACKED_BLOCK_LEN: Number of values per block.
+#define PACKED_BLOCK_LEN 128
+
+#define MODULE PackedArray
+#define Self CAT(MODULE, T)
+#define fn(NAME) CAT(Self, NAME)
+
+#define _PACKED_ARRAY_SELECT_MACRO(_1, _2, NAME, ...) NAME
+#define PackedArray(...) _PACKED_ARRAY_SELECT_MACRO(__VA_ARGS__, PackedArray2, PackedArray1)(__VA_ARGS__)
+#define PackedArray1(T) CAT(PackedArray, T)
+#define PackedArray2(T, FUNC) CAT3(PackedArray, T, FUNC)
+
+#ifndef PACKED_BLOCK_DEFINED
+#define PACKED_BLOCK_DEFINED
+// Skip index entry, one per block.
+typedef struct {
+    uint64_t base;
+    uint64_t offset : 56;
+    uint64_t width : 8;
+} PackedBlock;
+#endif
+
+typedef struct {
+    size_t _size;
+    size_t _blocks;
+    PackedBlock * index;
+    uint8_t * data;
+} Self;
+
+typedef struct {
+    Self * array;
+    size_t index;
+    T buffer[PACKED_BLOCK_LEN];
+} fn(Iter);
+
+
+// PackedArray >> new(values: *T, size: size_t) -> *PackedArray<T>
+//
+// Compresses ``size`` values into a new packed array.
+//
+// Parameters
+// ----------
+// values : *T
+//     The values to compress. Sorted values compress best.
+// size : size_t
+//     The number of values.
+//
+// Returns
+// -------
+// *PackedArray<T>: A pointer to the newly created packed array.
+//
+Self * fn(new)(const T * values, size_t size) {
+    ensure(values or size == 0, NULL);
+
+    size_t blocks = (size + PACKED_BLOCK_LEN - 1) / PACKED_BLOCK_LEN;
+    Self * array = malloc(sizeof(Self));
+    PackedBlock * index = malloc((blocks ? blocks : 1) * sizeof(PackedBlock));
+
+    // First pass: frame of each block, so the payload is allocated once.
+    size_t bytes = 0;
+    for (size_t block = 0; array and index and block < blocks; block++) {
+        const T * first = values + block * PACKED_BLOCK_LEN;
+        size_t length = size - block * PACKED_BLOCK_LEN;
+        if (length > PACKED_BLOCK_LEN) length = PACKED_BLOCK_LEN;
+
+        T min = first[0], max = first[0];
+        for (size_t i = 1; i < length; i++) {
+            min = first[i] < min ? first[i] : min;
+            max = first[i] > max ? first[i] : max;
+        }
+
+        unsigned width = Codec_bitwidth((uint64_t) max - (uint64_t) min);
+        index[block] = (PackedBlock) {
+            .base = min, .offset = bytes, .width = width
+        };
+        bytes += Codec_packed_size(length, width);
+    }
+
+    uint8_t * data = calloc(bytes + CODEC_PADDING, 1);
+    if (not array or not index or not data) {
+        free(array); free(index); free(data);
+        return NULL;
+    }
+
+    uint64_t wide[PACKED_BLOCK_LEN];
+    for (size_t block = 0; block < blocks; block++) {
+        size_t length = size - block * PACKED_BLOCK_LEN;
+        if (length > PACKED_BLOCK_LEN) length = PACKED_BLOCK_LEN;
+
+        for (size_t i = 0; i < length; i++)
+            wide[i] = values[block * PACKED_BLOCK_LEN + i];
+        Codec_bitpack(wide, length, index[block].base, index[block].width,
+                      data + index[block].offset);
+    }
+
+    array->_size = size;
+    array->_blocks = blocks;
+    array->index = index;
+    array->data = data;
+    return array;
+}
+
+// PackedArray >> from_array(array: *Array<T>) -> *PackedArray<T>
+//
+// Compresses an ``Array<T>``. The source array is left untouched.
+//
+Self * fn(from_array)(Array(T) * array) {
+    ensure(array, NULL);
+    return fn(new)(array->data, Array(T, size)(array));
+}
+
+// PackedArray >> delete(array: *PackedArray<T>) -> bool
+//
+// Safely deletes the packed array.
+//
+// Returns
+// -------
+// bool: Returns true on success.
+//
+bool fn(delete)(Self * array) {
+    ensure(array, false);
+
+    free(array->index);
+    free(array->data);
+    free(array);
+    return true;
+}
+
+// PackedArray >> size(array: *PackedArray<T>) -> size_t
+//
+// Returns the number of elements in the packed array.
+//
+size_t fn(size)(Self * array) {
+    ensure(array, 0);
+    return array->_size;
+}
+
+// PackedArray >> bytes(array: *PackedArray<T>) -> size_t
+//
+// Returns the memory used by the packed array, skip index included.
+//
+size_t fn(bytes)(Self * array) {
+    ensure(array, 0);
+
+    size_t payload = 0;
+    if (array->_blocks) {
+        PackedBlock last = array->index[array->_blocks - 1];
+        size_t length = array->_size - (array->_blocks - 1) * PACKED_BLOCK_LEN;
+        payload = last.offset + Codec_packed_size(length, last.width);
+    }
+    return sizeof(Self) + array->_blocks * sizeof(PackedBlock)
+         + payload + CODEC_PADDING;
+}
+
+// PackedArray >> get(array: *PackedArray<T>, index: size_t, out: *T) -> bool
+//
+// Reads the element at the specified index in O(1).
+//
+// Parameters
+// ----------
+// array : *PackedArray<T>
+//     The array from which to get the element.
+// index : size_t
+//     The index of the element to retrieve.
+// out : *T
+//     Where the element is written to.
+//
+// Returns
+// -------
+// bool: Returns true on success, false if the index is out of bounds.
+//
+bool fn(get)(Self * array, size_t index, T * out) {
+    ensure(array and out, false);
+    ensure(index < array->_size, false);
+
+    PackedBlock block = array->index[index / PACKED_BLOCK_LEN];
+    *out = (T) (block.base + Codec_bitget(array->data + block.offset,
+                                          index % PACKED_BLOCK_LEN,
+                                          block.width));
+    return true;
+}
+
+// PackedArray >> decode_block(array: *PackedArray<T>, block: size_t, out: *T) -> size_t
+//
+// Decodes a whole block of up to PACKED_BLOCK_LEN values.
+//
+// Returns
+// -------
+// size_t: The number of values decoded, 0 if the block is out of bounds.
+//
+size_t fn(decode_block)(Self * array, size_t block, T * out) {
+    ensure(array and out, 0);
+    ensure(block < array->_blocks, 0);
+
+    size_t length = array->_size - block * PACKED_BLOCK_LEN;
+    if (length > PACKED_BLOCK_LEN) length = PACKED_BLOCK_LEN;
+
+    PackedBlock frame = array->index[block];
+    uint64_t wide[PACKED_BLOCK_LEN];
+    Codec_bitunpack(array->data + frame.offset, length,
+                    frame.base, frame.width, wide);
+    for (size_t i = 0; i < length; i++) out[i] = (T) wide[i];
+    return length;
+}
+
+// PackedArray >> to_array(array: *PackedArray<T>) -> *Array<T>
+//
+// Decompresses the packed array into a new ``Array<T>``.
+//
+Array(T) * fn(to_array)(Self * array) {
+    ensure(array, NULL);
+
+    Array(T) * result = Array(T, new)(array->_size);
+    ensure(result, NULL);
+
+    for (size_t block = 0; block < array->_blocks; block++)
+        fn(decode_block)(array, block, result->data + block * PACKED_BLOCK_LEN);
+    return result;
+}
+
+// PackedArray >> lower_bound(array: *PackedArray<T>, value: T) -> size_t
+//
+// Finds the first element that is not less than ``value``.
+// The packed array must be sorted.
+//
+// Returns
+// -------
+// size_t: The index of the element, or ``size`` if there is none.
+//
+size_t fn(lower_bound)(Self * array, T value) {
+    ensure(array, 0);
+    ensure(array->_blocks, 0);
+
+    // Last block whose first element (its base, when sorted) is < value.
+    size_t low = 0, high = array->_blocks;
+    while (low < high) {
+        size_t middle = low + (high - low) / 2;
+        if (array->index[middle].base < (uint64_t) value) low = middle + 1;
+        else high = middle;
+    }
+    ensure(low > 0, 0);
+
+    size_t block = low - 1;
+    PackedBlock frame = array->index[block];
+    const uint8_t * packed = array->data + frame.offset;
+    size_t length = array->_size - block * PACKED_BLOCK_LEN;
+    if (length > PACKED_BLOCK_LEN) length = PACKED_BLOCK_LEN;
+
+    // Branchless binary search inside the block.
+    uint64_t target = (uint64_t) value - frame.base;
+    size_t first = 0;
+    for (size_t step = length; step > 1; ) {
+        size_t half = step / 2;
+        first = (Codec_bitget(packed, first + half, frame.width) < target)
+            ? first + half : first;
+        step -= half;
+    }
+    if (Codec_bitget(packed, first, frame.width) < target) first++;
+    return block * PACKED_BLOCK_LEN + first;
+}
+
+// PackedArray >> iter(array: *PackedArray<T>) -> PackedArray<T>::Iter
+//
+// Creates an iterator that decodes one block at a time.
+//
+// Example
+// -------
+//
+//      PackedArray(uint64_t, Iter) it = PackedArray(uint64_t, iter)(packed);
+//      uint64_t value;
+//      while (PackedArray(uint64_t, next)(&it, &value)) { ... }
+//
+fn(Iter) fn(iter)(Self * array) {
+    return (fn(Iter)) { .array = array, .index = 0 };
+}
+
+// PackedArray >> next(it: *PackedArray<T>::Iter, out: *T) -> bool
+//
+// Advances the iterator.
+//
+// Returns
+// -------
+// bool: Returns true and writes the value on ``out``,
+//       or false once the iterator is exhausted.
+//
+bool fn(next)(fn(Iter) * it, T * out) {
+    ensure(it and it->array and out, false);
+    ensure(it->index < it->array->_size, false);
+
+    size_t offset = it->index % PACKED_BLOCK_LEN;
+    if (offset == 0)
+        fn(decode_block)(it->array, it->index / PACKED_BLOCK_LEN, it->buffer);
+
+    *out = it->buffer[offset];
+    it->index++;
+    return true;
+}
+
+// PackedArray >> print(array: *PackedArray<T>) -> void
+//
+// Prints the packed array on terminal.
+//
+void fn(print)(Self * array) {
+    ensure(array,);
+
+    fn(Iter) it = fn(iter)(array);
+    T value;
+
+    printf("[");
+    for (size_t i = 0; fn(next)(&it, &value); i++) {
+        PRINT_T(value);
+        if (i < array->_size - 1) printf(", ");
+    }
+    printf("]");
+}
+
+// PackedArray >> println(array: *PackedArray<T>) -> void
+//
+// Prints the packed array on terminal followed by a newline.
+//
+void fn(println)(Self * array) {
+    fn(print)(array);
+    printf("\n");
+}
+
+// PackedArray >> debug(array: *PackedArray<T>) -> void
+//
+// Prints the debug representation of the packed array.
+//
+void fn(debug)(Self * array) {
+    if (not array) {
+        printf("PackedArray<%s> { NULL }\n", TOSTRING(T));
+        return;
+    }
+
+    printf("PackedArray<%s> {\n", TOSTRING(T));
+    printf("  size: %zu,\n", array->_size);
+    printf("  blocks: %zu,\n", array->_blocks);
+    printf("  bytes: %zu,\n", fn(bytes)(array));
+    printf("  data: "); fn(println)(array);
+    printf("}\n");
+}
+
+#undef MODULE
+#undef Self
+#undef fn
+#undef T
+#undef PRINT_T
@@ -0,0 +1,127 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdint.h>
+#include <stdio.h>
+#include <time.h>
+
+#define T int64_t
+#define PRINT_T(value) printf("%lld", (long long) value)
+#include "../array/array.h"
+
+#define T int64_t
+#define PRINT_T(value) printf("%lld", (long long) value)
+#include "persistent_vector.h"
+
+// Usage: ./main [size] [versions], defaults to 2^20 elements
+// and an undo history of 1000 versions, one change each.
+
+typedef PersistentVector(int64_t) Vector;
+
+double seconds() {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec + now.tv_nsec * 1e-9;
+}
+
+uint64_t next_random(uint64_t * seed) {
+    *seed = *seed * 6364136223846793005ull + 1442695040888963407ull;
+    return *seed >> 32;
+}
+
+int main(int argc, char ** argv) {
+
+    Vector * small = PersistentVector(int64_t, new)();
+    for (int64_t i = 0; i < 40; i++) {
+        Vector * next = PersistentVector(int64_t, push)(small, i);
+        PersistentVector(int64_t, delete)(small);
+        small = next;
+    }
+    Vector * changed = PersistentVector(int64_t, set)(small, 3, -3);
+    PersistentVector(int64_t, debug)(changed);
+    printf("before: %lld, after: %lld\n\n",
+        (long long) *PersistentVector(int64_t, get)(small, 3), (long long) *PersistentVector(int64_t, get)(changed, 3));
+    PersistentVector(int64_t, delete)(small);
+    PersistentVector(int64_t, delete)(changed);
+
+    size_t size = argc > 1 ? (size_t) atoll(argv[1]) : (size_t) 1 << 20;
+    size_t versions = argc > 2 ? (size_t) atoll(argv[2]) : 1000;
+    size_t node_bytes = sizeof(PersistentVector(int64_t, _Node));
+    printf("%zu elements, %zu versions\n", size, versions);
+
+    Array(int64_t) * values = Array(int64_t, new)(size);
+    for (size_t i = 0; i < size; i++) values->data[i] = (int64_t) i;
+
+    double start = seconds();
+    Vector * base = PersistentVector(int64_t, from_array)(values);
+    printf("from_array: %8.2f ms\n", (seconds() - start) * 1e3);
+    size_t base_nodes = PersistentVector(int64_t, nodes)();
+
+    // An undo history: every version keeps one change over the previous one.
+    Vector ** history = malloc(versions * sizeof(Vector *));
+    Vector * current = base;
+    uint64_t seed = 3;
+    start = seconds();
+    for (size_t v = 0; v < versions; v++) {
+        current = PersistentVector(int64_t, set)(current, next_random(&seed) % size, -(int64_t) v);
+        history[v] = current;
+    }
+    double set_time = (seconds() - start) / versions;
+    size_t history_bytes = (PersistentVector(int64_t, nodes)() - base_nodes) * node_bytes;
+    printf("persistent set: %6.0f ns each, %8.2f MB for the history, %8.2f MB as Array copies\n",
+        set_time * 1e9, history_bytes / 1e6, (double) versions * size * sizeof(int64_t) / 1e6);
+
+    // Undo is a lookup in the history: the base is untouched.
+    size_t intact = 0;
+    for (size_t i = 0; i < size; i++) intact += *PersistentVector(int64_t, get)(base, i) == (int64_t) i;
+    printf("base version intact: %s\n", intact == size ? "yes" : "no");
+
+    uint64_t stream = 5;
+    int64_t sum = 0;
+    start = seconds();
+    for (size_t i = 0; i < 4000000; i++) sum += *PersistentVector(int64_t, get)(current, next_random(&stream) % size);
+    double vector_get = (seconds() - start) / 4000000;
+    stream = 5;
+    start = seconds();
+    for (size_t i = 0; i < 4000000; i++) sum += values->data[next_random(&stream) % size];
+    double array_get = (seconds() - start) / 4000000;
+    printf("random get: vector %6.1f ns, array %6.1f ns (%lld)\n", vector_get * 1e9, array_get * 1e9, (long long) sum % 10);
+
+    // A bulk edit of a tenth of the elements, path by path or in place.
+    size_t edits = size / 10;
+    seed = 9;
+    start = seconds();
+    Vector * slow = PersistentVector(int64_t, set)(current, 0, 0);
+    for (size_t i = 0; i < edits; i++) {
+        Vector * next = PersistentVector(int64_t, set)(slow, next_random(&seed) % size, 1);
+        PersistentVector(int64_t, delete)(slow);
+        slow = next;
+    }
+    double persistent_bulk = seconds() - start;
+
+    seed = 9;
+    start = seconds();
+    Vector * edit = PersistentVector(int64_t, transient)(current);
+    PersistentVector(int64_t, set)(edit, 0, 0);
+    for (size_t i = 0; i < edits; i++) PersistentVector(int64_t, set)(edit, next_random(&seed) % size, 1);
+    Vector * fast = PersistentVector(int64_t, persistent)(edit);
+    double transient_bulk = seconds() - start;
+
+    Array(int64_t) * slow_array = PersistentVector(int64_t, to_array)(slow);
+    Array(int64_t) * fast_array = PersistentVector(int64_t, to_array)(fast);
+    size_t same = 0;
+    for (size_t i = 0; i < size; i++) same += slow_array->data[i] == fast_array->data[i];
+    printf("bulk %zu sets: persistent %8.2f ms, transient %8.2f ms, results %s\n",
+        edits, persistent_bulk * 1e3, transient_bulk * 1e3, same == size ? "agree" : "differ");
+
+    Array(int64_t, delete)(slow_array);
+    Array(int64_t, delete)(fast_array);
+    PersistentVector(int64_t, delete)(slow);
+    PersistentVector(int64_t, delete)(fast);
+    for (size_t v = 0; v < versions; v++) PersistentVector(int64_t, delete)(history[v]);
+    free(history);
+    PersistentVector(int64_t, delete)(base);
+    Array(int64_t, delete)(values);
+    printf("nodes left: %zu\n", PersistentVector(int64_t, nodes)());
+    return 0;
+
+}
@@ -0,0 +1,582 @@
+// ===================
+// PersistentVector<T>
+// ===================
+//
+// :Author: RickBarretto
+// :Year: 2026
+// :License: MPL 2.0
+// :Copyright: RickBarretto, 2026
+// :Version: 1.0
+//
+// ``PersistentVector<T>`` is an immutable sequence where every change
+// returns a new version and leaves the old one intact, for undo
+// histories and versioned state, without copying a whole ``Array<T>``
+// per version.
+//
+// Elements live in the leaves of a trie with 32-way branching, so
+// ``get`` and ``set`` take O(log32 n), i.e. at most 7 steps for any size
+// that fits in memory. A change copies only the path from the root to
+// its leaf, and shares every other node with the previous version:
+// memory per version is proportional to the change, not to the size.
+// Nodes are reference-counted, and freed with the last version holding
+// them. The last, partially filled leaf (the tail) is kept out of the
+// trie, so ``push`` is usually a copy of one leaf.
+//
+// Bulk edits go through a transient: a private, mutable version that
+// edits in place the nodes it has already copied, instead of copying
+// the same path on every call. ``persistent`` freezes it back into
+// an ordinary version.
+//
+// Versions are immutable, so they may be read, and deleted, from many
+// threads. A transient is used by one thread at a time.
+//
+// How to Use
+// ----------
+//
+// Include ``Array<T>`` first, then this header with the same T:
+//
+//      #define T int64_t
+//      #define PRINT_T(value) printf("%lld", (long long) value)
+//      #include "../array/array.h"
+//
+//      #define T int64_t
+//      #define PRINT_T(value) printf("%lld", (long long) value)
+//      #include "persistent_vector.h"
+//
+// And a common way to use it would be:
+//
+//      PersistentVector(int64_t) * v1 = PersistentVector(int64_t, from_array)(values);
+//      PersistentVector(int64_t) * v2 = PersistentVector(int64_t, set)(v1, 3, 42);   // v1 unchanged
+//
+//      PersistentVector(int64_t) * edit = PersistentVector(int64_t, transient)(v2);
+//      for (size_t i = 0; i < 1000; i++) PersistentVector(int64_t, set)(edit, i, 0);
+//      PersistentVector(int64_t) * v3 = PersistentVector(int64_t, persistent)(edit);
+//
+// Every version is deleted on its own, with ``delete``.
+//
+
+// =~=~=~=~=~=~=~=~ Imports ~=~=~=~=~=~=~=~=
+
+#include <iso646.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+// =~=~=~=~=~=~=~=~ Helper Macros ~=~=~=~=~=~=~=~=
+
+#define _CAT(X, Y) X ## _ ## Y
+#define CAT(X, Y) _CAT(X, Y)
+#define _CAT3(X, Y, Z) X ## _ ## Y ## _ ## Z
+#define CAT3(X, Y, Z) _CAT3(X, Y, Z)
+
+#define STRINGIFY(x) #x
+#define TOSTRING(x) STRINGIFY(x)
+
+#define ensure(COND, VAL) if (not (COND)) return VAL
+
+
+// =~=~=~=~=~=~=~=~ Shared helpers ~=~=~=~=~=~=~=~=
+
+#ifndef PERSISTENT_VECTOR_HELPERS
+#define PERSISTENT_VECTOR_HELPERS
+
+// PERSISTENT_VECTOR_BITS: Index bits per trie level, i.e. 32-way branching.
+#define PERSISTENT_VECTOR_BITS 5
+#define PERSISTENT_VECTOR_WIDTH (1 << PERSISTENT_VECTOR_BITS)
+#define PERSISTENT_VECTOR_MASK (PERSISTENT_VECTOR_WIDTH - 1)
+
+// Transient ids, 0 for none. A node made by a transient carries its id,
+// and only that transient may edit it in place. Ids are never reused,
+// so a frozen node can never be edited again.
+_Atomic uint64_t _PersistentVector_owners = 1;
+
+#endif
+
+
+// =~=~=~=~=~=~=~=~ Implementation ~=~=~=~=~=~=~=~=
+
+// T: Element type of the PersistentVector<T>
+#ifndef T
+#error "T is not defined"
+#endif
+
+// PRINT_T: (T) -> void
+//
+// PRINT_T is a macro that defines how to print an element of type T.
+// See ``Array<T>`` for more details.
+//
+#ifndef PRINT_T
+#error "PRINT_T is not defined"
+#endif
+
+#define MODULE PersistentVector
+#define Self CAT(MODULE, T)
+#define fn(NAME) CAT(Self, NAME)
+
+#define _PERSISTENT_VECTOR_SELECT_MACRO(_1, _2, NAME, ...) NAME
+#define PersistentVector(...) _PERSISTENT_VECTOR_SELECT_MACRO(__VA_ARGS__, PersistentVector2, PersistentVector1)(__VA_ARGS__)
+#define PersistentVector1(T) CAT(PersistentVector, T)
+#define PersistentVector2(T, FUNC) CAT3(PersistentVector, T, FUNC)
+
+typedef struct fn(_Node) fn(_Node);
+
+// A leaf (shift 0) holds values, any other node holds children.
+struct fn(_Node) {
+    _Atomic size_t references;
+    uint64_t owner;             // the transient that may edit it in place, or 0
+    union {
+        fn(_Node) * children[PERSISTENT_VECTOR_WIDTH];
+        T values[PERSISTENT_VECTOR_WIDTH];
+    };
+};
+
+typedef struct {
+    fn(_Node) * root;           // NULL while every element is in the tail
+    fn(_Node) * tail;           // the last 1 to 32 elements, out of the trie
+    size_t _size;
+    uint32_t _shift;            // index bits below the root
+    uint64_t _owner;            // non-zero while transient
+} Self;
+
+// Nodes alive for every PersistentVector<T> of this T.
+_Atomic size_t fn(_nodes);
+
+
+// ~~~~~~~~ Nodes ~~~~~~~~
+
+fn(_Node) * fn(_node)(uint64_t owner) {
+    fn(_Node) * node = ARRAY_CALLOC(1, sizeof(fn(_Node)));
+    ensure(node, NULL);
+
+    atomic_init(&node->references, 1);
+    node->owner = owner;
+    atomic_fetch_add_explicit(&fn(_nodes), 1, memory_order_relaxed);
+    return node;
+}
+
+void fn(_retain)(fn(_Node) * node) {
+    if (node) atomic_fetch_add_explicit(&node->references, 1, memory_order_relaxed);
+}
+
+// Drops one reference to a node at ``shift``, freeing the subtree it was the last to hold.
+void fn(_release)(fn(_Node) * node, uint32_t shift) {
+    ensure(node,);
+    ensure(atomic_fetch_sub_explicit(&node->references, 1, memory_order_release) == 1,);
+
+    atomic_thread_fence(memory_order_acquire);
+    if (shift > 0)
+        for (size_t i = 0; i < PERSISTENT_VECTOR_WIDTH; i++)
+            fn(_release)(node->children[i], shift - PERSISTENT_VECTOR_BITS);
+    atomic_fetch_sub_explicit(&fn(_nodes), 1, memory_order_relaxed);
+    ARRAY_FREE(node);
+}
+
+// Makes ``*slot`` editable by ``owner``: the node itself if the transient
+// made it, else a copy that replaces it, sharing its children.
+fn(_Node) * fn(_own)(fn(_Node) ** slot, uint32_t shift, uint64_t owner) {
+    fn(_Node) * node = *slot;
+    ensure(not owner or node->owner != owner, node);
+
+    fn(_Node) * copy = fn(_node)(owner);
+    ensure(copy, NULL);
+
+    memcpy(&copy->children, &node->children, sizeof(fn(_Node)) - offsetof(fn(_Node), children));
+    if (shift > 0)
+        for (size_t i = 0; i < PERSISTENT_VECTOR_WIDTH; i++) fn(_retain)(copy->children[i]);
+    fn(_release)(node, shift);
+    *slot = copy;
+    return copy;
+}
+
+// A chain of new nodes from ``shift`` down to ``leaf``.
+fn(_Node) * fn(_path)(uint32_t shift, fn(_Node) * leaf, uint64_t owner) {
+    ensure(shift > 0, leaf);
+
+    fn(_Node) * node = fn(_node)(owner);
+    ensure(node, NULL);
+
+    node->children[0] = fn(_path)(shift - PERSISTENT_VECTOR_BITS, leaf, owner);
+    if (not node->children[0]) {
+        fn(_release)(node, 0);
+        return NULL;
+    }
+    return node;
+}
+
+// Index of the first element in the tail.
+size_t fn(_tail_offset)(Self * vector) {
+    ensure(vector->_size > PERSISTENT_VECTOR_WIDTH, 0);
+    return (vector->_size - 1) & ~(size_t) PERSISTENT_VECTOR_MASK;
+}
+
+// The leaf holding ``index``.
+fn(_Node) * fn(_leaf)(Self * vector, size_t index) {
+    ensure(index < fn(_tail_offset)(vector), vector->tail);
+
+    fn(_Node) * node = vector->root;
+    for (uint32_t shift = vector->_shift; shift > 0; shift -= PERSISTENT_VECTOR_BITS)
+        node = node->children[(index >> shift) & PERSISTENT_VECTOR_MASK];
+    return node;
+}
+
+// The version that a change applies to: a transient itself, else a new version sharing every node.
+Self * fn(_target)(Self * vector) {
+    ensure(not vector->_owner, vector);
+
+    Self * version = ARRAY_MALLOC(sizeof(Self));
+    ensure(version, NULL);
+
+    *version = *vector;
+    fn(_retain)(version->root);
+    fn(_retain)(version->tail);
+    return version;
+}
+
+
+// ~~~~~~~~ Lifetime ~~~~~~~~
+
+// PersistentVector >> delete(vector: *PersistentVector<T>) -> bool
+//
+// Deletes a version. Nodes shared with other versions are kept.
+//
+// Returns
+// -------
+// bool: Returns true on success.
+//
+bool fn(delete)(Self * vector) {
+    ensure(vector, false);
+
+    fn(_release)(vector->root, vector->_shift);
+    fn(_release)(vector->tail, 0);
+    ARRAY_FREE(vector);
+    return true;
+}
+
+// PersistentVector >> new() -> *PersistentVector<T>
+//
+// Creates an empty vector.
+//
+// Returns
+// -------
+// *PersistentVector<T>: The new vector, or NULL on failure.
+//
+Self * fn(new)(void) {
+    Self * vector = ARRAY_MALLOC(sizeof(Self));
+    ensure(vector, NULL);
+
+    vector->tail = fn(_node)(0);
+    if (not vector->tail) {
+        ARRAY_FREE(vector);
+        return NULL;
+    }
+    vector->root = NULL;
+    vector->_size = 0;
+    vector->_shift = PERSISTENT_VECTOR_BITS;
+    vector->_owner = 0;
+    return vector;
+}
+
+// PersistentVector >> transient(vector: *PersistentVector<T>) -> *PersistentVector<T>
+//
+// Makes a mutable version for bulk edits: ``set`` and ``push`` change it
+// in place and return it, copying each shared node once at most.
+// ``vector`` is unchanged, and must not itself be a transient.
+//
+// Returns
+// -------
+// *PersistentVector<T>: The transient, or NULL on failure.
+//
+Self * fn(transient)(Self * vector) {
+    ensure(vector and not vector->_owner, NULL);
+
+    Self * transient = fn(_target)(vector);
+    ensure(transient, NULL);
+
+    transient->_owner = atomic_fetch_add_explicit(&_PersistentVector_owners, 1, memory_order_relaxed);
+    return transient;
+}
+
+// PersistentVector >> persistent(transient: *PersistentVector<T>) -> *PersistentVector<T>
+//
+// Freezes a transient into an ordinary version, in O(1).
+// Changes through it return new versions again.
+//
+// Returns
+// -------
+// *PersistentVector<T>: The same handle, now immutable.
+//
+Self * fn(persistent)(Self * transient) {
+    ensure(transient, NULL);
+
+    transient->_owner = 0;
+    return transient;
+}
+
+
+// ~~~~~~~~ Access ~~~~~~~~
+
+// PersistentVector >> get(vector: *PersistentVector<T>, index: size_t) -> *T
+//
+// Gets a pointer to the element at the specified index, for reading:
+// the element may be shared with other versions.
+//
+// Returns
+// -------
+// *T: A pointer to the element, or NULL if the index is out of bounds.
+//
+T * fn(get)(Self * vector, size_t index) {
+    ensure(vector and index < vector->_size, NULL);
+    return &fn(_leaf)(vector, index)->values[index & PERSISTENT_VECTOR_MASK];
+}
+
+// PersistentVector >> set(vector: *PersistentVector<T>, index: size_t, value: T) -> *PersistentVector<T>
+//
+// Returns a version with the element at ``index`` set to ``value``,
+// copying only the path to its leaf. A transient is changed in place.
+//
+// Parameters
+// ----------
+// vector : *PersistentVector<T>
+//     The version to change, left as is unless transient.
+// index : size_t
+//     The index of the element to set.
+// value : T
+//     The new value.
+//
+// Returns
+// -------
+// *PersistentVector<T>: The new version, or the transient itself.
+//     NULL if the index is out of bounds or on allocation failure.
+//
+Self * fn(set)(Self * vector, size_t index, T value) {
+    ensure(vector and index < vector->_size, NULL);
+
+    Self * out = fn(_target)(vector);
+    ensure(out, NULL);
+
+    fn(_Node) * node;
+    if (index >= fn(_tail_offset)(out)) {
+        node = fn(_own)(&out->tail, 0, out->_owner);
+    } else {
+        uint32_t shift = out->_shift;
+        node = fn(_own)(&out->root, shift, out->_owner);
+        while (node and shift > 0) {
+            fn(_Node) ** slot = &node->children[(index >> shift) & PERSISTENT_VECTOR_MASK];
+            shift -= PERSISTENT_VECTOR_BITS;
+            node = fn(_own)(slot, shift, out->_owner);
+        }
+    }
+    if (not node) {
+        if (out != vector) fn(delete)(out);
+        return NULL;
+    }
+    node->values[index & PERSISTENT_VECTOR_MASK] = value;
+    return out;
+}
+
+// Moves the full tail into the trie, as its rightmost leaf.
+bool fn(_push_tail)(Self * out) {
+    size_t offset = fn(_tail_offset)(out);
+    fn(_Node) * leaf = out->tail;
+
+    if (not out->root) {
+        out->root = fn(_path)(out->_shift, leaf, out->_owner);
+        return out->root != NULL;
+    }
+
+    // No room under the root: grow a level.
+    if ((offset >> PERSISTENT_VECTOR_BITS) >= ((size_t) 1 << out->_shift)) {
+        fn(_Node) * root = fn(_node)(out->_owner);
+        ensure(root, false);
+
+        root->children[1] = fn(_path)(out->_shift, leaf, out->_owner);
+        if (not root->children[1]) {
+            fn(_release)(root, 0);
+            return false;
+        }
+        root->children[0] = out->root;
+        out->root = root;
+        out->_shift += PERSISTENT_VECTOR_BITS;
+        return true;
+    }
+
+    uint32_t shift = out->_shift;
+    fn(_Node) * node = fn(_own)(&out->root, shift, out->_owner);
+    while (node and shift > PERSISTENT_VECTOR_BITS) {
+        fn(_Node) ** slot = &node->children[(offset >> shift) & PERSISTENT_VECTOR_MASK];
+        shift -= PERSISTENT_VECTOR_BITS;
+        if (not *slot) {
+            *slot = fn(_path)(shift, leaf, out->_owner);
+            return *slot != NULL;
+        }
+        node = fn(_own)(slot, shift, out->_owner);
+    }
+    ensure(node, false);
+
+    node->children[(offset >> PERSISTENT_VECTOR_BITS) & PERSISTENT_VECTOR_MASK] = leaf;
+    return true;
+}
+
+// PersistentVector >> push(vector: *PersistentVector<T>, value: T) -> *PersistentVector<T>
+//
+// Returns a version with ``value`` appended. A transient is changed in place.
+//
+// Returns
+// -------
+// *PersistentVector<T>: The new version, or the transient itself.
+//     NULL on allocation failure.
+//
+Self * fn(push)(Self * vector, T value) {
+    ensure(vector, NULL);
+
+    Self * out = fn(_target)(vector);
+    ensure(out, NULL);
+
+    size_t count = out->_size - fn(_tail_offset)(out);
+    if (count < PERSISTENT_VECTOR_WIDTH) {
+        fn(_Node) * tail = fn(_own)(&out->tail, 0, out->_owner);
+        if (not tail) {
+            if (out != vector) fn(delete)(out);
+            return NULL;
+        }
+        tail->values[count] = value;
+        out->_size++;
+        return out;
+    }
+
+    // The trie takes over this version's reference to the full tail.
+    fn(_Node) * tail = fn(_node)(out->_owner);
+    if (not tail or not fn(_push_tail)(out)) {
+        fn(_release)(tail, 0);
+        if (out != vector) fn(delete)(out);
+        return NULL;
+    }
+    tail->values[0] = value;
+    out->tail = tail;
+    out->_size++;
+    return out;
+}
+
+// PersistentVector >> size(vector: *PersistentVector<T>) -> size_t
+//
+// Returns the number of elements.
+//
+size_t fn(size)(Self * vector) {
+    ensure(vector, 0);
+    return vector->_size;
+}
+
+// PersistentVector >> nodes() -> size_t
+//
+// Returns the number of nodes alive across every vector of this T,
+// each of 32 elements, to measure what versions share.
+//
+size_t fn(nodes)(void) {
+    return atomic_load_explicit(&fn(_nodes), memory_order_relaxed);
+}
+
+
+// ~~~~~~~~ Arrays ~~~~~~~~
+
+// PersistentVector >> from_array(array: *Array<T>) -> *PersistentVector<T>
+//
+// Creates a vector with a copy of the elements of ``array``, in O(n).
+//
+// Returns
+// -------
+// *PersistentVector<T>: The new vector, or NULL on failure.
+//
+Self * fn(from_array)(Array(T) * array) {
+    ensure(array, NULL);
+
+    Self * empty = fn(new)();
+    Self * vector = fn(transient)(empty);
+    fn(delete)(empty);
+    ensure(vector, NULL);
+
+    for (size_t i = 0; i < array->_size; i++) {
+        if (not fn(push)(vector, array->data[i])) {
+            fn(delete)(vector);
+            return NULL;
+        }
+    }
+    return fn(persistent)(vector);
+}
+
+// PersistentVector >> to_array(vector: *PersistentVector<T>) -> *Array<T>
+//
+// Copies the elements into a new ``Array<T>``, a leaf at a time.
+//
+// Returns
+// -------
+// *Array<T>: The new array, or NULL on failure.
+//
+Array(T) * fn(to_array)(Self * vector) {
+    ensure(vector, NULL);
+
+    Array(T) * array = Array(T, new)(vector->_size);
+    ensure(array, NULL);
+
+    for (size_t i = 0; i < vector->_size; i += PERSISTENT_VECTOR_WIDTH) {
+        size_t count = vector->_size - i < PERSISTENT_VECTOR_WIDTH ? vector->_size - i : PERSISTENT_VECTOR_WIDTH;
+        memcpy(&array->data[i], fn(_leaf)(vector, i)->values, count * sizeof(T));
+    }
+    return array;
+}
+
+
+// ~~~~~~~~ Printing ~~~~~~~~
+
+// PersistentVector >> print(vector: *PersistentVector<T>) -> void
+//
+// Prints the elements on terminal.
+//
+void fn(print)(Self * vector) {
+    ensure(vector,);
+
+    printf("[");
+    for (size_t i = 0; i < vector->_size; i++) {
+        PRINT_T(*fn(get)(vector, i));
+        if (i + 1 < vector->_size) printf(", ");
+    }
+    printf("]");
+}
+
+// PersistentVector >> println(vector: *PersistentVector<T>) -> void
+//
+// Prints the elements on terminal followed by a newline.
+//
+void fn(println)(Self * vector) {
+    fn(print)(vector);
+    printf("\n");
+}
+
+// PersistentVector >> debug(vector: *PersistentVector<T>) -> void
+//
+// Prints the debug representation of the vector.
+//
+void fn(debug)(Self * vector) {
+    if (not vector) {
+        printf("PersistentVector<%s> { NULL }\n", TOSTRING(T));
+        return;
+    }
+
+    printf("PersistentVector<%s> {\n", TOSTRING(T));
+    printf("  size: %zu,\n", vector->_size);
+    printf("  levels: %u,\n", vector->root ? vector->_shift / PERSISTENT_VECTOR_BITS : 0);
+    printf("  tail: %zu,\n", vector->_size - fn(_tail_offset)(vector));
+    printf("  transient: %s,\n", vector->_owner ? "true" : "false");
+    printf("  data: "); fn(println)(vector);
+    printf("}\n");
+}
+
+#undef MODULE
+#undef Self
+#undef fn
+#undef T
+#undef PRINT_T
@@ -0,0 +1,98 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <math.h>
+#include <stdio.h>
+#include <time.h>
+
+#define T float
+#define PRINT_T(value) printf("%g", value)
+#include "../array/array.h"
+
+#include "quantized.h"
+
+double seconds() {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec + now.tv_nsec * 1e-9;
+}
+
+float dot_f32(const float * a, const float * b, size_t count) {
+    float total = 0.0f;
+    for (size_t i = 0; i < count; i++) total += a[i] * b[i];
+    return total;
+}
+
+int main() {
+
+    // An embedding table of rows x dim, roughly normal values.
+    size_t rows = 20000, dim = 256, size = rows * dim;
+    Array(float) * table = Array(float, new)(size);
+    Array(float) * query = Array(float, new)(dim);
+
+    srand(42);
+    for (size_t i = 0; i < size; i++) {
+        float u = 0.0f;
+        for (int k = 0; k < 4; k++) u += (float) rand() / RAND_MAX - 0.5f;
+        Array(float, set)(table, i, u);
+    }
+    for (size_t i = 0; i < dim; i++)
+        Array(float, set)(query, i, (float) rand() / RAND_MAX - 0.5f);
+
+    const char * names[] = { "f16", "bf16", "i8" };
+
+    // Baseline throughput over plain floats.
+    double start = seconds();
+    float checksum = 0.0f;
+    for (size_t r = 0; r < rows; r++)
+        checksum += dot_f32(table->data + r * dim, query->data, dim);
+    double baseline = seconds() - start;
+
+    printf("%-5s %10s %12s %12s %10s %10s\n",
+        "mode", "bytes", "max abs err", "rel dot err", "dot Gel/s", "speedup");
+    printf("%-5s %10zu %12s %12s %10.2f %10s\n", "f32", size * sizeof(float),
+        "-", "-", size / baseline / 1e9, "1.00x");
+
+    for (QuantMode mode = QUANT_F16; mode <= QUANT_I8; mode++) {
+        QuantArray * quantized = QuantArray_from_array(table, mode);
+        Array(float) * restored = QuantArray_to_array(quantized);
+
+        float max_error = 0.0f;
+        for (size_t i = 0; i < size; i++) {
+            float error = fabsf(restored->data[i] - table->data[i]);
+            max_error = error > max_error ? error : max_error;
+        }
+
+        double dot_error = 0.0, dot_norm = 0.0;
+        float total = 0.0f;
+        start = seconds();
+        for (size_t r = 0; r < rows; r++)
+            total += QuantArray_dot(quantized, query->data, r * dim, dim);
+        double elapsed = seconds() - start;
+
+        for (size_t r = 0; r < rows; r += 97) {
+            float exact = dot_f32(table->data + r * dim, query->data, dim);
+            float approx = QuantArray_dot(quantized, query->data, r * dim, dim);
+            dot_error += fabs(exact - approx);
+            dot_norm += fabs(exact);
+        }
+
+        printf("%-5s %10zu %12.2e %12.2e %10.2f %9.2fx\n", names[mode],
+            QuantArray_bytes(quantized), max_error, dot_error / dot_norm,
+            size / elapsed / 1e9, baseline / elapsed);
+
+        checksum += total;
+        Array(float, delete)(restored);
+        QuantArray_delete(quantized);
+    }
+
+    float small[] = { 0.1f, -2.5f, 3.14159f, 65504.0f, 1e-6f };
+    QuantArray * half = QuantArray_new(small, 5, QUANT_F16);
+    QuantArray_debug(half);
+    printf("sum: %g (checksum %g)\n", QuantArray_sum(half, 0, 5), checksum);
+
+    QuantArray_delete(half);
+    Array(float, delete)(table);
+    Array(float, delete)(query);
+    return 0;
+
+}
@@ -0,0 +1,589 @@
+// ==========
+// QuantArray
+// ==========
+//
+// :Author: RickBarretto
+// :Year: 2026
+// :License: MPL 2.0
+// :Copyright: RickBarretto, 2026
+// :Version: 1.0
+//
+// ``QuantArray`` is a compact companion of ``Array<float>``.
+// It stores the same values in one of the following modes:
+//
+// - ``QUANT_F16``: IEEE 754 half precision, 2 bytes per value.
+// - ``QUANT_BF16``: bfloat16 (truncated float), 2 bytes per value.
+// - ``QUANT_I8``: signed 8-bit integers with one float scale
+//   per block of QUANT_BLOCK_LEN values, ~1.1 bytes per value.
+//
+// ``sum`` and ``dot`` work directly on the compressed form,
+// so an embedding table never has to be expanded back to floats.
+//
+// When compiled with F16C and FMA (e.g. ``-mf16c -mfma`` or
+// ``-march=native``), half precision conversions and kernels use
+// the hardware instructions, 8 lanes at a time. With AVX2 and FMA,
+// so do the bfloat16 and int8 kernels.
+// Otherwise the portable paths are used, written to be auto-vectorized.
+//
+// How to Use
+// ----------
+//
+// Include ``Array<float>`` first, then this header:
+//
+//      #define T float
+//      #define PRINT_T(value) printf("%g", value)
+//      #include "../array/array.h"
+//
+//      #include "quantized.h"
+//
+// And a common way to use it would be:
+//
+//      QuantArray * table = QuantArray_from_array(embeddings, QUANT_I8);
+//      float score = QuantArray_dot(table, query->data, 0, 128);
+//
+
+#ifndef QUANTIZED_H
+#define QUANTIZED_H
+
+// =~=~=~=~=~=~=~=~ Imports ~=~=~=~=~=~=~=~=
+
+#include <iso646.h>
+#include <math.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__F16C__) && defined(__FMA__)
+#include <immintrin.h>
+#define QUANT_F16C 1
+#endif
+
+#if defined(__AVX2__) && defined(__FMA__)
+#include <immintrin.h>
+#define QUANT_AVX2 1
+#endif
+
+
+// =~=~=~=~=~=~=~=~ Helper Macros ~=~=~=~=~=~=~=~=
+
+#define ensure(COND, VAL) if (not (COND)) return VAL
+
+
+// =~=~=~=~=~=~=~=~ Implementation ~=~=~=~=~=~=~=~=
+
+// QUANT_BLOCK_LEN: Number of values sharing one scale on QUANT_I8.
+#define QUANT_BLOCK_LEN 32
+
+typedef enum {
+    QUANT_F16,
+    QUANT_BF16,
+    QUANT_I8,
+} QuantMode;
+
+typedef struct {
+    QuantMode mode;
+    size_t _size;
+    void * data;        // uint16_t for F16/BF16, int8_t for I8
+    float * scales;     // one per block on I8, NULL otherwise
+} QuantArray;
+
+
+// ~~~~~~~~ Scalar conversions ~~~~~~~~
+
+uint32_t _Quant_bits(float value) {
+    uint32_t bits;
+    memcpy(&bits, &value, 4);
+    return bits;
+}
+
+float _Quant_float(uint32_t bits) {
+    float value;
+    memcpy(&value, &bits, 4);
+    return value;
+}
+
+// Quant >> f32_to_f16(value: float) -> u16
+//
+// Converts to half precision, rounding to nearest even.
+// Out of range values become infinity, tiny ones become subnormals.
+//
+uint16_t Quant_f32_to_f16(float value) {
+    uint32_t bits = _Quant_bits(value);
+    uint16_t sign = (bits >> 16) & 0x8000;
+    uint32_t exponent = (bits >> 23) & 0xff;
+    uint32_t mantissa = bits & 0x7fffff;
+
+    if (exponent == 0xff)                                   // inf / NaN
+        return sign | 0x7c00 | (mantissa ? 0x200 : 0);
+
+    int32_t half_exponent = (int32_t) exponent - 127 + 15;
+    if (half_exponent >= 31) return sign | 0x7c00;           // overflow
+
+    if (half_exponent <= 0) {                               // subnormal
+        if (half_exponent < -10) return sign;
+        mantissa |= 0x800000;
+        uint32_t shift = (uint32_t) (14 - half_exponent);
+        uint32_t half = mantissa >> shift;
+        uint32_t rest = mantissa & ((1u << shift) - 1);
+        uint32_t midway = 1u << (shift - 1);
+        if (rest > midway or (rest == midway and (half & 1))) half++;
+        return sign | (uint16_t) half;
+    }
+
+    uint32_t half = ((uint32_t) half_exponent << 10) | (mantissa >> 13);
+    uint32_t rest = mantissa & 0x1fff;
+    if (rest > 0x1000 or (rest == 0x1000 and (half & 1))) half++;  // may carry into inf
+    return sign | (uint16_t) half;
+}
+
+// Quant >> f16_to_f32(value: u16) -> float
+//
+// Converts from half precision, exactly.
+//
+float Quant_f16_to_f32(uint16_t value) {
+    uint32_t sign = (uint32_t) (value & 0x8000) << 16;
+    uint32_t exponent = (value >> 10) & 0x1f;
+    uint32_t mantissa = value & 0x3ff;
+
+    if (exponent == 0x1f)
+        return _Quant_float(sign | 0x7f800000 | (mantissa << 13));
+    if (exponent == 0) {
+        float magnitude = (float) mantissa * (1.0f / 16777216.0f);   // 2^-24
+        return sign ? -magnitude : magnitude;
+    }
+    return _Quant_float(sign | ((exponent + 112) << 23) | (mantissa << 13));
+}
+
+// Quant >> f32_to_bf16(value: float) -> u16
+//
+// Converts to bfloat16, rounding to nearest even.
+//
+uint16_t Quant_f32_to_bf16(float value) {
+    uint32_t bits = _Quant_bits(value);
+    if ((bits & 0x7fffffff) > 0x7f800000) return (uint16_t) ((bits >> 16) | 0x40);
+    bits += 0x7fff + ((bits >> 16) & 1);
+    return (uint16_t) (bits >> 16);
+}
+
+// Quant >> bf16_to_f32(value: u16) -> float
+//
+// Converts from bfloat16, exactly.
+//
+float Quant_bf16_to_f32(uint16_t value) {
+    return _Quant_float((uint32_t) value << 16);
+}
+
+
+// ~~~~~~~~ Bulk conversion kernels ~~~~~~~~
+
+#ifdef QUANT_AVX2
+// 8 bfloat16 to 8 floats: each one is the top half of its float.
+__m256 _Quant_load_bf16(const uint16_t * in) {
+    __m256i wide = _mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i *) in));
+    return _mm256_castsi256_ps(_mm256_slli_epi32(wide, 16));
+}
+
+// 8 int8 to 8 floats.
+__m256 _Quant_load_i8(const int8_t * in) {
+    return _mm256_cvtepi32_ps(_mm256_cvtepi8_epi32(_mm_loadl_epi64((const __m128i *) in)));
+}
+
+float _Quant_hsum(__m256 acc) {
+    __m128 half = _mm_add_ps(_mm256_castps256_ps128(acc), _mm256_extractf128_ps(acc, 1));
+    half = _mm_add_ps(half, _mm_movehl_ps(half, half));
+    half = _mm_add_ss(half, _mm_movehdup_ps(half));
+    return _mm_cvtss_f32(half);
+}
+
+// Integer sum of a whole QUANT_BLOCK_LEN block.
+int32_t _Quant_block_sum_i8(const int8_t * in) {
+    __m256i bytes = _mm256_loadu_si256((const __m256i *) in);
+    __m256i ones = _mm256_set1_epi16(1);
+    __m256i low = _mm256_madd_epi16(_mm256_cvtepi8_epi16(_mm256_castsi256_si128(bytes)), ones);
+    __m256i high = _mm256_madd_epi16(_mm256_cvtepi8_epi16(_mm256_extracti128_si256(bytes, 1)), ones);
+    __m256i sum = _mm256_add_epi32(low, high);
+    __m128i half = _mm_add_epi32(_mm256_castsi256_si128(sum), _mm256_extracti128_si256(sum, 1));
+    half = _mm_add_epi32(half, _mm_shuffle_epi32(half, 0x4e));
+    half = _mm_add_epi32(half, _mm_shuffle_epi32(half, 0xb1));
+    return _mm_cvtsi128_si32(half);
+}
+#endif
+
+void _Quant_encode_f16(const float * in, size_t count, uint16_t * out) {
+    size_t i = 0;
+#ifdef QUANT_F16C
+    for (; i + 8 <= count; i += 8) {
+        __m128i half = _mm256_cvtps_ph(_mm256_loadu_ps(in + i), _MM_FROUND_TO_NEAREST_INT);
+        _mm_storeu_si128((__m128i *) (out + i), half);
+    }
+#endif
+    for (; i < count; i++) out[i] = Quant_f32_to_f16(in[i]);
+}
+
+void _Quant_decode_f16(const uint16_t * in, size_t count, float * out) {
+    size_t i = 0;
+#ifdef QUANT_F16C
+    for (; i + 8 <= count; i += 8)
+        _mm256_storeu_ps(out + i, _mm256_cvtph_ps(_mm_loadu_si128((const __m128i *) (in + i))));
+#endif
+    for (; i < count; i++) out[i] = Quant_f16_to_f32(in[i]);
+}
+
+void _Quant_encode_i8(const float * in, size_t count, int8_t * out, float * scales) {
+    for (size_t block = 0; block * QUANT_BLOCK_LEN < count; block++) {
+        const float * values = in + block * QUANT_BLOCK_LEN;
+        size_t length = count - block * QUANT_BLOCK_LEN;
+        if (length > QUANT_BLOCK_LEN) length = QUANT_BLOCK_LEN;
+
+        float max = 0.0f;
+        for (size_t i = 0; i < length; i++)
+            max = fabsf(values[i]) > max ? fabsf(values[i]) : max;
+
+        float scale = max / 127.0f;
+        float inverse = (scale > 0.0f) ? 1.0f / scale : 0.0f;
+        scales[block] = scale;
+        for (size_t i = 0; i < length; i++)
+            out[block * QUANT_BLOCK_LEN + i] = (int8_t) lrintf(values[i] * inverse);
+    }
+}
+
+// QuantArray >> decode(array: *QuantArray, start: size_t, count: size_t, out: *float) -> size_t
+//
+// Expands a range of the array back to floats.
+//
+// Returns
+// -------
+// size_t: The number of values written, clamped to the array bounds.
+//
+size_t QuantArray_decode(QuantArray * array, size_t start, size_t count, float * out) {
+    ensure(array and out, 0);
+    ensure(start < array->_size, 0);
+    if (count > array->_size - start) count = array->_size - start;
+
+    switch (array->mode) {
+        case QUANT_F16:
+            _Quant_decode_f16((uint16_t *) array->data + start, count, out);
+            break;
+        case QUANT_BF16: {
+            const uint16_t * in = (uint16_t *) array->data + start;
+            size_t i = 0;
+#ifdef QUANT_AVX2
+            for (; i + 8 <= count; i += 8) _mm256_storeu_ps(out + i, _Quant_load_bf16(in + i));
+#endif
+            for (; i < count; i++) out[i] = Quant_bf16_to_f32(in[i]);
+            break;
+        }
+        case QUANT_I8: {
+            const int8_t * in = array->data;
+            for (size_t i = start; i < start + count; i++)
+                out[i - start] = (float) in[i] * array->scales[i / QUANT_BLOCK_LEN];
+            break;
+        }
+    }
+    return count;
+}
+
+
+// ~~~~~~~~ Lifecycle ~~~~~~~~
+
+// QuantArray >> new(values: *float, size: size_t, mode: QuantMode) -> *QuantArray
+//
+// Quantizes ``size`` floats into a new array.
+//
+// Parameters
+// ----------
+// values : *float
+//     The values to quantize.
+// size : size_t
+//     The number of values.
+// mode : QuantMode
+//     The storage mode.
+//
+// Returns
+// -------
+// *QuantArray: A pointer to the newly created array.
+//
+QuantArray * QuantArray_new(const float * values, size_t size, QuantMode mode) {
+    ensure(values or size == 0, NULL);
+
+    QuantArray * array = malloc(sizeof(QuantArray));
+    size_t width = (mode == QUANT_I8) ? 1 : 2;
+    size_t blocks = (size + QUANT_BLOCK_LEN - 1) / QUANT_BLOCK_LEN;
+    void * data = malloc(size ? size * width : 1);
+    float * scales = (mode == QUANT_I8) ? malloc((blocks ? blocks : 1) * sizeof(float)) : NULL;
+
+    if (not array or not data or (mode == QUANT_I8 and not scales)) {
+        free(array); free(data); free(scales);
+        return NULL;
+    }
+
+    switch (mode) {
+        case QUANT_F16: _Quant_encode_f16(values, size, data); break;
+        case QUANT_BF16:
+            for (size_t i = 0; i < size; i++)
+                ((uint16_t *) data)[i] = Quant_f32_to_bf16(values[i]);
+            break;
+        case QUANT_I8: _Quant_encode_i8(values, size, data, scales); break;
+    }
+
+    array->mode = mode;
+    array->_size = size;
+    array->data = data;
+    array->scales = scales;
+    return array;
+}
+
+// QuantArray >> from_array(array: *Array<float>, mode: QuantMode) -> *QuantArray
+//
+// Quantizes an ``Array<float>``. The source array is left untouched.
+//
+QuantArray * QuantArray_from_array(Array(float) * array, QuantMode mode) {
+    ensure(array, NULL);
+    return QuantArray_new(array->data, Array(float, size)(array), mode);
+}
+
+// QuantArray >> to_array(array: *QuantArray) -> *Array<float>
+//
+// Expands the array back into a new ``Array<float>``.
+//
+Array(float) * QuantArray_to_array(QuantArray * array) {
+    ensure(array, NULL);
+
+    Array(float) * result = Array(float, new)(array->_size);
+    ensure(result, NULL);
+
+    QuantArray_decode(array, 0, array->_size, result->data);
+    return result;
+}
+
+// QuantArray >> delete(array: *QuantArray) -> bool
+//
+// Safely deletes the array.
+//
+// Returns
+// -------
+// bool: Returns true on success.
+//
+bool QuantArray_delete(QuantArray * array) {
+    ensure(array, false);
+
+    free(array->data);
+    free(array->scales);
+    free(array);
+    return true;
+}
+
+// QuantArray >> size(array: *QuantArray) -> size_t
+//
+// Returns the number of elements in the array.
+//
+size_t QuantArray_size(QuantArray * array) {
+    ensure(array, 0);
+    return array->_size;
+}
+
+// QuantArray >> bytes(array: *QuantArray) -> size_t
+//
+// Returns the memory used by the values and scales.
+//
+size_t QuantArray_bytes(QuantArray * array) {
+    ensure(array, 0);
+
+    if (array->mode != QUANT_I8) return array->_size * 2;
+    size_t blocks = (array->_size + QUANT_BLOCK_LEN - 1) / QUANT_BLOCK_LEN;
+    return array->_size + blocks * sizeof(float);
+}
+
+// QuantArray >> get(array: *QuantArray, index: size_t) -> float
+//
+// Returns the dequantized element at the specified index,
+// or NaN if the index is out of bounds.
+//
+float QuantArray_get(QuantArray * array, size_t index) {
+    float value = NAN;
+    QuantArray_decode(array, index, 1, &value);
+    return value;
+}
+
+
+// ~~~~~~~~ Fused kernels ~~~~~~~~
+
+// QuantArray >> sum(array: *QuantArray, start: size_t, count: size_t) -> float
+//
+// Sums a range without expanding it to memory.
+// On QUANT_I8 each block is summed as integers and scaled once.
+//
+float QuantArray_sum(QuantArray * array, size_t start, size_t count) {
+    ensure(array, 0.0f);
+    ensure(start < array->_size, 0.0f);
+    if (count > array->_size - start) count = array->_size - start;
+
+    size_t end = start + count, i = start;
+    float total = 0.0f;
+
+    switch (array->mode) {
+        case QUANT_F16: {
+            const uint16_t * in = array->data;
+#ifdef QUANT_F16C
+            __m256 acc = _mm256_setzero_ps();
+            for (; i + 8 <= end; i += 8)
+                acc = _mm256_add_ps(acc, _mm256_cvtph_ps(_mm_loadu_si128((const __m128i *) (in + i))));
+            float lanes[8];
+            _mm256_storeu_ps(lanes, acc);
+            for (int k = 0; k < 8; k++) total += lanes[k];
+#endif
+            for (; i < end; i++) total += Quant_f16_to_f32(in[i]);
+            break;
+        }
+        case QUANT_BF16: {
+            const uint16_t * in = array->data;
+#ifdef QUANT_AVX2
+            __m256 acc = _mm256_setzero_ps();
+            for (; i + 8 <= end; i += 8) acc = _mm256_add_ps(acc, _Quant_load_bf16(in + i));
+            total = _Quant_hsum(acc);
+#endif
+            for (; i < end; i++) total += Quant_bf16_to_f32(in[i]);
+            break;
+        }
+        case QUANT_I8: {
+            const int8_t * in = array->data;
+            while (i < end) {
+                size_t block = i / QUANT_BLOCK_LEN;
+                size_t stop = (block + 1) * QUANT_BLOCK_LEN;
+                if (stop > end) stop = end;
+
+                int32_t partial = 0;
+#ifdef QUANT_AVX2
+                if (stop - i == QUANT_BLOCK_LEN) {
+                    partial = _Quant_block_sum_i8(in + i);
+                    i = stop;
+                }
+#endif
+                for (; i < stop; i++) partial += in[i];
+                total += (float) partial * array->scales[block];
+            }
+            break;
+        }
+    }
+    return total;
+}
+
+// QuantArray >> dot(array: *QuantArray, vector: *float, start: size_t, count: size_t) -> float
+//
+// Dot product of ``array[start .. start + count]`` with a float vector,
+// computed on the compressed form.
+// On QUANT_I8 each block is accumulated in float, as the vector is float,
+// and scaled once.
+// Typical use is scoring row ``r`` of an embedding table of ``dim`` columns:
+// ``QuantArray_dot(table, query, r * dim, dim)``.
+//
+// Parameters
+// ----------
+// array : *QuantArray
+//     The quantized operand.
+// vector : *float
+//     The float operand, with at least ``count`` elements.
+// start : size_t
+//     First element of the quantized operand.
+// count : size_t
+//     Number of elements, clamped to the array bounds.
+//
+// Returns
+// -------
+// float: The dot product, 0 on invalid arguments.
+//
+float QuantArray_dot(QuantArray * array, const float * vector, size_t start, size_t count) {
+    ensure(array and vector, 0.0f);
+    ensure(start < array->_size, 0.0f);
+    if (count > array->_size - start) count = array->_size - start;
+
+    float total = 0.0f;
+    size_t i = 0;
+
+    switch (array->mode) {
+        case QUANT_F16: {
+            const uint16_t * in = (uint16_t *) array->data + start;
+#ifdef QUANT_F16C
+            __m256 acc = _mm256_setzero_ps();
+            for (; i + 8 <= count; i += 8) {
+                __m256 values = _mm256_cvtph_ps(_mm_loadu_si128((const __m128i *) (in + i)));
+                acc = _mm256_fmadd_ps(values, _mm256_loadu_ps(vector + i), acc);
+            }
+            float lanes[8];
+            _mm256_storeu_ps(lanes, acc);
+            for (int k = 0; k < 8; k++) total += lanes[k];
+#endif
+            for (; i < count; i++) total += Quant_f16_to_f32(in[i]) * vector[i];
+            break;
+        }
+        case QUANT_BF16: {
+            const uint16_t * in = (uint16_t *) array->data + start;
+#ifdef QUANT_AVX2
+            __m256 acc = _mm256_setzero_ps();
+            for (; i + 8 <= count; i += 8)
+                acc = _mm256_fmadd_ps(_Quant_load_bf16(in + i), _mm256_loadu_ps(vector + i), acc);
+            total = _Quant_hsum(acc);
+#endif
+            for (; i < count; i++) total += Quant_bf16_to_f32(in[i]) * vector[i];
+            break;
+        }
+        case QUANT_I8: {
+            const int8_t * in = array->data;
+            size_t end = start + count;
+#ifdef QUANT_AVX2
+            __m256 acc = _mm256_setzero_ps();
+#endif
+            for (size_t at = start; at < end; ) {
+                size_t block = at / QUANT_BLOCK_LEN;
+                size_t stop = (block + 1) * QUANT_BLOCK_LEN;
+                if (stop > end) stop = end;
+
+#ifdef QUANT_AVX2
+                if (stop - at == QUANT_BLOCK_LEN) {
+                    const float * v = vector + (at - start);
+                    __m256 partial = _mm256_mul_ps(_Quant_load_i8(in + at), _mm256_loadu_ps(v));
+                    for (int k = 8; k < QUANT_BLOCK_LEN; k += 8)
+                        partial = _mm256_fmadd_ps(_Quant_load_i8(in + at + k), _mm256_loadu_ps(v + k), partial);
+                    acc = _mm256_fmadd_ps(partial, _mm256_set1_ps(array->scales[block]), acc);
+                    at = stop;
+                    continue;
+                }
+#endif
+                float partial = 0.0f;
+                for (; at < stop; at++) partial += (float) in[at] * vector[at - start];
+                total += partial * array->scales[block];
+            }
+#ifdef QUANT_AVX2
+            total += _Quant_hsum(acc);
+#endif
+            break;
+        }
+    }
+    return total;
+}
+
+// QuantArray >> debug(array: *QuantArray) -> void
+//
+// Prints the debug representation of the array.
+//
+void QuantArray_debug(QuantArray * array) {
+    if (not array) {
+        printf("QuantArray { NULL }\n");
+        return;
+    }
+
+    const char * modes[] = { "f16", "bf16", "i8" };
+    printf("QuantArray<%s> {\n", modes[array->mode]);
+    printf("  size: %zu,\n", array->_size);
+    printf("  bytes: %zu,\n", QuantArray_bytes(array));
+    printf("  data: [");
+    for (size_t i = 0; i < array->_size; i++) {
+        printf("%g", QuantArray_get(array, i));
+        if (i < array->_size - 1) printf(", ");
+    }
+    printf("]\n}\n");
+}
+
+#endif
@@ -0,0 +1,151 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <pthread.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <time.h>
+
+#define T int64_t
+#define PRINT_T(value) printf("%lld", (long long) value)
+#include "../array/array.h"
+
+#include "../thread_pool/thread_pool.h"
+
+#define T int64_t
+#define PRINT_T(value) printf("%lld", (long long) value)
+#include "rcu_array.h"
+
+// Usage: ./main [lookups] [threads], defaults to 2^22 lookups per reader
+// on 8 threads over a table of 4096 entries. With a writer, thread 0
+// publishes a new table as fast as it can instead of reading.
+
+#define TABLE 4096
+
+typedef RcuArray(int64_t) Table;
+
+// CPU time of the calling thread, so readers are not charged for the writer's time slices.
+double thread_seconds() {
+    struct timespec now;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &now);
+    return now.tv_sec + now.tv_nsec * 1e-9;
+}
+
+uint64_t next_random(uint64_t * seed) {
+    *seed = *seed * 6364136223846793005ull + 1442695040888963407ull;
+    return *seed >> 32;
+}
+
+// Every table holds ``version + index``, so a torn read is noticed.
+typedef struct {
+    Table * rcu;
+    Array(int64_t) * locked;            // the same table behind a readers-writer lock
+    pthread_rwlock_t lock;
+    size_t lookups;
+    bool writer;
+    bool use_lock;
+    _Atomic size_t readers_left;
+    _Atomic size_t published;
+    _Atomic size_t torn;
+    _Atomic uint64_t nanoseconds;       // reader CPU time, summed
+} Job;
+
+void write_tables(Job * job, size_t worker) {
+    int64_t version = 0;
+    while (atomic_load(&job->readers_left) > 0) {
+        version++;
+        Array(int64_t) * fresh = Array(int64_t, new)(TABLE);
+        for (size_t i = 0; i < TABLE; i++) fresh->data[i] = version + (int64_t) i;
+
+        if (job->use_lock) {
+            pthread_rwlock_wrlock(&job->lock);
+            Array(int64_t) * old = job->locked;
+            job->locked = fresh;
+            pthread_rwlock_unlock(&job->lock);
+            Array(int64_t, delete)(old);
+        } else {
+            RcuArray(int64_t, publish)(job->rcu, worker, fresh);
+        }
+        atomic_fetch_add(&job->published, 1);
+    }
+}
+
+void run(void * context, size_t task, size_t worker) {
+    Job * job = context;
+    if (job->writer and task == 0) {
+        write_tables(job, worker);
+        return;
+    }
+
+    uint64_t seed = task + 1;
+    size_t torn = 0;
+    double start = thread_seconds();
+    for (size_t i = 0; i < job->lookups; i++) {
+        size_t key = next_random(&seed) % TABLE;
+        int64_t base, value;
+        if (job->use_lock) {
+            pthread_rwlock_rdlock(&job->lock);
+            base = job->locked->data[0];
+            value = job->locked->data[key];
+            pthread_rwlock_unlock(&job->lock);
+        } else {
+            Array(int64_t) * snapshot = RcuArray(int64_t, enter)(job->rcu, worker);
+            base = snapshot->data[0];
+            value = snapshot->data[key];
+            RcuArray(int64_t, exit)(job->rcu, worker);
+        }
+        torn += value - base != (int64_t) key;
+    }
+    double elapsed = thread_seconds() - start;
+
+    atomic_fetch_add(&job->nanoseconds, (uint64_t) (elapsed * 1e9));
+    atomic_fetch_add(&job->torn, torn);
+    atomic_fetch_sub(&job->readers_left, 1);
+}
+
+int main(int argc, char ** argv) {
+
+    Table * small = RcuArray(int64_t, new)(1, 4);
+    RcuArray(int64_t, update)(small, 0, 1, 10);
+    Array(int64_t) * fresh = RcuArray(int64_t, copy)(small, 0);
+    fresh->data[3] = 30;
+    RcuArray(int64_t, publish)(small, 0, fresh);
+    RcuArray(int64_t, debug)(small, 0);
+    RcuArray(int64_t, delete)(small);
+
+    size_t lookups = argc > 1 ? (size_t) atoll(argv[1]) : (size_t) 1 << 22;
+    size_t threads = argc > 2 ? (size_t) atoll(argv[2]) : 8;
+    if (threads < 2) threads = 2;              // a writer and a reader
+    printf("\n%zu lookups per reader, %zu threads, %zu cores\n", lookups, threads, ThreadPool_cores());
+    printf("                 ns/lookup   tables published   torn reads\n");
+
+    ThreadPool * pool = ThreadPool_new(threads);
+    for (int use_lock = 0; use_lock < 2; use_lock++) {
+        for (int writer = 0; writer < 2; writer++) {
+            Job job = { .lookups = lookups, .writer = writer, .use_lock = use_lock };
+            Array(int64_t) * table = Array(int64_t, new)(TABLE);
+            for (size_t i = 0; i < TABLE; i++) table->data[i] = (int64_t) i;
+            job.locked = Array(int64_t, new)(TABLE);
+            for (size_t i = 0; i < TABLE; i++) job.locked->data[i] = (int64_t) i;
+            job.rcu = RcuArray(int64_t, from_array)(threads, table);
+            pthread_rwlock_init(&job.lock, NULL);
+
+            size_t readers = writer ? threads - 1 : threads;
+            atomic_init(&job.readers_left, readers);
+            atomic_init(&job.published, 0);
+            atomic_init(&job.torn, 0);
+            atomic_init(&job.nanoseconds, 0);
+            ThreadPool_run(pool, threads, run, &job);
+
+            printf("%-7s %-8s %8.1f   %16zu   %10zu\n", use_lock ? "rwlock" : "rcu", writer ? "writer" : "idle",
+                (double) atomic_load(&job.nanoseconds) / (readers * lookups),
+                atomic_load(&job.published), atomic_load(&job.torn));
+
+            RcuArray(int64_t, delete)(job.rcu);
+            Array(int64_t, delete)(job.locked);
+            pthread_rwlock_destroy(&job.lock);
+        }
+    }
+    ThreadPool_delete(pool);
+    return 0;
+
+}
@@ -0,0 +1,416 @@
+// ===========
+// RcuArray<T>
+// ===========
+//
+// :Author: RickBarretto
+// :Year: 2026
+// :License: MPL 2.0
+// :Copyright: RickBarretto, 2026
+// :Version: 1.0
+//
+// ``RcuArray<T>`` shares a read-mostly ``Array<T>``, such as a lookup
+// table loaded from configuration, between many reader threads and
+// a few writers, in the read-copy-update style.
+//
+// Readers never lock and never write shared memory but their own
+// epoch: ``enter`` announces the thread to the array's ``Ebr`` domain
+// and takes the current snapshot with a single acquire load. The cost
+// is the same however often writers publish.
+//
+// Writers never touch a published snapshot. They build a new Array,
+// usually from ``copy``, and ``publish`` it with an atomic exchange.
+// The old snapshot is handed to ``Ebr`` and deleted after a grace
+// period, once every reader that could hold it has left. ``update``
+// does the copy, change and publish of one element for you, retrying
+// if another writer published in between.
+//
+// Old snapshots are freed by the next publications. If they are rare,
+// call ``Ebr_reclaim(rcu->ebr, thread)`` now and then, or start the
+// domain's background thread with ``Ebr_start(rcu->ebr, interval)``.
+//
+// Threads are numbered, like ``ThreadPool`` workers: each call names
+// the index of the calling thread. An index must not be used by two
+// threads at once.
+//
+// How to Use
+// ----------
+//
+// Include ``Array<T>`` first, then this header with the same T:
+//
+//      #define T int64_t
+//      #define PRINT_T(value) printf("%lld", (long long) value)
+//      #include "../array/array.h"
+//
+//      #define T int64_t
+//      #define PRINT_T(value) printf("%lld", (long long) value)
+//      #include "rcu_array.h"
+//
+// And a common way to use it would be:
+//
+//      RcuArray(int64_t) * table = RcuArray(int64_t, from_array)(threads, loaded);
+//
+//      Array(int64_t) * snapshot = RcuArray(int64_t, enter)(table, worker);     // readers
+//      int64_t limit = snapshot->data[key];
+//      RcuArray(int64_t, exit)(table, worker);
+//
+//      Array(int64_t) * fresh = RcuArray(int64_t, copy)(table, worker);         // writers
+//      fresh->data[key] = 100;
+//      RcuArray(int64_t, publish)(table, worker, fresh);
+//
+// Link with ``-pthread``.
+//
+
+// =~=~=~=~=~=~=~=~ Imports ~=~=~=~=~=~=~=~=
+
+#include <iso646.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../ebr/ebr.h"
+
+
+// =~=~=~=~=~=~=~=~ Helper Macros ~=~=~=~=~=~=~=~=
+
+#define _CAT(X, Y) X ## _ ## Y
+#define CAT(X, Y) _CAT(X, Y)
+#define _CAT3(X, Y, Z) X ## _ ## Y ## _ ## Z
+#define CAT3(X, Y, Z) _CAT3(X, Y, Z)
+
+#define STRINGIFY(x) #x
+#define TOSTRING(x) STRINGIFY(x)
+
+#define ensure(COND, VAL) if (not (COND)) return VAL
+
+
+// =~=~=~=~=~=~=~=~ Implementation ~=~=~=~=~=~=~=~=
+
+// T: Element type of the RcuArray<T>
+#ifndef T
+#error "T is not defined"
+#endif
+
+// PRINT_T: (T) -> void
+//
+// PRINT_T is a macro that defines how to print an element of type T.
+// See ``Array<T>`` for more details.
+//
+#ifndef PRINT_T
+#error "PRINT_T is not defined"
+#endif
+
+#define MODULE RcuArray
+#define Self CAT(MODULE, T)
+#define fn(NAME) CAT(Self, NAME)
+
+#define _RCU_ARRAY_SELECT_MACRO(_1, _2, NAME, ...) NAME
+#define RcuArray(...) _RCU_ARRAY_SELECT_MACRO(__VA_ARGS__, RcuArray2, RcuArray1)(__VA_ARGS__)
+#define RcuArray1(T) CAT(RcuArray, T)
+#define RcuArray2(T, FUNC) CAT3(RcuArray, T, FUNC)
+
+typedef struct {
+    _Atomic(Array(T) *) current;    // the published snapshot, never written
+    Ebr * ebr;
+    _Atomic size_t _version;        // publications so far
+} Self;
+
+
+// ~~~~~~~~ Snapshots ~~~~~~~~
+
+// The Ebr destructor of an old snapshot.
+void fn(_drop)(void * context, void * array) {
+    (void) context;
+    Array(T, delete)(array);
+}
+
+// Whether ``thread`` is inside ``enter``, where waiting out readers
+// in ``_retire`` would wait for the thread itself.
+bool fn(_inside)(Self * rcu, size_t thread) {
+    return rcu->ebr->threads[thread].depth > 0;
+}
+
+// Hands an unpublished snapshot to Ebr, or waits out readers if it cannot.
+// The caller must not be inside ``enter``.
+void fn(_retire)(Self * rcu, size_t thread, Array(T) * old) {
+    if (Ebr_defer_free(rcu->ebr, thread, old, fn(_drop), NULL)) return;
+
+    Ebr_synchronize(rcu->ebr);
+    Array(T, delete)(old);
+}
+
+// A private copy of ``array``.
+Array(T) * fn(_clone)(Array(T) * array) {
+    Array(T) * copy = Array(T, new)(array->_size);
+    ensure(copy, NULL);
+
+    if (array->_size) memcpy(copy->data, array->data, array->_size * sizeof(T));
+    return copy;
+}
+
+
+// ~~~~~~~~ Lifetime ~~~~~~~~
+
+// RcuArray >> delete(rcu: *RcuArray<T>) -> bool
+//
+// Deletes the handle, the current snapshot and every old one.
+// No thread may still be inside.
+//
+// Returns
+// -------
+// bool: Returns true on success.
+//
+bool fn(delete)(Self * rcu) {
+    ensure(rcu, false);
+
+    Ebr_delete(rcu->ebr);
+    Array(T, delete)(atomic_load(&rcu->current));
+    ARRAY_FREE(rcu);
+    return true;
+}
+
+// RcuArray >> from_array(threads: size_t, array: *Array<T>) -> *RcuArray<T>
+//
+// Publishes ``array`` as the first snapshot, taking ownership of it.
+//
+// Parameters
+// ----------
+// threads : size_t
+//     The number of thread indices.
+// array : *Array<T>
+//     The first snapshot, no longer to be written nor deleted by the caller.
+//
+// Returns
+// -------
+// *RcuArray<T>: The new handle, or NULL on failure, leaving ``array`` to the caller.
+//
+Self * fn(from_array)(size_t threads, Array(T) * array) {
+    ensure(array, NULL);
+
+    Self * rcu = ARRAY_MALLOC(sizeof(Self));
+    ensure(rcu, NULL);
+
+    rcu->ebr = Ebr_new(threads);
+    if (not rcu->ebr) {
+        ARRAY_FREE(rcu);
+        return NULL;
+    }
+    atomic_init(&rcu->current, array);
+    atomic_init(&rcu->_version, 0);
+    return rcu;
+}
+
+// RcuArray >> new(threads: size_t, size: size_t) -> *RcuArray<T>
+//
+// Creates a handle whose first snapshot holds ``size`` zeros.
+//
+// Returns
+// -------
+// *RcuArray<T>: The new handle, or NULL on failure.
+//
+Self * fn(new)(size_t threads, size_t size) {
+    Array(T) * array = Array(T, new)(size);
+    ensure(array, NULL);
+
+    Self * rcu = fn(from_array)(threads, array);
+    if (not rcu) Array(T, delete)(array);
+    return rcu;
+}
+
+
+// ~~~~~~~~ Readers ~~~~~~~~
+
+// RcuArray >> enter(rcu: *RcuArray<T>, thread: size_t) -> *Array<T>
+//
+// Starts reading and returns the current snapshot, which stays valid
+// until the matching ``exit``. Snapshots are shared: do not write them.
+// Calls nest, and a nested call may return a newer snapshot.
+//
+// Returns
+// -------
+// *Array<T>: The current snapshot, or NULL on an invalid handle or thread.
+//
+Array(T) * fn(enter)(Self * rcu, size_t thread) {
+    ensure(rcu and thread < rcu->ebr->_threads, NULL);
+
+    Ebr_enter(rcu->ebr, thread);
+    return atomic_load_explicit(&rcu->current, memory_order_acquire);
+}
+
+// RcuArray >> exit(rcu: *RcuArray<T>, thread: size_t) -> void
+//
+// Stops reading. Snapshots from ``enter`` must not be used after.
+//
+void fn(exit)(Self * rcu, size_t thread) {
+    ensure(rcu,);
+    Ebr_exit(rcu->ebr, thread);
+}
+
+// RcuArray >> get(rcu: *RcuArray<T>, thread: size_t, index: size_t, out: *T) -> bool
+//
+// Copies one element of the current snapshot into ``out``.
+//
+// Returns
+// -------
+// bool: Returns true on success, false if the index is out of bounds.
+//
+bool fn(get)(Self * rcu, size_t thread, size_t index, T * out) {
+    Array(T) * snapshot = fn(enter)(rcu, thread);
+    ensure(snapshot, false);
+
+    bool found = index < snapshot->_size;
+    if (found and out) *out = snapshot->data[index];
+    fn(exit)(rcu, thread);
+    return found;
+}
+
+
+// ~~~~~~~~ Writers ~~~~~~~~
+
+// RcuArray >> copy(rcu: *RcuArray<T>, thread: size_t) -> *Array<T>
+//
+// Returns a private copy of the current snapshot, to be changed
+// and then published, or deleted.
+//
+// Returns
+// -------
+// *Array<T>: The copy, or NULL on failure.
+//
+Array(T) * fn(copy)(Self * rcu, size_t thread) {
+    Array(T) * snapshot = fn(enter)(rcu, thread);
+    ensure(snapshot, NULL);
+
+    Array(T) * copy = fn(_clone)(snapshot);
+    fn(exit)(rcu, thread);
+    return copy;
+}
+
+// RcuArray >> publish(rcu: *RcuArray<T>, thread: size_t, fresh: *Array<T>) -> bool
+//
+// Makes ``fresh`` the current snapshot, taking ownership of it,
+// and retires the previous one. Readers see either the old or the new
+// snapshot, never a mix. The caller must not be inside ``enter``.
+//
+// Parameters
+// ----------
+// rcu : *RcuArray<T>
+//     The handle to publish to.
+// thread : size_t
+//     The index of the calling thread.
+// fresh : *Array<T>
+//     The new snapshot, no longer to be written nor deleted by the caller.
+//
+// Returns
+// -------
+// bool: Returns true on success, false if called inside ``enter``,
+//       in which case ``fresh`` still belongs to the caller.
+//
+bool fn(publish)(Self * rcu, size_t thread, Array(T) * fresh) {
+    ensure(rcu and fresh and thread < rcu->ebr->_threads, false);
+    ensure(not fn(_inside)(rcu, thread), false);
+
+    Array(T) * old = atomic_exchange_explicit(&rcu->current, fresh, memory_order_acq_rel);
+    atomic_fetch_add_explicit(&rcu->_version, 1, memory_order_relaxed);
+    fn(_retire)(rcu, thread, old);
+    return true;
+}
+
+// RcuArray >> update(rcu: *RcuArray<T>, thread: size_t, index: size_t, value: T) -> bool
+//
+// Publishes a copy of the current snapshot with one element changed.
+// If another writer publishes first, the copy is made again from
+// its snapshot, so no update is lost. Batch changes with ``copy``
+// and ``publish`` instead: each call copies the whole array.
+// The caller must not be inside ``enter``.
+//
+// Returns
+// -------
+// bool: Returns true on success, false if called inside ``enter``,
+//       if the index is out of bounds or the copy could not be made.
+//
+bool fn(update)(Self * rcu, size_t thread, size_t index, T value) {
+    ensure(rcu and thread < rcu->ebr->_threads, false);
+    ensure(not fn(_inside)(rcu, thread), false);
+
+    while (true) {
+        Array(T) * snapshot = fn(enter)(rcu, thread);
+        ensure(snapshot, false);
+
+        Array(T) * fresh = index < snapshot->_size ? fn(_clone)(snapshot) : NULL;
+        if (not fresh) {
+            fn(exit)(rcu, thread);
+            return false;
+        }
+        fresh->data[index] = value;
+
+        // Still inside: ``snapshot`` cannot be freed and reused meanwhile.
+        bool published = atomic_compare_exchange_strong_explicit(&rcu->current, &snapshot, fresh,
+            memory_order_acq_rel, memory_order_acquire);
+        fn(exit)(rcu, thread);
+
+        if (published) {
+            atomic_fetch_add_explicit(&rcu->_version, 1, memory_order_relaxed);
+            fn(_retire)(rcu, thread, snapshot);
+            return true;
+        }
+        Array(T, delete)(fresh);
+    }
+}
+
+// RcuArray >> version(rcu: *RcuArray<T>) -> size_t
+//
+// Returns the number of snapshots published after the first.
+//
+size_t fn(version)(Self * rcu) {
+    ensure(rcu, 0);
+    return atomic_load_explicit(&rcu->_version, memory_order_relaxed);
+}
+
+
+// ~~~~~~~~ Printing ~~~~~~~~
+
+// RcuArray >> print(rcu: *RcuArray<T>, thread: size_t) -> void
+//
+// Prints the current snapshot on terminal.
+//
+void fn(print)(Self * rcu, size_t thread) {
+    Array(T) * snapshot = fn(enter)(rcu, thread);
+    ensure(snapshot,);
+
+    Array(T, print)(snapshot);
+    fn(exit)(rcu, thread);
+}
+
+// RcuArray >> println(rcu: *RcuArray<T>, thread: size_t) -> void
+//
+// Prints the current snapshot on terminal followed by a newline.
+//
+void fn(println)(Self * rcu, size_t thread) {
+    fn(print)(rcu, thread);
+    printf("\n");
+}
+
+// RcuArray >> debug(rcu: *RcuArray<T>, thread: size_t) -> void
+//
+// Prints the debug representation of the handle.
+//
+void fn(debug)(Self * rcu, size_t thread) {
+    if (not rcu) {
+        printf("RcuArray<%s> { NULL }\n", TOSTRING(T));
+        return;
+    }
+
+    printf("RcuArray<%s> {\n", TOSTRING(T));
+    printf("  version: %zu,\n", fn(version)(rcu));
+    printf("  epoch: %llu,\n", (unsigned long long) Ebr_epoch(rcu->ebr));
+    printf("  retired: %zu,\n", Ebr_pending(rcu->ebr));
+    printf("  current: "); fn(println)(rcu, thread);
+    printf("}\n");
+}
+
+#undef MODULE
+#undef Self
+#undef fn
+#undef T
+#undef PRINT_T
@@ -164,9 +164,9 @@
 
 #define _RESULT_SELECT_MACRO(_1, _2, _3, NAME, ...) NAME
 #define Result(...) _RESULT_SELECT_MACRO(__VA_ARGS__, Result3, Result2, Result1)(__VA_ARGS__)
-#define Result1(T) CAT(MODULE, T, T)
-#define Result2(T, E) CAT3(MODULE, T, E)
-#define Result3(T, E, FUNC) CAT(CAT3(MODULE, T, E), FUNC)
+#define Result1(T) CAT3(Result, T, T)
+#define Result2(T, E) CAT3(Result, T, E)
+#define Result3(T, E, FUNC) CAT(CAT3(Result, T, E), FUNC)
 
 typedef struct {
     bool _is_ok;
@@ -276,6 +276,7 @@ Self * fn(fail)(E error) {
 bool fn(delete)(Self * result) {
     ensure(result, false);
     free(result);
+    return true;
 }
 
 // Result >> is_ok(result: *Result<T, E>) -> bool
@@ -454,6 +455,7 @@ void fn(debug)(Self * result) {
     printf("\n}\n");
 }
 
+#undef MODULE
 #undef Self
 #undef fn
 #undef T
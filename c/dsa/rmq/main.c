@@ -0,0 +1,123 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdint.h>
+#include <stdio.h>
+#include <time.h>
+
+#define T int32_t
+#define PRINT_T(value) printf("%d", value)
+#include "../array/array.h"
+
+#define T uint64_t
+#define PRINT_T(value) printf("%llu", (unsigned long long) value)
+#include "../array/array.h"
+
+#define T int32_t
+#define OP min
+#define PRINT_T(value) printf("%d", value)
+#include "rmq.h"
+
+#define T int32_t
+#define OP max
+#define PRINT_T(value) printf("%d", value)
+#define LESS(a, b) ((a) > (b))
+#include "rmq.h"
+
+#define T int32_t
+#define OP min
+#define PRINT_T(value) printf("%d", value)
+#define COMBINE(a, b) ((a) < (b) ? (a) : (b))
+#define IDENTITY INT32_MAX
+#include "../segment_tree/segment_tree.h"
+
+// Usage: ./main [size], defaults to 2^26 elements.
+
+double seconds() {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec + now.tv_nsec * 1e-9;
+}
+
+uint64_t next_random(uint64_t * seed) {
+    *seed = *seed * 6364136223846793005ull + 1442695040888963407ull;
+    return *seed >> 32;
+}
+
+int main(int argc, char ** argv) {
+
+    int32_t series[] = { 4, 7, 1, 9, 3, 3, 8, 2, 6, 5 };
+    Array(int32_t) * small = Array(int32_t, new)(10);
+    for (size_t i = 0; i < 10; i++) small->data[i] = series[i];
+
+    RMQ(int32_t, min) * lowest = RMQ(int32_t, min, new)(small, NULL);
+    RMQ(int32_t, max) * highest = RMQ(int32_t, max, new)(small, NULL);
+    RMQ(int32_t, min, debug)(lowest);
+    printf("min[3, 7) = %d, max[3, 7) = %d, max[0, 10) = %d\n\n",
+        RMQ(int32_t, min, query)(lowest, 3, 7),
+        RMQ(int32_t, max, query)(highest, 3, 7),
+        RMQ(int32_t, max, query)(highest, 0, 10));
+    RMQ(int32_t, min, delete)(lowest);
+    RMQ(int32_t, max, delete)(highest);
+    Array(int32_t, delete)(small);
+
+    size_t size = argc > 1 ? (size_t) atoll(argv[1]) : (size_t) 1 << 26;
+    Array(int32_t) * values = Array(int32_t, new)(size);
+    uint64_t seed = 13;
+    for (size_t i = 0; i < size; i++) values->data[i] = (int32_t) next_random(&seed);
+
+    double start = seconds();
+    RMQ(int32_t, min) * serial = RMQ(int32_t, min, new)(values, NULL);
+    double serial_time = seconds() - start;
+    RMQ(int32_t, min, delete)(serial);
+
+    ThreadPool * pool = ThreadPool_new(0);
+    start = seconds();
+    RMQ(int32_t, min) * index = RMQ(int32_t, min, new)(values, pool);
+    double parallel_time = seconds() - start;
+    if (not index) {
+        printf("not enough memory for %zu elements\n", size);
+        return 1;
+    }
+
+    printf("%zu elements (%zu MB), index of %.2f words per element\n",
+        size, size * sizeof(int32_t) >> 20, RMQ(int32_t, min, memory)(index) / 8.0 / size);
+    printf("build: serial %7.1f ms, %zu workers %7.1f ms\n",
+        serial_time * 1e3, ThreadPool_workers(pool), parallel_time * 1e3);
+
+    SegmentTree(int32_t, min) * tree = SegmentTree(int32_t, min, from_array)(values);
+
+    // Random ranges of every length, and short ones that stay inside a block.
+    size_t queries = 4000000;
+    for (int shape = 0; shape < 2; shape++) {
+        Array(uint64_t) * ranges = Array(uint64_t, new)(2 * queries);
+        for (size_t q = 0; q < queries; q++) {
+            size_t a = next_random(&seed) % size;
+            size_t length = 1 + (shape ? next_random(&seed) % 48 : next_random(&seed) % (size - a));
+            ranges->data[2 * q] = a;
+            ranges->data[2 * q + 1] = a + length < size ? a + length : size;
+        }
+
+        int64_t index_sum = 0, tree_sum = 0;
+        start = seconds();
+        for (size_t q = 0; q < queries; q++)
+            index_sum += RMQ(int32_t, min, query)(index, ranges->data[2 * q], ranges->data[2 * q + 1]);
+        double index_time = (seconds() - start) / queries;
+
+        start = seconds();
+        for (size_t q = 0; q < queries; q++)
+            tree_sum += SegmentTree(int32_t, min, query)(tree, ranges->data[2 * q], ranges->data[2 * q + 1]);
+        double tree_time = (seconds() - start) / queries;
+
+        printf("%s ranges: rmq %6.1f ns, segment tree %6.1f ns, results %s\n",
+            shape ? "short " : "random", index_time * 1e9, tree_time * 1e9,
+            index_sum == tree_sum ? "agree" : "differ");
+        Array(uint64_t, delete)(ranges);
+    }
+
+    SegmentTree(int32_t, min, delete)(tree);
+    RMQ(int32_t, min, delete)(index);
+    Array(int32_t, delete)(values);
+    ThreadPool_delete(pool);
+    return 0;
+
+}
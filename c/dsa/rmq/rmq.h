@@ -0,0 +1,380 @@
+// ==========
+// RMQ<T, OP>
+// ==========
+//
+// :Author: RickBarretto
+// :Year: 2026
+// :License: MPL 2.0
+// :Copyright: RickBarretto, 2026
+// :Version: 1.0
+//
+// ``RMQ<T, OP>`` is a static index over a read-only ``Array<T>``
+// that answers range minimum (or maximum) queries in O(1).
+//
+// Small arrays, up to RMQ_SPARSE_MAX elements, get a sparse table:
+// level ``k`` holds the best of every window of ``2^k`` elements,
+// and a query combines the two windows that cover the range.
+//
+// Larger arrays are cut in blocks of 64 elements:
+//
+// - Each element gets one 64-bit word: the bitmask of the increasing
+//   stack of its block, up to it. Inside a block, the answer for
+//   ``[l, r]`` is the lowest bit of ``masks[r]`` at or after ``l``.
+// - The block minima get a sparse table, n / 64 * log2(n / 64) entries.
+//
+// So the index costs about one word per element, and a query reads
+// at most two masks, two elements and two table entries.
+//
+// The blocks are built in parallel on a ``ThreadPool``, and so is each
+// level of the sparse table, as one flat loop over ``restrict`` pointers
+// that gcc turns into vector min / max instructions at ``-O3``, or at
+// ``-O2 -fvect-cost-model=dynamic``; plain ``-O2`` keeps it scalar.
+//
+// How to Use
+// ----------
+//
+// Include ``Array<T>`` and ``Array<uint64_t>`` first,
+// then this header with the same T. OP names the index in the type,
+// LESS is optional and defaults to ``<``, i.e. a range minimum:
+//
+//      #define T int32_t
+//      #define PRINT_T(value) printf("%d", value)
+//      #include "../array/array.h"
+//
+//      #define T uint64_t
+//      #define PRINT_T(value) printf("%llu", (unsigned long long) value)
+//      #include "../array/array.h"
+//
+//      #define T int32_t
+//      #define OP max
+//      #define PRINT_T(value) printf("%d", value)
+//      #define LESS(a, b) ((a) > (b))
+//      #include "rmq.h"
+//
+// And a common way to use it would be:
+//
+//      RMQ(int32_t, max) * index = RMQ(int32_t, max, new)(values, pool);
+//      int32_t highest = RMQ(int32_t, max, query)(index, 100, 5000);
+//
+// The Array is borrowed: it must outlive the index and stay unchanged.
+// Link with ``-pthread``.
+//
+
+// =~=~=~=~=~=~=~=~ Imports ~=~=~=~=~=~=~=~=
+
+#include <iso646.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "../thread_pool/thread_pool.h"
+
+
+// =~=~=~=~=~=~=~=~ Helper Macros ~=~=~=~=~=~=~=~=
+
+#define _CAT(X, Y) X ## _ ## Y
+#define CAT(X, Y) _CAT(X, Y)
+#define _CAT3(X, Y, Z) X ## _ ## Y ## _ ## Z
+#define CAT3(X, Y, Z) _CAT3(X, Y, Z)
+
+#define STRINGIFY(x) #x
+#define TOSTRING(x) STRINGIFY(x)
+
+#define ensure(COND, VAL) if (not (COND)) return VAL
+
+
+// =~=~=~=~=~=~=~=~ Shared helpers ~=~=~=~=~=~=~=~=
+
+#ifndef RMQ_HELPERS
+#define RMQ_HELPERS
+
+// RMQ_SPARSE_MAX: Largest array indexed by a plain sparse table.
+#ifndef RMQ_SPARSE_MAX
+#define RMQ_SPARSE_MAX ((size_t) 1 << 16)
+#endif
+
+// RMQ_BLOCK: Elements per block, one bit each in the masks.
+#define RMQ_BLOCK 64
+
+// RMQ_TASKS_PER_WORKER: Chunks per worker for the parallel loops.
+#define RMQ_TASKS_PER_WORKER 4
+
+// RMQ_MAX_LEVELS: One level per bit of size_t.
+#define RMQ_MAX_LEVELS 64
+
+// The better of two values, ``a`` on ties.
+#define _RMQ_BEST(a, b) (LESS(b, a) ? (b) : (a))
+
+// floor(log2(value)), value > 0.
+size_t _RMQ_log2(size_t value) {
+    return 63 - (size_t) __builtin_clzll(value);
+}
+
+#endif
+
+
+// =~=~=~=~=~=~=~=~ Implementation ~=~=~=~=~=~=~=~=
+
+// T: Element type of the RMQ<T, OP>, an ordered numeric type.
+#ifndef T
+#error "T is not defined"
+#endif
+
+// OP: Name of the index, part of the type name, i.e. ``min`` or ``max``.
+#ifndef OP
+#error "OP is not defined"
+#endif
+
+// PRINT_T: (T) -> void
+//
+// PRINT_T is a macro that defines how to print an element of type T.
+// See ``Array<T>`` for more details.
+//
+#ifndef PRINT_T
+#error "PRINT_T is not defined"
+#endif
+
+// LESS: (T, T) -> bool
+//
+// LESS is a macro that tells whether ``a`` is strictly better than ``b``.
+// It defaults to ``<``, so the index answers range minimums;
+// use ``>`` for range maximums.
+//
+#ifndef LESS
+#define LESS(a, b) ((a) < (b))
+#endif
+
+#define MODULE RMQ
+#define Self CAT3(MODULE, T, OP)
+#define fn(NAME) CAT(Self, NAME)
+
+#define _RMQ_SELECT_MACRO(_1, _2, _3, NAME, ...) NAME
+#define RMQ(...) _RMQ_SELECT_MACRO(__VA_ARGS__, RMQ3, RMQ2)(__VA_ARGS__)
+#define RMQ2(T, OP) CAT3(RMQ, T, OP)
+#define RMQ3(T, OP, FUNC) CAT(CAT3(RMQ, T, OP), FUNC)
+
+typedef struct {
+    Array(T) * array;           // borrowed, read-only
+    Array(T) * table;           // the sparse table, without level 0 if over elements
+    Array(uint64_t) * masks;    // one stack per element, NULL for a plain sparse table
+    const T * levels[RMQ_MAX_LEVELS];
+    size_t _size;
+    size_t _width;              // entries per level: elements or blocks
+    size_t _levels;
+} Self;
+
+typedef struct {
+    Self * rmq;
+    size_t level;
+    size_t tasks;
+} fn(_Job);
+
+
+// RMQ >> delete(rmq: *RMQ<T, OP>) -> bool
+//
+// Safely deletes the index. The Array is left untouched.
+//
+// Returns
+// -------
+// bool: Returns true on success.
+//
+bool fn(delete)(Self * rmq) {
+    ensure(rmq, false);
+
+    Array(T, delete)(rmq->table);
+    if (rmq->masks) Array(uint64_t, delete)(rmq->masks);
+    ARRAY_FREE(rmq);
+    return true;
+}
+
+// Builds the stacks of a slice of blocks, and their minima as level 0.
+void fn(_blocks)(void * context, size_t task, size_t worker) {
+    (void) worker;
+    fn(_Job) * job = context;
+    Self * rmq = job->rmq;
+
+    const T * data = rmq->array->data;
+    uint64_t * masks = rmq->masks->data;
+    T * minima = rmq->table->data;
+
+    size_t first = task * rmq->_width / job->tasks;
+    size_t last = (task + 1) * rmq->_width / job->tasks;
+    for (size_t block = first; block < last; block++) {
+        size_t base = block * RMQ_BLOCK;
+        size_t length = rmq->_size - base < RMQ_BLOCK ? rmq->_size - base : RMQ_BLOCK;
+
+        // Pop what the new element beats, so equal elements keep the first one.
+        uint64_t stack = 0;
+        for (size_t j = 0; j < length; j++) {
+            T value = data[base + j];
+            while (stack and LESS(value, data[base + _RMQ_log2(stack)]))
+                stack ^= (uint64_t) 1 << _RMQ_log2(stack);
+            stack |= (uint64_t) 1 << j;
+            masks[base + j] = stack;
+        }
+        minima[block] = data[base + (size_t) __builtin_ctzll(stack)];
+    }
+}
+
+// Fills a slice of one level from the level below.
+void fn(_level)(void * context, size_t task, size_t worker) {
+    (void) worker;
+    fn(_Job) * job = context;
+    Self * rmq = job->rmq;
+
+    size_t half = (size_t) 1 << (job->level - 1);
+    size_t valid = rmq->_width - 2 * half + 1;
+    const T * restrict left = rmq->levels[job->level - 1];
+    const T * restrict right = left + half;
+    T * restrict out = (T *) rmq->levels[job->level];
+
+    size_t first = task * valid / job->tasks;
+    size_t last = (task + 1) * valid / job->tasks;
+    for (size_t i = first; i < last; i++)
+        out[i] = _RMQ_BEST(left[i], right[i]);
+}
+
+// RMQ >> new(array: *Array<T>, pool: *ThreadPool) -> *RMQ<T, OP>
+//
+// Builds the index over ``array``, choosing the layout by its size.
+//
+// Parameters
+// ----------
+// array : *Array<T>
+//     The values, borrowed: they must outlive the index and not change.
+// pool : *ThreadPool
+//     Where to build the blocks and levels, NULL for the calling thread.
+//
+// Returns
+// -------
+// *RMQ<T, OP>: A pointer to the new index, or NULL on failure.
+//
+Self * fn(new)(Array(T) * array, ThreadPool * pool) {
+    ensure(array, NULL);
+
+    Self * rmq = ARRAY_MALLOC(sizeof(Self));
+    ensure(rmq, NULL);
+
+    size_t size = Array(T, size)(array);
+    bool sparse = size <= RMQ_SPARSE_MAX;
+    rmq->array = array;
+    rmq->_size = size;
+    rmq->_width = sparse ? size : (size + RMQ_BLOCK - 1) / RMQ_BLOCK;
+    rmq->_levels = rmq->_width ? _RMQ_log2(rmq->_width) + 1 : 0;
+
+    // A plain sparse table reads level 0 straight from the Array.
+    size_t stored = sparse ? rmq->_levels - (rmq->_levels > 0) : rmq->_levels;
+    rmq->table = Array(T, new)(stored * rmq->_width);
+    rmq->masks = sparse ? NULL : Array(uint64_t, new)(size);
+    if (not rmq->table or (not sparse and not rmq->masks)) {
+        if (rmq->table) Array(T, delete)(rmq->table);
+        if (rmq->masks) Array(uint64_t, delete)(rmq->masks);
+        ARRAY_FREE(rmq);
+        return NULL;
+    }
+
+    T * table = rmq->table->data;
+    for (size_t k = 0; k < rmq->_levels; k++) {
+        if (sparse) rmq->levels[k] = k ? table + (k - 1) * rmq->_width : array->data;
+        else rmq->levels[k] = table + k * rmq->_width;
+    }
+
+    fn(_Job) job = { .rmq = rmq, .tasks = ThreadPool_workers(pool) * RMQ_TASKS_PER_WORKER };
+    if (not sparse) ThreadPool_run(pool, job.tasks, fn(_blocks), &job);
+    for (job.level = 1; job.level < rmq->_levels; job.level++)
+        ThreadPool_run(pool, job.tasks, fn(_level), &job);
+    return rmq;
+}
+
+// RMQ >> size(rmq: *RMQ<T, OP>) -> size_t
+//
+// Returns the number of indexed elements.
+//
+size_t fn(size)(Self * rmq) {
+    ensure(rmq, 0);
+    return rmq->_size;
+}
+
+// RMQ >> memory(rmq: *RMQ<T, OP>) -> size_t
+//
+// Returns the bytes used by the index, not counting the Array.
+//
+size_t fn(memory)(Self * rmq) {
+    ensure(rmq, 0);
+
+    size_t bytes = sizeof(Self) + Array(T, size)(rmq->table) * sizeof(T);
+    if (rmq->masks) bytes += Array(uint64_t, size)(rmq->masks) * sizeof(uint64_t);
+    return bytes;
+}
+
+// Best of ``[first, last]`` from the sparse table, two overlapping windows.
+T fn(_table)(Self * rmq, size_t first, size_t last) {
+    size_t k = _RMQ_log2(last - first + 1);
+    T a = rmq->levels[k][first];
+    T b = rmq->levels[k][last + 1 - ((size_t) 1 << k)];
+    return _RMQ_BEST(a, b);
+}
+
+// Best of ``[first, last]`` inside one block.
+T fn(_in_block)(Self * rmq, size_t first, size_t last) {
+    size_t base = first & ~(size_t) (RMQ_BLOCK - 1);
+    uint64_t stack = rmq->masks->data[last] & (~(uint64_t) 0 << (first - base));
+    return rmq->array->data[base + (size_t) __builtin_ctzll(stack)];
+}
+
+// RMQ >> query(rmq: *RMQ<T, OP>, start: size_t, end: size_t) -> T
+//
+// Returns the best element in ``[start, end)``, in O(1).
+//
+// Returns
+// -------
+// T: The minimum (or maximum), or 0 for an empty or out-of-bounds range.
+//
+T fn(query)(Self * rmq, size_t start, size_t end) {
+    ensure(rmq and start < end and end <= rmq->_size, (T) 0);
+
+    size_t last = end - 1;
+    if (not rmq->masks) return fn(_table)(rmq, start, last);
+
+    size_t first_block = start / RMQ_BLOCK, last_block = last / RMQ_BLOCK;
+    if (first_block == last_block) return fn(_in_block)(rmq, start, last);
+
+    // The tail of the first block, the head of the last one,
+    // and the whole blocks in between.
+    T best = fn(_in_block)(rmq, start, first_block * RMQ_BLOCK + RMQ_BLOCK - 1);
+    T head = fn(_in_block)(rmq, last_block * RMQ_BLOCK, last);
+    best = _RMQ_BEST(best, head);
+    if (first_block + 1 < last_block) {
+        T middle = fn(_table)(rmq, first_block + 1, last_block - 1);
+        best = _RMQ_BEST(best, middle);
+    }
+    return best;
+}
+
+// RMQ >> debug(rmq: *RMQ<T, OP>) -> void
+//
+// Prints the debug representation of the index.
+//
+void fn(debug)(Self * rmq) {
+    if (not rmq) {
+        printf("RMQ<%s, %s> { NULL }\n", TOSTRING(T), TOSTRING(OP));
+        return;
+    }
+
+    printf("RMQ<%s, %s> {\n", TOSTRING(T), TOSTRING(OP));
+    printf("  size: %zu,\n", rmq->_size);
+    printf("  layout: %s,\n", rmq->masks ? "blocks" : "sparse table");
+    printf("  levels: %zu x %zu,\n", rmq->_levels, rmq->_width);
+    printf("  memory: %zu bytes,\n", fn(memory)(rmq));
+    printf("  values: "); Array(T, println)(rmq->array);
+    printf("}\n");
+}
+
+#undef MODULE
+#undef Self
+#undef fn
+#undef T
+#undef OP
+#undef PRINT_T
+#undef LESS
@@ -0,0 +1,165 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdint.h>
+#include <stdio.h>
+#include <time.h>
+
+#define T int64_t
+#define PRINT_T(value) printf("%lld", (long long) value)
+#include "../array/array.h"
+
+#define T int64_t
+#define OP min
+#define PRINT_T(value) printf("%lld", (long long) value)
+#define COMBINE(a, b) ((a) < (b) ? (a) : (b))
+#define IDENTITY INT64_MAX
+#include "segment_tree.h"
+
+#define T int64_t
+#define OP sum
+#define PRINT_T(value) printf("%lld", (long long) value)
+#define COMBINE(a, b) ((a) + (b))
+#define IDENTITY 0
+#include "segment_tree.h"
+
+// Usage: ./main [size], defaults to 2^22 elements.
+
+double seconds() {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec + now.tv_nsec * 1e-9;
+}
+
+uint64_t next_random(uint64_t * seed) {
+    *seed = *seed * 6364136223846793005ull + 1442695040888963407ull;
+    return *seed >> 32;
+}
+
+// The textbook layout, for comparison: recursive, top-down,
+// root at 1 and children at 2i, 2i + 1 over a 4n array.
+
+int64_t min(int64_t a, int64_t b) {
+    return a < b ? a : b;
+}
+
+void recursive_build(int64_t * nodes, const int64_t * values, size_t node, size_t low, size_t high) {
+    if (high - low == 1) {
+        nodes[node] = values[low];
+        return;
+    }
+    size_t middle = (low + high) / 2;
+    recursive_build(nodes, values, 2 * node, low, middle);
+    recursive_build(nodes, values, 2 * node + 1, middle, high);
+    nodes[node] = min(nodes[2 * node], nodes[2 * node + 1]);
+}
+
+void recursive_set(int64_t * nodes, size_t node, size_t low, size_t high, size_t index, int64_t value) {
+    if (high - low == 1) {
+        nodes[node] = value;
+        return;
+    }
+    size_t middle = (low + high) / 2;
+    if (index < middle) recursive_set(nodes, 2 * node, low, middle, index, value);
+    else recursive_set(nodes, 2 * node + 1, middle, high, index, value);
+    nodes[node] = min(nodes[2 * node], nodes[2 * node + 1]);
+}
+
+int64_t recursive_query(int64_t * nodes, size_t node, size_t low, size_t high, size_t start, size_t end) {
+    if (end <= low or high <= start) return INT64_MAX;
+    if (start <= low and high <= end) return nodes[node];
+    size_t middle = (low + high) / 2;
+    return min(recursive_query(nodes, 2 * node, low, middle, start, end),
+               recursive_query(nodes, 2 * node + 1, middle, high, start, end));
+}
+
+int main(int argc, char ** argv) {
+
+    Array(int64_t) * small = Array(int64_t, new)(7);
+    int64_t numbers[] = { 5, 3, 8, 6, 1, 9, 2 };
+    for (size_t i = 0; i < 7; i++) small->data[i] = numbers[i];
+
+    SegmentTree(int64_t, min) * lowest = SegmentTree(int64_t, min, from_array)(small);
+    SegmentTree(int64_t, sum) * total = SegmentTree(int64_t, sum, from_array)(small);
+    SegmentTree(int64_t, min, set)(lowest, 4, 7);
+    SegmentTree(int64_t, min, debug)(lowest);
+    printf("min[1, 6) = %lld, sum[1, 6) = %lld\n\n",
+        (long long) SegmentTree(int64_t, min, query)(lowest, 1, 6),
+        (long long) SegmentTree(int64_t, sum, query)(total, 1, 6));
+    SegmentTree(int64_t, min, delete)(lowest);
+    SegmentTree(int64_t, sum, delete)(total);
+    Array(int64_t, delete)(small);
+
+    size_t size = argc > 1 ? (size_t) atoll(argv[1]) : (size_t) 1 << 22;
+    Array(int64_t) * values = Array(int64_t, new)(size);
+    uint64_t seed = 9;
+    for (size_t i = 0; i < size; i++) values->data[i] = (int64_t) next_random(&seed);
+
+    double start = seconds();
+    SegmentTree(int64_t, min) * tree = SegmentTree(int64_t, min, from_array)(values);
+    double build = seconds() - start;
+
+    int64_t * nodes = malloc(4 * size * sizeof(int64_t));
+    start = seconds();
+    recursive_build(nodes, values->data, 1, 0, size);
+    double recursive_build_time = seconds() - start;
+
+    printf("%zu elements, %zu MB bottom-up, %zu MB recursive\n",
+        size, 2 * size * sizeof(int64_t) >> 20, 4 * size * sizeof(int64_t) >> 20);
+    printf("build:  bottom-up %8.1f ms, recursive %8.1f ms\n", build * 1e3, recursive_build_time * 1e3);
+
+    // One point update, then one range minimum, with the same random stream.
+    size_t rounds = 2000000;
+    int64_t bottom_up_sum = 0, recursive_sum = 0;
+    uint64_t stream = 11;
+    start = seconds();
+    for (size_t r = 0; r < rounds; r++) {
+        size_t index = next_random(&stream) % size;
+        size_t a = next_random(&stream) % size, b = next_random(&stream) % size;
+        SegmentTree(int64_t, min, set)(tree, index, (int64_t) next_random(&stream));
+        bottom_up_sum += SegmentTree(int64_t, min, query)(tree, a < b ? a : b, (a < b ? b : a) + 1);
+    }
+    double bottom_up_time = (seconds() - start) / rounds;
+
+    stream = 11;
+    start = seconds();
+    for (size_t r = 0; r < rounds; r++) {
+        size_t index = next_random(&stream) % size;
+        size_t a = next_random(&stream) % size, b = next_random(&stream) % size;
+        recursive_set(nodes, 1, 0, size, index, (int64_t) next_random(&stream));
+        recursive_sum += recursive_query(nodes, 1, 0, size, a < b ? a : b, (a < b ? b : a) + 1);
+    }
+    double recursive_time = (seconds() - start) / rounds;
+
+    printf("update + range min: bottom-up %8.1f ns, recursive %8.1f ns, results %s\n",
+        bottom_up_time * 1e9, recursive_time * 1e9,
+        bottom_up_sum == recursive_sum ? "agree" : "differ");
+
+    // Batches: shared ancestors are refreshed once per level.
+    for (size_t count = 1024; count <= size; count *= 16) {
+        size_t * indices = malloc(count * sizeof(size_t));
+        int64_t * updates = malloc(count * sizeof(int64_t));
+        for (size_t k = 0; k < count; k++) {
+            indices[k] = next_random(&seed) % size;
+            updates[k] = (int64_t) next_random(&seed);
+        }
+
+        start = seconds();
+        for (size_t k = 0; k < count; k++) SegmentTree(int64_t, min, set)(tree, indices[k], updates[k]);
+        double single = seconds() - start;
+
+        start = seconds();
+        SegmentTree(int64_t, min, set_all)(tree, indices, updates, count);
+        double batch = seconds() - start;
+
+        printf("%8zu updates: one by one %8.2f ms, set_all %8.2f ms\n",
+            count, single * 1e3, batch * 1e3);
+        free(indices);
+        free(updates);
+    }
+
+    free(nodes);
+    SegmentTree(int64_t, min, delete)(tree);
+    Array(int64_t, delete)(values);
+    return 0;
+
+}
@@ -0,0 +1,410 @@
+// ==================
+// SegmentTree<T, OP>
+// ==================
+//
+// :Author: RickBarretto
+// :Year: 2026
+// :License: MPL 2.0
+// :Copyright: RickBarretto, 2026
+// :Version: 1.0
+//
+// ``SegmentTree<T, OP>`` answers range queries, such as the minimum
+// or the sum of ``[start, end)``, under point updates, both in O(log n).
+// OP is any associative operation with an identity element,
+// it does not need to be commutative.
+//
+// The tree is iterative and bottom-up: 2n elements in one ``Array<T>``,
+// the leaves at ``[n, 2n)`` and the parent of node ``i`` at ``i / 2``.
+// This is the Eytzinger (breadth-first) layout, with no gaps and no
+// recursion: the top levels share a few cache lines that stay hot,
+// and the leaves are a contiguous copy of the input.
+//
+// - ``from_array`` builds it in O(n), one linear sweep from the leaves up.
+// - ``query`` walks up from both ends of the range at once.
+// - ``set_all`` applies a batch of updates and refreshes each touched
+//   ancestor once, or rebuilds the tree when that is cheaper.
+//
+// How to Use
+// ----------
+//
+// Include ``Array<T>`` first, then this header with the same T.
+// OP names the operation in the type, COMBINE defines it
+// and IDENTITY is its neutral element:
+//
+//      #define T int64_t
+//      #define PRINT_T(value) printf("%lld", (long long) value)
+//      #include "../array/array.h"
+//
+//      #define T int64_t
+//      #define OP min
+//      #define PRINT_T(value) printf("%lld", (long long) value)
+//      #define COMBINE(a, b) ((a) < (b) ? (a) : (b))
+//      #define IDENTITY INT64_MAX
+//      #include "segment_tree.h"
+//
+// Each function is namespaced under SegmentTree<T, OP>,
+// i.e. ``SegmentTree(int64_t, min, query)`` is the same as
+// ``SegmentTree_int64_t_min_query``.
+//
+//      SegmentTree(int64_t, min) * tree = SegmentTree(int64_t, min, from_array)(values);
+//      SegmentTree(int64_t, min, set)(tree, 3, -2);
+//      int64_t lowest = SegmentTree(int64_t, min, query)(tree, 2, 10);
+//
+
+// =~=~=~=~=~=~=~=~ Imports ~=~=~=~=~=~=~=~=
+
+#include <iso646.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+
+// =~=~=~=~=~=~=~=~ Helper Macros ~=~=~=~=~=~=~=~=
+
+#define _CAT(X, Y) X ## _ ## Y
+#define CAT(X, Y) _CAT(X, Y)
+#define _CAT3(X, Y, Z) X ## _ ## Y ## _ ## Z
+#define CAT3(X, Y, Z) _CAT3(X, Y, Z)
+
+#define STRINGIFY(x) #x
+#define TOSTRING(x) STRINGIFY(x)
+
+#define ensure(COND, VAL) if (not (COND)) return VAL
+
+
+// =~=~=~=~=~=~=~=~ Shared helpers ~=~=~=~=~=~=~=~=
+
+#ifndef SEGMENT_TREE_HELPERS
+#define SEGMENT_TREE_HELPERS
+
+// Number of bits of ``value``, i.e. floor(log2(value)) + 1.
+size_t _SegmentTree_bits(size_t value) {
+    size_t bits = 0;
+    for (; value; value >>= 1) bits++;
+    return bits;
+}
+
+int _SegmentTree_compare(const void * a, const void * b) {
+    size_t x = *(const size_t *) a, y = *(const size_t *) b;
+    return (x > y) - (x < y);
+}
+
+#endif
+
+
+// =~=~=~=~=~=~=~=~ Implementation ~=~=~=~=~=~=~=~=
+
+// T: Element type of the SegmentTree<T, OP>.
+#ifndef T
+#error "T is not defined"
+#endif
+
+// OP: Name of the operation, part of the type name, i.e. ``min`` or ``sum``.
+#ifndef OP
+#error "OP is not defined"
+#endif
+
+// PRINT_T: (T) -> void
+//
+// PRINT_T is a macro that defines how to print an element of type T.
+// See ``Array<T>`` for more details.
+//
+#ifndef PRINT_T
+#error "PRINT_T is not defined"
+#endif
+
+// COMBINE: (T, T) -> T
+//
+// COMBINE is a macro that merges the results of two adjacent ranges,
+// the left one first. It must be associative.
+// Its arguments may be evaluated more than once.
+//
+#ifndef COMBINE
+#error "COMBINE is not defined"
+#endif
+
+// IDENTITY: T
+//
+// IDENTITY is the result of an empty range,
+// so that ``COMBINE(IDENTITY, x) == COMBINE(x, IDENTITY) == x``.
+//
+#ifndef IDENTITY
+#error "IDENTITY is not defined"
+#endif
+
+#define MODULE SegmentTree
+#define Self CAT3(MODULE, T, OP)
+#define fn(NAME) CAT(Self, NAME)
+
+#define _SEGMENT_TREE_SELECT_MACRO(_1, _2, _3, NAME, ...) NAME
+#define SegmentTree(...) _SEGMENT_TREE_SELECT_MACRO(__VA_ARGS__, SegmentTree3, SegmentTree2)(__VA_ARGS__)
+#define SegmentTree2(T, OP) CAT3(SegmentTree, T, OP)
+#define SegmentTree3(T, OP, FUNC) CAT(CAT3(SegmentTree, T, OP), FUNC)
+
+typedef struct {
+    Array(T) * storage;         // node 0 is unused, leaves at [size, 2 * size)
+    size_t _size;
+} Self;
+
+
+// SegmentTree >> delete(tree: *SegmentTree<T, OP>) -> bool
+//
+// Safely deletes the tree and its storage.
+//
+// Returns
+// -------
+// bool: Returns true on success.
+//
+bool fn(delete)(Self * tree) {
+    ensure(tree, false);
+
+    Array(T, delete)(tree->storage);
+    ARRAY_FREE(tree);
+    return true;
+}
+
+// Recomputes every inner node, from the last one up to the root.
+void fn(_build)(Self * tree) {
+    T * data = tree->storage->data;
+    for (size_t i = tree->_size; i-- > 1;)
+        data[i] = COMBINE(data[2 * i], data[2 * i + 1]);
+}
+
+// SegmentTree >> new(size: size_t) -> *SegmentTree<T, OP>
+//
+// Creates a tree over ``size`` copies of IDENTITY.
+//
+// Returns
+// -------
+// *SegmentTree<T, OP>: A pointer to the new tree, or NULL on failure.
+//
+Self * fn(new)(size_t size) {
+    Self * tree = ARRAY_MALLOC(sizeof(Self));
+    ensure(tree, NULL);
+
+    tree->storage = Array(T, new)(2 * size);
+    if (not tree->storage) {
+        ARRAY_FREE(tree);
+        return NULL;
+    }
+
+    tree->_size = size;
+    for (size_t i = 0; i < 2 * size; i++) tree->storage->data[i] = IDENTITY;
+    return tree;
+}
+
+// SegmentTree >> from_array(array: *Array<T>) -> *SegmentTree<T, OP>
+//
+// Builds a tree over a copy of the array, in O(n).
+//
+// Returns
+// -------
+// *SegmentTree<T, OP>: A pointer to the new tree, or NULL on failure.
+//
+Self * fn(from_array)(Array(T) * array) {
+    ensure(array, NULL);
+
+    size_t size = Array(T, size)(array);
+    Self * tree = ARRAY_MALLOC(sizeof(Self));
+    ensure(tree, NULL);
+
+    tree->storage = Array(T, new)(2 * size);
+    if (not tree->storage) {
+        ARRAY_FREE(tree);
+        return NULL;
+    }
+
+    tree->_size = size;
+    T * leaves = tree->storage->data + size;
+    for (size_t i = 0; i < size; i++) leaves[i] = array->data[i];
+    fn(_build)(tree);
+    return tree;
+}
+
+// SegmentTree >> size(tree: *SegmentTree<T, OP>) -> size_t
+//
+// Returns the number of elements.
+//
+size_t fn(size)(Self * tree) {
+    ensure(tree, 0);
+    return tree->_size;
+}
+
+// SegmentTree >> get(tree: *SegmentTree<T, OP>, index: size_t) -> T
+//
+// Returns the element at ``index``, or IDENTITY if out of bounds.
+//
+T fn(get)(Self * tree, size_t index) {
+    ensure(tree and index < tree->_size, IDENTITY);
+    return tree->storage->data[tree->_size + index];
+}
+
+
+// ~~~~~~~~ Updates ~~~~~~~~
+
+// SegmentTree >> set(tree: *SegmentTree<T, OP>, index: size_t, value: T) -> bool
+//
+// Sets the element at ``index`` and refreshes its ancestors, in O(log n).
+//
+// Returns
+// -------
+// bool: Returns true on success, false if out of bounds.
+//
+bool fn(set)(Self * tree, size_t index, T value) {
+    ensure(tree and index < tree->_size, false);
+
+    T * data = tree->storage->data;
+    size_t i = tree->_size + index;
+    data[i] = value;
+    for (i /= 2; i >= 1; i /= 2)
+        data[i] = COMBINE(data[2 * i], data[2 * i + 1]);
+    return true;
+}
+
+// SegmentTree >> set_all(tree: *SegmentTree<T, OP>, indices: *size_t, values: *T, count: size_t) -> bool
+//
+// Sets ``values[k]`` at ``indices[k]``, for every k, later entries winning.
+//
+// The touched leaves are sorted and lifted one level at a time,
+// so an ancestor shared by many updates is refreshed once per level
+// instead of once per update. Once the batch costs more than a rebuild,
+// i.e. ``count * log2(n) > n``, the whole tree is rebuilt in O(n).
+//
+// Parameters
+// ----------
+// tree : *SegmentTree<T, OP>
+//     The tree to update.
+// indices : *size_t
+//     The positions to update, in any order, repeats allowed.
+// values : *T
+//     The new value of each position.
+// count : size_t
+//     The number of updates.
+//
+// Returns
+// -------
+// bool: Returns true on success, false if any index is out of bounds,
+//       in which case nothing is changed.
+//
+bool fn(set_all)(Self * tree, const size_t * indices, const T * values, size_t count) {
+    ensure(tree, false);
+    ensure(count == 0 or (indices and values), false);
+    for (size_t k = 0; k < count; k++) ensure(indices[k] < tree->_size, false);
+
+    T * data = tree->storage->data;
+    for (size_t k = 0; k < count; k++) data[tree->_size + indices[k]] = values[k];
+
+    size_t * nodes = NULL;
+    if (count * _SegmentTree_bits(tree->_size) <= tree->_size)
+        nodes = ARRAY_MALLOC(count * sizeof(size_t) + 1);
+    if (not nodes) {
+        fn(_build)(tree);
+        return true;
+    }
+
+    for (size_t k = 0; k < count; k++) nodes[k] = tree->_size + indices[k];
+    qsort(nodes, count, sizeof(size_t), _SegmentTree_compare);
+
+    // Halving keeps the list sorted, so repeats are adjacent.
+    // With n not a power of two the leaves sit on two levels, so a node
+    // may be refreshed early, but it is refreshed again one level later,
+    // after its deeper child.
+    while (count) {
+        size_t parents = 0;
+        for (size_t k = 0; k < count; k++) {
+            size_t parent = nodes[k] / 2;
+            if (parent == 0 or (parents and nodes[parents - 1] == parent)) continue;
+            data[parent] = COMBINE(data[2 * parent], data[2 * parent + 1]);
+            nodes[parents++] = parent;
+        }
+        count = parents;
+    }
+
+    ARRAY_FREE(nodes);
+    return true;
+}
+
+
+// ~~~~~~~~ Queries ~~~~~~~~
+
+// SegmentTree >> query(tree: *SegmentTree<T, OP>, start: size_t, end: size_t) -> T
+//
+// Combines the elements in ``[start, end)``, in O(log n).
+// Both ends climb one level per step; the left end collects nodes
+// in order on the left, the right end on the right.
+//
+// Returns
+// -------
+// T: The combined value, or IDENTITY for an empty or out-of-bounds range.
+//
+T fn(query)(Self * tree, size_t start, size_t end) {
+    ensure(tree and start < end and end <= tree->_size, IDENTITY);
+
+    T * data = tree->storage->data;
+    T left = IDENTITY, right = IDENTITY;
+    for (start += tree->_size, end += tree->_size; start < end; start /= 2, end /= 2) {
+        if (start & 1) {
+            left = COMBINE(left, data[start]);
+            start++;
+        }
+        if (end & 1) {
+            end--;
+            right = COMBINE(data[end], right);
+        }
+    }
+    return COMBINE(left, right);
+}
+
+
+// ~~~~~~~~ Printing ~~~~~~~~
+
+// SegmentTree >> print(tree: *SegmentTree<T, OP>) -> void
+//
+// Prints the elements on terminal.
+//
+void fn(print)(Self * tree) {
+    ensure(tree,);
+
+    T * leaves = tree->storage->data + tree->_size;
+    printf("[");
+    for (size_t i = 0; i < tree->_size; i++) {
+        PRINT_T(leaves[i]);
+        if (i + 1 < tree->_size) printf(", ");
+    }
+    printf("]");
+}
+
+// SegmentTree >> println(tree: *SegmentTree<T, OP>) -> void
+//
+// Prints the elements on terminal followed by a newline.
+//
+void fn(println)(Self * tree) {
+    fn(print)(tree);
+    printf("\n");
+}
+
+// SegmentTree >> debug(tree: *SegmentTree<T, OP>) -> void
+//
+// Prints the debug representation of the tree.
+//
+void fn(debug)(Self * tree) {
+    if (not tree) {
+        printf("SegmentTree<%s, %s> { NULL }\n", TOSTRING(T), TOSTRING(OP));
+        return;
+    }
+
+    printf("SegmentTree<%s, %s> {\n", TOSTRING(T), TOSTRING(OP));
+    printf("  size: %zu,\n", tree->_size);
+    printf("  values: "); fn(println)(tree);
+    printf("  nodes: "); Array(T, println)(tree->storage);
+    printf("}\n");
+}
+
+#undef MODULE
+#undef Self
+#undef fn
+#undef T
+#undef OP
+#undef PRINT_T
+#undef COMBINE
+#undef IDENTITY
@@ -0,0 +1,112 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#define T int64_t
+#define PRINT_T(value) printf("%lld", (long long) value)
+#include "../array/array.h"
+
+#include "../thread_pool/thread_pool.h"
+
+#define T int64_t
+#define PRINT_T(value) printf("%lld", (long long) value)
+#include "shared_array.h"
+
+// Usage: ./main [size] [consumers] [threads], defaults to 2^22 elements
+// handed to 64 consumers on 8 threads. One consumer in four writes.
+
+typedef SharedArray(int64_t) Shared;
+
+double seconds() {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec + now.tv_nsec * 1e-9;
+}
+
+typedef struct {
+    Array(int64_t) * source;
+    Shared * shared;
+    _Atomic int64_t total;
+} Job;
+
+// Each consumer sums a window of its array; one in four edits it first.
+int64_t consume(int64_t * data, size_t size, size_t task) {
+    int64_t sum = 0;
+    size_t start = task * 4096 % size;
+    for (size_t i = start; i < size and i < start + 4096; i++) sum += data[i];
+    return sum;
+}
+
+void run_copies(void * context, size_t task, size_t worker) {
+    Job * job = context;
+    (void) worker;
+    Array(int64_t) * copy = Array(int64_t, new)(job->source->_size);
+    memcpy(copy->data, job->source->data, copy->_size * sizeof(int64_t));
+    if (task % 4 == 0) copy->data[task % copy->_size] = -1;
+
+    atomic_fetch_add(&job->total, consume(copy->data, copy->_size, task));
+    Array(int64_t, delete)(copy);
+}
+
+void run_shared(void * context, size_t task, size_t worker) {
+    Job * job = context;
+    (void) worker;
+    Shared * mine = SharedArray(int64_t, clone)(job->shared);
+    if (task % 4 == 0) SharedArray(int64_t, set)(mine, task % SharedArray(int64_t, size)(mine), -1);
+
+    Array(int64_t) * view = SharedArray(int64_t, array)(mine);
+    atomic_fetch_add(&job->total, consume(view->data, view->_size, task));
+    SharedArray(int64_t, delete)(mine);
+}
+
+int main(int argc, char ** argv) {
+
+    Shared * small = SharedArray(int64_t, new)(4);
+    SharedArray(int64_t, set)(small, 0, 7);
+    Shared * other = SharedArray(int64_t, clone)(small);
+    SharedArray(int64_t, debug)(other);
+    SharedArray(int64_t, set)(other, 1, 8);
+    SharedArray(int64_t, println)(small);
+    SharedArray(int64_t, println)(other);
+    SharedArray(int64_t, delete)(small);
+    SharedArray(int64_t, delete)(other);
+    printf("\n");
+
+    size_t size = argc > 1 ? (size_t) atoll(argv[1]) : (size_t) 1 << 22;
+    size_t consumers = argc > 2 ? (size_t) atoll(argv[2]) : 64;
+    size_t threads = argc > 3 ? (size_t) atoll(argv[3]) : 8;
+    printf("%zu elements, %zu consumers, %zu threads, %zu cores\n", size, consumers, threads, ThreadPool_cores());
+
+    Array(int64_t) * source = Array(int64_t, new)(size);
+    for (size_t i = 0; i < size; i++) source->data[i] = (int64_t) i;
+
+    ThreadPool * pool = ThreadPool_new(threads);
+    Job copies = { .source = source };
+    atomic_init(&copies.total, 0);
+    double start = seconds();
+    ThreadPool_run(pool, consumers, run_copies, &copies);
+    double copy_time = seconds() - start;
+
+    Job shared = { .shared = SharedArray(int64_t, from_array)(source) };
+    atomic_init(&shared.total, 0);
+    SharedArray(int64_t, Stats) before = SharedArray(int64_t, stats)();
+    start = seconds();
+    ThreadPool_run(pool, consumers, run_shared, &shared);
+    double shared_time = seconds() - start;
+    SharedArray(int64_t, Stats) after = SharedArray(int64_t, stats)();
+
+    size_t copied = after.copies - before.copies;
+    printf("defensive copies: %8.2f ms, %zu arrays copied\n", copy_time * 1e3, consumers);
+    printf("shared clones:    %8.2f ms, %zu arrays copied, %zu copies avoided, results %s\n",
+        shared_time * 1e3, copied, (after.clones - before.clones) - copied,
+        atomic_load(&copies.total) == atomic_load(&shared.total) ? "agree" : "differ");
+    printf("references left:  %zu\n", SharedArray(int64_t, references)(shared.shared));
+
+    SharedArray(int64_t, delete)(shared.shared);
+    ThreadPool_delete(pool);
+    return 0;
+
+}
@@ -0,0 +1,406 @@
+// ==============
+// SharedArray<T>
+// ==============
+//
+// :Author: RickBarretto
+// :Year: 2026
+// :License: MPL 2.0
+// :Copyright: RickBarretto, 2026
+// :Version: 1.0
+//
+// ``SharedArray<T>`` is a handle to a reference-counted ``Array<T>``,
+// for passing one large array to many consumers without each of them
+// copying it defensively.
+//
+// ``clone`` is O(1): it makes a new handle to the same buffer and bumps
+// an atomic count. The first ``set`` or ``replace`` through a handle
+// whose buffer is shared copies it, so that handle gets a buffer of
+// its own and no other handle sees the change (copy-on-write). Writes
+// through an unshared handle go straight to the buffer, as in an Array.
+//
+// ``make_unique`` is the escape hatch: it returns the handle's own
+// ``Array<T>``, copying it first if shared, for bulk writes or for
+// code that expects a plain Array. ``stats`` counts clones and copies
+// per element type, and so how many copies were avoided.
+//
+// Handles may be cloned, read and deleted from many threads; a single
+// handle is used by one thread at a time, like an Array.
+//
+// How to Use
+// ----------
+//
+// Include ``Array<T>`` first, then this header with the same T:
+//
+//      #define T int64_t
+//      #define PRINT_T(value) printf("%lld", (long long) value)
+//      #include "../array/array.h"
+//
+//      #define T int64_t
+//      #define PRINT_T(value) printf("%lld", (long long) value)
+//      #include "shared_array.h"
+//
+// And a common way to use it would be:
+//
+//      SharedArray(int64_t) * prices = SharedArray(int64_t, from_array)(loaded);
+//      SharedArray(int64_t) * mine = SharedArray(int64_t, clone)(prices);    // no copy
+//      SharedArray(int64_t, set)(mine, 0, 42);                              // copies now
+//      SharedArray(int64_t, delete)(mine);
+//
+
+// =~=~=~=~=~=~=~=~ Imports ~=~=~=~=~=~=~=~=
+
+#include <iso646.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+// =~=~=~=~=~=~=~=~ Helper Macros ~=~=~=~=~=~=~=~=
+
+#define _CAT(X, Y) X ## _ ## Y
+#define CAT(X, Y) _CAT(X, Y)
+#define _CAT3(X, Y, Z) X ## _ ## Y ## _ ## Z
+#define CAT3(X, Y, Z) _CAT3(X, Y, Z)
+
+#define STRINGIFY(x) #x
+#define TOSTRING(x) STRINGIFY(x)
+
+#define ensure(COND, VAL) if (not (COND)) return VAL
+
+
+// =~=~=~=~=~=~=~=~ Implementation ~=~=~=~=~=~=~=~=
+
+// T: Element type of the SharedArray<T>
+#ifndef T
+#error "T is not defined"
+#endif
+
+// PRINT_T: (T) -> void
+//
+// PRINT_T is a macro that defines how to print an element of type T.
+// See ``Array<T>`` for more details.
+//
+#ifndef PRINT_T
+#error "PRINT_T is not defined"
+#endif
+
+#define MODULE SharedArray
+#define Self CAT(MODULE, T)
+#define fn(NAME) CAT(Self, NAME)
+
+#define _SHARED_ARRAY_SELECT_MACRO(_1, _2, NAME, ...) NAME
+#define SharedArray(...) _SHARED_ARRAY_SELECT_MACRO(__VA_ARGS__, SharedArray2, SharedArray1)(__VA_ARGS__)
+#define SharedArray1(T) CAT(SharedArray, T)
+#define SharedArray2(T, FUNC) CAT3(SharedArray, T, FUNC)
+
+typedef struct {
+    _Atomic size_t references;
+    Array(T) * array;
+} fn(_Buffer);
+
+typedef struct {
+    fn(_Buffer) * buffer;
+} Self;
+
+// Copy-on-write counts for every SharedArray<T> of this T.
+typedef struct {
+    size_t clones;              // handles made by ``clone``
+    size_t copies;              // buffers copied because they were shared
+    size_t avoided;             // clones that never needed a copy
+} fn(Stats);
+
+_Atomic size_t fn(_clones);
+_Atomic size_t fn(_copies);
+
+
+// ~~~~~~~~ Buffers ~~~~~~~~
+
+fn(_Buffer) * fn(_buffer)(Array(T) * array) {
+    fn(_Buffer) * buffer = ARRAY_MALLOC(sizeof(fn(_Buffer)));
+    ensure(buffer, NULL);
+
+    atomic_init(&buffer->references, 1);
+    buffer->array = array;
+    return buffer;
+}
+
+// Drops one reference, deleting the buffer with the last one.
+void fn(_release)(fn(_Buffer) * buffer) {
+    ensure(atomic_fetch_sub_explicit(&buffer->references, 1, memory_order_release) == 1,);
+
+    atomic_thread_fence(memory_order_acquire);
+    Array(T, delete)(buffer->array);
+    ARRAY_FREE(buffer);
+}
+
+// Gives the handle a buffer of its own, copying a shared one.
+bool fn(_detach)(Self * shared) {
+    fn(_Buffer) * buffer = shared->buffer;
+    ensure(atomic_load_explicit(&buffer->references, memory_order_acquire) > 1, true);
+
+    Array(T) * array = Array(T, new)(buffer->array->_size);
+    ensure(array, false);
+
+    if (array->_size) memcpy(array->data, buffer->array->data, array->_size * sizeof(T));
+    shared->buffer = fn(_buffer)(array);
+    if (not shared->buffer) {
+        shared->buffer = buffer;
+        Array(T, delete)(array);
+        return false;
+    }
+    fn(_release)(buffer);
+    atomic_fetch_add_explicit(&fn(_copies), 1, memory_order_relaxed);
+    return true;
+}
+
+
+// ~~~~~~~~ Lifetime ~~~~~~~~
+
+// SharedArray >> delete(shared: *SharedArray<T>) -> bool
+//
+// Deletes the handle. The array is deleted with its last handle.
+//
+// Returns
+// -------
+// bool: Returns true on success.
+//
+bool fn(delete)(Self * shared) {
+    ensure(shared, false);
+
+    fn(_release)(shared->buffer);
+    ARRAY_FREE(shared);
+    return true;
+}
+
+// SharedArray >> from_array(array: *Array<T>) -> *SharedArray<T>
+//
+// Makes the first handle to ``array``, taking ownership of it.
+//
+// Parameters
+// ----------
+// array : *Array<T>
+//     The array to share, no longer to be used nor deleted by the caller.
+//
+// Returns
+// -------
+// *SharedArray<T>: The new handle, or NULL on failure, leaving ``array`` to the caller.
+//
+Self * fn(from_array)(Array(T) * array) {
+    ensure(array, NULL);
+
+    Self * shared = ARRAY_MALLOC(sizeof(Self));
+    ensure(shared, NULL);
+
+    shared->buffer = fn(_buffer)(array);
+    if (not shared->buffer) {
+        ARRAY_FREE(shared);
+        return NULL;
+    }
+    return shared;
+}
+
+// SharedArray >> new(size: size_t) -> *SharedArray<T>
+//
+// Creates a handle to a new array of ``size`` zeros.
+//
+// Returns
+// -------
+// *SharedArray<T>: The new handle, or NULL on failure.
+//
+Self * fn(new)(size_t size) {
+    Array(T) * array = Array(T, new)(size);
+    ensure(array, NULL);
+
+    Self * shared = fn(from_array)(array);
+    if (not shared) Array(T, delete)(array);
+    return shared;
+}
+
+// SharedArray >> clone(shared: *SharedArray<T>) -> *SharedArray<T>
+//
+// Makes another handle to the same array in O(1), without copying.
+// Writes through either handle are not seen by the other.
+//
+// Returns
+// -------
+// *SharedArray<T>: The new handle, or NULL on failure.
+//
+Self * fn(clone)(Self * shared) {
+    ensure(shared, NULL);
+
+    Self * clone = ARRAY_MALLOC(sizeof(Self));
+    ensure(clone, NULL);
+
+    atomic_fetch_add_explicit(&shared->buffer->references, 1, memory_order_relaxed);
+    atomic_fetch_add_explicit(&fn(_clones), 1, memory_order_relaxed);
+    clone->buffer = shared->buffer;
+    return clone;
+}
+
+
+// ~~~~~~~~ Access ~~~~~~~~
+
+// SharedArray >> get(shared: *SharedArray<T>, index: size_t) -> *T
+//
+// Gets a pointer to the element at the specified index, for reading:
+// the element may be shared with other handles.
+//
+// Returns
+// -------
+// *T: A pointer to the element, or NULL if the index is out of bounds.
+//
+T * fn(get)(Self * shared, size_t index) {
+    ensure(shared, NULL);
+    return Array(T, get)(shared->buffer->array, index);
+}
+
+// SharedArray >> set(shared: *SharedArray<T>, index: size_t, value: T) -> bool
+//
+// Sets the element at the specified index, copying the array
+// first if another handle shares it.
+//
+// Returns
+// -------
+// bool: Returns true on success, false if the index is out of bounds
+//       or the copy could not be made.
+//
+bool fn(set)(Self * shared, size_t index, T value) {
+    ensure(shared and index < shared->buffer->array->_size, false);
+    ensure(fn(_detach)(shared), false);
+
+    shared->buffer->array->data[index] = value;
+    return true;
+}
+
+// SharedArray >> replace(shared: *SharedArray<T>, index: size_t, value: T, old: *T) -> bool
+//
+// Like ``set``, also copying the previous value into ``old``.
+//
+// Parameters
+// ----------
+// shared : *SharedArray<T>
+//     The handle to write through.
+// index : size_t
+//     The index of the element to replace.
+// value : T
+//     The new value.
+// old : *T
+//     Receives the previous value, if not NULL.
+//
+// Returns
+// -------
+// bool: Returns true on success, false if the index is out of bounds
+//       or the copy could not be made.
+//
+bool fn(replace)(Self * shared, size_t index, T value, T * old) {
+    ensure(shared and index < shared->buffer->array->_size, false);
+    ensure(fn(_detach)(shared), false);
+
+    T * slot = &shared->buffer->array->data[index];
+    if (old) *old = *slot;
+    *slot = value;
+    return true;
+}
+
+// SharedArray >> make_unique(shared: *SharedArray<T>) -> *Array<T>
+//
+// Returns the handle's array for writing, copying it first if shared.
+// The Array stays owned by the handle, and is only valid until
+// the handle is cloned or deleted.
+//
+// Returns
+// -------
+// *Array<T>: The handle's own array, or NULL if the copy could not be made.
+//
+Array(T) * fn(make_unique)(Self * shared) {
+    ensure(shared, NULL);
+    ensure(fn(_detach)(shared), NULL);
+
+    return shared->buffer->array;
+}
+
+// SharedArray >> array(shared: *SharedArray<T>) -> *Array<T>
+//
+// Returns the shared array for reading, without copying. Do not write it.
+//
+Array(T) * fn(array)(Self * shared) {
+    ensure(shared, NULL);
+    return shared->buffer->array;
+}
+
+// SharedArray >> size(shared: *SharedArray<T>) -> size_t
+//
+// Returns the number of elements.
+//
+size_t fn(size)(Self * shared) {
+    ensure(shared, 0);
+    return shared->buffer->array->_size;
+}
+
+// SharedArray >> references(shared: *SharedArray<T>) -> size_t
+//
+// Returns the number of handles sharing the array, 1 if unique.
+// With other threads cloning, it is only a hint.
+//
+size_t fn(references)(Self * shared) {
+    ensure(shared, 0);
+    return atomic_load_explicit(&shared->buffer->references, memory_order_acquire);
+}
+
+// SharedArray >> stats() -> SharedArray<T>.Stats
+//
+// Returns the clones and copies made so far for this T.
+//
+fn(Stats) fn(stats)(void) {
+    fn(Stats) stats;
+    stats.clones = atomic_load_explicit(&fn(_clones), memory_order_relaxed);
+    stats.copies = atomic_load_explicit(&fn(_copies), memory_order_relaxed);
+    stats.avoided = stats.clones > stats.copies ? stats.clones - stats.copies : 0;
+    return stats;
+}
+
+
+// ~~~~~~~~ Printing ~~~~~~~~
+
+// SharedArray >> print(shared: *SharedArray<T>) -> void
+//
+// Prints the elements on terminal.
+//
+void fn(print)(Self * shared) {
+    ensure(shared,);
+    Array(T, print)(shared->buffer->array);
+}
+
+// SharedArray >> println(shared: *SharedArray<T>) -> void
+//
+// Prints the elements on terminal followed by a newline.
+//
+void fn(println)(Self * shared) {
+    fn(print)(shared);
+    printf("\n");
+}
+
+// SharedArray >> debug(shared: *SharedArray<T>) -> void
+//
+// Prints the debug representation of the handle.
+//
+void fn(debug)(Self * shared) {
+    if (not shared) {
+        printf("SharedArray<%s> { NULL }\n", TOSTRING(T));
+        return;
+    }
+
+    printf("SharedArray<%s> {\n", TOSTRING(T));
+    printf("  references: %zu,\n", fn(references)(shared));
+    printf("  size: %zu,\n", fn(size)(shared));
+    printf("  data: "); fn(println)(shared);
+    printf("}\n");
+}
+
+#undef MODULE
+#undef Self
+#undef fn
+#undef T
+#undef PRINT_T
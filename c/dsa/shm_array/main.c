@@ -0,0 +1,231 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdint.h>
+#include <stdio.h>
+#include <sys/wait.h>
+#include <time.h>
+
+#define T int64_t
+#define PRINT_T(value) printf("%lld", (long long) value)
+#include "../array/array.h"
+
+#define T int64_t
+#define PRINT_T(value) printf("%lld", (long long) value)
+#include "shm_array.h"
+
+#define T double
+#define PRINT_T(value) printf("%g", value)
+#include "../array/array.h"
+
+#define T double
+#define PRINT_T(value) printf("%g", value)
+#include "shm_array.h"
+
+// Usage: ./main [size] [readers] [rounds], defaults to 2^20 elements
+// handed to 4 reader processes, 20 times.
+
+typedef ShmArray(int64_t) Shm;
+
+double seconds() {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec + now.tv_nsec * 1e-9;
+}
+
+// Reads all of ``size`` bytes, through short reads.
+bool read_all(int fd, void * bytes, size_t size) {
+    char * p = bytes;
+    while (size > 0) {
+        ssize_t got = read(fd, p, size);
+        if (got <= 0) return false;
+        p += got;
+        size -= (size_t) got;
+    }
+    return true;
+}
+
+bool write_all(int fd, const void * bytes, size_t size) {
+    const char * p = bytes;
+    while (size > 0) {
+        ssize_t written = write(fd, p, size);
+        if (written <= 0) return false;
+        p += written;
+        size -= (size_t) written;
+    }
+    return true;
+}
+
+// Round ``round`` sets element ``i`` to ``round + i``, so a consistent
+// snapshot has the same ``value - i`` everywhere.
+int64_t checksum(const int64_t * data, size_t size, bool * consistent) {
+    int64_t sum = 0;
+    *consistent = true;
+    for (size_t i = 0; i < size; i++) {
+        sum += data[i];
+        *consistent = *consistent and data[i] - (int64_t) i == data[0];
+    }
+    return sum;
+}
+
+// A reader process fed through a pipe: it receives each round's table into its own copy.
+void piped_reader(int input, int output, size_t size) {
+    int64_t * copy = malloc(size * sizeof(int64_t));
+    bool consistent;
+    while (copy and read_all(input, copy, size * sizeof(int64_t))) {
+        int64_t sum = checksum(copy, size, &consistent);
+        if (not write_all(output, &sum, sizeof(sum))) break;
+    }
+    _exit(0);
+}
+
+// A reader process on the segment: each byte on ``input`` asks for a sum of the current table.
+// Once ``input`` closes, it checks snapshots for a while against a writer that never stops,
+// and reports how many it had to retry and how many it accepted torn.
+void shm_reader(const char * name, int input, int output) {
+    Shm * view = Array(int64_t, shm_open)(name);
+    if (not view) _exit(1);
+
+    size_t size = Array(int64_t, shm_size)(view);
+    const int64_t * data = Array(int64_t, shm_get)(view, 0);
+    char request;
+    bool consistent;
+    while (read(input, &request, 1) == 1) {
+        int64_t sum;
+        uint64_t generation;
+        do {
+            generation = Array(int64_t, shm_read_begin)(view);
+            sum = checksum(data, size, &consistent);
+        } while (not Array(int64_t, shm_read_valid)(view, generation));
+        if (not write_all(output, &sum, sizeof(sum))) _exit(1);
+    }
+
+    int64_t counts[2] = { 0, 0 };       // retried, torn
+    for (double start = seconds(); seconds() - start < 0.2;) {
+        uint64_t generation = Array(int64_t, shm_read_begin)(view);
+        checksum(data, size, &consistent);
+        if (not Array(int64_t, shm_read_valid)(view, generation)) counts[0]++;
+        else counts[1] += not consistent;
+    }
+    write_all(output, counts, sizeof(counts));
+    Array(int64_t, shm_close)(view);
+    _exit(0);
+}
+
+int main(int argc, char ** argv) {
+
+    char name[64];
+    snprintf(name, sizeof(name), "/rickland_shm_%d", (int) getpid());
+
+    Array(int64_t) * small = Array(int64_t, new)(4);
+    for (size_t i = 0; i < 4; i++) Array(int64_t, set)(small, i, (int64_t) i * 10);
+    Shm * writer = Array(int64_t, shm_from_array)(name, small);
+    Shm * reader = Array(int64_t, shm_open)(name);
+    Array(int64_t, shm_begin_write)(writer);
+    Array(int64_t, shm_set)(writer, 3, 99);
+    Array(int64_t, shm_publish)(writer);
+    Array(int64_t, shm_debug)(reader);
+    printf("opened as double: %s\n", Array(double, shm_open)(name) ? "yes" : "refused");
+    Array(int64_t, shm_close)(reader);
+    Array(int64_t, shm_close)(writer);
+    Array(int64_t, shm_unlink)(name);
+    Array(int64_t, delete)(small);
+    printf("\n");
+
+    size_t size = argc > 1 ? (size_t) atoll(argv[1]) : (size_t) 1 << 20;
+    size_t readers = argc > 2 ? (size_t) atoll(argv[2]) : 4;
+    size_t rounds = argc > 3 ? (size_t) atoll(argv[3]) : 20;
+    int64_t * table = malloc(size * sizeof(int64_t));
+    pid_t * children = malloc(readers * sizeof(pid_t));
+    int (*pipes)[2][2] = malloc(readers * sizeof(*pipes));     // [reader][to, from][read end, write end]
+    if (not table or not children or not pipes) return 1;
+
+    // Every round, each reader sums the writer's new table: sent down a pipe
+    // into each reader's copy, or published once in the segment.
+    double times[2];
+    int64_t expected = 0, mismatches = 0;
+    for (int shared = 0; shared < 2; shared++) {
+        writer = shared ? Array(int64_t, shm_create)(name, size) : NULL;
+        if (shared and not writer) return 1;
+
+        for (size_t r = 0; r < readers; r++) {
+            if (pipe(pipes[r][0]) != 0 or pipe(pipes[r][1]) != 0) return 1;
+            children[r] = fork();
+            if (children[r] == 0) {
+                close(pipes[r][0][1]);
+                close(pipes[r][1][0]);
+                if (shared) shm_reader(name, pipes[r][0][0], pipes[r][1][1]);
+                piped_reader(pipes[r][0][0], pipes[r][1][1], size);
+            }
+            close(pipes[r][0][0]);
+            close(pipes[r][1][1]);
+        }
+
+        double start = seconds();
+        for (size_t round = 1; round <= rounds; round++) {
+            int64_t * data = shared ? writer->data : table;
+            if (shared) Array(int64_t, shm_begin_write)(writer);
+            for (size_t i = 0; i < size; i++) data[i] = (int64_t) (round + i);
+            if (shared) Array(int64_t, shm_publish)(writer);
+
+            bool consistent;
+            expected = checksum(data, size, &consistent);
+            for (size_t r = 0; r < readers; r++) {
+                bool sent = shared
+                    ? write_all(pipes[r][0][1], "?", 1)
+                    : write_all(pipes[r][0][1], table, size * sizeof(int64_t));
+                if (not sent) return 1;
+            }
+            for (size_t r = 0; r < readers; r++) {
+                int64_t sum;
+                if (not read_all(pipes[r][1][0], &sum, sizeof(sum))) return 1;
+                mismatches += sum != expected;
+            }
+        }
+        times[shared] = seconds() - start;
+
+        for (size_t r = 0; r < readers; r++) close(pipes[r][0][1]);
+        if (not shared) {
+            for (size_t r = 0; r < readers; r++) {
+                close(pipes[r][1][0]);
+                waitpid(children[r], NULL, 0);
+            }
+        }
+    }
+
+    printf("%zu elements, %zu readers, %zu rounds\n", size, readers, rounds);
+    printf("pipes and copies: %8.2f ms, %zu bytes copied per round\n",
+        times[0] * 1e3, readers * size * sizeof(int64_t));
+    printf("shared memory:    %8.2f ms, 0 bytes copied per round, %lld wrong sums\n",
+        times[1] * 1e3, (long long) mismatches);
+
+    // The writer keeps rewriting while the readers check their snapshots.
+    int64_t retried = 0, torn = 0;
+    size_t done = 0;
+    for (size_t round = rounds + 1; done < readers; round++) {
+        Array(int64_t, shm_begin_write)(writer);
+        for (size_t i = 0; i < size; i++) writer->data[i] = (int64_t) (round + i);
+        Array(int64_t, shm_publish)(writer);
+
+        for (size_t r = 0; r < readers; r++) {
+            if (pipes[r][1][0] < 0) continue;
+            if (waitpid(children[r], NULL, WNOHANG) == 0) continue;
+            int64_t counts[2];
+            if (read_all(pipes[r][1][0], counts, sizeof(counts))) {
+                retried += counts[0];
+                torn += counts[1];
+            }
+            close(pipes[r][1][0]);
+            pipes[r][1][0] = -1;
+            done++;
+        }
+    }
+    printf("under a busy writer: %lld snapshots retried, %lld accepted torn\n", (long long) retried, (long long) torn);
+
+    Array(int64_t, shm_close)(writer);
+    Array(int64_t, shm_unlink)(name);
+    free(table);
+    free(children);
+    free(pipes);
+    return 0;
+
+}
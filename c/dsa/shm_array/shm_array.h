@@ -0,0 +1,471 @@
+// ===========
+// ShmArray<T>
+// ===========
+//
+// :Author: RickBarretto
+// :Year: 2026
+// :License: MPL 2.0
+// :Copyright: RickBarretto, 2026
+// :Version: 1.0
+//
+// ``ShmArray<T>`` places an array in POSIX shared memory, so one writer
+// process publishes a table and any number of reader processes use it
+// in place, without copies or serialization.
+//
+// The segment holds no pointers, as each process maps it elsewhere:
+// a header, then the elements, found by their offset from the header.
+//
+//      +-----------------+
+//      | magic "RKSHM1"  |  stored last by the creator, so openers never
+//      | type tag        |  see a half-built segment; the tag is a hash of
+//      | element, size   |  the type's name and size, checked on open
+//      | offset          |  of the elements, from the header
+//      | generation      |  odd while the writer writes
+//      +-----------------+
+//      | elements ...    |  at ``offset``, cache line aligned
+//      +-----------------+
+//
+// Publishing is a sequence lock on the generation: the writer makes it
+// odd with ``shm_begin_write``, writes, and makes it even again with
+// ``shm_publish``. A reader takes an even generation with ``shm_read_begin``,
+// reads the elements in place, then keeps what it read only if
+// ``shm_read_valid`` finds the generation unchanged, or reads again.
+// Readers never write the segment, and are mapped read only.
+//
+// T must be plain data: pointers inside elements would only make sense
+// in the process that stored them. POSIX only.
+//
+// How to Use
+// ----------
+//
+// Include ``Array<T>`` first, then this header with the same T:
+//
+//      #define T int64_t
+//      #define PRINT_T(value) printf("%lld", (long long) value)
+//      #include "../array/array.h"
+//
+//      #define T int64_t
+//      #define PRINT_T(value) printf("%lld", (long long) value)
+//      #include "shm_array.h"
+//
+// And a common way to use it would be:
+//
+//      ShmArray(int64_t) * prices = Array(int64_t, shm_create)("/prices", size);     // writer
+//      Array(int64_t, shm_begin_write)(prices);
+//      Array(int64_t, shm_set)(prices, item, 100);
+//      Array(int64_t, shm_publish)(prices);
+//
+//      ShmArray(int64_t) * view = Array(int64_t, shm_open)("/prices");               // readers
+//      uint64_t generation;
+//      int64_t price;
+//      do {
+//          generation = Array(int64_t, shm_read_begin)(view);
+//          price = *Array(int64_t, shm_get)(view, item);
+//      } while (not Array(int64_t, shm_read_valid)(view, generation));
+//
+//      Array(int64_t, shm_close)(view);
+//      Array(int64_t, shm_close)(prices);
+//      Array(int64_t, shm_unlink)("/prices");
+//
+// Link with ``-lrt`` on C libraries older than glibc 2.34.
+//
+
+// =~=~=~=~=~=~=~=~ Imports ~=~=~=~=~=~=~=~=
+
+#include <fcntl.h>
+#include <iso646.h>
+#include <sched.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+
+
+// =~=~=~=~=~=~=~=~ Helper Macros ~=~=~=~=~=~=~=~=
+
+#define _CAT(X, Y) X ## _ ## Y
+#define CAT(X, Y) _CAT(X, Y)
+#define _CAT3(X, Y, Z) X ## _ ## Y ## _ ## Z
+#define CAT3(X, Y, Z) _CAT3(X, Y, Z)
+
+#define STRINGIFY(x) #x
+#define TOSTRING(x) STRINGIFY(x)
+
+#define ensure(COND, VAL) if (not (COND)) return VAL
+
+
+// =~=~=~=~=~=~=~=~ Shared helpers ~=~=~=~=~=~=~=~=
+
+#ifndef SHM_ARRAY_HELPERS
+#define SHM_ARRAY_HELPERS
+
+#define _SHM_ARRAY_MAGIC 0x00314d48534b52ull    // "RKSHM1", little endian
+#define _SHM_ARRAY_OFFSET 64
+
+typedef struct {
+    _Atomic uint64_t magic;
+    uint64_t tag;
+    uint64_t element;
+    uint64_t size;
+    uint64_t offset;
+    _Atomic uint64_t generation;
+} _ShmArrayHeader;
+
+_Static_assert(sizeof(_ShmArrayHeader) <= _SHM_ARRAY_OFFSET, "ShmArray header outgrew its offset");
+
+// FNV-1a of the type's name, then of its size.
+uint64_t _ShmArray_tag(const char * name, size_t element) {
+    uint64_t hash = 0xcbf29ce484222325ull;
+    for (const char * c = name; *c; c++) hash = (hash ^ (uint8_t) *c) * 0x100000001b3ull;
+    for (int byte = 0; byte < 8; byte++) hash = (hash ^ (element >> (byte * 8) & 0xFF)) * 0x100000001b3ull;
+    return hash;
+}
+
+#endif
+
+
+// =~=~=~=~=~=~=~=~ Implementation ~=~=~=~=~=~=~=~=
+
+// T: Element type of the ShmArray<T>, plain data without pointers.
+#ifndef T
+#error "T is not defined"
+#endif
+
+// PRINT_T: (T) -> void
+//
+// PRINT_T is a macro that defines how to print an element of type T.
+// See ``Array<T>`` for more details.
+//
+#ifndef PRINT_T
+#error "PRINT_T is not defined"
+#endif
+
+#define MODULE ShmArray
+#define Self CAT(MODULE, T)
+#define fn(NAME) CAT(Self, NAME)
+
+#define _SHM_ARRAY_SELECT_MACRO(_1, _2, NAME, ...) NAME
+#define ShmArray(...) _SHM_ARRAY_SELECT_MACRO(__VA_ARGS__, ShmArray2, ShmArray1)(__VA_ARGS__)
+#define ShmArray1(T) CAT(ShmArray, T)
+#define ShmArray2(T, FUNC) CAT3(ShmArray, T, FUNC)
+
+// The process-local handle; only the segment is shared.
+typedef struct {
+    _ShmArrayHeader * header;
+    T * data;
+    size_t _mapped;
+    bool _writer;
+} Self;
+
+
+// ~~~~~~~~ Lifetime ~~~~~~~~
+
+// Maps ``fd`` and wraps it in a handle, closing ``fd`` either way.
+Self * fn(_map)(int fd, size_t bytes, bool writer) {
+    Self * shm = ARRAY_CALLOC(1, sizeof(Self));
+    void * memory = MAP_FAILED;
+    if (shm) memory = mmap(NULL, bytes, writer ? PROT_READ | PROT_WRITE : PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (memory == MAP_FAILED) {
+        ARRAY_FREE(shm);
+        return NULL;
+    }
+
+    shm->header = memory;
+    shm->_mapped = bytes;
+    shm->_writer = writer;
+    return shm;
+}
+
+// Array >> shm_create(name: *char, size: size_t) -> *ShmArray<T>
+//
+// Creates the shared memory segment ``name``, such as "/prices",
+// with ``size`` zeros, and maps it for writing.
+//
+// Returns
+// -------
+// *ShmArray<T>: The writer's handle, or NULL if the segment exists
+//     already or cannot be created.
+//
+Self * Array(T, shm_create)(const char * name, size_t size) {
+    ensure(name, NULL);
+
+    size_t bytes = _SHM_ARRAY_OFFSET + size * sizeof(T);
+    int fd = shm_open(name, O_RDWR | O_CREAT | O_EXCL, 0600);
+    ensure(fd >= 0, NULL);
+    if (ftruncate(fd, (off_t) bytes) != 0) {
+        close(fd);
+        shm_unlink(name);
+        return NULL;
+    }
+
+    Self * shm = fn(_map)(fd, bytes, true);
+    if (not shm) {
+        shm_unlink(name);
+        return NULL;
+    }
+
+    _ShmArrayHeader * header = shm->header;
+    header->tag = _ShmArray_tag(TOSTRING(T), sizeof(T));
+    header->element = sizeof(T);
+    header->size = size;
+    header->offset = _SHM_ARRAY_OFFSET;
+    atomic_init(&header->generation, 0);
+    atomic_store_explicit(&header->magic, _SHM_ARRAY_MAGIC, memory_order_release);
+
+    shm->data = (T *) ((char *) header + header->offset);
+    return shm;
+}
+
+// Array >> shm_from_array(name: *char, array: *Array<T>) -> *ShmArray<T>
+//
+// Creates the segment ``name`` with a copy of ``array``, published
+// as generation 2.
+//
+// Returns
+// -------
+// *ShmArray<T>: The writer's handle, or NULL as ``shm_create``.
+//
+Self * Array(T, shm_from_array)(const char * name, Array(T) * array) {
+    ensure(array, NULL);
+
+    Self * shm = Array(T, shm_create)(name, array->_size);
+    ensure(shm, NULL);
+
+    atomic_store_explicit(&shm->header->generation, 1, memory_order_relaxed);
+    memcpy(shm->data, array->data, array->_size * sizeof(T));
+    atomic_store_explicit(&shm->header->generation, 2, memory_order_release);
+    return shm;
+}
+
+// Array >> shm_open(name: *char) -> *ShmArray<T>
+//
+// Maps the existing segment ``name`` read only, for a reader.
+//
+// Returns
+// -------
+// *ShmArray<T>: The reader's handle, or NULL if the segment is missing,
+//     not yet created in full, or holds another type.
+//
+Self * Array(T, shm_open)(const char * name) {
+    ensure(name, NULL);
+
+    int fd = shm_open(name, O_RDONLY, 0);
+    ensure(fd >= 0, NULL);
+    struct stat info;
+    if (fstat(fd, &info) != 0 or info.st_size < _SHM_ARRAY_OFFSET) {
+        close(fd);
+        return NULL;
+    }
+
+    Self * shm = fn(_map)(fd, (size_t) info.st_size, false);
+    ensure(shm, NULL);
+
+    _ShmArrayHeader * header = shm->header;
+    bool valid = atomic_load_explicit(&header->magic, memory_order_acquire) == _SHM_ARRAY_MAGIC
+        and header->tag == _ShmArray_tag(TOSTRING(T), sizeof(T))
+        and header->element == sizeof(T)
+        and header->offset >= _SHM_ARRAY_OFFSET
+        and header->offset + header->size * sizeof(T) <= shm->_mapped;
+    if (not valid) {
+        munmap(shm->header, shm->_mapped);
+        ARRAY_FREE(shm);
+        return NULL;
+    }
+
+    shm->data = (T *) ((char *) header + header->offset);
+    return shm;
+}
+
+// Array >> shm_close(shm: *ShmArray<T>) -> bool
+//
+// Unmaps the segment from this process. The segment itself lives
+// on until ``shm_unlink`` and the last process closing it.
+//
+// Returns
+// -------
+// bool: Returns true on success.
+//
+bool Array(T, shm_close)(Self * shm) {
+    ensure(shm, false);
+
+    munmap(shm->header, shm->_mapped);
+    ARRAY_FREE(shm);
+    return true;
+}
+
+// Array >> shm_unlink(name: *char) -> bool
+//
+// Removes the segment's name: processes that mapped it keep using it,
+// new ``shm_open`` calls fail.
+//
+// Returns
+// -------
+// bool: Returns true on success.
+//
+bool Array(T, shm_unlink)(const char * name) {
+    ensure(name, false);
+    return shm_unlink(name) == 0;
+}
+
+
+// ~~~~~~~~ Writer ~~~~~~~~
+
+// Array >> shm_begin_write(shm: *ShmArray<T>) -> bool
+//
+// Makes the generation odd: readers retry until ``shm_publish``.
+//
+// Returns
+// -------
+// bool: Returns true on success, false on a reader's handle
+//       or if a write is open already.
+//
+bool Array(T, shm_begin_write)(Self * shm) {
+    ensure(shm and shm->_writer, false);
+
+    uint64_t generation = atomic_load_explicit(&shm->header->generation, memory_order_relaxed);
+    ensure(generation % 2 == 0, false);
+    atomic_store_explicit(&shm->header->generation, generation + 1, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+    return true;
+}
+
+// Array >> shm_set(shm: *ShmArray<T>, index: size_t, value: T) -> bool
+//
+// Sets the element at ``index``, between ``shm_begin_write`` and ``shm_publish``.
+//
+// Returns
+// -------
+// bool: Returns true on success, false on a reader's handle,
+//       outside a write, or if the index is out of bounds.
+//
+bool Array(T, shm_set)(Self * shm, size_t index, T value) {
+    ensure(shm and shm->_writer and index < shm->header->size, false);
+    ensure(atomic_load_explicit(&shm->header->generation, memory_order_relaxed) % 2 == 1, false);
+
+    shm->data[index] = value;
+    return true;
+}
+
+// Array >> shm_publish(shm: *ShmArray<T>) -> u64
+//
+// Publishes the writes made since ``shm_begin_write`` to every reader.
+//
+// Returns
+// -------
+// u64: The new, even generation, or 0 on a reader's handle or outside a write.
+//
+uint64_t Array(T, shm_publish)(Self * shm) {
+    ensure(shm and shm->_writer, 0);
+
+    uint64_t generation = atomic_load_explicit(&shm->header->generation, memory_order_relaxed);
+    ensure(generation % 2 == 1, 0);
+    atomic_store_explicit(&shm->header->generation, generation + 1, memory_order_release);
+    return generation + 1;
+}
+
+
+// ~~~~~~~~ Readers ~~~~~~~~
+
+// Array >> shm_read_begin(shm: *ShmArray<T>) -> u64
+//
+// Waits out any write in progress and returns the published generation,
+// to hand to ``shm_read_valid`` once done reading.
+//
+uint64_t Array(T, shm_read_begin)(Self * shm) {
+    ensure(shm, 0);
+
+    // Yield a few times, then sleep, so waiting readers leave the writer the CPU.
+    uint64_t generation;
+    struct timespec pause = { 0, 50000 };
+    for (int tries = 0; (generation = atomic_load_explicit(&shm->header->generation, memory_order_acquire)) % 2 == 1; tries++) {
+        if (tries < 16) sched_yield();
+        else nanosleep(&pause, NULL);
+    }
+    return generation;
+}
+
+// Array >> shm_read_valid(shm: *ShmArray<T>, generation: u64) -> bool
+//
+// Checks that nothing was written since ``shm_read_begin`` returned
+// ``generation``, so everything read meanwhile belongs to it.
+//
+// Returns
+// -------
+// bool: Returns true if the reads are consistent, false to read again.
+//
+bool Array(T, shm_read_valid)(Self * shm, uint64_t generation) {
+    ensure(shm, false);
+
+    atomic_thread_fence(memory_order_acquire);
+    return atomic_load_explicit(&shm->header->generation, memory_order_relaxed) == generation;
+}
+
+// Array >> shm_get(shm: *ShmArray<T>, index: size_t) -> *T
+//
+// Gets a pointer to the element at ``index``, in the segment itself.
+// Readers check what they read with ``shm_read_valid``.
+//
+// Returns
+// -------
+// *T: A pointer to the element, or NULL if the index is out of bounds.
+//
+const T * Array(T, shm_get)(Self * shm, size_t index) {
+    ensure(shm and index < shm->header->size, NULL);
+    return &shm->data[index];
+}
+
+// Array >> shm_size(shm: *ShmArray<T>) -> size_t
+//
+// Returns the number of elements.
+//
+size_t Array(T, shm_size)(Self * shm) {
+    ensure(shm, 0);
+    return (size_t) shm->header->size;
+}
+
+// Array >> shm_generation(shm: *ShmArray<T>) -> u64
+//
+// Returns the current generation, odd while a write is open.
+//
+uint64_t Array(T, shm_generation)(Self * shm) {
+    ensure(shm, 0);
+    return atomic_load_explicit(&shm->header->generation, memory_order_acquire);
+}
+
+// Array >> shm_debug(shm: *ShmArray<T>) -> void
+//
+// Prints the debug representation of the segment, as seen right now.
+//
+void Array(T, shm_debug)(Self * shm) {
+    if (not shm) {
+        printf("ShmArray<%s> { NULL }\n", TOSTRING(T));
+        return;
+    }
+
+    size_t size = (size_t) shm->header->size;
+    printf("ShmArray<%s> {\n", TOSTRING(T));
+    printf("  role: %s,\n", shm->_writer ? "writer" : "reader");
+    printf("  tag: %016llx,\n", (unsigned long long) shm->header->tag);
+    printf("  offset: %llu,\n", (unsigned long long) shm->header->offset);
+    printf("  generation: %llu,\n", (unsigned long long) Array(T, shm_generation)(shm));
+    printf("  size: %zu,\n", size);
+    printf("  data: [");
+    for (size_t i = 0; i < size; i++) {
+        PRINT_T(shm->data[i]);
+        if (i + 1 < size) printf(", ");
+    }
+    printf("]\n}\n");
+}
+
+#undef MODULE
+#undef Self
+#undef fn
+#undef T
+#undef PRINT_T
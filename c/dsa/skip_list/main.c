@@ -0,0 +1,184 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <pthread.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <time.h>
+
+#define T int64_t
+#define PRINT_T(value) printf("%lld", (long long) value)
+#include "../array/array.h"
+
+#define T size_t
+#define PRINT_T(value) printf("%zu", value)
+#include "../array/array.h"
+
+#include "../thread_pool/thread_pool.h"
+
+#define K int64_t
+#define V size_t
+#define PRINT_K(key) printf("%lld", (long long) key)
+#define PRINT_V(value) printf("%zu", value)
+#include "skip_list.h"
+
+#define K int64_t
+#define V size_t
+#define PRINT_K(key) printf("%lld", (long long) key)
+#define PRINT_V(value) printf("%zu", value)
+#include "../btree/btree.h"
+
+// Usage: ./main [keys] [operations], defaults to 2^20 keys
+// and 2^20 operations per thread, for 1 to 32 threads.
+
+typedef SkipList(int64_t, size_t) List;
+typedef BTree(int64_t, size_t) Tree;
+
+double seconds() {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec + now.tv_nsec * 1e-9;
+}
+
+uint64_t next_random(uint64_t * seed) {
+    *seed = *seed * 6364136223846793005ull + 1442695040888963407ull;
+    return *seed >> 32;
+}
+
+typedef struct {
+    List * list;
+    Tree * tree;
+    pthread_rwlock_t lock;
+    size_t keys;
+    size_t operations;
+    int writes;                 // percent of inserts plus removals
+    _Atomic size_t unsorted;
+} Job;
+
+// Random gets, inserts and removals, and a short scan every 256 operations.
+void run_list(void * context, size_t task, size_t worker) {
+    Job * job = context;
+    uint64_t seed = task * 7919 + 1;
+    for (size_t i = 0; i < job->operations; i++) {
+        int64_t key = (int64_t) (next_random(&seed) % job->keys);
+        int dice = (int) (next_random(&seed) % 100);
+        if (dice < job->writes / 2) SkipList(int64_t, size_t, insert)(job->list, worker, key, i);
+        else if (dice < job->writes) SkipList(int64_t, size_t, remove)(job->list, worker, key);
+        else SkipList(int64_t, size_t, contains)(job->list, worker, key);
+
+        if (i % 256 == 0) {
+            SkipList(int64_t, size_t, Iterator) scan = SkipList(int64_t, size_t, range)(job->list, worker, key, key + 64);
+            int64_t previous = INT64_MIN, seen;
+            while (SkipList(int64_t, size_t, next)(&scan, &seen, NULL)) {
+                if (seen <= previous) atomic_fetch_add(&job->unsorted, 1);
+                previous = seen;
+            }
+        }
+    }
+}
+
+// The same work on a BTree behind a readers-writer lock.
+void run_tree(void * context, size_t task, size_t worker) {
+    Job * job = context;
+    uint64_t seed = task * 7919 + 1;
+    (void) worker;
+    for (size_t i = 0; i < job->operations; i++) {
+        int64_t key = (int64_t) (next_random(&seed) % job->keys);
+        int dice = (int) (next_random(&seed) % 100);
+        if (dice < job->writes) {
+            pthread_rwlock_wrlock(&job->lock);
+            if (dice < job->writes / 2) {
+                if (not BTree(int64_t, size_t, get)(job->tree, key)) BTree(int64_t, size_t, set)(job->tree, key, i);
+            } else {
+                BTree(int64_t, size_t, remove)(job->tree, key);
+            }
+            pthread_rwlock_unlock(&job->lock);
+        } else {
+            pthread_rwlock_rdlock(&job->lock);
+            BTree(int64_t, size_t, get)(job->tree, key);
+            pthread_rwlock_unlock(&job->lock);
+        }
+
+        if (i % 256 == 0) {
+            pthread_rwlock_rdlock(&job->lock);
+            BTree(int64_t, size_t, Iterator) scan = BTree(int64_t, size_t, range)(job->tree, key, key + 64);
+            while (BTree(int64_t, size_t, next)(&scan, NULL, NULL)) {}
+            pthread_rwlock_unlock(&job->lock);
+        }
+    }
+}
+
+int main(int argc, char ** argv) {
+
+    List * small = SkipList(int64_t, size_t, new)(1);
+    for (int64_t key = 10; key > 0; key--) SkipList(int64_t, size_t, insert)(small, 0, key * 3, (size_t) key);
+    SkipList(int64_t, size_t, remove)(small, 0, 15);
+    SkipList(int64_t, size_t, debug)(small);
+
+    SkipList(int64_t, size_t, Iterator) range = SkipList(int64_t, size_t, range)(small, 0, 7, 20);
+    int64_t key;
+    printf("[7, 20):");
+    while (SkipList(int64_t, size_t, next)(&range, &key, NULL)) printf(" %lld", (long long) key);
+    printf("\n\n");
+    SkipList(int64_t, size_t, delete)(small);
+
+    // Many threads inserting and removing the same few keys, so removals
+    // race with inserts still linking their towers, and towers are reused.
+    Job churn = { .keys = 16, .operations = (size_t) 1 << 18, .writes = 90 };
+    atomic_init(&churn.unsorted, 0);
+    churn.list = SkipList(int64_t, size_t, new)(8);
+    ThreadPool * pool = ThreadPool_new(8);
+    ThreadPool_run(pool, 8, run_list, &churn);
+    ThreadPool_delete(pool);
+    size_t left = 0;
+    SkipList(int64_t, size_t, Iterator) all = SkipList(int64_t, size_t, iterate)(churn.list, 0);
+    while (SkipList(int64_t, size_t, next)(&all, NULL, NULL)) left++;
+    printf("churn on %zu keys: %zu left, size %s, scans %s\n\n", churn.keys, left,
+        left == SkipList(int64_t, size_t, size)(churn.list) ? "exact" : "off",
+        atomic_load(&churn.unsorted) ? "unsorted" : "sorted");
+    SkipList(int64_t, size_t, delete)(churn.list);
+
+    size_t keys = argc > 1 ? (size_t) atoll(argv[1]) : (size_t) 1 << 20;
+    size_t operations = argc > 2 ? (size_t) atoll(argv[2]) : (size_t) 1 << 20;
+    printf("%zu keys, %zu operations per thread, %zu cores\n", keys, operations, ThreadPool_cores());
+
+    for (int writes = 10; writes <= 50; writes += 40) {
+        printf("\n%d%% writes    skip list     rwlock btree\n", writes);
+        for (size_t threads = 1; threads <= 32; threads *= 2) {
+            Job job = { .keys = keys, .operations = operations, .writes = writes };
+            pthread_rwlock_init(&job.lock, NULL);
+            atomic_init(&job.unsorted, 0);
+            job.list = SkipList(int64_t, size_t, new)(threads);
+            job.tree = BTree(int64_t, size_t, new)();
+            for (size_t i = 0; i < keys; i += 2) {
+                SkipList(int64_t, size_t, insert)(job.list, 0, (int64_t) i, i);
+                BTree(int64_t, size_t, set)(job.tree, (int64_t) i, i);
+            }
+
+            ThreadPool * pool = ThreadPool_new(threads);
+            double start = seconds();
+            ThreadPool_run(pool, threads, run_list, &job);
+            double list_time = seconds() - start;
+
+            start = seconds();
+            ThreadPool_run(pool, threads, run_tree, &job);
+            double tree_time = seconds() - start;
+
+            // Same operations and seeds, but interleaved differently: only counts can be compared.
+            size_t counted = 0;
+            SkipList(int64_t, size_t, Iterator) all = SkipList(int64_t, size_t, iterate)(job.list, 0);
+            while (SkipList(int64_t, size_t, next)(&all, NULL, NULL)) counted++;
+
+            printf("%2zu threads  %8.2f M/s  %8.2f M/s   size %s, scans %s\n", threads,
+                threads * operations / list_time / 1e6, threads * operations / tree_time / 1e6,
+                counted == SkipList(int64_t, size_t, size)(job.list) ? "exact" : "off",
+                atomic_load(&job.unsorted) ? "unsorted" : "sorted");
+
+            ThreadPool_delete(pool);
+            SkipList(int64_t, size_t, delete)(job.list);
+            BTree(int64_t, size_t, delete)(job.tree);
+            pthread_rwlock_destroy(&job.lock);
+        }
+    }
+    return 0;
+
+}
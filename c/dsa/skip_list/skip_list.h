@@ -0,0 +1,704 @@
+// ==============
+// SkipList<K, V>
+// ==============
+//
+// :Author: RickBarretto
+// :Year: 2026
+// :License: MPL 2.0
+// :Copyright: RickBarretto, 2026
+// :Version: 1.1
+//
+// ``SkipList<K, V>`` is an ordered map that many threads may read,
+// insert into and remove from at once, without locks.
+//
+// Every entry is a tower of forward links. Insertion links the tower
+// bottom-up with compare-and-swap; removal marks the links of the tower
+// top-down (the low bit of each link), and whoever walks past a marked
+// tower unlinks it. Lookups and scans never write shared memory,
+// and are never blocked by writers.
+//
+// Towers are carved from an ``Arena`` per thread. A removed tower may
+// still be read by a concurrent scan, so it is handed to the list's
+// ``Ebr`` domain, which gives it back once no running operation can
+// see it; it is then reused by the next insert of the same height.
+// An open iterator holds back reclamation, so keep scans short.
+//
+// Threads are numbered, like ``ThreadPool`` workers: the list is made
+// for a number of threads, and each call names the calling thread's
+// index. An index must not be used by two threads at once.
+//
+// How to Use
+// ----------
+//
+// Include this header after defining K, V, PRINT_K and PRINT_V:
+//
+//      #define K int64_t
+//      #define V size_t
+//      #define PRINT_K(key) printf("%lld", (long long) key)
+//      #define PRINT_V(value) printf("%zu", value)
+//      #include "skip_list.h"
+//
+// For other keys, define LESS_K (defaults to ``<``).
+//
+// Each function is namespaced under SkipList<K, V>,
+// i.e. ``SkipList(int64_t, size_t, get)`` is the same as
+// ``SkipList_int64_t_size_t_get``.
+//
+//      SkipList(int64_t, size_t) * list = SkipList(int64_t, size_t, new)(threads);
+//      SkipList(int64_t, size_t, insert)(list, worker, 42, 7);
+//
+//      size_t value;
+//      if (SkipList(int64_t, size_t, get)(list, worker, 42, &value)) { ... }
+//
+//      SkipList(int64_t, size_t, Iterator) range = SkipList(int64_t, size_t, range)(list, worker, 10, 20);
+//      int64_t key;
+//      while (SkipList(int64_t, size_t, next)(&range, &key, &value)) { ... }
+//
+// Link with ``-pthread``.
+//
+
+// =~=~=~=~=~=~=~=~ Imports ~=~=~=~=~=~=~=~=
+
+#include <iso646.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../arena/arena.h"
+#include "../ebr/ebr.h"
+
+
+// =~=~=~=~=~=~=~=~ Helper Macros ~=~=~=~=~=~=~=~=
+
+#define _CAT(X, Y) X ## _ ## Y
+#define CAT(X, Y) _CAT(X, Y)
+#define _CAT3(X, Y, Z) X ## _ ## Y ## _ ## Z
+#define CAT3(X, Y, Z) _CAT3(X, Y, Z)
+
+#define STRINGIFY(x) #x
+#define TOSTRING(x) STRINGIFY(x)
+
+#define ensure(COND, VAL) if (not (COND)) return VAL
+
+
+// =~=~=~=~=~=~=~=~ Shared helpers ~=~=~=~=~=~=~=~=
+
+#ifndef SKIPLIST_HELPERS
+#define SKIPLIST_HELPERS
+
+// SKIPLIST_MAX_HEIGHT: Tallest tower; a quarter of the towers grow each level.
+#define SKIPLIST_MAX_HEIGHT 16
+
+// The low bit of a link: the tower holding it is being removed.
+#define _SKIPLIST_MARK ((uintptr_t) 1)
+
+#endif
+
+
+// =~=~=~=~=~=~=~=~ Implementation ~=~=~=~=~=~=~=~=
+
+// K: Key type of the SkipList<K, V>
+#ifndef K
+#error "K is not defined"
+#endif
+
+// V: Value type of the SkipList<K, V>
+#ifndef V
+#error "V is not defined"
+#endif
+
+// PRINT_K: (K) -> void
+//
+// PRINT_K is a macro that defines how to print a key of type K.
+// See ``Array<T>`` PRINT_T for more details.
+//
+#ifndef PRINT_K
+#error "PRINT_K is not defined"
+#endif
+
+// PRINT_V: (V) -> void
+//
+// PRINT_V is a macro that defines how to print a value of type V.
+//
+#ifndef PRINT_V
+#error "PRINT_V is not defined"
+#endif
+
+// LESS_K: (K, K) -> bool
+//
+// Optional. Defaults to ``<``.
+//
+#ifndef LESS_K
+#define LESS_K(a, b) ((a) < (b))
+#endif
+
+#define MODULE SkipList
+#define Self CAT3(MODULE, K, V)
+#define fn(NAME) CAT(Self, NAME)
+
+#define _SKIPLIST_SELECT_MACRO(_1, _2, _3, NAME, ...) NAME
+#define SkipList(...) _SKIPLIST_SELECT_MACRO(__VA_ARGS__, SkipList3, SkipList2)(__VA_ARGS__)
+#define SkipList2(K, V) CAT3(SkipList, K, V)
+#define SkipList3(K, V, FUNC) CAT(CAT3(SkipList, K, V), FUNC)
+
+typedef struct fn(_Node) fn(_Node);
+
+struct fn(_Node) {
+    K key;
+    V value;
+    uint32_t height;
+    _Atomic uint32_t holds;     // insert still linking, entry not yet unlinked
+    _Atomic uintptr_t next[];   // one link per level, marked on removal
+};
+
+// Per-thread state, one cache line apart from the others.
+typedef struct {
+    _Alignas(64) _Atomic int64_t count;         // insertions minus removals
+    _Atomic uintptr_t returned;                 // towers given back by Ebr, any height
+    Arena * arena;
+    uint64_t random;
+    fn(_Node) * free[SKIPLIST_MAX_HEIGHT];      // reusable towers, per height
+} fn(_Thread);
+
+typedef struct {
+    fn(_Node) * head;           // a full-height tower before every key
+    fn(_Thread) * threads;
+    Arena * arena;              // the head and the thread states
+    Ebr * ebr;
+    size_t _threads;
+    _Atomic uint32_t _levels;   // levels in use
+} Self;
+
+typedef struct {
+    Self * list;
+    size_t thread;
+    fn(_Node) * node;
+    K high;
+    bool bounded;
+} fn(Iterator);
+
+
+// ~~~~~~~~ Towers ~~~~~~~~
+
+fn(_Node) * fn(_pointer)(uintptr_t link) {
+    return (fn(_Node) *) (link & ~_SKIPLIST_MARK);
+}
+
+// A random height, each level kept with probability 1/4.
+uint32_t fn(_height)(fn(_Thread) * thread) {
+    thread->random ^= thread->random << 13;
+    thread->random ^= thread->random >> 7;
+    thread->random ^= thread->random << 17;
+
+    uint64_t bits = thread->random;
+    uint32_t height = 1;
+    while ((bits & 3) == 0 and height < SKIPLIST_MAX_HEIGHT) {
+        height++;
+        bits >>= 2;
+    }
+    return height;
+}
+
+// Ebr destructor of a removed tower: pushes it on the ``returned`` stack
+// of the thread that removed it, from whichever thread reclaims.
+void fn(_recycle)(void * context, void * pointer) {
+    fn(_Thread) * thread = context;
+    fn(_Node) * node = pointer;
+
+    uintptr_t top = atomic_load_explicit(&thread->returned, memory_order_relaxed);
+    do atomic_store_explicit(&node->next[0], top, memory_order_relaxed);
+    while (not atomic_compare_exchange_weak_explicit(&thread->returned, &top, (uintptr_t) node,
+                                                     memory_order_release, memory_order_relaxed));
+}
+
+fn(_Node) * fn(_node)(fn(_Thread) * thread, uint32_t height) {
+    fn(_Node) * node = thread->free[height - 1];
+    if (not node and atomic_load_explicit(&thread->returned, memory_order_relaxed)) {
+        // Only the owner pops, and it takes the whole stack at once.
+        uintptr_t link = atomic_exchange_explicit(&thread->returned, 0, memory_order_acquire);
+        while (link) {
+            fn(_Node) * returned = fn(_pointer)(link);
+            link = atomic_load_explicit(&returned->next[0], memory_order_relaxed);
+            atomic_store_explicit(&returned->next[0], (uintptr_t) thread->free[returned->height - 1],
+                memory_order_relaxed);
+            thread->free[returned->height - 1] = returned;
+        }
+        node = thread->free[height - 1];
+    }
+    if (node) {
+        thread->free[height - 1] = fn(_pointer)(atomic_load_explicit(&node->next[0], memory_order_relaxed));
+        return node;
+    }
+
+    node = Arena_alloc(thread->arena, sizeof(fn(_Node)) + height * sizeof(uintptr_t), _Alignof(fn(_Node)));
+    ensure(node, NULL);
+    node->height = height;
+    return node;
+}
+
+// One pass of ``_find``: returns 1 if ``key`` is in the list, 0 if not,
+// and -1 if a link changed under us and the pass must start over.
+int fn(_search)(Self * list, K key, bool through, fn(_Node) ** preds, fn(_Node) ** succs) {
+    fn(_Node) * pred = list->head;
+    for (size_t level = atomic_load(&list->_levels); level-- > 0;) {
+        fn(_Node) * curr = fn(_pointer)(atomic_load_explicit(&pred->next[level], memory_order_acquire));
+        while (curr) {
+            uintptr_t next = atomic_load_explicit(&curr->next[level], memory_order_acquire);
+            if (next & _SKIPLIST_MARK) {
+                uintptr_t expected = (uintptr_t) curr;
+                if (not atomic_compare_exchange_strong(&pred->next[level], &expected, next & ~_SKIPLIST_MARK))
+                    return -1;
+                curr = fn(_pointer)(next);
+                continue;
+            }
+            if (not LESS_K(curr->key, key) and not (through and not LESS_K(key, curr->key))) break;
+            pred = curr;
+            curr = fn(_pointer)(next);
+        }
+        preds[level] = pred;
+        succs[level] = curr;
+    }
+    return succs[0] and not LESS_K(key, succs[0]->key);
+}
+
+// Fills ``preds`` and ``succs`` with the towers around ``key`` at each
+// level in use, unlinking marked towers on the way. With ``through``,
+// it also walks past the tower equal to ``key``, so that every marked
+// tower with that key is unlinked from every level.
+bool fn(_find)(Self * list, K key, bool through, fn(_Node) ** preds, fn(_Node) ** succs) {
+    int found;
+    while ((found = fn(_search)(list, key, through, preds, succs)) < 0) {}
+    return found;
+}
+
+// Finds the first tower not below ``key``, without writing anything.
+// Marked towers are walked through, since their links still lead forward.
+fn(_Node) * fn(_lower)(Self * list, K key) {
+    fn(_Node) * pred = list->head, * curr = NULL;
+    for (size_t level = atomic_load(&list->_levels); level-- > 0;) {
+        curr = fn(_pointer)(atomic_load_explicit(&pred->next[level], memory_order_acquire));
+        while (curr and LESS_K(curr->key, key)) {
+            pred = curr;
+            curr = fn(_pointer)(atomic_load_explicit(&curr->next[level], memory_order_acquire));
+        }
+    }
+    return curr;
+}
+
+bool fn(_removed)(fn(_Node) * node) {
+    return atomic_load_explicit(&node->next[0], memory_order_acquire) & _SKIPLIST_MARK;
+}
+
+// Drops one of the two holds on a tower: its insert is done linking,
+// or its removal is done unlinking. A tower still being linked when it
+// is removed may be linked again at an upper level after the removal
+// has swept it, so only the last of the two retires it, once no level
+// can lead to it anymore. If the queue cannot grow, the tower is simply
+// left to the arena.
+void fn(_release)(Self * list, size_t thread, fn(_Node) * node) {
+    if (atomic_fetch_sub_explicit(&node->holds, 1, memory_order_acq_rel) == 1)
+        Ebr_defer_free(list->ebr, thread, node, fn(_recycle), &list->threads[thread]);
+}
+
+
+// ~~~~~~~~ Lifetime ~~~~~~~~
+
+// SkipList >> delete(list: *SkipList<K, V>) -> bool
+//
+// Deletes the list and every tower at once.
+// No other thread may be using it.
+//
+// Returns
+// -------
+// bool: Returns true on success.
+//
+bool fn(delete)(Self * list) {
+    ensure(list, false);
+
+    // Pending towers go back to the free lists, then every arena goes at once.
+    if (list->ebr) Ebr_delete(list->ebr);
+    for (size_t i = 0; list->threads and i < list->_threads; i++)
+        if (list->threads[i].arena) Arena_delete(list->threads[i].arena);
+    Arena_delete(list->arena);
+    ARRAY_FREE(list);
+    return true;
+}
+
+// SkipList >> new(threads: size_t) -> *SkipList<K, V>
+//
+// Creates an empty list for up to ``threads`` concurrent threads.
+//
+// Parameters
+// ----------
+// threads : size_t
+//     The number of thread indices, e.g. ``ThreadPool_workers(pool)``.
+//
+// Returns
+// -------
+// *SkipList<K, V>: A pointer to the new list, or NULL on failure.
+//
+Self * fn(new)(size_t threads) {
+    ensure(threads > 0, NULL);
+
+    Self * list = ARRAY_MALLOC(sizeof(Self));
+    ensure(list, NULL);
+
+    list->_threads = threads;
+    list->threads = NULL;
+    list->ebr = NULL;
+    list->arena = Arena_new(0);
+    atomic_init(&list->_levels, 1);
+    if (not list->arena) {
+        ARRAY_FREE(list);
+        return NULL;
+    }
+
+    size_t head = sizeof(fn(_Node)) + SKIPLIST_MAX_HEIGHT * sizeof(uintptr_t);
+    list->head = Arena_alloc(list->arena, head, 64);
+    list->threads = Arena_alloc(list->arena, threads * sizeof(fn(_Thread)), 64);
+    list->ebr = Ebr_new(threads);
+    if (not list->head or not list->threads or not list->ebr) {
+        list->threads = NULL;
+        fn(delete)(list);
+        return NULL;
+    }
+
+    list->head->height = SKIPLIST_MAX_HEIGHT;
+    for (size_t level = 0; level < SKIPLIST_MAX_HEIGHT; level++) atomic_init(&list->head->next[level], 0);
+
+    bool ok = true;
+    for (size_t i = 0; i < threads; i++) {
+        fn(_Thread) * thread = &list->threads[i];
+        memset(thread, 0, sizeof(fn(_Thread)));
+        atomic_init(&thread->count, 0);
+        atomic_init(&thread->returned, 0);
+        thread->random = (i + 1) * 0x9e3779b97f4a7c15ull;
+        thread->arena = Arena_new(0);
+        ok = ok and thread->arena;
+    }
+    if (not ok) {
+        fn(delete)(list);
+        return NULL;
+    }
+    return list;
+}
+
+// SkipList >> size(list: *SkipList<K, V>) -> size_t
+//
+// Returns the number of entries. While other threads write,
+// it is only a snapshot of a moving count.
+//
+size_t fn(size)(Self * list) {
+    ensure(list, 0);
+
+    int64_t size = 0;
+    for (size_t i = 0; i < list->_threads; i++)
+        size += atomic_load_explicit(&list->threads[i].count, memory_order_relaxed);
+    return size > 0 ? (size_t) size : 0;
+}
+
+
+// ~~~~~~~~ Lookup and Updates ~~~~~~~~
+
+// SkipList >> get(list: *SkipList<K, V>, thread: size_t, key: K, value: *V) -> bool
+//
+// Looks a key up, without taking any lock or writing shared memory.
+//
+// Parameters
+// ----------
+// list : *SkipList<K, V>
+//     The list to search.
+// thread : size_t
+//     The index of the calling thread.
+// key : K
+//     The key to look up.
+// value : *V
+//     Receives a copy of the value, may be NULL.
+//
+// Returns
+// -------
+// bool: Returns true if the key is in the list.
+//
+bool fn(get)(Self * list, size_t thread, K key, V * value) {
+    ensure(list and thread < list->_threads, false);
+
+    Ebr_enter(list->ebr, thread);
+    fn(_Node) * node = fn(_lower)(list, key);
+    bool found = node and not LESS_K(key, node->key) and not fn(_removed)(node);
+    if (found and value) *value = node->value;
+    Ebr_exit(list->ebr, thread);
+    return found;
+}
+
+// SkipList >> contains(list: *SkipList<K, V>, thread: size_t, key: K) -> bool
+//
+// Returns true if the key is in the list.
+//
+bool fn(contains)(Self * list, size_t thread, K key) {
+    return fn(get)(list, thread, key, NULL);
+}
+
+// SkipList >> insert(list: *SkipList<K, V>, thread: size_t, key: K, value: V) -> bool
+//
+// Inserts an entry, unless the key is already there.
+// Values are never overwritten, so readers always see whole values.
+//
+// Returns
+// -------
+// bool: Returns true if the entry was inserted,
+//       false if the key was present or the allocation failed.
+//
+bool fn(insert)(Self * list, size_t thread, K key, V value) {
+    ensure(list and thread < list->_threads, false);
+
+    fn(_Thread) * self = &list->threads[thread];
+    fn(_Node) * preds[SKIPLIST_MAX_HEIGHT], * succs[SKIPLIST_MAX_HEIGHT];
+    uint32_t height = fn(_height)(self);
+    uint32_t levels = atomic_load(&list->_levels);
+    while (levels < height and not atomic_compare_exchange_weak(&list->_levels, &levels, height)) {}
+
+    Ebr_enter(list->ebr, thread);
+    fn(_Node) * node = NULL;
+    while (true) {
+        if (fn(_find)(list, key, false, preds, succs)) {
+            if (node) {
+                atomic_store_explicit(&node->next[0], (uintptr_t) self->free[height - 1], memory_order_relaxed);
+                self->free[height - 1] = node;
+            }
+            Ebr_exit(list->ebr, thread);
+            return false;
+        }
+
+        if (not node) {
+            node = fn(_node)(self, height);
+            if (not node) {
+                Ebr_exit(list->ebr, thread);
+                return false;
+            }
+            node->key = key;
+            node->value = value;
+            atomic_store_explicit(&node->holds, 2, memory_order_relaxed);
+        }
+
+        for (size_t level = 0; level < height; level++)
+            atomic_store_explicit(&node->next[level], (uintptr_t) succs[level], memory_order_relaxed);
+        uintptr_t expected = (uintptr_t) succs[0];
+        if (atomic_compare_exchange_strong(&preds[0]->next[0], &expected, (uintptr_t) node)) break;
+    }
+
+    // The entry is in; the upper levels only speed up searches.
+    bool removed = false;
+    for (size_t level = 1; level < height and not removed; level++) {
+        while (true) {
+            uintptr_t link = atomic_load(&node->next[level]);
+            if ((removed = link & _SKIPLIST_MARK)) break;
+            if (link != (uintptr_t) succs[level]
+                and not atomic_compare_exchange_strong(&node->next[level], &link, (uintptr_t) succs[level]))
+                continue;
+
+            uintptr_t expected = (uintptr_t) succs[level];
+            if (atomic_compare_exchange_strong(&preds[level]->next[level], &expected, (uintptr_t) node)) break;
+            fn(_find)(list, key, false, preds, succs);
+        }
+    }
+
+    // A racing ``remove`` may have missed the levels linked after its unlinking.
+    if (fn(_removed)(node)) fn(_find)(list, key, true, preds, succs);
+    fn(_release)(list, thread, node);
+
+    atomic_fetch_add_explicit(&self->count, 1, memory_order_relaxed);
+    Ebr_exit(list->ebr, thread);
+    return true;
+}
+
+// SkipList >> remove(list: *SkipList<K, V>, thread: size_t, key: K) -> bool
+//
+// Removes an entry. Its tower is reused once no thread can still see it.
+//
+// Returns
+// -------
+// bool: Returns true if this call removed the key.
+//
+bool fn(remove)(Self * list, size_t thread, K key) {
+    ensure(list and thread < list->_threads, false);
+
+    fn(_Thread) * self = &list->threads[thread];
+    fn(_Node) * preds[SKIPLIST_MAX_HEIGHT], * succs[SKIPLIST_MAX_HEIGHT];
+    Ebr_enter(list->ebr, thread);
+    if (not fn(_find)(list, key, false, preds, succs)) {
+        Ebr_exit(list->ebr, thread);
+        return false;
+    }
+
+    // Upper levels first, so the tower never looks present without its base.
+    fn(_Node) * node = succs[0];
+    for (size_t level = node->height; level-- > 1;) {
+        uintptr_t link = atomic_load(&node->next[level]);
+        while (not (link & _SKIPLIST_MARK)
+            and not atomic_compare_exchange_weak(&node->next[level], &link, link | _SKIPLIST_MARK)) {}
+    }
+
+    // Marking the base decides which thread removed the entry.
+    uintptr_t link = atomic_load(&node->next[0]);
+    while (true) {
+        if (link & _SKIPLIST_MARK) {
+            Ebr_exit(list->ebr, thread);
+            return false;
+        }
+        if (atomic_compare_exchange_weak(&node->next[0], &link, link | _SKIPLIST_MARK)) break;
+    }
+
+    fn(_find)(list, key, true, preds, succs);
+    atomic_fetch_sub_explicit(&self->count, 1, memory_order_relaxed);
+    fn(_release)(list, thread, node);
+    Ebr_exit(list->ebr, thread);
+    return true;
+}
+
+
+// ~~~~~~~~ Iteration ~~~~~~~~
+
+// SkipList >> iterate(list: *SkipList<K, V>, thread: size_t) -> SkipList<K, V>.Iterator
+//
+// Returns an iterator over every entry, in key order.
+// See ``range`` for the guarantees.
+//
+fn(Iterator) fn(iterate)(Self * list, size_t thread) {
+    fn(Iterator) iterator = { .list = NULL, .thread = thread, .node = NULL, .bounded = false };
+    ensure(list and thread < list->_threads, iterator);
+
+    iterator.list = list;
+    Ebr_enter(list->ebr, thread);
+    iterator.node = fn(_pointer)(atomic_load_explicit(&list->head->next[0], memory_order_acquire));
+    return iterator;
+}
+
+// SkipList >> range(list: *SkipList<K, V>, thread: size_t, low: K, high: K) -> SkipList<K, V>.Iterator
+//
+// Returns an iterator over the entries with keys in ``[low, high)``,
+// in key order. Concurrent inserts and removals are safe: the scan
+// sees every entry that stays in the list while it runs, in order,
+// and may or may not see entries inserted or removed meanwhile.
+//
+// The iterator stays in an Ebr critical section until ``next`` returns
+// false or ``done`` is called. The same thread may use the list meanwhile.
+//
+fn(Iterator) fn(range)(Self * list, size_t thread, K low, K high) {
+    fn(Iterator) iterator = { .list = NULL, .thread = thread, .node = NULL, .high = high, .bounded = true };
+    ensure(list and thread < list->_threads, iterator);
+
+    iterator.list = list;
+    Ebr_enter(list->ebr, thread);
+    iterator.node = fn(_lower)(list, low);
+    return iterator;
+}
+
+// SkipList >> done(iterator: *SkipList<K, V>.Iterator) -> void
+//
+// Ends a scan early, leaving its critical section. Safe to call more than once.
+//
+void fn(done)(fn(Iterator) * iterator) {
+    ensure(iterator and iterator->list,);
+
+    Ebr_exit(iterator->list->ebr, iterator->thread);
+    iterator->list = NULL;
+    iterator->node = NULL;
+}
+
+// SkipList >> next(iterator: *SkipList<K, V>.Iterator, key: *K, value: *V) -> bool
+//
+// Moves to the next entry, copying it out. ``key`` and ``value`` may be NULL.
+//
+// Returns
+// -------
+// bool: Returns true and fills ``key`` and ``value`` with the next entry,
+//       or false once the range is over.
+//
+bool fn(next)(fn(Iterator) * iterator, K * key, V * value) {
+    ensure(iterator and iterator->list, false);
+
+    fn(_Node) * node = iterator->node;
+    while (node and fn(_removed)(node))
+        node = fn(_pointer)(atomic_load_explicit(&node->next[0], memory_order_acquire));
+
+    if (not node or (iterator->bounded and not LESS_K(node->key, iterator->high))) {
+        fn(done)(iterator);
+        return false;
+    }
+
+    if (key) *key = node->key;
+    if (value) *value = node->value;
+    iterator->node = fn(_pointer)(atomic_load_explicit(&node->next[0], memory_order_acquire));
+    return true;
+}
+
+
+// ~~~~~~~~ Printing ~~~~~~~~
+
+// SkipList >> print(list: *SkipList<K, V>) -> void
+//
+// Prints the entries on terminal, in key order.
+// No other thread may remove entries meanwhile.
+//
+void fn(print)(Self * list) {
+    ensure(list,);
+
+    bool first = true;
+    printf("{");
+    for (fn(_Node) * node = fn(_pointer)(atomic_load(&list->head->next[0])); node;
+         node = fn(_pointer)(atomic_load(&node->next[0]))) {
+        if (fn(_removed)(node)) continue;
+        if (not first) printf(", ");
+        PRINT_K(node->key);
+        printf(": ");
+        PRINT_V(node->value);
+        first = false;
+    }
+    printf("}");
+}
+
+// SkipList >> println(list: *SkipList<K, V>) -> void
+//
+// Prints the entries on terminal followed by a newline.
+//
+void fn(println)(Self * list) {
+    fn(print)(list);
+    printf("\n");
+}
+
+// SkipList >> debug(list: *SkipList<K, V>) -> void
+//
+// Prints the debug representation of the list.
+// No other thread may remove entries meanwhile.
+//
+void fn(debug)(Self * list) {
+    if (not list) {
+        printf("SkipList<%s, %s> { NULL }\n", TOSTRING(K), TOSTRING(V));
+        return;
+    }
+
+    size_t memory = 0;
+    for (size_t i = 0; i < list->_threads; i++) memory += Arena_allocated(list->threads[i].arena);
+
+    printf("SkipList<%s, %s> {\n", TOSTRING(K), TOSTRING(V));
+    printf("  size: %zu,\n", fn(size)(list));
+    printf("  threads: %zu,\n", list->_threads);
+    printf("  levels: %u,\n", atomic_load(&list->_levels));
+    printf("  epoch: %llu,\n", (unsigned long long) Ebr_epoch(list->ebr));
+    printf("  pending: %zu,\n", Ebr_pending(list->ebr));
+    printf("  memory: %zu,\n", memory);
+    printf("  data: "); fn(println)(list);
+    printf("}\n");
+}
+
+#undef MODULE
+#undef Self
+#undef fn
+#undef K
+#undef V
+#undef PRINT_K
+#undef PRINT_V
+#undef LESS_K
@@ -0,0 +1,79 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <time.h>
+
+#include "soa.h"
+
+// A 64-byte record.
+SOA(Particle,
+    (double, x), (double, y), (double, z),
+    (double, vx), (double, vy), (double, vz), (double, charge),
+    (float, mass), (int, id))
+
+#define T Particle
+#define PRINT_T(value) printf("#%d", value.id)
+#include "../array/array.h"
+
+SOA_ARRAY(Particle)
+
+double seconds() {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec + now.tv_nsec * 1e-9;
+}
+
+int main() {
+
+    size_t size = 2000000;
+    Array(Particle) * particles = Array(Particle, new)(size);
+    for (size_t i = 0; i < size; i++) {
+        Array(Particle, set)(particles, i, (Particle) {
+            .x = (double) i, .y = 1.0, .z = 2.0, .mass = 1.5f, .id = (int) i
+        });
+    }
+
+    SoA(Particle) * columns = SoA(Particle, from_array)(particles);
+
+    // Scanning a single field: one cache line per 8 values, instead of 1.
+    int rounds = 10;
+    double aos_sum = 0.0, soa_sum = 0.0;
+
+    double start = seconds();
+    for (int round = 0; round < rounds; round++)
+        for (size_t i = 0; i < size; i++) aos_sum += particles->data[i].x;
+    double aos = seconds() - start;
+
+    start = seconds();
+    for (int round = 0; round < rounds; round++) {
+        const double * xs = columns->x;
+        for (size_t i = 0; i < SoA(Particle, size)(columns); i++) soa_sum += xs[i];
+    }
+    double soa = seconds() - start;
+
+    printf("record: %zu bytes\n", sizeof(Particle));
+    printf("sum(x) AoS: %.3fs, SoA: %.3fs (%.2fx), %s\n",
+        aos, soa, aos / soa, aos_sum == soa_sum ? "same result" : "mismatch");
+
+    // Rows are views into the columns.
+    SoA(Particle, Row) row = SoA(Particle, row)(columns, 3);
+    *row.vx = 9.5;
+
+    Particle third;
+    SoA(Particle, get)(columns, 3, &third);
+    printf("particle #%d: vx = %g\n", third.id, third.vx);
+
+    Array(Particle) * back = SoA(Particle, to_array)(columns);
+    printf("round trip vx: %g\n", Array(Particle, get)(back, 3)->vx);
+
+    SoA(Particle) * few = SoA(Particle, new)(2);
+    SoA(Particle, set)(few, 1, (Particle) { .x = 0.5, .mass = 2.0f, .id = 42 });
+    SoA(Particle, debug)(few);
+
+    SoA(Particle, delete)(few);
+    SoA(Particle, delete)(columns);
+    Array(Particle, delete)(back);
+    Array(Particle, delete)(particles);
+    return 0;
+
+}
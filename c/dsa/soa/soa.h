@@ -0,0 +1,338 @@
+// ===========
+// SoA<Record>
+// ===========
+//
+// :Author: RickBarretto
+// :Year: 2026
+// :License: MPL 2.0
+// :Copyright: RickBarretto, 2026
+// :Version: 1.0
+//
+// ``SOA(Name, (type, field)...)`` generates a record type ``Name``
+// together with ``SoA<Name>``, a struct-of-arrays container
+// that keeps one contiguous column per field.
+//
+// ``Array<T>`` is an array-of-structs: scanning a single field of a
+// 64-byte record wastes most of every cache line it loads.
+// ``SoA<Name>`` loads only the column being scanned,
+// and each column is a plain ``type *`` of ``size`` elements,
+// so it may be handed as is to any kernel that takes a pointer and a count
+// (``Codec_compress``, ``PackedArray(T, new)``, ``QuantArray_new``...).
+//
+// How to Use
+// ----------
+//
+// Declare the record once, at file scope:
+//
+//      #include "soa.h"
+//
+//      SOA(Particle,
+//          (double, x), (double, y), (double, z), (int, id))
+//
+// This gives ``Particle`` (the record), ``SoA(Particle)`` (the container)
+// and ``SoA(Particle, Row)`` (a view of pointers into one row).
+// Each function is namespaced under SoA<Name>,
+// i.e. ``SoA(Particle, new)`` is the same as ``SoA_Particle_new``.
+//
+//      SoA(Particle) * particles = SoA(Particle, new)(1000);
+//      SoA(Particle, set)(particles, 0, (Particle) { .x = 1.0, .id = 7 });
+//
+//      SoA(Particle, Row) row = SoA(Particle, row)(particles, 0);
+//      *row.x += 1.0;
+//
+//      double * xs = particles->x;     // a single column
+//
+// Converting from and to ``Array<Name>`` needs the Array instantiated
+// for the record, so it is generated separately:
+//
+//      #define T Particle
+//      #define PRINT_T(value) printf("%d", value.id)
+//      #include "../array/array.h"
+//
+//      SOA_ARRAY(Particle)
+//
+// Up to 16 fields are supported.
+// Fields are printed through ``_Generic`` for the builtin scalar types
+// and ``char *``; other types print as ``?``.
+//
+
+#ifndef SOA_H
+#define SOA_H
+
+// =~=~=~=~=~=~=~=~ Imports ~=~=~=~=~=~=~=~=
+
+#include <iso646.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+
+// =~=~=~=~=~=~=~=~ Helper Macros ~=~=~=~=~=~=~=~=
+
+#define _CAT(X, Y) X ## _ ## Y
+#define CAT(X, Y) _CAT(X, Y)
+#define _CAT3(X, Y, Z) X ## _ ## Y ## _ ## Z
+#define CAT3(X, Y, Z) _CAT3(X, Y, Z)
+
+#define STRINGIFY(x) #x
+#define TOSTRING(x) STRINGIFY(x)
+
+#define ensure(COND, VAL) if (not (COND)) return VAL
+
+// _SOA_EACH(M, (type, field)...) -> M((type, field)) ...
+#define _SOA_COUNT(...) _SOA_COUNT_(__VA_ARGS__, \
+    16, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1)
+#define _SOA_COUNT_(_1, _2, _3, _4, _5, _6, _7, _8, \
+    _9, _10, _11, _12, _13, _14, _15, _16, N, ...) N
+
+#define _SOA_EACH(M, ...) CAT(_SOA_EACH, _SOA_COUNT(__VA_ARGS__))(M, __VA_ARGS__)
+#define _SOA_EACH_1(M, X) M X
+#define _SOA_EACH_2(M, X, ...) M X _SOA_EACH_1(M, __VA_ARGS__)
+#define _SOA_EACH_3(M, X, ...) M X _SOA_EACH_2(M, __VA_ARGS__)
+#define _SOA_EACH_4(M, X, ...) M X _SOA_EACH_3(M, __VA_ARGS__)
+#define _SOA_EACH_5(M, X, ...) M X _SOA_EACH_4(M, __VA_ARGS__)
+#define _SOA_EACH_6(M, X, ...) M X _SOA_EACH_5(M, __VA_ARGS__)
+#define _SOA_EACH_7(M, X, ...) M X _SOA_EACH_6(M, __VA_ARGS__)
+#define _SOA_EACH_8(M, X, ...) M X _SOA_EACH_7(M, __VA_ARGS__)
+#define _SOA_EACH_9(M, X, ...) M X _SOA_EACH_8(M, __VA_ARGS__)
+#define _SOA_EACH_10(M, X, ...) M X _SOA_EACH_9(M, __VA_ARGS__)
+#define _SOA_EACH_11(M, X, ...) M X _SOA_EACH_10(M, __VA_ARGS__)
+#define _SOA_EACH_12(M, X, ...) M X _SOA_EACH_11(M, __VA_ARGS__)
+#define _SOA_EACH_13(M, X, ...) M X _SOA_EACH_12(M, __VA_ARGS__)
+#define _SOA_EACH_14(M, X, ...) M X _SOA_EACH_13(M, __VA_ARGS__)
+#define _SOA_EACH_15(M, X, ...) M X _SOA_EACH_14(M, __VA_ARGS__)
+#define _SOA_EACH_16(M, X, ...) M X _SOA_EACH_15(M, __VA_ARGS__)
+
+#define _SOA_SELECT_MACRO(_1, _2, NAME, ...) NAME
+#define SoA(...) _SOA_SELECT_MACRO(__VA_ARGS__, SoA2, SoA1)(__VA_ARGS__)
+#define SoA1(Name) CAT(SoA, Name)
+#define SoA2(Name, FUNC) CAT3(SoA, Name, FUNC)
+
+
+// =~=~=~=~=~=~=~=~ Field printing ~=~=~=~=~=~=~=~=
+
+void _SoA_print_bool(const bool * value) { printf("%s", *value ? "true" : "false"); }
+void _SoA_print_char(const char * value) { printf("'%c'", *value); }
+void _SoA_print_schar(const signed char * value) { printf("%hhd", *value); }
+void _SoA_print_uchar(const unsigned char * value) { printf("%hhu", *value); }
+void _SoA_print_short(const short * value) { printf("%hd", *value); }
+void _SoA_print_ushort(const unsigned short * value) { printf("%hu", *value); }
+void _SoA_print_int(const int * value) { printf("%d", *value); }
+void _SoA_print_uint(const unsigned * value) { printf("%u", *value); }
+void _SoA_print_long(const long * value) { printf("%ld", *value); }
+void _SoA_print_ulong(const unsigned long * value) { printf("%lu", *value); }
+void _SoA_print_llong(const long long * value) { printf("%lld", *value); }
+void _SoA_print_ullong(const unsigned long long * value) { printf("%llu", *value); }
+void _SoA_print_float(const float * value) { printf("%g", *value); }
+void _SoA_print_double(const double * value) { printf("%g", *value); }
+void _SoA_print_ldouble(const long double * value) { printf("%Lg", *value); }
+void _SoA_print_str(char * const * value) { printf("%s", *value); }
+void _SoA_print_cstr(const char * const * value) { printf("%s", *value); }
+void _SoA_print_unknown(const void * value) { (void) value; printf("?"); }
+
+// SOA_PRINT_VALUE(value: lvalue) -> void
+//
+// Prints a field value, picking the format by its type.
+//
+#define SOA_PRINT_VALUE(value) _Generic((value),        \
+    bool: _SoA_print_bool,                              \
+    char: _SoA_print_char,                              \
+    signed char: _SoA_print_schar,                      \
+    unsigned char: _SoA_print_uchar,                    \
+    short: _SoA_print_short,                            \
+    unsigned short: _SoA_print_ushort,                  \
+    int: _SoA_print_int,                                \
+    unsigned: _SoA_print_uint,                          \
+    long: _SoA_print_long,                              \
+    unsigned long: _SoA_print_ulong,                    \
+    long long: _SoA_print_llong,                        \
+    unsigned long long: _SoA_print_ullong,              \
+    float: _SoA_print_float,                            \
+    double: _SoA_print_double,                          \
+    long double: _SoA_print_ldouble,                    \
+    char *: _SoA_print_str,                             \
+    const char *: _SoA_print_cstr,                      \
+    default: _SoA_print_unknown)(&(value))
+
+
+// =~=~=~=~=~=~=~=~ Per-field code ~=~=~=~=~=~=~=~=
+//
+// Every generated function uses the same local names:
+// ``soa``, ``index``, ``record``, ``records``, ``row``, ``size`` and ``ok``.
+
+#define _SOA_FIELD(TYPE, FIELD) TYPE FIELD;
+#define _SOA_COLUMN(TYPE, FIELD) TYPE * FIELD;
+#define _SOA_REF(TYPE, FIELD) TYPE * FIELD;
+#define _SOA_NAME(TYPE, FIELD) " " #FIELD
+
+#define _SOA_ALLOC(TYPE, FIELD) \
+    soa->FIELD = calloc(size ? size : 1, sizeof(TYPE)); \
+    ok = ok and soa->FIELD;
+
+#define _SOA_FREE(TYPE, FIELD) free(soa->FIELD);
+#define _SOA_POINT(TYPE, FIELD) row.FIELD = &soa->FIELD[index];
+#define _SOA_GATHER(TYPE, FIELD) record->FIELD = soa->FIELD[index];
+#define _SOA_SCATTER(TYPE, FIELD) soa->FIELD[index] = record.FIELD;
+
+#define _SOA_FROM_AOS(TYPE, FIELD) \
+    for (size_t index = 0; index < size; index++) \
+        soa->FIELD[index] = records[index].FIELD;
+
+#define _SOA_TO_AOS(TYPE, FIELD) \
+    for (size_t index = 0; index < soa->_size; index++) \
+        records[index].FIELD = soa->FIELD[index];
+
+#define _SOA_PRINT(TYPE, FIELD) \
+    printf("%s" #FIELD ": ", separator); \
+    SOA_PRINT_VALUE(soa->FIELD[index]); \
+    separator = ", ";
+
+
+// =~=~=~=~=~=~=~=~ Implementation ~=~=~=~=~=~=~=~=
+
+// SOA(Name, (type, field)...)
+//
+// Generates the record ``Name``, the container ``SoA<Name>``,
+// the row view ``SoA<Name>::Row`` and the functions below.
+//
+// SoA >> new(size: size_t) -> *SoA<Name>
+//     Creates a container of ``size`` zeroed rows.
+// SoA >> delete(soa: *SoA<Name>) -> bool
+//     Safely deletes the container and its columns.
+// SoA >> size(soa: *SoA<Name>) -> size_t
+//     Returns the number of rows.
+// SoA >> get(soa: *SoA<Name>, index: size_t, out: *Name) -> bool
+//     Gathers a row into a record. False if out of bounds.
+// SoA >> set(soa: *SoA<Name>, index: size_t, record: Name) -> bool
+//     Scatters a record into a row. False if out of bounds.
+// SoA >> row(soa: *SoA<Name>, index: size_t) -> SoA<Name>::Row
+//     Returns pointers to each field of a row.
+//     All pointers are NULL if the index is out of bounds.
+// SoA >> from_aos(records: *Name, size: size_t) -> *SoA<Name>
+//     Bulk conversion from a plain array of records, column by column.
+// SoA >> to_aos(soa: *SoA<Name>, records: *Name) -> bool
+//     Bulk conversion into a plain array of ``size`` records.
+// SoA >> print / println / debug(soa: *SoA<Name>) -> void
+//     Same output conventions as ``Array<T>``.
+//
+#define SOA(Name, ...) \
+    typedef struct { _SOA_EACH(_SOA_FIELD, __VA_ARGS__) } Name; \
+    typedef struct { size_t _size; _SOA_EACH(_SOA_COLUMN, __VA_ARGS__) } SoA(Name); \
+    typedef struct { _SOA_EACH(_SOA_REF, __VA_ARGS__) } SoA(Name, Row); \
+    \
+    bool SoA(Name, delete)(SoA(Name) * soa) { \
+        ensure(soa, false); \
+        _SOA_EACH(_SOA_FREE, __VA_ARGS__) \
+        free(soa); \
+        return true; \
+    } \
+    \
+    SoA(Name) * SoA(Name, new)(size_t size) { \
+        SoA(Name) * soa = calloc(1, sizeof(SoA(Name))); \
+        ensure(soa, NULL); \
+        \
+        bool ok = true; \
+        soa->_size = size; \
+        _SOA_EACH(_SOA_ALLOC, __VA_ARGS__) \
+        if (not ok) { \
+            SoA(Name, delete)(soa); \
+            return NULL; \
+        } \
+        return soa; \
+    } \
+    \
+    size_t SoA(Name, size)(SoA(Name) * soa) { \
+        ensure(soa, 0); \
+        return soa->_size; \
+    } \
+    \
+    bool SoA(Name, get)(SoA(Name) * soa, size_t index, Name * record) { \
+        ensure(soa and record, false); \
+        ensure(index < soa->_size, false); \
+        _SOA_EACH(_SOA_GATHER, __VA_ARGS__) \
+        return true; \
+    } \
+    \
+    bool SoA(Name, set)(SoA(Name) * soa, size_t index, Name record) { \
+        ensure(soa, false); \
+        ensure(index < soa->_size, false); \
+        _SOA_EACH(_SOA_SCATTER, __VA_ARGS__) \
+        return true; \
+    } \
+    \
+    SoA(Name, Row) SoA(Name, row)(SoA(Name) * soa, size_t index) { \
+        SoA(Name, Row) row = { 0 }; \
+        ensure(soa and index < soa->_size, row); \
+        _SOA_EACH(_SOA_POINT, __VA_ARGS__) \
+        return row; \
+    } \
+    \
+    SoA(Name) * SoA(Name, from_aos)(const Name * records, size_t size) { \
+        ensure(records or size == 0, NULL); \
+        SoA(Name) * soa = SoA(Name, new)(size); \
+        ensure(soa, NULL); \
+        _SOA_EACH(_SOA_FROM_AOS, __VA_ARGS__) \
+        return soa; \
+    } \
+    \
+    bool SoA(Name, to_aos)(SoA(Name) * soa, Name * records) { \
+        ensure(soa and records, false); \
+        _SOA_EACH(_SOA_TO_AOS, __VA_ARGS__) \
+        return true; \
+    } \
+    \
+    void SoA(Name, print)(SoA(Name) * soa) { \
+        ensure(soa,); \
+        printf("["); \
+        for (size_t index = 0; index < soa->_size; index++) { \
+            const char * separator = ""; \
+            printf("{"); \
+            _SOA_EACH(_SOA_PRINT, __VA_ARGS__) \
+            printf("}"); \
+            if (index < soa->_size - 1) printf(", "); \
+        } \
+        printf("]"); \
+    } \
+    \
+    void SoA(Name, println)(SoA(Name) * soa) { \
+        SoA(Name, print)(soa); \
+        printf("\n"); \
+    } \
+    \
+    void SoA(Name, debug)(SoA(Name) * soa) { \
+        if (not soa) { \
+            printf("SoA<%s> { NULL }\n", #Name); \
+            return; \
+        } \
+        printf("SoA<%s> {\n", #Name); \
+        printf("  size: %zu,\n", soa->_size); \
+        printf("  columns:" _SOA_EACH(_SOA_NAME, __VA_ARGS__) ",\n"); \
+        printf("  data: "); SoA(Name, println)(soa); \
+        printf("}\n"); \
+    }
+
+// SOA_ARRAY(Name)
+//
+// Generates the conversions between ``SoA<Name>`` and ``Array<Name>``.
+// ``Array<Name>`` must be included before.
+//
+// SoA >> from_array(array: *Array<Name>) -> *SoA<Name>
+//     Copies an array of records into a new container.
+// SoA >> to_array(soa: *SoA<Name>) -> *Array<Name>
+//     Copies the container into a new array of records.
+//
+#define SOA_ARRAY(Name) \
+    SoA(Name) * SoA(Name, from_array)(Array(Name) * array) { \
+        ensure(array, NULL); \
+        return SoA(Name, from_aos)(array->data, Array(Name, size)(array)); \
+    } \
+    \
+    Array(Name) * SoA(Name, to_array)(SoA(Name) * soa) { \
+        ensure(soa, NULL); \
+        Array(Name) * array = Array(Name, new)(soa->_size); \
+        ensure(array, NULL); \
+        SoA(Name, to_aos)(soa, array->data); \
+        return array; \
+    }
+
+#endif
@@ -0,0 +1,152 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <time.h>
+
+#define T size_t
+#define PRINT_T(value) printf("%zu", value)
+#include "../array/array.h"
+
+#define T uint32_t
+#define PRINT_T(value) printf("%u", value)
+#include "../array/array.h"
+
+#define T double
+#define PRINT_T(value) printf("%g", value)
+#include "../array/array.h"
+
+#define T double
+#define PRINT_T(value) printf("%g", value)
+#include "sparse_matrix.h"
+
+double seconds() {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec + now.tv_nsec * 1e-9;
+}
+
+uint64_t next_random(uint64_t * seed) {
+    *seed = *seed * 6364136223846793005ull + 1442695040888963407ull;
+    return *seed >> 33;
+}
+
+// Read bandwidth of a plain sequential sum, as the ceiling for SpMV.
+double stream_bandwidth(size_t size) {
+    double * values = malloc(size * sizeof(double));
+    for (size_t i = 0; i < size; i++) values[i] = 1.0;
+
+    double start = seconds(), sum = 0.0;
+    for (int round = 0; round < 4; round++)
+        for (size_t i = 0; i < size; i++) sum += values[i];
+    double elapsed = seconds() - start;
+
+    free(values);
+    return sum > 0 ? 4.0 * size * sizeof(double) / elapsed / 1e9 : 0.0;
+}
+
+int main() {
+
+    // (row, col, value), with (1, 2) given twice.
+    uint32_t coo_rows[] = { 3, 0, 1, 1, 2, 1 };
+    uint32_t coo_cols[] = { 3, 0, 2, 0, 1, 2 };
+    double coo_values[] = { 4, 1, 2, 3, 5, 0.5 };
+
+    Array(uint32_t) * rows = Array(uint32_t, new)(6);
+    Array(uint32_t) * cols = Array(uint32_t, new)(6);
+    Array(double) * values = Array(double, new)(6);
+    for (size_t i = 0; i < 6; i++) {
+        rows->data[i] = coo_rows[i];
+        cols->data[i] = coo_cols[i];
+        values->data[i] = coo_values[i];
+    }
+
+    SparseMatrix(double) * small = SparseMatrix(double, from_coo)(SPARSE_CSR, 4, 4, rows, cols, values);
+    SparseMatrix(double) * by_column = SparseMatrix(double, convert)(small, SPARSE_CSC);
+    SparseMatrix(double, debug)(small);
+    SparseMatrix(double, debug)(by_column);
+    printf("a[1][2] = %g, a[2][2] = %g\n\n",
+        SparseMatrix(double, get)(small, 1, 2), SparseMatrix(double, get)(small, 2, 2));
+
+    SparseMatrix(double, delete)(small);
+    SparseMatrix(double, delete)(by_column);
+    Array(uint32_t, delete)(rows);
+    Array(uint32_t, delete)(cols);
+    Array(double, delete)(values);
+
+    // 1M x 1M, ~16M nonzeros, with 1% of the rows 30x denser than the rest.
+    size_t n = 1 << 20;
+    uint64_t seed = 5;
+    size_t nnz = 0;
+    for (size_t row = 0; row < n; row++) nnz += row % 100 == 0 ? 400 : 12;
+
+    rows = Array(uint32_t, new)(nnz);
+    cols = Array(uint32_t, new)(nnz);
+    values = Array(double, new)(nnz);
+    for (size_t row = 0, at = 0; row < n; row++) {
+        size_t count = row % 100 == 0 ? 400 : 12;
+        for (size_t k = 0; k < count; k++, at++) {
+            rows->data[at] = (uint32_t) row;
+            cols->data[at] = (uint32_t) (next_random(&seed) % n);
+            values->data[at] = 1.0 / (1 + next_random(&seed) % 8);
+        }
+    }
+
+    double start = seconds();
+    SparseMatrix(double) * csr = SparseMatrix(double, from_coo)(SPARSE_CSR, n, n, rows, cols, values);
+    double build = seconds() - start;
+    SparseMatrix(double) * csc = SparseMatrix(double, convert)(csr, SPARSE_CSC);
+    Array(uint32_t, delete)(rows);
+    Array(uint32_t, delete)(cols);
+    Array(double, delete)(values);
+
+    Array(double) * x = Array(double, new)(n);
+    Array(double) * y = Array(double, new)(n);
+    Array(double) * check = Array(double, new)(n);
+    for (size_t i = 0; i < n; i++) x->data[i] = 1.0 + (double) (i % 7);
+
+    ThreadPool * pool = ThreadPool_new(0);
+    nnz = SparseMatrix(double, nnz)(csr);
+    double bytes = nnz * (sizeof(double) + sizeof(uint32_t))
+        + (n + 1) * sizeof(size_t) + 2.0 * n * sizeof(double);
+    double stream = stream_bandwidth((size_t) 1 << 25);
+
+#ifdef SPARSE_MATRIX_AVX2
+    const char * dot = "AVX2 gather";
+#else
+    const char * dot = "scalar";
+#endif
+    printf("%zu x %zu, %zu nonzeros, built from COO in %.2f s\n", n, n, nnz, build);
+    printf("%zu workers, %s dot, sequential read bandwidth %.1f GB/s\n\n",
+        ThreadPool_workers(pool), dot, stream);
+
+    SparseMatrix(double) * formats[] = { csr, csc };
+    const char * names[] = { "CSR", "CSC" };
+    for (size_t f = 0; f < 2; f++) {
+        SparseMatrix(double, spmv)(formats[f], x, f ? check : y, pool);
+
+        int rounds = 10;
+        start = seconds();
+        for (int round = 0; round < rounds; round++)
+            SparseMatrix(double, spmv)(formats[f], x, f ? check : y, pool);
+        double elapsed = (seconds() - start) / rounds;
+
+        printf("%s spmv: %6.2f ms, %5.2f GFLOPS, %5.1f GB/s (%3.0f%% of stream)\n",
+            names[f], elapsed * 1e3, 2.0 * nnz / elapsed / 1e9,
+            bytes / elapsed / 1e9, 100.0 * bytes / elapsed / 1e9 / stream);
+    }
+
+    double error = 0.0;
+    for (size_t i = 0; i < n; i++) error = fmax(error, fabs(y->data[i] - check->data[i]));
+    printf("max |CSR - CSC| = %.2e\n", error);
+
+    SparseMatrix(double, delete)(csr);
+    SparseMatrix(double, delete)(csc);
+    Array(double, delete)(x);
+    Array(double, delete)(y);
+    Array(double, delete)(check);
+    ThreadPool_delete(pool);
+    return 0;
+
+}
@@ -0,0 +1,634 @@
+// ===============
+// SparseMatrix<T>
+// ===============
+//
+// :Author: RickBarretto
+// :Year: 2026
+// :License: MPL 2.0
+// :Copyright: RickBarretto, 2026
+// :Version: 1.0
+//
+// ``SparseMatrix<T>`` stores only the nonzeros of a matrix,
+// in CSR (compressed rows) or CSC (compressed columns) form,
+// as three Arrays:
+//
+// - ``offsets``: ``Array<size_t>``, where the entries of row (or column)
+//   ``i`` are at ``[offsets[i], offsets[i + 1])``.
+// - ``indices``: ``Array<uint32_t>``, the column (or row) of each entry,
+//   sorted inside each row (or column).
+// - ``values``: ``Array<T>``, the value of each entry.
+//
+// Matrices are built from COO triplets with a counting sort:
+// one pass counts the entries of each row, a prefix sum turns the
+// counts into ``offsets``, and a second pass scatters the entries.
+// Duplicated coordinates are summed.
+//
+// ``spmv`` computes ``y = A x`` on a ``ThreadPool``.
+// For CSR, every task gets a range of rows with the same number of
+// nonzeros, found by binary searching ``offsets``, so a few dense rows
+// do not leave the other workers idle. CSC tasks scatter into private
+// copies of ``y``, which are then summed.
+// When compiled with AVX2 and FMA, ``SparseMatrix<double>`` gathers
+// the ``x`` values with ``vgatherdpd``.
+//
+// Dimensions are limited to 2^31 - 1, so indices fit 32 bits.
+//
+// How to Use
+// ----------
+//
+// Include ``Array<size_t>``, ``Array<uint32_t>`` and ``Array<T>`` first,
+// then this header:
+//
+//      #define T size_t
+//      #define PRINT_T(value) printf("%zu", value)
+//      #include "../array/array.h"
+//
+//      #define T uint32_t
+//      #define PRINT_T(value) printf("%u", value)
+//      #include "../array/array.h"
+//
+//      #define T double
+//      #define PRINT_T(value) printf("%g", value)
+//      #include "../array/array.h"
+//
+//      #define T double
+//      #define PRINT_T(value) printf("%g", value)
+//      #include "sparse_matrix.h"
+//
+// And a common way to use it would be:
+//
+//      SparseMatrix(double) * a = SparseMatrix(double, from_coo)(
+//          SPARSE_CSR, rows, cols, row_indices, col_indices, values);
+//      SparseMatrix(double, spmv)(a, x, y, pool);
+//      SparseMatrix(double) * columns = SparseMatrix(double, convert)(a, SPARSE_CSC);
+//
+// Link with ``-pthread``.
+//
+
+// =~=~=~=~=~=~=~=~ Imports ~=~=~=~=~=~=~=~=
+
+#include <iso646.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../thread_pool/thread_pool.h"
+
+
+// =~=~=~=~=~=~=~=~ Helper Macros ~=~=~=~=~=~=~=~=
+
+#define _CAT(X, Y) X ## _ ## Y
+#define CAT(X, Y) _CAT(X, Y)
+#define _CAT3(X, Y, Z) X ## _ ## Y ## _ ## Z
+#define CAT3(X, Y, Z) _CAT3(X, Y, Z)
+
+#define STRINGIFY(x) #x
+#define TOSTRING(x) STRINGIFY(x)
+
+#define ensure(COND, VAL) if (not (COND)) return VAL
+
+
+// =~=~=~=~=~=~=~=~ Shared helpers ~=~=~=~=~=~=~=~=
+
+#ifndef SPARSE_MATRIX_HELPERS
+#define SPARSE_MATRIX_HELPERS
+
+// SPARSE_TASKS_PER_WORKER: CSR row ranges per worker.
+#define SPARSE_TASKS_PER_WORKER 4
+
+// SPARSE_MAX_DIM: Largest number of rows or columns.
+#define SPARSE_MAX_DIM ((size_t) INT32_MAX)
+
+typedef enum {
+    SPARSE_CSR,
+    SPARSE_CSC,
+} SparseFormat;
+
+// First ``i`` in [0, size] with ``offsets[i] >= target``.
+size_t _SparseMatrix_lower_bound(const size_t * offsets, size_t size, size_t target) {
+    size_t low = 0, high = size;
+    while (low < high) {
+        size_t middle = low + (high - low) / 2;
+        if (offsets[middle] < target) low = middle + 1;
+        else high = middle;
+    }
+    return low;
+}
+
+#if defined(__AVX2__) && defined(__FMA__)
+#include <immintrin.h>
+#define SPARSE_MATRIX_AVX2 1
+
+// Sum of ``values[i] * x[indices[i]]``, 8 gathers in flight.
+double _SparseMatrix_dot_f64(const double * values, const uint32_t * indices,
+                             size_t count, const double * x) {
+    __m256d acc0 = _mm256_setzero_pd(), acc1 = _mm256_setzero_pd();
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m128i low = _mm_loadu_si128((const __m128i *) (indices + i));
+        __m128i high = _mm_loadu_si128((const __m128i *) (indices + i + 4));
+        acc0 = _mm256_fmadd_pd(_mm256_loadu_pd(values + i), _mm256_i32gather_pd(x, low, 8), acc0);
+        acc1 = _mm256_fmadd_pd(_mm256_loadu_pd(values + i + 4), _mm256_i32gather_pd(x, high, 8), acc1);
+    }
+
+    __m256d acc = _mm256_add_pd(acc0, acc1);
+    __m128d half = _mm_add_pd(_mm256_castpd256_pd128(acc), _mm256_extractf128_pd(acc, 1));
+    double sum = _mm_cvtsd_f64(_mm_add_sd(half, _mm_unpackhi_pd(half, half)));
+
+    for (; i < count; i++) sum += values[i] * x[indices[i]];
+    return sum;
+}
+#endif
+
+#endif
+
+
+// =~=~=~=~=~=~=~=~ Implementation ~=~=~=~=~=~=~=~=
+
+// T: Element type of the SparseMatrix<T>, a numeric type.
+#ifndef T
+#error "T is not defined"
+#endif
+
+// PRINT_T: (T) -> void
+//
+// PRINT_T is a macro that defines how to print an element of type T.
+// See ``Array<T>`` for more details.
+//
+#ifndef PRINT_T
+#error "PRINT_T is not defined"
+#endif
+
+#define MODULE SparseMatrix
+#define Self CAT(MODULE, T)
+#define fn(NAME) CAT(Self, NAME)
+
+#define _SPARSE_MATRIX_SELECT_MACRO(_1, _2, NAME, ...) NAME
+#define SparseMatrix(...) _SPARSE_MATRIX_SELECT_MACRO(__VA_ARGS__, SparseMatrix2, SparseMatrix1)(__VA_ARGS__)
+#define SparseMatrix1(T) CAT(SparseMatrix, T)
+#define SparseMatrix2(T, FUNC) CAT3(SparseMatrix, T, FUNC)
+
+typedef struct {
+    SparseFormat format;
+    size_t _rows;
+    size_t _cols;
+    Array(size_t) * offsets;
+    Array(uint32_t) * indices;
+    Array(T) * values;
+} Self;
+
+typedef struct {
+    uint32_t index;
+    T value;
+} fn(_Entry);
+
+
+// SparseMatrix >> delete(matrix: *SparseMatrix<T>) -> bool
+//
+// Safely deletes the matrix and its three Arrays.
+//
+// Returns
+// -------
+// bool: Returns true on success.
+//
+bool fn(delete)(Self * matrix) {
+    ensure(matrix, false);
+
+    Array(size_t, delete)(matrix->offsets);
+    Array(uint32_t, delete)(matrix->indices);
+    Array(T, delete)(matrix->values);
+    ARRAY_FREE(matrix);
+    return true;
+}
+
+Self * fn(_new)(SparseFormat format, size_t rows, size_t cols, size_t nnz) {
+    Self * matrix = ARRAY_MALLOC(sizeof(Self));
+    ensure(matrix, NULL);
+
+    *matrix = (Self) { .format = format, ._rows = rows, ._cols = cols };
+    matrix->offsets = Array(size_t, new)((format == SPARSE_CSR ? rows : cols) + 1);
+    matrix->indices = Array(uint32_t, new)(nnz);
+    matrix->values = Array(T, new)(nnz);
+    if (not matrix->offsets or not matrix->indices or not matrix->values) {
+        fn(delete)(matrix);
+        return NULL;
+    }
+    return matrix;
+}
+
+size_t fn(_majors)(Self * matrix) {
+    return matrix->format == SPARSE_CSR ? matrix->_rows : matrix->_cols;
+}
+
+int fn(_compare)(const void * left, const void * right) {
+    uint32_t a = ((const fn(_Entry) *) left)->index;
+    uint32_t b = ((const fn(_Entry) *) right)->index;
+    return (a > b) - (a < b);
+}
+
+// Sorts the minor indices inside every major, and sums duplicates.
+// Returns the number of entries left, compacted to the front.
+size_t fn(_normalize)(Self * matrix) {
+    size_t * offsets = matrix->offsets->data;
+    uint32_t * indices = matrix->indices->data;
+    T * values = matrix->values->data;
+    size_t majors = fn(_majors)(matrix);
+
+    fn(_Entry) * scratch = NULL;
+    size_t scratch_size = 0, written = 0;
+
+    for (size_t major = 0; major < majors; major++) {
+        size_t first = offsets[major], count = offsets[major + 1] - first;
+        offsets[major] = written;
+
+        bool sorted = true;
+        for (size_t i = first + 1; i < first + count and sorted; i++)
+            sorted = indices[i - 1] < indices[i];
+
+        if (sorted) {
+            memmove(indices + written, indices + first, count * sizeof(uint32_t));
+            memmove(values + written, values + first, count * sizeof(T));
+            written += count;
+            continue;
+        }
+
+        if (count > scratch_size) {
+            ARRAY_FREE(scratch);
+            scratch_size = count * 2;
+            scratch = ARRAY_MALLOC(scratch_size * sizeof(fn(_Entry)));
+            ensure(scratch, SIZE_MAX);
+        }
+        for (size_t i = 0; i < count; i++)
+            scratch[i] = (fn(_Entry)) { indices[first + i], values[first + i] };
+        qsort(scratch, count, sizeof(fn(_Entry)), fn(_compare));
+
+        size_t start = written;
+        for (size_t i = 0; i < count; i++) {
+            if (written > start and indices[written - 1] == scratch[i].index) {
+                values[written - 1] += scratch[i].value;
+                continue;
+            }
+            indices[written] = scratch[i].index;
+            values[written] = scratch[i].value;
+            written++;
+        }
+    }
+    offsets[majors] = written;
+
+    ARRAY_FREE(scratch);
+    return written;
+}
+
+// SparseMatrix >> from_coo(format: SparseFormat, rows: size_t, cols: size_t,
+//                          row_indices: *Array<uint32_t>, col_indices: *Array<uint32_t>,
+//                          values: *Array<T>) -> *SparseMatrix<T>
+//
+// Builds a matrix from COO triplets, in any order.
+// Duplicated coordinates are summed. The input Arrays are not modified.
+//
+// Parameters
+// ----------
+// format : SparseFormat
+//     SPARSE_CSR or SPARSE_CSC.
+// rows, cols : size_t
+//     The dimensions, up to SPARSE_MAX_DIM.
+// row_indices, col_indices : *Array<uint32_t>
+//     The coordinates of every entry.
+// values : *Array<T>
+//     The value of every entry.
+//
+// Returns
+// -------
+// *SparseMatrix<T>: The new matrix, or NULL on mismatching sizes,
+//     out of bounds coordinates or failure.
+//
+Self * fn(from_coo)(SparseFormat format, size_t rows, size_t cols,
+                    Array(uint32_t) * row_indices, Array(uint32_t) * col_indices,
+                    Array(T) * values) {
+    ensure(row_indices and col_indices and values, NULL);
+    ensure(rows <= SPARSE_MAX_DIM and cols <= SPARSE_MAX_DIM, NULL);
+
+    size_t nnz = Array(T, size)(values);
+    ensure(Array(uint32_t, size)(row_indices) == nnz, NULL);
+    ensure(Array(uint32_t, size)(col_indices) == nnz, NULL);
+    for (size_t i = 0; i < nnz; i++)
+        ensure(row_indices->data[i] < rows and col_indices->data[i] < cols, NULL);
+
+    Self * matrix = fn(_new)(format, rows, cols, nnz);
+    ensure(matrix, NULL);
+
+    const uint32_t * major = format == SPARSE_CSR ? row_indices->data : col_indices->data;
+    const uint32_t * minor = format == SPARSE_CSR ? col_indices->data : row_indices->data;
+    size_t majors = fn(_majors)(matrix);
+    size_t * offsets = matrix->offsets->data;
+
+    // Count, prefix sum, scatter.
+    for (size_t i = 0; i < nnz; i++) offsets[major[i] + 1]++;
+    for (size_t m = 0; m < majors; m++) offsets[m + 1] += offsets[m];
+    for (size_t i = 0; i < nnz; i++) {
+        size_t at = offsets[major[i]]++;
+        matrix->indices->data[at] = minor[i];
+        matrix->values->data[at] = values->data[i];
+    }
+    for (size_t m = majors; m > 0; m--) offsets[m] = offsets[m - 1];
+    offsets[0] = 0;
+
+    size_t kept = fn(_normalize)(matrix);
+    if (kept == SIZE_MAX) {
+        fn(delete)(matrix);
+        return NULL;
+    }
+
+    // Duplicates were merged: shrink to fit.
+    if (kept < nnz) {
+        Array(uint32_t) * indices = Array(uint32_t, new)(kept);
+        Array(T) * merged = Array(T, new)(kept);
+        if (not indices or not merged) {
+            Array(uint32_t, delete)(indices);
+            Array(T, delete)(merged);
+            fn(delete)(matrix);
+            return NULL;
+        }
+        memcpy(indices->data, matrix->indices->data, kept * sizeof(uint32_t));
+        memcpy(merged->data, matrix->values->data, kept * sizeof(T));
+        Array(uint32_t, delete)(matrix->indices);
+        Array(T, delete)(matrix->values);
+        matrix->indices = indices;
+        matrix->values = merged;
+    }
+    return matrix;
+}
+
+// SparseMatrix >> convert(matrix: *SparseMatrix<T>, format: SparseFormat) -> *SparseMatrix<T>
+//
+// Returns a copy of the matrix in the given format.
+// CSR to CSC (and back) is a counting sort on the other index,
+// which keeps the new minor indices sorted.
+//
+// Returns
+// -------
+// *SparseMatrix<T>: The new matrix, or NULL on failure.
+//
+Self * fn(convert)(Self * matrix, SparseFormat format) {
+    ensure(matrix, NULL);
+
+    size_t nnz = Array(T, size)(matrix->values);
+    Self * result = fn(_new)(format, matrix->_rows, matrix->_cols, nnz);
+    ensure(result, NULL);
+
+    if (format == matrix->format) {
+        memcpy(result->offsets->data, matrix->offsets->data,
+            (fn(_majors)(matrix) + 1) * sizeof(size_t));
+        memcpy(result->indices->data, matrix->indices->data, nnz * sizeof(uint32_t));
+        memcpy(result->values->data, matrix->values->data, nnz * sizeof(T));
+        return result;
+    }
+
+    size_t * offsets = result->offsets->data;
+    size_t majors = fn(_majors)(result);
+    for (size_t i = 0; i < nnz; i++) offsets[matrix->indices->data[i] + 1]++;
+    for (size_t m = 0; m < majors; m++) offsets[m + 1] += offsets[m];
+
+    for (size_t old = 0; old < fn(_majors)(matrix); old++) {
+        for (size_t i = matrix->offsets->data[old]; i < matrix->offsets->data[old + 1]; i++) {
+            size_t at = offsets[matrix->indices->data[i]]++;
+            result->indices->data[at] = (uint32_t) old;
+            result->values->data[at] = matrix->values->data[i];
+        }
+    }
+    for (size_t m = majors; m > 0; m--) offsets[m] = offsets[m - 1];
+    offsets[0] = 0;
+    return result;
+}
+
+// SparseMatrix >> rows(matrix: *SparseMatrix<T>) -> size_t
+//
+// Returns the number of rows.
+//
+size_t fn(rows)(Self * matrix) {
+    ensure(matrix, 0);
+    return matrix->_rows;
+}
+
+// SparseMatrix >> cols(matrix: *SparseMatrix<T>) -> size_t
+//
+// Returns the number of columns.
+//
+size_t fn(cols)(Self * matrix) {
+    ensure(matrix, 0);
+    return matrix->_cols;
+}
+
+// SparseMatrix >> nnz(matrix: *SparseMatrix<T>) -> size_t
+//
+// Returns the number of stored entries.
+//
+size_t fn(nnz)(Self * matrix) {
+    ensure(matrix, 0);
+    return Array(T, size)(matrix->values);
+}
+
+// SparseMatrix >> get(matrix: *SparseMatrix<T>, row: size_t, col: size_t) -> T
+//
+// Returns the element at (row, col), 0 when it is not stored
+// or out of bounds. Binary searches the row (or column).
+//
+T fn(get)(Self * matrix, size_t row, size_t col) {
+    T zero = 0;
+    ensure(matrix and row < matrix->_rows and col < matrix->_cols, zero);
+
+    size_t major = matrix->format == SPARSE_CSR ? row : col;
+    uint32_t minor = (uint32_t) (matrix->format == SPARSE_CSR ? col : row);
+
+    size_t low = matrix->offsets->data[major], high = matrix->offsets->data[major + 1];
+    while (low < high) {
+        size_t middle = low + (high - low) / 2;
+        if (matrix->indices->data[middle] < minor) low = middle + 1;
+        else high = middle;
+    }
+
+    bool found = low < matrix->offsets->data[major + 1] and matrix->indices->data[low] == minor;
+    return found ? matrix->values->data[low] : zero;
+}
+
+
+// ~~~~~~~~ SpMV ~~~~~~~~
+
+T fn(_dot)(const T * values, const uint32_t * indices, size_t count, const T * x) {
+    T sum = 0;
+    for (size_t i = 0; i < count; i++) sum += values[i] * x[indices[i]];
+    return sum;
+}
+
+#ifdef SPARSE_MATRIX_AVX2
+#define _SPARSE_MATRIX_DOT _Generic((T) 0, double: _SparseMatrix_dot_f64, default: fn(_dot))
+#else
+#define _SPARSE_MATRIX_DOT fn(_dot)
+#endif
+
+typedef struct {
+    Self * matrix;
+    const T * x;
+    T * y;
+    size_t tasks;
+    T * partials;               // CSC only: one y per task
+} fn(_SpmvJob);
+
+// The rows of a task: the same share of nonzeros for every task.
+void fn(_csr_rows)(void * context, size_t task, size_t worker) {
+    (void) worker;
+    fn(_SpmvJob) * job = context;
+
+    const size_t * offsets = job->matrix->offsets->data;
+    size_t rows = job->matrix->_rows, nnz = offsets[rows];
+    size_t first = _SparseMatrix_lower_bound(offsets, rows, task * nnz / job->tasks);
+    size_t last = task + 1 == job->tasks
+        ? rows : _SparseMatrix_lower_bound(offsets, rows, (task + 1) * nnz / job->tasks);
+
+    const uint32_t * indices = job->matrix->indices->data;
+    const T * values = job->matrix->values->data;
+    for (size_t row = first; row < last; row++)
+        job->y[row] = _SPARSE_MATRIX_DOT(values + offsets[row],
+            indices + offsets[row], offsets[row + 1] - offsets[row], job->x);
+}
+
+void fn(_csc_scatter)(void * context, size_t task, size_t worker) {
+    (void) worker;
+    fn(_SpmvJob) * job = context;
+
+    const size_t * offsets = job->matrix->offsets->data;
+    size_t cols = job->matrix->_cols, nnz = offsets[cols];
+    size_t first = _SparseMatrix_lower_bound(offsets, cols, task * nnz / job->tasks);
+    size_t last = task + 1 == job->tasks
+        ? cols : _SparseMatrix_lower_bound(offsets, cols, (task + 1) * nnz / job->tasks);
+
+    T * y = job->tasks == 1 ? job->y : job->partials + task * job->matrix->_rows;
+    for (size_t row = 0; row < job->matrix->_rows; row++) y[row] = 0;
+
+    const uint32_t * indices = job->matrix->indices->data;
+    const T * values = job->matrix->values->data;
+    for (size_t col = first; col < last; col++) {
+        T x = job->x[col];
+        for (size_t i = offsets[col]; i < offsets[col + 1]; i++) y[indices[i]] += values[i] * x;
+    }
+}
+
+void fn(_csc_reduce)(void * context, size_t task, size_t worker) {
+    (void) worker;
+    fn(_SpmvJob) * job = context;
+
+    size_t rows = job->matrix->_rows;
+    size_t first = task * rows / job->tasks, last = (task + 1) * rows / job->tasks;
+    for (size_t row = first; row < last; row++) {
+        T sum = 0;
+        for (size_t part = 0; part < job->tasks; part++) sum += job->partials[part * rows + row];
+        job->y[row] = sum;
+    }
+}
+
+// SparseMatrix >> spmv(matrix: *SparseMatrix<T>, x: *Array<T>, y: *Array<T>, pool: *ThreadPool) -> bool
+//
+// Computes ``y = A x``.
+//
+// Parameters
+// ----------
+// matrix : *SparseMatrix<T>
+//     The matrix A.
+// x : *Array<T>
+//     The input vector, one element per column.
+// y : *Array<T>
+//     The output vector, one element per row. Must not alias ``x``.
+// pool : *ThreadPool
+//     Where to run, NULL for the calling thread.
+//
+// Returns
+// -------
+// bool: Returns true on success, false on mismatching sizes or failure.
+//
+bool fn(spmv)(Self * matrix, Array(T) * x, Array(T) * y, ThreadPool * pool) {
+    ensure(matrix and x and y, false);
+    ensure(Array(T, size)(x) == matrix->_cols and Array(T, size)(y) == matrix->_rows, false);
+
+    fn(_SpmvJob) job = { .matrix = matrix, .x = x->data, .y = y->data };
+
+    if (matrix->format == SPARSE_CSR) {
+        job.tasks = ThreadPool_workers(pool) * SPARSE_TASKS_PER_WORKER;
+        ThreadPool_run(pool, job.tasks, fn(_csr_rows), &job);
+        return true;
+    }
+
+    job.tasks = ThreadPool_workers(pool);
+    if (job.tasks > 1) {
+        job.partials = ARRAY_MALLOC(job.tasks * (matrix->_rows ? matrix->_rows : 1) * sizeof(T));
+        ensure(job.partials, false);
+    }
+    ThreadPool_run(pool, job.tasks, fn(_csc_scatter), &job);
+    if (job.tasks > 1) ThreadPool_run(pool, job.tasks, fn(_csc_reduce), &job);
+    ARRAY_FREE(job.partials);
+    return true;
+}
+
+#undef _SPARSE_MATRIX_DOT
+
+
+// ~~~~~~~~ Printing ~~~~~~~~
+
+// SparseMatrix >> print(matrix: *SparseMatrix<T>) -> void
+//
+// Prints the stored entries on terminal, as ``(row, col): value``.
+//
+void fn(print)(Self * matrix) {
+    ensure(matrix,);
+
+    printf("{");
+    size_t printed = 0;
+    for (size_t major = 0; major < fn(_majors)(matrix); major++) {
+        for (size_t i = matrix->offsets->data[major]; i < matrix->offsets->data[major + 1]; i++) {
+            size_t minor = matrix->indices->data[i];
+            if (printed++) printf(", ");
+            printf("(%zu, %zu): ",
+                matrix->format == SPARSE_CSR ? major : minor,
+                matrix->format == SPARSE_CSR ? minor : major);
+            PRINT_T(matrix->values->data[i]);
+        }
+    }
+    printf("}");
+}
+
+// SparseMatrix >> println(matrix: *SparseMatrix<T>) -> void
+//
+// Prints the stored entries on terminal followed by a newline.
+//
+void fn(println)(Self * matrix) {
+    fn(print)(matrix);
+    printf("\n");
+}
+
+// SparseMatrix >> debug(matrix: *SparseMatrix<T>) -> void
+//
+// Prints the debug representation of the matrix.
+//
+void fn(debug)(Self * matrix) {
+    if (not matrix) {
+        printf("SparseMatrix<%s> { NULL }\n", TOSTRING(T));
+        return;
+    }
+
+    printf("SparseMatrix<%s> {\n", TOSTRING(T));
+    printf("  format: %s,\n", matrix->format == SPARSE_CSR ? "CSR" : "CSC");
+    printf("  rows: %zu,\n", matrix->_rows);
+    printf("  cols: %zu,\n", matrix->_cols);
+    printf("  nnz: %zu,\n", fn(nnz)(matrix));
+    printf("  offsets: "); Array(size_t, println)(matrix->offsets);
+    printf("  indices: "); Array(uint32_t, println)(matrix->indices);
+    printf("  values: "); Array(T, println)(matrix->values);
+    printf("}\n");
+}
+
+#undef MODULE
+#undef Self
+#undef fn
+#undef T
+#undef PRINT_T
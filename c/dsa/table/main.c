@@ -0,0 +1,157 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#define T int64_t
+#define PRINT_T(value) printf("%lld", (long long) value)
+#include "../array/array.h"
+
+#define T double
+#define PRINT_T(value) printf("%g", value)
+#include "../array/array.h"
+
+#define K int64_t
+#define V size_t
+#define PRINT_K(key) printf("%lld", (long long) key)
+#define PRINT_V(value) printf("%zu", value)
+#include "../hashmap/hashmap.h"
+
+#include "table.h"
+
+double seconds() {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec + now.tv_nsec * 1e-9;
+}
+
+// A lineitem-like table, with (returnflag, linestatus) packed in one key.
+Table * lineitem(size_t rows) {
+    Array(int64_t) * flag_status = Array(int64_t, new)(rows);
+    Array(int64_t) * shipdate = Array(int64_t, new)(rows);
+    Array(double) * quantity = Array(double, new)(rows);
+    Array(double) * price = Array(double, new)(rows);
+    Array(double) * discount = Array(double, new)(rows);
+    Array(double) * tax = Array(double, new)(rows);
+
+    const char flags[] = "ANR", statuses[] = "FO";
+    uint64_t seed = 7;
+    for (size_t i = 0; i < rows; i++) {
+        seed = seed * 6364136223846793005ull + 1442695040888963407ull;
+        uint32_t r = (uint32_t) (seed >> 33);
+        flag_status->data[i] = flags[r % 3] * 256 + statuses[(r >> 2) % 2];
+        shipdate->data[i] = 8000 + (r >> 4) % 2500;
+        quantity->data[i] = 1 + (r >> 8) % 50;
+        price->data[i] = 900.0 + (r >> 10) % 100000 / 10.0;
+        discount->data[i] = ((r >> 12) % 11) / 100.0;
+        tax->data[i] = ((r >> 16) % 9) / 100.0;
+    }
+
+    Table * table = Table_new();
+    Table_add_i64(table, "flag_status", flag_status);
+    Table_add_i64(table, "shipdate", shipdate);
+    Table_add_f64(table, "quantity", quantity);
+    Table_add_f64(table, "price", price);
+    Table_add_f64(table, "discount", discount);
+    Table_add_f64(table, "tax", tax);
+    return table;
+}
+
+// The same query, hand-written one row at a time.
+double q1_by_hand(Table * table, int64_t cutoff) {
+    const int64_t * keys = table->columns[0].i64->data;
+    const int64_t * shipdate = table->columns[1].i64->data;
+    const double * quantity = table->columns[2].f64->data;
+    const double * price = table->columns[3].f64->data;
+    const double * discount = table->columns[4].f64->data;
+    const double * tax = table->columns[5].f64->data;
+
+    static double sums[1 << 16][6];
+    static double counts[1 << 16];
+    memset(sums, 0, sizeof(sums));
+    memset(counts, 0, sizeof(counts));
+
+    for (size_t i = 0; i < table->_rows; i++) {
+        if (shipdate[i] > cutoff) continue;
+        double disc_price = price[i] * (1 - discount[i]);
+        double * group = sums[keys[i]];
+        group[0] += quantity[i];
+        group[1] += price[i];
+        group[2] += disc_price;
+        group[3] += disc_price * (1 + tax[i]);
+        group[4] += discount[i];
+        counts[keys[i]] += 1;
+    }
+
+    // sum_qty + sum_charge of every group, to cross-check the engine.
+    double checksum = 0.0;
+    for (size_t key = 0; key < (1 << 16); key++)
+        if (counts[key] > 0) checksum += sums[key][0] + sums[key][3];
+    return checksum;
+}
+
+int main() {
+
+    size_t rows = 6000000;
+    Table * table = lineitem(rows);
+    int64_t cutoff = 10400;
+
+    TableExpr * qty = Table_col("quantity");
+    TableExpr * base = Table_col("price");
+    TableExpr * disc_price = Table_mul(Table_col("price"),
+        Table_sub(Table_const(1), Table_col("discount")));
+    TableExpr * charge = Table_mul(Table_mul(Table_col("price"),
+        Table_sub(Table_const(1), Table_col("discount"))),
+        Table_add(Table_const(1), Table_col("tax")));
+    TableExpr * disc = Table_col("discount");
+
+    TableFilter where[] = { { "shipdate", TABLE_LE, (double) cutoff } };
+    TableAggregate select[] = {
+        { TABLE_SUM, qty }, { TABLE_SUM, base },
+        { TABLE_SUM, disc_price }, { TABLE_SUM, charge },
+        { TABLE_AVG, qty }, { TABLE_AVG, base },
+        { TABLE_AVG, disc }, { TABLE_COUNT, NULL },
+    };
+
+    double start = seconds();
+    TableResult * result = Table_query(table, where, 1, "flag_status", select, 8);
+    double engine = seconds() - start;
+
+    printf("flag status  sum_qty  sum_base_price  sum_disc_price  sum_charge"
+           "  avg_qty  avg_price  avg_disc  count\n");
+    for (size_t g = 0; g < result->groups; g++) {
+        int64_t key = result->keys[g];
+        printf("%4c %6c %8.0f %15.2f %15.2f %11.2f %8.2f %10.2f %9.4f %6.0f\n",
+            (char) (key / 256), (char) (key % 256),
+            TableResult_get(result, g, 0), TableResult_get(result, g, 1),
+            TableResult_get(result, g, 2), TableResult_get(result, g, 3),
+            TableResult_get(result, g, 4), TableResult_get(result, g, 5),
+            TableResult_get(result, g, 6), TableResult_get(result, g, 7));
+    }
+
+    start = seconds();
+    double checksum = q1_by_hand(table, cutoff);
+    double by_hand = seconds() - start;
+
+    double expected = 0.0;
+    for (size_t g = 0; g < result->groups; g++)
+        expected += TableResult_get(result, g, 3) + TableResult_get(result, g, 0);
+
+    printf("\nvectorized engine: %.1f M rows/s (batch of %d)\n",
+        rows / engine / 1e6, TABLE_BATCH);
+    printf("hand-written loop: %.1f M rows/s, results %s\n",
+        rows / by_hand / 1e6,
+        fabs(checksum - expected) < 1e-6 * expected ? "agree" : "differ");
+
+    TableResult_delete(result);
+    Table_expr_delete(qty);
+    Table_expr_delete(base);
+    Table_expr_delete(disc_price);
+    Table_expr_delete(charge);
+    Table_expr_delete(disc);
+    Table_delete(table);
+    return 0;
+
+}
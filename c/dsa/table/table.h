@@ -0,0 +1,946 @@
+// =====
+// Table
+// =====
+//
+// :Author: RickBarretto
+// :Year: 2026
+// :License: MPL 2.0
+// :Copyright: RickBarretto, 2026
+// :Version: 1.0
+//
+// ``Table`` is a small columnar query engine over ``Array<T>`` columns.
+// A table is a set of named, typed columns of the same length,
+// either ``Array<int64_t>`` or ``Array<double>``.
+//
+// Queries run in vectorized form, one batch of TABLE_BATCH rows at a time,
+// so the working set of every step stays in cache:
+//
+// 1. Filters narrow a selection vector (indices of the surviving rows)
+//    with branch-free loops.
+// 2. Expressions are evaluated a whole batch at a time,
+//    one tight loop per operator, instead of one row at a time.
+// 3. Aggregates (sum, min, max, count, avg) fold the resulting vectors,
+//    either into a single row or into groups found through a
+//    ``HashMap<int64_t, size_t>`` from group key to group slot.
+//
+// How to Use
+// ----------
+//
+// The table reads from ``Array<int64_t>``, ``Array<double>``
+// and ``HashMap<int64_t, size_t>``, so those must be included first:
+//
+//      #define T int64_t
+//      #define PRINT_T(value) printf("%lld", (long long) value)
+//      #include "../array/array.h"
+//
+//      #define T double
+//      #define PRINT_T(value) printf("%g", value)
+//      #include "../array/array.h"
+//
+//      #define K int64_t
+//      #define V size_t
+//      #define PRINT_K(key) printf("%lld", (long long) key)
+//      #define PRINT_V(value) printf("%zu", value)
+//      #include "../hashmap/hashmap.h"
+//
+//      #include "table.h"
+//
+// And a common way to use it would be:
+//
+//      Table * sales = Table_new();
+//      Table_add_i64(sales, "store", stores);
+//      Table_add_f64(sales, "price", prices);
+//      Table_add_f64(sales, "discount", discounts);
+//
+//      // select store, sum(price * (1 - discount)), count(*)
+//      // where price > 10 group by store
+//      TableFilter where[] = { { "price", TABLE_GT, 10.0 } };
+//      TableAggregate select[] = {
+//          { TABLE_SUM, Table_mul(Table_col("price"),
+//                          Table_sub(Table_const(1), Table_col("discount"))) },
+//          { TABLE_COUNT, NULL },
+//      };
+//      TableResult * result = Table_query(sales, where, 1, "store", select, 2);
+//      TableResult_print(result);
+//
+// Grouping is done by a single ``int64_t`` column.
+// Composite keys are packed into one column beforehand.
+//
+
+#ifndef TABLE_H
+#define TABLE_H
+
+// =~=~=~=~=~=~=~=~ Imports ~=~=~=~=~=~=~=~=
+
+#include <iso646.h>
+#include <math.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__AVX2__) && defined(__BMI2__)
+#include <immintrin.h>
+#define TABLE_AVX2 1
+#endif
+
+
+// =~=~=~=~=~=~=~=~ Helper Macros ~=~=~=~=~=~=~=~=
+
+#define ensure(COND, VAL) if (not (COND)) return VAL
+
+
+// =~=~=~=~=~=~=~=~ Configuration ~=~=~=~=~=~=~=~=
+
+// TABLE_BATCH: Rows per vectorized step.
+// 2048 rows of a few double vectors fit comfortably in L1/L2.
+#ifndef TABLE_BATCH
+#define TABLE_BATCH 2048
+#endif
+
+// TABLE_GROUP_CACHE: Direct-mapped key -> group cache in front of the map.
+#define TABLE_GROUP_CACHE 64
+
+
+// =~=~=~=~=~=~=~=~ Implementation ~=~=~=~=~=~=~=~=
+
+typedef enum { TABLE_I64, TABLE_F64 } TableType;
+
+typedef enum { TABLE_LT, TABLE_LE, TABLE_GT, TABLE_GE, TABLE_EQ, TABLE_NE } TableOp;
+
+typedef enum { TABLE_SUM, TABLE_MIN, TABLE_MAX, TABLE_COUNT, TABLE_AVG } TableAgg;
+
+typedef struct {
+    char * name;
+    TableType type;
+    union {
+        Array(int64_t) * i64;
+        Array(double) * f64;
+    };
+} TableColumn;
+
+typedef struct {
+    TableColumn * columns;
+    size_t _columns;
+    size_t _rows;
+} Table;
+
+typedef enum {
+    _TABLE_COLUMN, _TABLE_CONST, _TABLE_ADD, _TABLE_SUB, _TABLE_MUL, _TABLE_DIV
+} _TableExprKind;
+
+typedef struct TableExpr {
+    _TableExprKind kind;
+    char * column;
+    size_t index;               // resolved column, set by the query
+    double value;
+    struct TableExpr * left;
+    struct TableExpr * right;
+} TableExpr;
+
+// A predicate ``column op value``. Filters of a query are AND-ed.
+// Integer columns are compared as integers, against the exact ``value``.
+typedef struct {
+    const char * column;
+    TableOp op;
+    double value;
+} TableFilter;
+
+// An aggregate over an expression. TABLE_COUNT takes no expression.
+typedef struct {
+    TableAgg op;
+    TableExpr * expr;
+} TableAggregate;
+
+typedef struct {
+    size_t groups;
+    size_t aggregates;
+    int64_t * keys;
+    double * values;            // groups x aggregates, row-major
+} TableResult;
+
+
+// ~~~~~~~~ Tables ~~~~~~~~
+
+// Table >> new() -> *Table
+//
+// Creates an empty table.
+//
+Table * Table_new() {
+    return calloc(1, sizeof(Table));
+}
+
+// Table >> delete(table: *Table) -> bool
+//
+// Safely deletes the table, including the Arrays of its columns.
+//
+// Returns
+// -------
+// bool: Returns true on success.
+//
+bool Table_delete(Table * table) {
+    ensure(table, false);
+
+    for (size_t i = 0; i < table->_columns; i++) {
+        TableColumn * column = &table->columns[i];
+        if (column->type == TABLE_I64) Array(int64_t, delete)(column->i64);
+        else Array(double, delete)(column->f64);
+        free(column->name);
+    }
+    free(table->columns);
+    free(table);
+    return true;
+}
+
+// Table >> rows(table: *Table) -> size_t
+//
+// Returns the number of rows of the table.
+//
+size_t Table_rows(Table * table) {
+    ensure(table, 0);
+    return table->_rows;
+}
+
+// Table >> column(table: *Table, name: *char) -> size_t
+//
+// Finds a column by name.
+//
+// Returns
+// -------
+// size_t: The index of the column, or SIZE_MAX if there is none.
+//
+size_t Table_column(Table * table, const char * name) {
+    ensure(table and name, SIZE_MAX);
+
+    for (size_t i = 0; i < table->_columns; i++)
+        if (strcmp(table->columns[i].name, name) == 0) return i;
+    return SIZE_MAX;
+}
+
+bool _Table_add(Table * table, const char * name, TableType type,
+                void * array, size_t size) {
+    ensure(table and name and array, false);
+    ensure(Table_column(table, name) == SIZE_MAX, false);
+    ensure(table->_columns == 0 or size == table->_rows, false);
+
+    TableColumn * columns = realloc(table->columns,
+        (table->_columns + 1) * sizeof(TableColumn));
+    ensure(columns, false);
+    table->columns = columns;
+
+    char * copy = malloc(strlen(name) + 1);
+    ensure(copy, false);
+    strcpy(copy, name);
+
+    TableColumn * column = &columns[table->_columns++];
+    column->name = copy;
+    column->type = type;
+    if (type == TABLE_I64) column->i64 = array;
+    else column->f64 = array;
+
+    table->_rows = size;
+    return true;
+}
+
+// Table >> add_i64(table: *Table, name: *char, column: *Array<int64_t>) -> bool
+//
+// Adds an integer column. The table takes ownership of the Array.
+//
+// Returns
+// -------
+// bool: Returns true on success, false if the name is taken
+//       or the length differs from the other columns.
+//
+bool Table_add_i64(Table * table, const char * name, Array(int64_t) * column) {
+    return _Table_add(table, name, TABLE_I64, column, Array(int64_t, size)(column));
+}
+
+// Table >> add_f64(table: *Table, name: *char, column: *Array<double>) -> bool
+//
+// Adds a floating point column. The table takes ownership of the Array.
+// See ``Table_add_i64``.
+//
+bool Table_add_f64(Table * table, const char * name, Array(double) * column) {
+    return _Table_add(table, name, TABLE_F64, column, Array(double, size)(column));
+}
+
+
+// ~~~~~~~~ Expressions ~~~~~~~~
+
+TableExpr * _Table_expr(_TableExprKind kind, TableExpr * left, TableExpr * right) {
+    TableExpr * expr = calloc(1, sizeof(TableExpr));
+    ensure(expr, NULL);
+
+    expr->kind = kind;
+    expr->left = left;
+    expr->right = right;
+    return expr;
+}
+
+// Table >> col(name: *char) -> *TableExpr
+//
+// An expression that reads a column, as double.
+//
+TableExpr * Table_col(const char * name) {
+    ensure(name, NULL);
+
+    TableExpr * expr = _Table_expr(_TABLE_COLUMN, NULL, NULL);
+    ensure(expr, NULL);
+
+    expr->column = malloc(strlen(name) + 1);
+    if (not expr->column) { free(expr); return NULL; }
+    strcpy(expr->column, name);
+    return expr;
+}
+
+// Table >> const(value: double) -> *TableExpr
+//
+// A constant expression.
+//
+TableExpr * Table_const(double value) {
+    TableExpr * expr = _Table_expr(_TABLE_CONST, NULL, NULL);
+    if (expr) expr->value = value;
+    return expr;
+}
+
+// Table >> add / sub / mul / div(left: *TableExpr, right: *TableExpr) -> *TableExpr
+//
+// Arithmetic over two expressions. The new node owns both operands.
+//
+TableExpr * Table_add(TableExpr * left, TableExpr * right) {
+    return _Table_expr(_TABLE_ADD, left, right);
+}
+
+TableExpr * Table_sub(TableExpr * left, TableExpr * right) {
+    return _Table_expr(_TABLE_SUB, left, right);
+}
+
+TableExpr * Table_mul(TableExpr * left, TableExpr * right) {
+    return _Table_expr(_TABLE_MUL, left, right);
+}
+
+TableExpr * Table_div(TableExpr * left, TableExpr * right) {
+    return _Table_expr(_TABLE_DIV, left, right);
+}
+
+// Table >> expr_delete(expr: *TableExpr) -> bool
+//
+// Safely deletes an expression tree.
+//
+bool Table_expr_delete(TableExpr * expr) {
+    ensure(expr, false);
+
+    Table_expr_delete(expr->left);
+    Table_expr_delete(expr->right);
+    free(expr->column);
+    free(expr);
+    return true;
+}
+
+bool _Table_resolve(Table * table, TableExpr * expr) {
+    ensure(expr, false);
+
+    switch (expr->kind) {
+        case _TABLE_COLUMN:
+            expr->index = Table_column(table, expr->column);
+            return expr->index != SIZE_MAX;
+        case _TABLE_CONST:
+            return true;
+        default:
+            return _Table_resolve(table, expr->left)
+               and _Table_resolve(table, expr->right);
+    }
+}
+
+
+// ~~~~~~~~ Vectorized primitives ~~~~~~~~
+//
+// A selection vector ``sel`` lists the positions, relative to the batch,
+// of the rows still alive. A NULL selection means every row of the batch.
+
+// Rows before ``first`` were already selected into ``out[0 .. kept)``.
+#define _TABLE_SELECT(VALUES, OP, VALUE, SEL, COUNT, OUT) do {              \
+    size_t _kept = kept;                                                    \
+    if (SEL) {                                                              \
+        for (size_t k = first; k < (COUNT); k++) {                          \
+            (OUT)[_kept] = (SEL)[k];                                        \
+            _kept += ((VALUES)[(SEL)[k]] OP (VALUE));                       \
+        }                                                                   \
+    } else {                                                                \
+        for (size_t k = first; k < (COUNT); k++) {                          \
+            (OUT)[_kept] = (uint32_t) k;                                    \
+            _kept += ((VALUES)[k] OP (VALUE));                              \
+        }                                                                   \
+    }                                                                       \
+    return _kept;                                                           \
+} while (0)
+
+#define _TABLE_SELECT_OPS(VALUES)                                           \
+    switch (op) {                                                           \
+        case TABLE_LT: _TABLE_SELECT(VALUES, <, value, sel, count, out);   \
+        case TABLE_LE: _TABLE_SELECT(VALUES, <=, value, sel, count, out);  \
+        case TABLE_GT: _TABLE_SELECT(VALUES, >, value, sel, count, out);   \
+        case TABLE_GE: _TABLE_SELECT(VALUES, >=, value, sel, count, out);  \
+        case TABLE_EQ: _TABLE_SELECT(VALUES, ==, value, sel, count, out);  \
+        case TABLE_NE: _TABLE_SELECT(VALUES, !=, value, sel, count, out);  \
+    }                                                                       \
+    return 0
+
+#ifdef TABLE_AVX2
+// Appends ``first + i`` for every set bit ``i`` of an 8-bit mask:
+// pdep spreads the mask to bytes, pext keeps the matching lane numbers.
+// Writes 8 indices whatever the mask, returns how many are kept.
+size_t _Table_compress(uint32_t * out, unsigned mask, uint32_t first) {
+    uint64_t bytes = _pdep_u64(mask, 0x0101010101010101ull) * 0xff;
+    uint64_t lanes = _pext_u64(0x0706050403020100ull, bytes);
+    __m256i rows = _mm256_cvtepu8_epi32(_mm_cvtsi64_si128((long long) lanes));
+    _mm256_storeu_si256((__m256i *) out, _mm256_add_epi32(rows, _mm256_set1_epi32((int) first)));
+    return (size_t) __builtin_popcount(mask);
+}
+
+// Selects the first ``count`` rows of a batch, a multiple of 8, without
+// an input selection. ``HIT(k, ARG)`` compares 4 values from row ``k``,
+// and ``NEGATE`` flips the 8 bits of a mask for the negated comparisons.
+#define _TABLE_SELECT_WIDE(HIT, ARG, NEGATE) do {                           \
+    size_t _kept = 0;                                                       \
+    for (size_t k = 0; k < count; k += 8) {                                 \
+        unsigned _mask = (unsigned) _mm256_movemask_pd(HIT(k, ARG))         \
+                       | (unsigned) _mm256_movemask_pd(HIT(k + 4, ARG)) << 4; \
+        _kept += _Table_compress(out + _kept, _mask ^ (NEGATE), (uint32_t) k); \
+    }                                                                       \
+    return _kept;                                                           \
+} while (0)
+
+#define _TABLE_I64_LOAD(K) _mm256_loadu_si256((const __m256i *) (values + (K)))
+#define _TABLE_I64_LT(K, _) _mm256_castsi256_pd(_mm256_cmpgt_epi64(bound, _TABLE_I64_LOAD(K)))
+#define _TABLE_I64_GT(K, _) _mm256_castsi256_pd(_mm256_cmpgt_epi64(_TABLE_I64_LOAD(K), bound))
+#define _TABLE_I64_EQ(K, _) _mm256_castsi256_pd(_mm256_cmpeq_epi64(_TABLE_I64_LOAD(K), bound))
+#define _TABLE_F64_CMP(K, PREDICATE) _mm256_cmp_pd(_mm256_loadu_pd(values + (K)), bound, PREDICATE)
+
+size_t _Table_select_wide_i64(const int64_t * values, TableOp op, int64_t value,
+                              size_t count, uint32_t * out) {
+    __m256i bound = _mm256_set1_epi64x(value);
+    switch (op) {
+        case TABLE_LT: _TABLE_SELECT_WIDE(_TABLE_I64_LT, 0, 0);
+        case TABLE_LE: _TABLE_SELECT_WIDE(_TABLE_I64_GT, 0, 0xff);
+        case TABLE_GT: _TABLE_SELECT_WIDE(_TABLE_I64_GT, 0, 0);
+        case TABLE_GE: _TABLE_SELECT_WIDE(_TABLE_I64_LT, 0, 0xff);
+        case TABLE_EQ: _TABLE_SELECT_WIDE(_TABLE_I64_EQ, 0, 0);
+        case TABLE_NE: _TABLE_SELECT_WIDE(_TABLE_I64_EQ, 0, 0xff);
+    }
+    return 0;
+}
+
+size_t _Table_select_wide_f64(const double * values, TableOp op, double value,
+                              size_t count, uint32_t * out) {
+    __m256d bound = _mm256_set1_pd(value);
+    switch (op) {
+        case TABLE_LT: _TABLE_SELECT_WIDE(_TABLE_F64_CMP, _CMP_LT_OQ, 0);
+        case TABLE_LE: _TABLE_SELECT_WIDE(_TABLE_F64_CMP, _CMP_LE_OQ, 0);
+        case TABLE_GT: _TABLE_SELECT_WIDE(_TABLE_F64_CMP, _CMP_GT_OQ, 0);
+        case TABLE_GE: _TABLE_SELECT_WIDE(_TABLE_F64_CMP, _CMP_GE_OQ, 0);
+        case TABLE_EQ: _TABLE_SELECT_WIDE(_TABLE_F64_CMP, _CMP_EQ_OQ, 0);
+        case TABLE_NE: _TABLE_SELECT_WIDE(_TABLE_F64_CMP, _CMP_NEQ_UQ, 0);
+    }
+    return 0;
+}
+#endif
+
+// Table >> select_i64(values: *i64, op: TableOp, value: i64, sel: *u32, count: size_t, out: *u32) -> size_t
+//
+// Keeps the rows where ``values[row] op value``, without branching.
+// With AVX2 and BMI2, a batch without input selection is compared
+// 8 rows at a time.
+//
+// Parameters
+// ----------
+// values : *i64
+//     The column, offset to the start of the batch.
+// op : TableOp
+//     The comparison.
+// value : i64
+//     The right-hand side of the comparison.
+// sel : *u32
+//     The input selection vector, or NULL for rows [0, count).
+// count : size_t
+//     The length of ``sel``, or of the batch when ``sel`` is NULL.
+// out : *u32
+//     The output selection vector, may be the same as ``sel``.
+//
+// Returns
+// -------
+// size_t: The number of rows kept in ``out``.
+//
+size_t Table_select_i64(const int64_t * values, TableOp op, int64_t value,
+                        const uint32_t * sel, size_t count, uint32_t * out) {
+    size_t kept = 0, first = 0;
+#ifdef TABLE_AVX2
+    if (not sel) {
+        first = count & ~(size_t) 7;
+        kept = _Table_select_wide_i64(values, op, value, first, out);
+    }
+#endif
+    _TABLE_SELECT_OPS(values);
+}
+
+// Table >> select_f64(values: *double, op: TableOp, value: double, sel: *u32, count: size_t, out: *u32) -> size_t
+//
+// Same as ``Table_select_i64``, for double columns.
+//
+size_t Table_select_f64(const double * values, TableOp op, double value,
+                        const uint32_t * sel, size_t count, uint32_t * out) {
+    size_t kept = 0, first = 0;
+#ifdef TABLE_AVX2
+    if (not sel) {
+        first = count & ~(size_t) 7;
+        kept = _Table_select_wide_f64(values, op, value, first, out);
+    }
+#endif
+    _TABLE_SELECT_OPS(values);
+}
+
+// Rewrites ``column op value`` on an integer column as ``column op bound``
+// with an integer bound, true for exactly the same rows. Casting the
+// column to double instead would round values past 2^53.
+// Comparisons that hold for every row, or none, become ``<= INT64_MAX``
+// and ``> INT64_MAX``.
+int64_t _Table_integer_bound(TableOp * op, double value) {
+    const double limit = 9223372036854775808.0;     // 2^63
+    bool all = false, none = false;
+    double bound = value;
+
+    if (isnan(value)) {
+        all = (*op == TABLE_NE);
+        none = not all;
+    } else {
+        switch (*op) {
+            case TABLE_LT: case TABLE_GE:       // x < v  <=>  x < ceil(v)
+                bound = ceil(value);
+                all = (*op == TABLE_LT) ? bound >= limit : bound <= -limit;
+                none = (*op == TABLE_LT) ? bound <= -limit : bound >= limit;
+                break;
+            case TABLE_LE: case TABLE_GT:       // x <= v  <=>  x <= floor(v)
+                bound = floor(value);
+                all = (*op == TABLE_LE) ? bound >= limit : bound < -limit;
+                none = (*op == TABLE_LE) ? bound < -limit : bound >= limit;
+                break;
+            case TABLE_EQ: case TABLE_NE: {
+                bool integral = value == floor(value) and value >= -limit and value < limit;
+                all = (*op == TABLE_NE) and not integral;
+                none = (*op == TABLE_EQ) and not integral;
+                break;
+            }
+        }
+    }
+
+    if (all or none) {
+        *op = all ? TABLE_LE : TABLE_GT;
+        return INT64_MAX;
+    }
+    return (int64_t) bound;
+}
+
+#define _TABLE_APPLY(OUT, LEFT, RIGHT, COUNT) do {                          \
+    switch (expr->kind) {                                                   \
+        case _TABLE_ADD: for (size_t k = 0; k < (COUNT); k++) (OUT)[k] = LEFT + RIGHT; break; \
+        case _TABLE_SUB: for (size_t k = 0; k < (COUNT); k++) (OUT)[k] = LEFT - RIGHT; break; \
+        case _TABLE_MUL: for (size_t k = 0; k < (COUNT); k++) (OUT)[k] = LEFT * RIGHT; break; \
+        case _TABLE_DIV: for (size_t k = 0; k < (COUNT); k++) (OUT)[k] = LEFT / RIGHT; break; \
+        default: break;                                                     \
+    }                                                                       \
+} while (0)
+
+// Evaluates into ``out`` and returns where the values are: ``out``,
+// or the column itself when a double column is read without selection.
+// A constant operand stays a scalar instead of being spread into a vector.
+const double * _Table_eval(Table * table, TableExpr * expr, size_t start,
+                           const uint32_t * sel, size_t count, double * out) {
+    switch (expr->kind) {
+        case _TABLE_COLUMN: {
+            TableColumn * column = &table->columns[expr->index];
+            if (column->type == TABLE_F64) {
+                const double * values = column->f64->data + start;
+                if (not sel) return values;
+                for (size_t k = 0; k < count; k++) out[k] = values[sel[k]];
+            } else {
+                const int64_t * values = column->i64->data + start;
+                if (sel) for (size_t k = 0; k < count; k++) out[k] = (double) values[sel[k]];
+                else for (size_t k = 0; k < count; k++) out[k] = (double) values[k];
+            }
+            return out;
+        }
+        case _TABLE_CONST:
+            for (size_t k = 0; k < count; k++) out[k] = expr->value;
+            return out;
+        default:
+            break;
+    }
+
+    if (expr->right->kind == _TABLE_CONST) {
+        const double * left = _Table_eval(table, expr->left, start, sel, count, out);
+        double value = expr->right->value;
+        _TABLE_APPLY(out, left[k], value, count);
+    } else if (expr->left->kind == _TABLE_CONST) {
+        const double * right = _Table_eval(table, expr->right, start, sel, count, out);
+        double value = expr->left->value;
+        _TABLE_APPLY(out, value, right[k], count);
+    } else {
+        double scratch[TABLE_BATCH];
+        const double * left = _Table_eval(table, expr->left, start, sel, count, out);
+        const double * right = _Table_eval(table, expr->right, start, sel, count, scratch);
+        _TABLE_APPLY(out, left[k], right[k], count);
+    }
+    return out;
+}
+
+// Table >> eval(table: *Table, expr: *TableExpr, start: size_t, sel: *u32, count: size_t, out: *double) -> void
+//
+// Evaluates a resolved expression over a batch starting at row ``start``,
+// writing one value per selected row into ``out``.
+// Each operator runs as one loop over the whole batch.
+//
+void Table_eval(Table * table, TableExpr * expr, size_t start,
+                const uint32_t * sel, size_t count, double * out) {
+    const double * values = _Table_eval(table, expr, start, sel, count, out);
+    if (values != out) memcpy(out, values, count * sizeof(double));
+}
+
+
+// ~~~~~~~~ Queries ~~~~~~~~
+
+double _Table_initial(TableAgg op) {
+    switch (op) {
+        case TABLE_MIN: return INFINITY;
+        case TABLE_MAX: return -INFINITY;
+        default: return 0.0;
+    }
+}
+
+int _Table_compare_keys(const void * a, const void * b) {
+    int64_t x = **(const int64_t * const *) a, y = **(const int64_t * const *) b;
+    return (x > y) - (x < y);
+}
+
+// The group cache line of a key (Fibonacci hashing).
+size_t _Table_cache_line(int64_t key) {
+    return (size_t) (((uint64_t) key * 0x9e3779b97f4a7c15ull) >> 58) & (TABLE_GROUP_CACHE - 1);
+}
+
+#define _TABLE_FOLD_ROWS(ROW) do {                                          \
+    if (not group_of) {                                                     \
+        for (size_t a = 0; a < aggregates; a++) {                           \
+            if (not results[a]) continue;                                   \
+            const double * values = results[a];                             \
+            double total = acc[a];                                          \
+            switch (select[a].op) {                                         \
+                case TABLE_MIN: for (size_t k = 0; k < count; k++) total = fmin(total, values[ROW]); break; \
+                case TABLE_MAX: for (size_t k = 0; k < count; k++) total = fmax(total, values[ROW]); break; \
+                default: for (size_t k = 0; k < count; k++) total += values[ROW]; break; \
+            }                                                               \
+            acc[a] = total;                                                 \
+        }                                                                   \
+        break;                                                              \
+    }                                                                       \
+    for (size_t k = 0; k < count; k++) {                                    \
+        double * cells = acc + group_of[k] * aggregates;                    \
+        size_t row = ROW;                                                   \
+        for (size_t s = 0; s < sums; s++)                                   \
+            cells[sum_of[s]] += sum_values[s][row];                         \
+    }                                                                       \
+    for (size_t a = 0; a < aggregates; a++) {                               \
+        if (select[a].op != TABLE_MIN and select[a].op != TABLE_MAX) continue; \
+        const double * values = results[a];                                 \
+        for (size_t k = 0; k < count; k++) {                                \
+            double * cell = &acc[group_of[k] * aggregates + a];             \
+            *cell = (select[a].op == TABLE_MIN)                             \
+                ? fmin(*cell, values[ROW]) : fmax(*cell, values[ROW]);      \
+        }                                                                   \
+    }                                                                       \
+} while (0)
+
+// Folds the evaluated vectors into the accumulators, ``aggregates`` per
+// group, row after row. Sums and averages of a row are added together,
+// so each row touches its group once. Row ``k`` of a vector is
+// ``through[k]`` when the batch was evaluated densely, and
+// ``group_of`` is NULL when there is a single group.
+void _Table_fold(TableAggregate * select, size_t aggregates,
+                 const double ** results, const uint32_t * through,
+                 size_t count, const size_t * group_of, double * acc) {
+    size_t sum_of[aggregates ? aggregates : 1], sums = 0;
+    const double * sum_values[aggregates ? aggregates : 1];
+    for (size_t a = 0; a < aggregates; a++) {
+        if (select[a].op != TABLE_SUM and select[a].op != TABLE_AVG) continue;
+        sum_of[sums] = a;
+        sum_values[sums++] = results[a];
+    }
+
+    if (through) _TABLE_FOLD_ROWS(through[k]);
+    else _TABLE_FOLD_ROWS(k);
+}
+
+// Grows the per-group state so ``groups`` slots fit.
+bool _Table_reserve(size_t groups, size_t aggregates, TableAggregate * select,
+                    size_t * capacity, int64_t ** keys, double ** acc, double ** counts) {
+    ensure(groups > *capacity, true);
+
+    size_t slots = *capacity ? *capacity * 2 : 64;
+    int64_t * new_keys = realloc(*keys, slots * sizeof(int64_t));
+    if (new_keys) *keys = new_keys;
+    double * new_acc = realloc(*acc, slots * aggregates * sizeof(double) + 1);
+    if (new_acc) *acc = new_acc;
+    double * new_counts = realloc(*counts, slots * sizeof(double));
+    if (new_counts) *counts = new_counts;
+    ensure(new_keys and new_acc and new_counts, false);
+
+    for (size_t group = *capacity; group < slots; group++) {
+        (*counts)[group] = 0.0;
+        for (size_t a = 0; a < aggregates; a++)
+            (*acc)[group * aggregates + a] = _Table_initial(select[a].op);
+    }
+    *capacity = slots;
+    return true;
+}
+
+// Table >> query(table: *Table, where: *TableFilter, filters: size_t, group_by: *char, select: *TableAggregate, aggregates: size_t) -> *TableResult
+//
+// Runs ``select aggregates from table where filters group by group_by``.
+//
+// Parameters
+// ----------
+// table : *Table
+//     The table to scan.
+// where : *TableFilter
+//     The predicates, all of them must hold. May be NULL if ``filters`` is 0.
+// filters : size_t
+//     The number of predicates.
+// group_by : *char
+//     The name of an integer column to group by, or NULL for a single group.
+// select : *TableAggregate
+//     The aggregates to compute. Expressions remain owned by the caller.
+// aggregates : size_t
+//     The number of aggregates.
+//
+// Returns
+// -------
+// *TableResult: One row per group, sorted by key.
+//     NULL if a column is missing or has the wrong type.
+//
+TableResult * Table_query(Table * table, TableFilter * where, size_t filters,
+                          const char * group_by, TableAggregate * select,
+                          size_t aggregates) {
+    ensure(table, NULL);
+    ensure(where or filters == 0, NULL);
+    ensure(select or aggregates == 0, NULL);
+
+    // Resolve every name once, before scanning.
+    size_t filter_columns[filters ? filters : 1];
+    TableOp integer_ops[filters ? filters : 1];
+    int64_t integer_bounds[filters ? filters : 1];
+    for (size_t f = 0; f < filters; f++) {
+        filter_columns[f] = Table_column(table, where[f].column);
+        ensure(filter_columns[f] != SIZE_MAX, NULL);
+        integer_ops[f] = where[f].op;
+        integer_bounds[f] = _Table_integer_bound(&integer_ops[f], where[f].value);
+    }
+    for (size_t a = 0; a < aggregates; a++) {
+        if (select[a].op == TABLE_COUNT) continue;
+        ensure(_Table_resolve(table, select[a].expr), NULL);
+    }
+
+    const int64_t * group_keys = NULL;
+    if (group_by) {
+        size_t index = Table_column(table, group_by);
+        ensure(index != SIZE_MAX, NULL);
+        ensure(table->columns[index].type == TABLE_I64, NULL);
+        group_keys = table->columns[index].i64->data;
+    }
+
+    HashMap(int64_t, size_t) * slots = HashMap(int64_t, size_t, new)(64);
+    size_t groups = 0, capacity = 0;
+    int64_t * keys = NULL;
+    double * acc = NULL, * counts = NULL;
+    bool ok = slots != NULL;
+
+    if (not group_by) {
+        ok = ok and _Table_reserve(1, aggregates, select, &capacity, &keys, &acc, &counts);
+        if (ok) keys[groups++] = 0;
+    }
+
+    // Evaluated vectors, one per aggregate over a new expression.
+    const double * results[aggregates ? aggregates : 1];
+    double * vectors = malloc((aggregates ? aggregates : 1) * TABLE_BATCH * sizeof(double));
+    ok = ok and vectors;
+
+    uint32_t selection[TABLE_BATCH], missed[TABLE_BATCH];
+    size_t group_of[TABLE_BATCH];
+    int64_t cached_keys[TABLE_GROUP_CACHE];
+    size_t cached[TABLE_GROUP_CACHE];
+    for (size_t line = 0; line < TABLE_GROUP_CACHE; line++) cached[line] = SIZE_MAX;
+
+    for (size_t start = 0; ok and start < table->_rows; start += TABLE_BATCH) {
+        size_t count = table->_rows - start;
+        if (count > TABLE_BATCH) count = TABLE_BATCH;
+
+        // 1. Filter into the selection vector.
+        const uint32_t * sel = NULL;
+        for (size_t f = 0; f < filters and count > 0; f++) {
+            TableColumn * column = &table->columns[filter_columns[f]];
+            count = (column->type == TABLE_F64)
+                ? Table_select_f64(column->f64->data + start, where[f].op,
+                                   where[f].value, sel, count, selection)
+                : Table_select_i64(column->i64->data + start, integer_ops[f],
+                                   integer_bounds[f], sel, count, selection);
+            sel = selection;
+        }
+        if (count == 0) continue;
+
+        // 2. Map every selected row to its group slot.
+        // Few distinct keys is the common case: every row tries the cache
+        // without branching, and only the misses go to the map.
+        if (group_by) {
+            const int64_t * batch_keys = group_keys + start;
+            size_t misses = 0;
+            for (size_t k = 0; k < count; k++) {
+                int64_t key = batch_keys[sel ? sel[k] : k];
+                size_t line = _Table_cache_line(key);
+                group_of[k] = cached[line];
+                missed[misses] = (uint32_t) k;
+                misses += cached[line] == SIZE_MAX or cached_keys[line] != key;
+            }
+
+            for (size_t m = 0; ok and m < misses; m++) {
+                size_t k = missed[m];
+                int64_t key = batch_keys[sel ? sel[k] : k];
+                size_t line = _Table_cache_line(key);
+                if (cached[line] != SIZE_MAX and cached_keys[line] == key) {
+                    group_of[k] = cached[line];
+                    continue;
+                }
+
+                size_t * slot = HashMap(int64_t, size_t, entry)(slots, key, groups);
+                ok = slot != NULL;
+                if (ok and *slot == groups) {
+                    ok = _Table_reserve(groups + 1, aggregates, select,
+                                        &capacity, &keys, &acc, &counts);
+                    if (ok) keys[groups++] = key;
+                }
+                group_of[k] = ok ? *slot : 0;
+                cached_keys[line] = key;
+                cached[line] = group_of[k];
+            }
+            if (not ok) break;
+            for (size_t k = 0; k < count; k++) counts[group_of[k]] += 1.0;
+        } else {
+            counts[0] += (double) count;
+        }
+
+        // 3. Evaluate each expression once, a whole vector per operator.
+        // When most rows survive, computing the whole batch densely and
+        // reading the live rows through ``sel`` at the fold beats
+        // gathering on every node.
+        size_t batch = table->_rows - start;
+        if (batch > TABLE_BATCH) batch = TABLE_BATCH;
+        bool dense = sel and count * 2 >= batch;
+        const uint32_t * through = dense ? sel : NULL;
+
+        for (size_t a = 0; a < aggregates; a++) {
+            results[a] = NULL;
+            if (select[a].op == TABLE_COUNT) continue;
+
+            for (size_t b = 0; b < a and not results[a]; b++)
+                if (select[b].expr == select[a].expr) results[a] = results[b];
+            if (not results[a]) {
+                results[a] = _Table_eval(table, select[a].expr, start,
+                                         dense ? NULL : sel, dense ? batch : count,
+                                         vectors + a * TABLE_BATCH);
+            }
+        }
+
+        // 4. Fold every aggregate in one pass over the rows.
+        _Table_fold(select, aggregates, results, through, count,
+                    group_by ? group_of : NULL, acc);
+    }
+    free(vectors);
+
+    HashMap(int64_t, size_t, delete)(slots);
+    TableResult * result = ok ? malloc(sizeof(TableResult)) : NULL;
+    int64_t ** order = ok ? malloc((groups ? groups : 1) * sizeof(int64_t *)) : NULL;
+    double * values = ok ? malloc((groups * aggregates + 1) * sizeof(double)) : NULL;
+    int64_t * sorted_keys = ok ? malloc((groups ? groups : 1) * sizeof(int64_t)) : NULL;
+
+    if (not result or not order or not values or not sorted_keys) {
+        free(result); free(order); free(values); free(sorted_keys);
+        free(keys); free(acc); free(counts);
+        return NULL;
+    }
+
+    // Finalize: sort groups by key, then resolve counts and averages.
+    for (size_t group = 0; group < groups; group++) order[group] = &keys[group];
+    qsort(order, groups, sizeof(int64_t *), _Table_compare_keys);
+
+    for (size_t row = 0; row < groups; row++) {
+        size_t group = (size_t) (order[row] - keys);
+        sorted_keys[row] = keys[group];
+        for (size_t a = 0; a < aggregates; a++) {
+            double value = acc[group * aggregates + a];
+            if (select[a].op == TABLE_COUNT) value = counts[group];
+            if (select[a].op == TABLE_AVG) value /= counts[group];
+            values[row * aggregates + a] = value;
+        }
+    }
+
+    free(order);
+    free(keys);
+    free(acc);
+    free(counts);
+
+    result->groups = groups;
+    result->aggregates = aggregates;
+    result->keys = sorted_keys;
+    result->values = values;
+    return result;
+}
+
+
+// ~~~~~~~~ Results ~~~~~~~~
+
+// TableResult >> get(result: *TableResult, group: size_t, aggregate: size_t) -> double
+//
+// Returns an aggregate of a group, or NaN if out of bounds.
+//
+double TableResult_get(TableResult * result, size_t group, size_t aggregate) {
+    ensure(result, NAN);
+    ensure(group < result->groups and aggregate < result->aggregates, NAN);
+    return result->values[group * result->aggregates + aggregate];
+}
+
+// TableResult >> delete(result: *TableResult) -> bool
+//
+// Safely deletes the result.
+//
+bool TableResult_delete(TableResult * result) {
+    ensure(result, false);
+
+    free(result->keys);
+    free(result->values);
+    free(result);
+    return true;
+}
+
+// TableResult >> print(result: *TableResult) -> void
+//
+// Prints the result on terminal, one group per line.
+//
+void TableResult_print(TableResult * result) {
+    ensure(result,);
+
+    for (size_t group = 0; group < result->groups; group++) {
+        printf("%lld:", (long long) result->keys[group]);
+        for (size_t a = 0; a < result->aggregates; a++)
+            printf(" %.2f", TableResult_get(result, group, a));
+        printf("\n");
+    }
+}
+
+#endif
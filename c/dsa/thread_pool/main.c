@@ -0,0 +1,47 @@
+#include <stdio.h>
+
+#include "thread_pool.h"
+
+#define CHUNKS 64
+
+typedef struct {
+    const double * values;
+    size_t size;
+    double partial[CHUNKS];
+} Sum;
+
+void sum_chunk(void * context, size_t task, size_t worker) {
+    (void) worker;
+    Sum * sum = context;
+
+    size_t first = task * sum->size / CHUNKS;
+    size_t last = (task + 1) * sum->size / CHUNKS;
+
+    double total = 0.0;
+    for (size_t i = first; i < last; i++) total += sum->values[i];
+    sum->partial[task] = total;
+}
+
+int main() {
+
+    size_t size = 10000000;
+    double * values = malloc(size * sizeof(double));
+    for (size_t i = 0; i < size; i++) values[i] = 0.5;
+
+    ThreadPool * pool = ThreadPool_new(4);
+    Sum sum = { .values = values, .size = size };
+
+    for (int round = 0; round < 3; round++) {
+        ThreadPool_run(pool, CHUNKS, sum_chunk, &sum);
+
+        double total = 0.0;
+        for (size_t chunk = 0; chunk < CHUNKS; chunk++) total += sum.partial[chunk];
+        printf("round %d: %zu workers, sum = %g\n",
+            round, ThreadPool_workers(pool), total);
+    }
+
+    ThreadPool_delete(pool);
+    free(values);
+    return 0;
+
+}
@@ -0,0 +1,255 @@
+// ==========
+// ThreadPool
+// ==========
+//
+// :Author: RickBarretto
+// :Year: 2026
+// :License: MPL 2.0
+// :Copyright: RickBarretto, 2026
+// :Version: 1.0
+//
+// ``ThreadPool`` is a fork-join pool of persistent POSIX threads
+// for the parallel kernels of this repository.
+//
+// A job is ``tasks`` independent calls of ``fn(context, task, worker)``.
+// Tasks are handed out dynamically through an atomic counter,
+// so uneven tasks still balance, and the calling thread works too.
+// ``worker`` is in [0, workers), handy to index per-thread buffers.
+//
+// Every kernel taking a ``ThreadPool *`` also accepts NULL,
+// which runs all the tasks on the calling thread.
+//
+// How to Use
+// ----------
+//
+//      #include "thread_pool.h"
+//
+//      void square(void * context, size_t task, size_t worker) {
+//          double * values = context;
+//          values[task] *= values[task];
+//      }
+//
+//      ThreadPool * pool = ThreadPool_new(0);    // one worker per core
+//      ThreadPool_run(pool, 1000, square, values);
+//      ThreadPool_delete(pool);
+//
+// Link with ``-pthread``.
+//
+
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+// =~=~=~=~=~=~=~=~ Imports ~=~=~=~=~=~=~=~=
+
+#include <iso646.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+
+// =~=~=~=~=~=~=~=~ Helper Macros ~=~=~=~=~=~=~=~=
+
+#define ensure(COND, VAL) if (not (COND)) return VAL
+
+
+// =~=~=~=~=~=~=~=~ Implementation ~=~=~=~=~=~=~=~=
+
+typedef void (*ThreadPoolTask)(void * context, size_t task, size_t worker);
+
+typedef struct ThreadPool ThreadPool;
+
+typedef struct {
+    ThreadPool * pool;
+    size_t worker;
+} _ThreadPoolSeat;
+
+struct ThreadPool {
+    pthread_t * threads;
+    _ThreadPoolSeat * seats;
+    size_t _workers;            // threads + the calling thread
+
+    pthread_mutex_t lock;
+    pthread_cond_t wake;
+    pthread_cond_t done;
+    uint64_t generation;        // bumped for every job
+    size_t busy;                // threads still working on the job
+    bool stopping;
+
+    ThreadPoolTask fn;
+    void * context;
+    size_t tasks;
+    atomic_size_t next;
+};
+
+void _ThreadPool_drain(ThreadPool * pool, size_t worker) {
+    for (;;) {
+        size_t task = atomic_fetch_add_explicit(&pool->next, 1, memory_order_relaxed);
+        if (task >= pool->tasks) return;
+        pool->fn(pool->context, task, worker);
+    }
+}
+
+void * _ThreadPool_main(void * argument) {
+    _ThreadPoolSeat * seat = argument;
+    ThreadPool * pool = seat->pool;
+    uint64_t seen = 0;
+
+    pthread_mutex_lock(&pool->lock);
+    for (;;) {
+        while (pool->generation == seen and not pool->stopping)
+            pthread_cond_wait(&pool->wake, &pool->lock);
+        if (pool->stopping) break;
+        seen = pool->generation;
+        pthread_mutex_unlock(&pool->lock);
+
+        _ThreadPool_drain(pool, seat->worker);
+
+        pthread_mutex_lock(&pool->lock);
+        if (--pool->busy == 0) pthread_cond_signal(&pool->done);
+    }
+    pthread_mutex_unlock(&pool->lock);
+    return NULL;
+}
+
+// ThreadPool >> cores() -> size_t
+//
+// Returns the number of online processors, at least 1.
+//
+size_t ThreadPool_cores() {
+    long cores = sysconf(_SC_NPROCESSORS_ONLN);
+    return cores > 0 ? (size_t) cores : 1;
+}
+
+// ThreadPool >> delete(pool: *ThreadPool) -> bool
+//
+// Stops and joins the threads, then deletes the pool.
+// Must not be called while a job is running.
+//
+// Returns
+// -------
+// bool: Returns true on success.
+//
+bool ThreadPool_delete(ThreadPool * pool) {
+    ensure(pool, false);
+
+    pthread_mutex_lock(&pool->lock);
+    pool->stopping = true;
+    pthread_cond_broadcast(&pool->wake);
+    pthread_mutex_unlock(&pool->lock);
+
+    for (size_t i = 0; i + 1 < pool->_workers; i++)
+        pthread_join(pool->threads[i], NULL);
+
+    pthread_mutex_destroy(&pool->lock);
+    pthread_cond_destroy(&pool->wake);
+    pthread_cond_destroy(&pool->done);
+    free(pool->threads);
+    free(pool->seats);
+    free(pool);
+    return true;
+}
+
+// ThreadPool >> new(workers: size_t) -> *ThreadPool
+//
+// Creates a pool, spawning ``workers - 1`` threads.
+//
+// Parameters
+// ----------
+// workers : size_t
+//     The number of workers, counting the calling thread.
+//     0 means one worker per online processor.
+//
+// Returns
+// -------
+// *ThreadPool: A pointer to the newly created pool, or NULL on failure.
+//
+ThreadPool * ThreadPool_new(size_t workers) {
+    if (workers == 0) workers = ThreadPool_cores();
+
+    ThreadPool * pool = calloc(1, sizeof(ThreadPool));
+    ensure(pool, NULL);
+
+    pool->threads = calloc(workers, sizeof(pthread_t));
+    pool->seats = calloc(workers, sizeof(_ThreadPoolSeat));
+    if (not pool->threads or not pool->seats) {
+        free(pool->threads); free(pool->seats); free(pool);
+        return NULL;
+    }
+
+    pthread_mutex_init(&pool->lock, NULL);
+    pthread_cond_init(&pool->wake, NULL);
+    pthread_cond_init(&pool->done, NULL);
+    atomic_init(&pool->next, 0);
+
+    pool->_workers = 1;
+    for (size_t i = 1; i < workers; i++) {
+        pool->seats[i] = (_ThreadPoolSeat) { .pool = pool, .worker = i };
+        if (pthread_create(&pool->threads[i - 1], NULL,
+                           _ThreadPool_main, &pool->seats[i]) != 0) {
+            ThreadPool_delete(pool);
+            return NULL;
+        }
+        pool->_workers++;
+    }
+    return pool;
+}
+
+// ThreadPool >> workers(pool: *ThreadPool) -> size_t
+//
+// Returns the number of workers, 1 for a NULL pool.
+//
+size_t ThreadPool_workers(ThreadPool * pool) {
+    ensure(pool, 1);
+    return pool->_workers;
+}
+
+// ThreadPool >> run(pool: *ThreadPool, tasks: size_t, fn: ThreadPoolTask, context: *void) -> bool
+//
+// Runs ``fn(context, task, worker)`` for every task in [0, tasks)
+// and waits for all of them. The calling thread runs tasks as worker 0.
+//
+// Parameters
+// ----------
+// pool : *ThreadPool
+//     The pool, or NULL to run everything on the calling thread.
+// tasks : size_t
+//     The number of tasks.
+// fn : ThreadPoolTask
+//     The task body.
+// context : *void
+//     Shared, read-mostly data handed to every task.
+//
+// Returns
+// -------
+// bool: Returns true once every task has run.
+//
+bool ThreadPool_run(ThreadPool * pool, size_t tasks, ThreadPoolTask fn, void * context) {
+    ensure(fn, false);
+
+    if (not pool or pool->_workers == 1 or tasks <= 1) {
+        for (size_t task = 0; task < tasks; task++) fn(context, task, 0);
+        return true;
+    }
+
+    pthread_mutex_lock(&pool->lock);
+    pool->fn = fn;
+    pool->context = context;
+    pool->tasks = tasks;
+    atomic_store(&pool->next, 0);
+    pool->busy = pool->_workers - 1;
+    pool->generation++;
+    pthread_cond_broadcast(&pool->wake);
+    pthread_mutex_unlock(&pool->lock);
+
+    _ThreadPool_drain(pool, 0);
+
+    pthread_mutex_lock(&pool->lock);
+    while (pool->busy > 0) pthread_cond_wait(&pool->done, &pool->lock);
+    pthread_mutex_unlock(&pool->lock);
+    return true;
+}
+
+#endif
@@ -0,0 +1,171 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <signal.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <sys/wait.h>
+#include <time.h>
+
+#define WAL_ARRAY_CHECKPOINT ((off_t) 1 << 20)
+#define T int64_t
+#define PRINT_T(value) printf("%lld", (long long) value)
+#include "wal_array.h"
+
+// Usage: ./main [commits] [rounds] [accounts], defaults to 20000 commits of
+// 16 sets, 20 crash rounds and 4096 accounts. Files go to /tmp.
+
+typedef WalArray(int64_t) Wal;
+
+double seconds() {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec + now.tv_nsec * 1e-9;
+}
+
+uint64_t next_random(uint64_t * seed) {
+    *seed = *seed * 6364136223846793005ull + 1442695040888963407ull;
+    return *seed >> 32;
+}
+
+// What the writer had synced: every commit up to ``lsn``, in ``log`` bytes of log.
+typedef struct {
+    uint64_t lsn;
+    int64_t log;
+} Synced;
+
+void remove_files(const char * path) {
+    char log[256];
+    snprintf(log, sizeof(log), "%s.wal", path);
+    unlink(path);
+    unlink(log);
+}
+
+// Eight transfers per commit, so the total never changes between commits.
+// The 16 accounts are distinct, as staged sets are not seen by ``get``.
+void transfer(Wal * wal, uint64_t * seed) {
+    size_t size = WalArray(int64_t, size)(wal);
+    size_t base = next_random(seed) % size;
+    for (size_t i = 0; i < 8; i++) {
+        size_t from = (base + 2 * i) % size, to = (base + 2 * i + 1) % size;
+        int64_t amount = (int64_t) (next_random(seed) % 100);
+        WalArray(int64_t, set)(wal, from, *WalArray(int64_t, get)(wal, from) - amount);
+        WalArray(int64_t, set)(wal, to, *WalArray(int64_t, get)(wal, to) + amount);
+    }
+    if (not WalArray(int64_t, commit)(wal)) WalArray(int64_t, abort)(wal);
+}
+
+// Commits forever, reporting each sync on ``report``, until killed.
+void writer(const char * path, size_t accounts, uint64_t seed, int report) {
+    Wal * wal = WalArray(int64_t, open)(path, accounts);
+    if (not wal) _exit(1);
+
+    size_t syncs = wal->_syncs;
+    for (;;) {
+        transfer(wal, &seed);
+        if (wal->_syncs != syncs) {
+            syncs = wal->_syncs;
+            Synced synced = { WalArray(int64_t, lsn)(wal), (int64_t) wal->_log_size };
+            if (write(report, &synced, sizeof(synced)) != sizeof(synced)) _exit(1);
+        }
+    }
+}
+
+int main(int argc, char ** argv) {
+
+    char path[64];
+    snprintf(path, sizeof(path), "/tmp/wal_array_%d.dat", (int) getpid());
+    remove_files(path);
+
+    Wal * small = WalArray(int64_t, open)(path, 4);
+    WalArray(int64_t, set)(small, 0, 7);
+    WalArray(int64_t, set)(small, 3, 9);
+    WalArray(int64_t, commit)(small);
+    WalArray(int64_t, set)(small, 1, 8);
+    WalArray(int64_t, sync)(small);
+    WalArray(int64_t, debug)(small);
+    WalArray(int64_t, close)(small);
+    small = WalArray(int64_t, open)(path, 4);
+    WalArray(int64_t, println)(small);
+    WalArray(int64_t, close)(small);
+    remove_files(path);
+    printf("\n");
+
+    size_t commits = argc > 1 ? (size_t) atoll(argv[1]) : 20000;
+    size_t rounds = argc > 2 ? (size_t) atoll(argv[2]) : 20;
+    size_t accounts = argc > 3 ? (size_t) atoll(argv[3]) : 4096;
+    uint64_t seed = 1;
+
+    // Throughput: a sync per commit, against a sync per WAL_ARRAY_GROUP commits.
+    double times[2];
+    for (int grouped = 0; grouped < 2; grouped++) {
+        Wal * wal = WalArray(int64_t, open)(path, accounts);
+        if (not wal) return 1;
+        double start = seconds();
+        for (size_t i = 0; i < commits; i++) {
+            transfer(wal, &seed);
+            if (not grouped) WalArray(int64_t, sync)(wal);
+        }
+        WalArray(int64_t, sync)(wal);
+        times[grouped] = seconds() - start;
+        WalArray(int64_t, close)(wal);
+        remove_files(path);
+    }
+    printf("%zu commits of 16 sets, %zu accounts\n", commits, accounts);
+    printf("sync per commit:  %8.2f ms, %10.0f commits/s\n", times[0] * 1e3, commits / times[0]);
+    printf("group of %3d:     %8.2f ms, %10.0f commits/s\n", WAL_ARRAY_GROUP, times[1] * 1e3, commits / times[1]);
+
+    // Crashes: a writer is killed at a random point, and the unsynced tail
+    // of its log is cut at a random byte, as a power loss would, unless a
+    // checkpoint may have begun, whose own sync made that tail durable.
+    // Recovery must keep the total, and every commit the writer saw synced.
+    Wal * wal = WalArray(int64_t, open)(path, accounts);
+    if (not wal) return 1;
+    for (size_t i = 0; i < accounts; i++) WalArray(int64_t, set)(wal, i, 1000);
+    WalArray(int64_t, commit)(wal);
+    WalArray(int64_t, close)(wal);
+
+    size_t broken = 0, lost = 0, replayed = 0;
+    for (size_t round = 0; round < rounds; round++) {
+        int report[2];
+        if (pipe(report) != 0) return 1;
+        pid_t child = fork();
+        if (child == 0) {
+            close(report[0]);
+            writer(path, accounts, seed + round, report[1]);
+        }
+        close(report[1]);
+
+        struct timespec pause = { 0, (long) (next_random(&seed) % 200) * 1000000 };
+        nanosleep(&pause, NULL);
+        kill(child, SIGKILL);
+        waitpid(child, NULL, 0);
+
+        Synced synced = { 0, -1 }, last;
+        while (read(report[0], &last, sizeof(last)) == sizeof(last)) synced = last;
+        close(report[0]);
+
+        char log[80];
+        snprintf(log, sizeof(log), "%s.wal", path);
+        struct stat info;
+        if (synced.log >= 0 and stat(log, &info) == 0 and info.st_size > synced.log
+            and info.st_size < WAL_ARRAY_CHECKPOINT) {
+            off_t cut = synced.log + (off_t) (next_random(&seed) % (uint64_t) (info.st_size - synced.log + 1));
+            if (truncate(log, cut) != 0) return 1;
+        }
+
+        wal = WalArray(int64_t, open)(path, accounts);
+        if (not wal) return 1;
+        int64_t total = 0;
+        for (size_t i = 0; i < accounts; i++) total += *WalArray(int64_t, get)(wal, i);
+        broken += total != (int64_t) accounts * 1000;
+        lost += WalArray(int64_t, lsn)(wal) < synced.lsn;
+        replayed += WalArray(int64_t, replayed)(wal);
+        if (not WalArray(int64_t, close)(wal)) return 1;
+    }
+    printf("%zu crashes: %zu records replayed, %zu broken totals, %zu lost synced commits\n",
+        rounds, replayed, broken, lost);
+
+    remove_files(path);
+    return 0;
+
+}
@@ -0,0 +1,665 @@
+// ============
+// WalArray<T>
+// ============
+//
+// :Author: RickBarretto
+// :Year: 2026
+// :License: MPL 2.0
+// :Copyright: RickBarretto, 2026
+// :Version: 1.0
+//
+// ``WalArray<T>`` is a fixed-size array kept in a file, which survives
+// crashes without rewriting the file on every change, through
+// a write-ahead log (WAL) next to it.
+//
+// The file is mapped privately: changes live in memory, and reach the
+// file only at a checkpoint. ``set`` stages ``(index, value)`` pairs,
+// and ``commit`` appends them as one record to ``<path>.wal``, with
+// a CRC-32 over the record, before applying them to the mapping.
+//
+// Commits are synced in groups: the log is ``fdatasync``ed once every
+// WAL_ARRAY_GROUP commits, or on ``sync``, so a crash loses at most the
+// commits since the last sync, and never part of one. A checkpoint, run
+// once the log grows past WAL_ARRAY_CHECKPOINT bytes, or on ``checkpoint``
+// and ``close``, writes the pages changed since the last one to the file,
+// syncs it, stamps the last record in its header, and empties the log.
+//
+// ``open`` recovers: it replays every record after the checkpoint stamp,
+// in order, and stops at the first torn or corrupt one, dropping the rest.
+//
+//      +-----------------+
+//      | header          |  magic "RKWAL1", element size, size, checkpoint
+//      +-----------------+  WAL_ARRAY_HEADER bytes, so the data is page aligned
+//      | elements ...    |
+//      +-----------------+
+//
+// Each log record is a header (magic, CRC, sequence number, count),
+// then ``count`` pairs of a 64-bit index and a T. Integers are stored
+// in the host byte order, so files move only between alike machines.
+//
+// A WalArray is used by one thread at a time. POSIX only.
+//
+// How to Use
+// ----------
+//
+//      #define T int64_t
+//      #define PRINT_T(value) printf("%lld", (long long) value)
+//      #include "wal_array.h"
+//
+// And a common way to use it would be:
+//
+//      WalArray(int64_t) * accounts = WalArray(int64_t, open)("accounts.dat", size);
+//
+//      WalArray(int64_t, set)(accounts, from, *WalArray(int64_t, get)(accounts, from) - 10);
+//      WalArray(int64_t, set)(accounts, to, *WalArray(int64_t, get)(accounts, to) + 10);
+//      WalArray(int64_t, commit)(accounts);           // both or neither, after a crash
+//
+//      WalArray(int64_t, close)(accounts);
+//
+
+// =~=~=~=~=~=~=~=~ Imports ~=~=~=~=~=~=~=~=
+
+#include <fcntl.h>
+#include <iso646.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+
+// =~=~=~=~=~=~=~=~ Helper Macros ~=~=~=~=~=~=~=~=
+
+#define _CAT(X, Y) X ## _ ## Y
+#define CAT(X, Y) _CAT(X, Y)
+#define _CAT3(X, Y, Z) X ## _ ## Y ## _ ## Z
+#define CAT3(X, Y, Z) _CAT3(X, Y, Z)
+
+#define STRINGIFY(x) #x
+#define TOSTRING(x) STRINGIFY(x)
+
+#define ensure(COND, VAL) if (not (COND)) return VAL
+
+
+// =~=~=~=~=~=~=~=~ Allocator Hooks ~=~=~=~=~=~=~=~=
+
+// The same hooks as ``Array<T>``, see its documentation.
+
+#ifndef ARRAY_MALLOC
+#define ARRAY_MALLOC(size) malloc(size)
+#endif
+
+#ifndef ARRAY_CALLOC
+#define ARRAY_CALLOC(count, size) calloc(count, size)
+#endif
+
+#ifndef ARRAY_REALLOC
+#define ARRAY_REALLOC(pointer, size) realloc(pointer, size)
+#endif
+
+#ifndef ARRAY_FREE
+#define ARRAY_FREE(pointer) free(pointer)
+#endif
+
+
+// =~=~=~=~=~=~=~=~ Shared helpers ~=~=~=~=~=~=~=~=
+
+#ifndef WAL_ARRAY_HELPERS
+#define WAL_ARRAY_HELPERS
+
+// WAL_ARRAY_GROUP: Commits per log sync.
+#ifndef WAL_ARRAY_GROUP
+#define WAL_ARRAY_GROUP 64
+#endif
+
+// WAL_ARRAY_CHECKPOINT: Log bytes that trigger a checkpoint.
+#ifndef WAL_ARRAY_CHECKPOINT
+#define WAL_ARRAY_CHECKPOINT ((off_t) 64 << 20)
+#endif
+
+// WAL_ARRAY_HEADER: Bytes before the data, a multiple of any page size.
+#define WAL_ARRAY_HEADER 65536
+
+// WAL_ARRAY_PAGE: Granularity of the pages written at a checkpoint.
+#define WAL_ARRAY_PAGE 4096
+
+#define _WAL_ARRAY_MAGIC "RKWAL1"
+#define _WAL_ARRAY_RECORD 0x57414c52u      // "RLAW"
+
+typedef struct {
+    char magic[8];
+    uint64_t element;           // sizeof(T)
+    uint64_t size;
+    uint64_t checkpoint;        // the last record already in the file
+} _WalArrayHeader;
+
+typedef struct {
+    uint32_t magic;
+    uint32_t crc;               // of everything after it, up to the record's end
+    uint64_t lsn;               // sequence number, one more than the previous record's
+    uint64_t count;
+} _WalArrayRecord;
+
+// CRC-32 (IEEE 802.3), a byte at a time from a table built on first use.
+uint32_t _WalArray_crc32(const void * bytes, size_t size) {
+    static uint32_t table[256];
+    if (not table[1]) {
+        for (uint32_t i = 0; i < 256; i++) {
+            uint32_t crc = i;
+            for (int bit = 0; bit < 8; bit++) crc = crc & 1 ? crc >> 1 ^ 0xEDB88320u : crc >> 1;
+            table[i] = crc;
+        }
+    }
+
+    const uint8_t * p = bytes;
+    uint32_t crc = 0xFFFFFFFFu;
+    for (size_t i = 0; i < size; i++) crc = table[(crc ^ p[i]) & 0xFF] ^ crc >> 8;
+    return crc ^ 0xFFFFFFFFu;
+}
+
+// Writes all of ``size`` bytes at ``offset``, through short writes.
+bool _WalArray_pwrite(int fd, const void * bytes, size_t size, off_t offset) {
+    const uint8_t * p = bytes;
+    while (size > 0) {
+        ssize_t written = pwrite(fd, p, size, offset);
+        ensure(written > 0, false);
+        p += written;
+        size -= (size_t) written;
+        offset += written;
+    }
+    return true;
+}
+
+// Reads all of ``size`` bytes at ``offset``, false if the file ends first.
+bool _WalArray_pread(int fd, void * bytes, size_t size, off_t offset) {
+    uint8_t * p = bytes;
+    while (size > 0) {
+        ssize_t got = pread(fd, p, size, offset);
+        ensure(got > 0, false);
+        p += got;
+        size -= (size_t) got;
+        offset += got;
+    }
+    return true;
+}
+
+#endif
+
+
+// =~=~=~=~=~=~=~=~ Implementation ~=~=~=~=~=~=~=~=
+
+// T: Element type of the WalArray<T>, plain data without pointers.
+#ifndef T
+#error "T is not defined"
+#endif
+
+// PRINT_T: (T) -> void
+//
+// PRINT_T is a macro that defines how to print an element of type T.
+// See ``Array<T>`` for more details.
+//
+#ifndef PRINT_T
+#error "PRINT_T is not defined"
+#endif
+
+#define MODULE WalArray
+#define Self CAT(MODULE, T)
+#define fn(NAME) CAT(Self, NAME)
+
+#define _WAL_ARRAY_SELECT_MACRO(_1, _2, NAME, ...) NAME
+#define WalArray(...) _WAL_ARRAY_SELECT_MACRO(__VA_ARGS__, WalArray2, WalArray1)(__VA_ARGS__)
+#define WalArray1(T) CAT(WalArray, T)
+#define WalArray2(T, FUNC) CAT3(WalArray, T, FUNC)
+
+typedef struct {
+    uint64_t index;
+    T value;
+} fn(_Entry);
+
+typedef struct {
+    T * data;                   // the private mapping, with every commit applied
+    size_t _size;
+    int _file;
+    int _log;
+    off_t _log_size;
+    uint64_t _lsn;              // the last record appended
+    uint64_t _checkpoint;       // the last record in the file
+    size_t _unsynced;           // commits since the last log sync
+    size_t _syncs;
+    size_t _replayed;           // records recovered by ``open``
+    size_t _failures;           // group syncs and checkpoints ``commit`` could not do
+    uint8_t * _record;          // the staged record: header, then entries
+    size_t _staged;
+    size_t _capacity;           // entries that fit in ``_record``
+    uint64_t * _dirty;          // a bit per WAL_ARRAY_PAGE changed since the checkpoint
+    size_t _mapped;             // bytes of the mapping
+} Self;
+
+
+// ~~~~~~~~ Log ~~~~~~~~
+
+fn(_Entry) * fn(_entries)(uint8_t * record) {
+    return (fn(_Entry) *) (record + sizeof(_WalArrayRecord));
+}
+
+// Applies entries to the mapping, marking their pages for the next checkpoint.
+void fn(_apply)(Self * wal, fn(_Entry) * entries, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        size_t index = (size_t) entries[i].index;
+        wal->data[index] = entries[i].value;
+        size_t first = index * sizeof(T) / WAL_ARRAY_PAGE, last = ((index + 1) * sizeof(T) - 1) / WAL_ARRAY_PAGE;
+        for (size_t page = first; page <= last; page++) wal->_dirty[page / 64] |= (uint64_t) 1 << (page % 64);
+    }
+}
+
+// Room for ``count`` staged entries.
+bool fn(_reserve)(Self * wal, size_t count) {
+    ensure(count > wal->_capacity, true);
+
+    size_t capacity = wal->_capacity ? wal->_capacity : 64;
+    while (capacity < count) capacity *= 2;
+    uint8_t * record = ARRAY_REALLOC(wal->_record, sizeof(_WalArrayRecord) + capacity * sizeof(fn(_Entry)));
+    ensure(record, false);
+
+    wal->_record = record;
+    wal->_capacity = capacity;
+    return true;
+}
+
+// Replays the records after the checkpoint, then cuts the log after the last valid one.
+bool fn(_recover)(Self * wal) {
+    struct stat info;
+    ensure(fstat(wal->_log, &info) == 0, false);
+
+    off_t offset = 0;
+    uint64_t lsn = 0;
+    _WalArrayRecord header;
+    while (_WalArray_pread(wal->_log, &header, sizeof(header), offset)) {
+        off_t left = info.st_size - offset - (off_t) sizeof(header);
+        if (header.magic != _WAL_ARRAY_RECORD or header.count > (uint64_t) left / sizeof(fn(_Entry))) break;
+        if (lsn and header.lsn != lsn + 1) break;
+        if (not fn(_reserve)(wal, (size_t) header.count)) return false;
+
+        size_t bytes = (size_t) header.count * sizeof(fn(_Entry));
+        memcpy(wal->_record, &header, sizeof(header));
+        if (not _WalArray_pread(wal->_log, fn(_entries)(wal->_record), bytes, offset + (off_t) sizeof(header))) break;
+        if (_WalArray_crc32(wal->_record + 8, sizeof(header) - 8 + bytes) != header.crc) break;
+
+        bool bounded = true;
+        for (size_t i = 0; i < header.count; i++) bounded = bounded and fn(_entries)(wal->_record)[i].index < wal->_size;
+        if (not bounded) break;
+
+        if (header.lsn > wal->_checkpoint) {
+            fn(_apply)(wal, fn(_entries)(wal->_record), (size_t) header.count);
+            wal->_replayed++;
+        }
+        lsn = header.lsn;
+        offset += (off_t) (sizeof(header) + bytes);
+    }
+
+    // Whatever follows the last valid record was never synced: drop it.
+    if (offset != info.st_size) {
+        ensure(ftruncate(wal->_log, offset) == 0, false);
+        ensure(fdatasync(wal->_log) == 0, false);
+    }
+    wal->_log_size = offset;
+    wal->_lsn = lsn > wal->_checkpoint ? lsn : wal->_checkpoint;
+    return true;
+}
+
+
+// ~~~~~~~~ Lifetime ~~~~~~~~
+
+bool fn(checkpoint)(Self * wal);
+
+// Releases everything, without a checkpoint.
+void fn(_free)(Self * wal) {
+    if (wal->data and wal->data != MAP_FAILED) munmap(wal->data, wal->_mapped);
+    if (wal->_file >= 0) close(wal->_file);
+    if (wal->_log >= 0) close(wal->_log);
+    ARRAY_FREE(wal->_record);
+    ARRAY_FREE(wal->_dirty);
+    ARRAY_FREE(wal);
+}
+
+// WalArray >> open(path: *char, size: size_t) -> *WalArray<T>
+//
+// Opens the array stored at ``path`` and recovers it from its log,
+// or creates it with ``size`` zeros. The log is ``<path>.wal``.
+//
+// Parameters
+// ----------
+// path : *char
+//     The data file.
+// size : size_t
+//     The number of elements, which must match an existing file.
+//
+// Returns
+// -------
+// *WalArray<T>: The array, or NULL if the files cannot be opened,
+//     belong to another size or type, or recovery fails.
+//
+Self * fn(open)(const char * path, size_t size) {
+    ensure(path, NULL);
+
+    Self * wal = ARRAY_CALLOC(1, sizeof(Self));
+    ensure(wal, NULL);
+
+    wal->_size = size;
+    wal->_file = wal->_log = -1;
+    wal->_mapped = size ? size * sizeof(T) : 1;
+    size_t pages = (wal->_mapped + WAL_ARRAY_PAGE - 1) / WAL_ARRAY_PAGE;
+    wal->_dirty = ARRAY_CALLOC((pages + 63) / 64, sizeof(uint64_t));
+
+    char * log_path = ARRAY_MALLOC(strlen(path) + 5);
+    if (log_path) {
+        strcpy(log_path, path);
+        strcat(log_path, ".wal");
+        wal->_file = open(path, O_RDWR | O_CREAT, 0644);
+        wal->_log = open(log_path, O_RDWR | O_CREAT, 0644);
+        ARRAY_FREE(log_path);
+    }
+    if (not wal->_dirty or wal->_file < 0 or wal->_log < 0) {
+        fn(_free)(wal);
+        return NULL;
+    }
+
+    // A new file, or one whose creation never reached its sync, gets its
+    // header and zeros; an existing one must match.
+    _WalArrayHeader header;
+    off_t length = WAL_ARRAY_HEADER + (off_t) (size * sizeof(T));
+    if (not _WalArray_pread(wal->_file, &header, sizeof(header), 0) or header.magic[0] == 0) {
+        memset(&header, 0, sizeof(header));
+        memcpy(header.magic, _WAL_ARRAY_MAGIC, sizeof(_WAL_ARRAY_MAGIC));
+        header.element = sizeof(T);
+        header.size = size;
+        bool created = ftruncate(wal->_file, length) == 0
+            and _WalArray_pwrite(wal->_file, &header, sizeof(header), 0)
+            and fsync(wal->_file) == 0
+            and ftruncate(wal->_log, 0) == 0;
+        if (not created) {
+            fn(_free)(wal);
+            return NULL;
+        }
+    }
+    bool matches = memcmp(header.magic, _WAL_ARRAY_MAGIC, sizeof(_WAL_ARRAY_MAGIC)) == 0
+        and header.element == sizeof(T) and header.size == size;
+    struct stat info;
+    if (not matches or fstat(wal->_file, &info) != 0 or info.st_size < length) {
+        fn(_free)(wal);
+        return NULL;
+    }
+    wal->_checkpoint = header.checkpoint;
+
+    wal->data = mmap(NULL, wal->_mapped, PROT_READ | PROT_WRITE, MAP_PRIVATE, wal->_file, WAL_ARRAY_HEADER);
+    if (wal->data == MAP_FAILED or not fn(_recover)(wal)) {
+        fn(_free)(wal);
+        return NULL;
+    }
+    return wal;
+}
+
+// WalArray >> close(wal: *WalArray<T>) -> bool
+//
+// Checkpoints the array, then closes it. Staged changes are dropped.
+//
+// Returns
+// -------
+// bool: Returns true on success, false if the checkpoint failed,
+//       in which case the log still recovers every synced commit.
+//
+bool fn(close)(Self * wal) {
+    ensure(wal, false);
+
+    wal->_staged = 0;
+    bool ok = fn(checkpoint)(wal);
+    fn(_free)(wal);
+    return ok;
+}
+
+
+// ~~~~~~~~ Access ~~~~~~~~
+
+// WalArray >> get(wal: *WalArray<T>, index: size_t) -> *T
+//
+// Gets a pointer to the committed element at ``index``, for reading:
+// staged changes are not seen before ``commit``.
+//
+// Returns
+// -------
+// *T: A pointer to the element, or NULL if the index is out of bounds.
+//
+T * fn(get)(Self * wal, size_t index) {
+    ensure(wal and index < wal->_size, NULL);
+    return &wal->data[index];
+}
+
+// WalArray >> set(wal: *WalArray<T>, index: size_t, value: T) -> bool
+//
+// Stages ``value`` at ``index``, for the next ``commit``.
+//
+// Returns
+// -------
+// bool: Returns true on success, false if the index is out of bounds.
+//
+bool fn(set)(Self * wal, size_t index, T value) {
+    ensure(wal and index < wal->_size, false);
+    ensure(fn(_reserve)(wal, wal->_staged + 1), false);
+
+    fn(_Entry) * entry = &fn(_entries)(wal->_record)[wal->_staged++];
+    memset(entry, 0, sizeof(*entry));       // no stray padding in the CRC
+    entry->index = index;
+    entry->value = value;
+    return true;
+}
+
+// WalArray >> abort(wal: *WalArray<T>) -> bool
+//
+// Drops the staged changes.
+//
+// Returns
+// -------
+// bool: Returns true on success.
+//
+bool fn(abort)(Self * wal) {
+    ensure(wal, false);
+
+    wal->_staged = 0;
+    return true;
+}
+
+// WalArray >> sync(wal: *WalArray<T>) -> bool
+//
+// Makes every commit so far durable, with one ``fdatasync`` of the log.
+//
+// Returns
+// -------
+// bool: Returns true on success.
+//
+bool fn(sync)(Self * wal) {
+    ensure(wal, false);
+    ensure(wal->_unsynced > 0, true);
+    ensure(fdatasync(wal->_log) == 0, false);
+
+    wal->_unsynced = 0;
+    wal->_syncs++;
+    return true;
+}
+
+// WalArray >> commit(wal: *WalArray<T>) -> bool
+//
+// Appends the staged changes to the log as one record, and applies them.
+// The record is synced with its group, every WAL_ARRAY_GROUP commits,
+// and a checkpoint follows once the log passes WAL_ARRAY_CHECKPOINT.
+//
+// A failed group sync or checkpoint does not undo the commit: both are
+// retried by the next commit, counted by ``failures``, and reported by
+// ``sync`` and ``checkpoint`` when called directly.
+//
+// Returns
+// -------
+// bool: Returns true once the record is written and applied. If the log
+//       cannot be written, nothing is applied and the changes stay staged.
+//
+bool fn(commit)(Self * wal) {
+    ensure(wal, false);
+    ensure(wal->_staged > 0, true);
+
+    _WalArrayRecord header = { _WAL_ARRAY_RECORD, 0, wal->_lsn + 1, wal->_staged };
+    size_t bytes = sizeof(header) + wal->_staged * sizeof(fn(_Entry));
+    memcpy(wal->_record, &header, sizeof(header));
+    header.crc = _WalArray_crc32(wal->_record + 8, bytes - 8);
+    memcpy(wal->_record, &header, sizeof(header));
+    ensure(_WalArray_pwrite(wal->_log, wal->_record, bytes, wal->_log_size), false);
+
+    fn(_apply)(wal, fn(_entries)(wal->_record), wal->_staged);
+    wal->_log_size += (off_t) bytes;
+    wal->_lsn++;
+    wal->_staged = 0;
+    wal->_unsynced++;
+
+    if (wal->_unsynced >= WAL_ARRAY_GROUP and not fn(sync)(wal)) wal->_failures++;
+    else if (wal->_log_size >= WAL_ARRAY_CHECKPOINT and not fn(checkpoint)(wal)) wal->_failures++;
+    return true;
+}
+
+// WalArray >> checkpoint(wal: *WalArray<T>) -> bool
+//
+// Syncs the log, writes every page changed since the last checkpoint to
+// the file, syncs it, stamps the last record in the header and empties
+// the log. A crash at any step recovers from the log as before.
+//
+// Returns
+// -------
+// bool: Returns true on success.
+//
+bool fn(checkpoint)(Self * wal) {
+    ensure(wal, false);
+    ensure(fn(sync)(wal), false);
+    ensure(wal->_lsn != wal->_checkpoint or wal->_log_size > 0, true);
+
+    size_t pages = (wal->_mapped + WAL_ARRAY_PAGE - 1) / WAL_ARRAY_PAGE;
+    for (size_t page = 0; page < pages; page++) {
+        if (not (wal->_dirty[page / 64] >> (page % 64) & 1)) {
+            if (wal->_dirty[page / 64] == 0) page |= 63;
+            continue;
+        }
+
+        size_t first = page;
+        while (page + 1 < pages and wal->_dirty[(page + 1) / 64] >> ((page + 1) % 64) & 1) page++;
+        size_t start = first * WAL_ARRAY_PAGE;
+        size_t end = (page + 1) * WAL_ARRAY_PAGE < wal->_mapped ? (page + 1) * WAL_ARRAY_PAGE : wal->_mapped;
+        ensure(_WalArray_pwrite(wal->_file, (uint8_t *) wal->data + start, end - start, WAL_ARRAY_HEADER + (off_t) start), false);
+    }
+    ensure(fdatasync(wal->_file) == 0, false);
+
+    // Records up to the stamp are in the file; the log may go.
+    _WalArrayHeader header;
+    ensure(_WalArray_pread(wal->_file, &header, sizeof(header), 0), false);
+    header.checkpoint = wal->_lsn;
+    ensure(_WalArray_pwrite(wal->_file, &header, sizeof(header), 0), false);
+    ensure(fdatasync(wal->_file) == 0, false);
+    wal->_checkpoint = wal->_lsn;
+
+    ensure(ftruncate(wal->_log, 0) == 0 and fdatasync(wal->_log) == 0, false);
+    wal->_log_size = 0;
+    wal->_syncs++;
+    memset(wal->_dirty, 0, (pages + 63) / 64 * sizeof(uint64_t));
+    return true;
+}
+
+
+// ~~~~~~~~ Inspection ~~~~~~~~
+
+// WalArray >> size(wal: *WalArray<T>) -> size_t
+//
+// Returns the number of elements.
+//
+size_t fn(size)(Self * wal) {
+    ensure(wal, 0);
+    return wal->_size;
+}
+
+// WalArray >> lsn(wal: *WalArray<T>) -> u64
+//
+// Returns the sequence number of the last commit, 0 if none yet.
+//
+uint64_t fn(lsn)(Self * wal) {
+    ensure(wal, 0);
+    return wal->_lsn;
+}
+
+// WalArray >> replayed(wal: *WalArray<T>) -> size_t
+//
+// Returns the number of records ``open`` recovered from the log.
+//
+size_t fn(replayed)(Self * wal) {
+    ensure(wal, 0);
+    return wal->_replayed;
+}
+
+// WalArray >> failures(wal: *WalArray<T>) -> size_t
+//
+// Returns the number of group syncs and checkpoints that ``commit``
+// attempted and could not do. Commits since the last successful sync
+// are not durable while this grows.
+//
+size_t fn(failures)(Self * wal) {
+    ensure(wal, 0);
+    return wal->_failures;
+}
+
+// WalArray >> print(wal: *WalArray<T>) -> void
+//
+// Prints the committed elements on terminal.
+//
+void fn(print)(Self * wal) {
+    ensure(wal,);
+
+    printf("[");
+    for (size_t i = 0; i < wal->_size; i++) {
+        PRINT_T(wal->data[i]);
+        if (i + 1 < wal->_size) printf(", ");
+    }
+    printf("]");
+}
+
+// WalArray >> println(wal: *WalArray<T>) -> void
+//
+// Prints the committed elements on terminal followed by a newline.
+//
+void fn(println)(Self * wal) {
+    fn(print)(wal);
+    printf("\n");
+}
+
+// WalArray >> debug(wal: *WalArray<T>) -> void
+//
+// Prints the debug representation of the array.
+//
+void fn(debug)(Self * wal) {
+    if (not wal) {
+        printf("WalArray<%s> { NULL }\n", TOSTRING(T));
+        return;
+    }
+
+    printf("WalArray<%s> {\n", TOSTRING(T));
+    printf("  size: %zu,\n", wal->_size);
+    printf("  lsn: %llu,\n", (unsigned long long) wal->_lsn);
+    printf("  checkpoint: %llu,\n", (unsigned long long) wal->_checkpoint);
+    printf("  log: %lld bytes,\n", (long long) wal->_log_size);
+    printf("  unsynced: %zu,\n", wal->_unsynced);
+    printf("  replayed: %zu,\n", wal->_replayed);
+    printf("  failures: %zu,\n", wal->_failures);
+    printf("  data: "); fn(println)(wal);
+    printf("}\n");
+}
+
+#undef MODULE
+#undef Self
+#undef fn
+#undef T
+#undef PRINT_T